@@ -0,0 +1,84 @@
+/**
+ * @file AdaptiveRate.cpp
+ * @brief Contains the implementation of the AdaptiveRate class.
+ * @author Alessandro Bellia
+ * @date 10/15/2026
+ */
+
+#include "AdaptiveRate.h"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @brief The weight of the newest sample in the running mean and variance.
+ */
+static constexpr float kSmoothing = 0.3f;
+
+
+AdaptiveRate::AdaptiveRate()
+	: m_minIntervalNs(std::chrono::nanoseconds(kDefaultMinInterval).count()),
+	  m_maxIntervalNs(std::chrono::nanoseconds(kDefaultMaxInterval).count()),
+	  m_intervalNs(m_minIntervalNs),
+	  m_changeThreshold(kDefaultChangeThreshold),
+	  m_deviationThreshold(kDefaultDeviationThreshold),
+	  m_lastValue(0.0f),
+	  m_mean(0.0f),
+	  m_variance(0.0f),
+	  m_stableCount(0),
+	  m_hasValue(false)
+{
+}
+
+_Use_decl_annotations_
+void AdaptiveRate::SetRange(
+	const std::chrono::nanoseconds minInterval,
+	const std::chrono::nanoseconds maxInterval)
+{
+	m_minIntervalNs = std::max<int64_t>(minInterval.count(), 1);
+	m_maxIntervalNs = std::max(maxInterval.count(), m_minIntervalNs);
+	m_intervalNs    = std::clamp(m_intervalNs, m_minIntervalNs, m_maxIntervalNs);
+}
+
+_Use_decl_annotations_
+void AdaptiveRate::SetThresholds(
+	const float change,
+	const float deviation)
+{
+	m_changeThreshold    = change;
+	m_deviationThreshold = deviation;
+}
+
+_Use_decl_annotations_
+void AdaptiveRate::Observe(
+	const float value)
+{
+	if (!m_hasValue)
+	{
+		m_hasValue  = true;
+		m_lastValue = value;
+		m_mean      = value;
+	}
+
+	// Incremental exponentially weighted mean and variance.
+	const float difference = value - m_mean;
+	const float increment  = kSmoothing * difference;
+	m_mean += increment;
+	m_variance = (1.0f - kSmoothing) * (m_variance + difference * increment);
+
+	const bool isVolatile = std::fabs(value - m_lastValue) >= m_changeThreshold ||
+		m_variance >= m_deviationThreshold * m_deviationThreshold;
+	m_lastValue = value;
+
+	if (isVolatile)
+	{
+		// Attack at once: the next sample comes one minimum interval later.
+		m_intervalNs  = m_minIntervalNs;
+		m_stableCount = 0;
+	}
+	else if (++m_stableCount >= kStableSamples)
+	{
+		// Decay slowly, one doubling per run of calm samples.
+		m_intervalNs  = std::min(m_intervalNs * 2, m_maxIntervalNs);
+		m_stableCount = 0;
+	}
+}
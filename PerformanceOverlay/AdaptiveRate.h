@@ -0,0 +1,117 @@
+/**
+ * @file AdaptiveRate.h
+ * @brief Contains the declaration of the AdaptiveRate class.
+ * @author Alessandro Bellia
+ * @date 10/15/2026
+ */
+
+#pragma once
+
+#include "Platform.h"
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @class AdaptiveRate
+ * @brief Picks the sampling interval of one source from how volatile its signal is.
+ *
+ * The controller watches one representative value of the source (e.g. the total CPU load).
+ * When the step between two samples or the running standard deviation crosses its
+ * threshold, the interval drops straight to the minimum, so a spike is followed at full
+ * rate from the next sample on. After kStableSamples calm samples in a row it doubles, up to
+ * the maximum, so an idle signal is sampled rarely. The mean and variance are exponentially
+ * weighted, so old history fades after a few samples.
+ *
+ * Thresholds are in the units of the value; callers with differently scaled signals
+ * normalize them first (see Normalize()). The controller only picks the interval; the
+ * caller schedules the reads.
+ */
+class AdaptiveRate
+{
+public:
+	/**
+	 * @brief The shortest interval when none is set; also the sampler's default interval.
+	 */
+	static constexpr std::chrono::milliseconds kDefaultMinInterval{250};
+
+	/**
+	 * @brief The longest interval when none is set. At 2 s a stable source can sit out a
+	 *		  short spike entirely; AdaptiveSamplingBenchmark fails if a fixed rate beats this.
+	 */
+	static constexpr std::chrono::milliseconds kDefaultMaxInterval{1000};
+
+	/**
+	 * @brief The step between two consecutive samples that counts as volatile when none is set.
+	 */
+	static constexpr float kDefaultChangeThreshold = 10.0f;
+
+	/**
+	 * @brief The running standard deviation that counts as volatile when none is set.
+	 */
+	static constexpr float kDefaultDeviationThreshold = 4.0f;
+
+	/**
+	 * @brief The number of calm samples in a row after which the interval doubles.
+	 */
+	static constexpr uint32_t kStableSamples = 4;
+
+	AdaptiveRate();
+
+	/**
+	 * @brief Sets the interval range. The current interval is clamped into it.
+	 * @param[in] minInterval The shortest interval, used while the signal is volatile.
+	 * @param[in] maxInterval The longest interval, reached while the signal is stable.
+	 */
+	void SetRange(
+		_In_ std::chrono::nanoseconds minInterval,
+		_In_ std::chrono::nanoseconds maxInterval);
+
+	/**
+	 * @brief Sets the volatility thresholds.
+	 * @param[in] change The step between two consecutive samples that counts as volatile.
+	 * @param[in] deviation The running standard deviation that counts as volatile.
+	 */
+	void SetThresholds(
+		_In_ float change,
+		_In_ float deviation);
+
+	/**
+	 * @brief Feeds a new sample and adapts the interval to the next one.
+	 * @param[in] value The representative value of the source.
+	 */
+	void Observe(
+		_In_ float value);
+
+	/**
+	 * @brief Gets the current interval.
+	 * @return The interval in nanoseconds.
+	 */
+	[[nodiscard]] int64_t GetIntervalNs() const { return m_intervalNs; }
+
+	/**
+	 * @brief Scales a value to percent of a range, so one set of thresholds fits every signal.
+	 * @param[in] value The value.
+	 * @param[in] rangeMin The bottom of the value's scale.
+	 * @param[in] rangeMax The top of its scale; a range that is not fixed leaves the value as is.
+	 * @return The normalized value.
+	 */
+	[[nodiscard]] static float Normalize(
+		_In_ float value,
+		_In_ float rangeMin,
+		_In_ float rangeMax)
+	{
+		return rangeMax > rangeMin ? (value - rangeMin) / (rangeMax - rangeMin) * 100.0f : value;
+	}
+
+private:
+	int64_t  m_minIntervalNs;
+	int64_t  m_maxIntervalNs;
+	int64_t  m_intervalNs;
+	float    m_changeThreshold;
+	float    m_deviationThreshold;
+	float    m_lastValue;
+	float    m_mean;     ///< Exponentially weighted mean.
+	float    m_variance; ///< Exponentially weighted variance around m_mean.
+	uint32_t m_stableCount;
+	bool     m_hasValue;
+};
@@ -0,0 +1,147 @@
+/**
+ * @file AllocationCounter.cpp
+ * @brief Contains the implementation of the allocation-counting test mode.
+ * @author Alessandro Bellia
+ * @date 10/15/2026
+ */
+
+#include "AllocationCounter.h"
+
+#ifdef PERFOVERLAY_COUNT_ALLOCATIONS
+
+#include "imgui.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+/**
+ * @brief The number of allocations made through the counting hooks.
+ */
+static std::atomic<uint64_t> g_allocationCount{0};
+
+/**
+ * @brief Allocates memory and counts the allocation.
+ * @param[in] size The number of bytes to allocate.
+ * @return The allocated memory, or nullptr if it could not be allocated.
+ */
+static void* CountedAlloc(
+	_In_ size_t size);
+
+/**
+ * @brief ImGui allocator hook that counts the allocation.
+ * @param[in] size The number of bytes to allocate.
+ * @param[in] userData Unused.
+ * @return The allocated memory.
+ */
+static void* ImGuiCountedAlloc(
+	_In_ size_t    size,
+	_In_opt_ void* userData);
+
+/**
+ * @brief ImGui deallocator hook.
+ * @param[in] ptr The memory to free; may be null.
+ * @param[in] userData Unused.
+ */
+static void ImGuiFree(
+	_In_opt_ void* ptr,
+	_In_opt_ void* userData);
+
+
+void* operator new(
+	const size_t size)
+{
+	if (void* ptr = CountedAlloc(size))
+	{
+		return ptr;
+	}
+	throw std::bad_alloc();
+}
+
+void* operator new(
+	const size_t size,
+	const std::nothrow_t&) noexcept
+{
+	return CountedAlloc(size);
+}
+
+void operator delete(
+	void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(
+	void*        ptr,
+	const size_t size) noexcept
+{
+	(void)size;
+	std::free(ptr);
+}
+
+void InstallImGuiAllocationCounter()
+{
+	ImGui::SetAllocatorFunctions(ImGuiCountedAlloc, ImGuiFree);
+}
+
+uint64_t GetAllocationCount()
+{
+	return g_allocationCount.load(std::memory_order_relaxed);
+}
+
+_Use_decl_annotations_
+AllocationCheck::AllocationCheck(
+	const std::chrono::steady_clock::duration warmup)
+	: m_warmupEnd(std::chrono::steady_clock::now() + warmup),
+	  m_baseline(0),
+	  m_steadyStateAllocations(0),
+	  m_warmedUp(false)
+{
+}
+
+bool AllocationCheck::Check()
+{
+	const uint64_t count = GetAllocationCount();
+	if (!m_warmedUp)
+	{
+		if (std::chrono::steady_clock::now() >= m_warmupEnd)
+		{
+			m_warmedUp = true;
+			m_baseline = count;
+		}
+		return true;
+	}
+
+	const uint64_t allocations = count - m_baseline;
+	m_baseline                 = count;
+	m_steadyStateAllocations += allocations;
+	return allocations == 0;
+}
+
+
+_Use_decl_annotations_
+static void* CountedAlloc(
+	const size_t size)
+{
+	g_allocationCount.fetch_add(1, std::memory_order_relaxed);
+	return std::malloc(size != 0 ? size : 1);
+}
+
+_Use_decl_annotations_
+static void* ImGuiCountedAlloc(
+	const size_t size,
+	void*        userData)
+{
+	(void)userData;
+	return CountedAlloc(size);
+}
+
+_Use_decl_annotations_
+static void ImGuiFree(
+	void* ptr,
+	void* userData)
+{
+	(void)userData;
+	std::free(ptr);
+}
+
+#endif // PERFOVERLAY_COUNT_ALLOCATIONS
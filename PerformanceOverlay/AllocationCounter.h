@@ -0,0 +1,66 @@
+/**
+ * @file AllocationCounter.h
+ * @brief Contains the declaration of the allocation-counting test mode.
+ * @author Alessandro Bellia
+ * @date 10/15/2026
+ */
+
+#pragma once
+
+// The test mode is opt-in: build with PERFOVERLAY_COUNT_ALLOCATIONS defined to replace the
+// global operator new/delete with counting versions and to route ImGui through them too.
+#ifdef PERFOVERLAY_COUNT_ALLOCATIONS
+
+#include "Platform.h"
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @brief Routes ImGui's allocations through the counter. Must be called before ImGui::CreateContext().
+ */
+void InstallImGuiAllocationCounter();
+
+/**
+ * @brief Gets the number of heap allocations made so far, on any thread, through the
+ *		  global operator new or ImGui's allocator.
+ * @return The allocation count.
+ */
+uint64_t GetAllocationCount();
+
+/**
+ * @class AllocationCheck
+ * @brief Fails the steady-state path if it allocates once a warm-up period is over.
+ *
+ * Containers grow to their working size during the warm-up; from then on every sample and
+ * every frame must reuse that storage, so any further allocation is reported as a failure.
+ */
+class AllocationCheck
+{
+public:
+	/**
+	 * @brief Starts the warm-up period.
+	 * @param[in] warmup How long allocations are allowed for.
+	 */
+	explicit AllocationCheck(
+		_In_ std::chrono::steady_clock::duration warmup);
+
+	/**
+	 * @brief Checks the allocations made since the last call. Call once per frame.
+	 * @return False if an allocation happened after the warm-up, true otherwise.
+	 */
+	bool Check();
+
+	/**
+	 * @brief Gets the number of allocations made after the warm-up.
+	 * @return The allocation count.
+	 */
+	[[nodiscard]] uint64_t GetSteadyStateAllocations() const { return m_steadyStateAllocations; }
+
+private:
+	std::chrono::steady_clock::time_point m_warmupEnd;
+	uint64_t                              m_baseline;
+	uint64_t                              m_steadyStateAllocations;
+	bool                                  m_warmedUp;
+};
+
+#endif // PERFOVERLAY_COUNT_ALLOCATIONS
@@ -0,0 +1,89 @@
+/**
+ * @file BumpArena.cpp
+ * @brief Contains the implementation of the BumpArena class.
+ * @author Alessandro Bellia
+ * @date 10/15/2026
+ */
+
+#include "BumpArena.h"
+#include <cstdlib>
+
+_Use_decl_annotations_
+BumpArena::BumpArena(
+	const MemoryAccounting::Subsystem subsystem)
+	: m_subsystem(subsystem),
+	  m_block(nullptr),
+	  m_capacity(0),
+	  m_used(0),
+	  m_overflow(nullptr),
+	  m_overflowUsed(0),
+	  m_highWater(0)
+{
+}
+
+BumpArena::~BumpArena()
+{
+	Reset();
+
+	std::free(m_block);
+	MemoryAccounting::Remove(m_subsystem, m_capacity);
+}
+
+_Use_decl_annotations_
+void* BumpArena::Allocate(
+	const size_t size,
+	const size_t alignment)
+{
+	const size_t offset = (m_used + alignment - 1) & ~(alignment - 1);
+	if (offset + size <= m_capacity)
+	{
+		m_used = offset + size;
+		return m_block + offset;
+	}
+
+	// The block is full for this sample; serve the request from its own overflow block.
+	auto* const overflow = static_cast<Overflow*>(std::malloc(sizeof(Overflow) + size));
+	if (!overflow)
+	{
+		return nullptr;
+	}
+
+	overflow->next = m_overflow;
+	overflow->size = sizeof(Overflow) + size;
+	m_overflow     = overflow;
+	m_overflowUsed += size;
+	MemoryAccounting::Add(m_subsystem, overflow->size);
+	return overflow + 1;
+}
+
+void BumpArena::Reset()
+{
+	const size_t used = GetBytesUsed();
+	m_highWater       = used > m_highWater ? used : m_highWater;
+
+	if (m_overflow)
+	{
+		while (m_overflow)
+		{
+			Overflow* const next = m_overflow->next;
+			MemoryAccounting::Remove(m_subsystem, m_overflow->size);
+			std::free(m_overflow);
+			m_overflow = next;
+		}
+
+		// Grow the block to the high-water mark, plus slack for alignment padding, so the
+		// next samples fit in it.
+		const size_t capacity = m_highWater + m_highWater / 4 + 64;
+		if (char* const block = static_cast<char*>(std::malloc(capacity)))
+		{
+			std::free(m_block);
+			MemoryAccounting::Remove(m_subsystem, m_capacity);
+			MemoryAccounting::Add(m_subsystem, capacity);
+			m_block    = block;
+			m_capacity = capacity;
+		}
+	}
+
+	m_used         = 0;
+	m_overflowUsed = 0;
+}
@@ -0,0 +1,96 @@
+/**
+ * @file BumpArena.h
+ * @brief Contains the declaration of the BumpArena class.
+ * @author Alessandro Bellia
+ * @date 10/15/2026
+ */
+
+#pragma once
+
+#include "Platform.h"
+#include "MemoryAccounting.h"
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @class BumpArena
+ * @brief A bump allocator for scratch memory that lives for one sample and is released in bulk.
+ *
+ * Allocation is a pointer bump in one block; Reset() releases everything at once. When a
+ * sample needs more than the block holds, the excess is served from overflow blocks, and
+ * the next Reset() replaces them all with a single block large enough for the high-water
+ * mark, so after the first few samples the arena stops touching the heap.
+ */
+class BumpArena
+{
+public:
+	/**
+	 * @brief Constructs an empty arena.
+	 * @param[in] subsystem The subsystem the reserved memory is accounted to.
+	 */
+	explicit BumpArena(
+		_In_ MemoryAccounting::Subsystem subsystem);
+	~BumpArena();
+
+	BumpArena(const BumpArena& other)            = delete;
+	BumpArena& operator=(const BumpArena& other) = delete;
+
+	/**
+	 * @brief Allocates scratch memory valid until the next Reset().
+	 * @param[in] size The number of bytes.
+	 * @param[in] alignment The alignment, a power of two up to 16.
+	 * @return The memory, or nullptr if the heap is exhausted.
+	 */
+	void* Allocate(
+		_In_ size_t size,
+		_In_ size_t alignment = 16);
+
+	/**
+	 * @brief Allocates an uninitialized array valid until the next Reset().
+	 * @tparam T A trivially destructible type aligned to at most 16 bytes.
+	 * @param[in] count The number of elements.
+	 * @return The array, or nullptr if the heap is exhausted.
+	 */
+	template <typename T>
+	T* AllocateArray(
+		_In_ size_t count)
+	{
+		return static_cast<T*>(Allocate(count * sizeof(T), alignof(T)));
+	}
+
+	/**
+	 * @brief Releases everything allocated since the last Reset().
+	 */
+	void Reset();
+
+	/**
+	 * @brief Gets the bytes allocated since the last Reset().
+	 * @return The bytes in use, alignment padding included.
+	 */
+	[[nodiscard]] size_t GetBytesUsed() const { return m_used + m_overflowUsed; }
+
+	/**
+	 * @brief Gets the most bytes any single sample has used.
+	 * @return The high-water mark.
+	 */
+	[[nodiscard]] size_t GetHighWater() const { return m_highWater; }
+
+private:
+	/**
+	 * @struct Overflow
+	 * @brief A block allocated when the main block was full, linked until the next Reset().
+	 */
+	struct alignas(16) Overflow
+	{
+		Overflow* next;
+		size_t    size;
+	};
+
+	MemoryAccounting::Subsystem m_subsystem;
+	char*                       m_block;
+	size_t                      m_capacity;
+	size_t                      m_used;
+	Overflow*                   m_overflow;
+	size_t                      m_overflowUsed;
+	size_t                      m_highWater;
+};
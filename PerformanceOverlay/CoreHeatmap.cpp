@@ -0,0 +1,113 @@
+/**
+ * @file CoreHeatmap.cpp
+ * @brief Contains the implementation of the CoreHeatmap class.
+ * @author Alessandro Bellia
+ * @date 10/15/2026
+ */
+
+#include "CoreHeatmap.h"
+#include <algorithm>
+
+/**
+ * @brief Linearly interpolates between two colors given as RGBA float arrays.
+ * @param[in] from The color at t = 0.
+ * @param[in] to The color at t = 1.
+ * @param[in] t The interpolation factor in [0, 1].
+ * @return The interpolated color, packed with IM_COL32.
+ */
+static ImU32 LerpColor(
+	_In_ const ImVec4& from,
+	_In_ const ImVec4& to,
+	_In_ float         t);
+
+
+CoreHeatmap::CoreHeatmap()
+	: m_palette{},
+	  m_coresPerRow(1),
+	  m_head(kColumns - 1)
+{
+	// Idle cores fade into the window background, busy ones go through the overlay's
+	// green towards red, so saturation stands out even in a dense heatmap.
+	const ImVec4 idle(0.0f, 0.15f, 0.10f, 0.35f);
+	const ImVec4 busy(0.0f, 1.0f, 0.5f, 1.0f);
+	const ImVec4 saturated(1.0f, 0.2f, 0.2f, 1.0f);
+
+	for (int i = 0; i < 256; i++)
+	{
+		const float t = static_cast<float>(i) / 255.0f;
+		m_palette[i]  = t < 0.6f
+			               ? LerpColor(idle, busy, t / 0.6f)
+			               : LerpColor(busy, saturated, (t - 0.6f) / 0.4f);
+	}
+}
+
+_Use_decl_annotations_
+void CoreHeatmap::Resize(
+	const uint32_t coreCount)
+{
+	// The pooling factor comes first and the rows follow from it, so that no row is left
+	// without a core: 200 cores pool 2 per row into 100 rows, not 128 rows of which 28 are empty.
+	m_coresPerRow       = std::max((coreCount + kMaxRows - 1) / kMaxRows, 1u);
+	const uint32_t rows = (coreCount + m_coresPerRow - 1) / m_coresPerRow;
+	m_column.assign(rows, 0);
+	m_head = kColumns - 1;
+}
+
+_Use_decl_annotations_
+uint32_t CoreHeatmap::PushColumn(
+	const float*   loads,
+	const uint32_t coreCount)
+{
+	m_head = (m_head + 1) % kColumns;
+
+	const uint32_t rows = GetRows();
+	for (uint32_t row = 0; row < rows; row++)
+	{
+		// Max-pool the cores of this row, so a single saturated core is never averaged away.
+		const uint32_t first = row * m_coresPerRow;
+		const uint32_t last  = std::min(first + m_coresPerRow, coreCount);
+		float          load  = 0.0f;
+		for (uint32_t core = first; core < last; core++)
+		{
+			load = std::max(load, loads[core]);
+		}
+
+		const int index = static_cast<int>(std::clamp(load, 0.0f, 100.0f) * 2.55f + 0.5f);
+		m_column[row]   = m_palette[index];
+	}
+
+	return m_head;
+}
+
+_Use_decl_annotations_
+void CoreHeatmap::Draw(
+	ImDrawList*        drawList,
+	const ImTextureRef texture,
+	const ImVec2&      pos,
+	const ImVec2&      size) const
+{
+	// The oldest column is the one right after the head; the quad spans exactly one turn
+	// of the ring starting there, relying on wrap addressing to continue past u = 1.
+	const float u0 = static_cast<float>(m_head + 1) / static_cast<float>(kColumns);
+
+	drawList->AddImage(
+		texture,
+		pos,
+		ImVec2(pos.x + size.x, pos.y + size.y),
+		ImVec2(u0, 0.0f),
+		ImVec2(u0 + 1.0f, 1.0f));
+}
+
+
+_Use_decl_annotations_
+static ImU32 LerpColor(
+	const ImVec4& from,
+	const ImVec4& to,
+	const float   t)
+{
+	return ImGui::ColorConvertFloat4ToU32(ImVec4(
+		from.x + (to.x - from.x) * t,
+		from.y + (to.y - from.y) * t,
+		from.z + (to.z - from.z) * t,
+		from.w + (to.w - from.w) * t));
+}
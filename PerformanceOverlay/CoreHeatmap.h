@@ -0,0 +1,93 @@
+/**
+ * @file CoreHeatmap.h
+ * @brief Contains the declaration of the CoreHeatmap class.
+ * @author Alessandro Bellia
+ * @date 10/15/2026
+ */
+
+#pragma once
+
+#include "Platform.h"
+#include "imgui.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class CoreHeatmap
+ * @brief Maps per-core CPU loads to a core x time heatmap stored in a small RGBA texture.
+ *
+ * Each sample produces one column of pixels, which the renderer uploads into a ring of
+ * texture columns. The whole heatmap is then drawn as a single textured quad whose UVs
+ * scroll over the ring, so the UI cost does not depend on the number of cores. Machines
+ * with more than kMaxRows cores are max-pooled so a single hot core stays visible.
+ */
+class CoreHeatmap
+{
+public:
+	/**
+	 * @brief The number of samples (texture columns) kept in the heatmap.
+	 */
+	static constexpr uint32_t kColumns = 120;
+
+	/**
+	 * @brief The maximum number of texture rows; larger core counts are pooled.
+	 */
+	static constexpr uint32_t kMaxRows = 128;
+
+	CoreHeatmap();
+
+	/**
+	 * @brief Resizes the heatmap for a new core count and restarts the column ring.
+	 * @param[in] coreCount The number of logical CPUs.
+	 */
+	void Resize(
+		_In_ uint32_t coreCount);
+
+	/**
+	 * @brief Converts one sample into the next column of the ring.
+	 * @param[in] loads The per-core loads in percent.
+	 * @param[in] coreCount The number of entries in loads; must match the last Resize().
+	 * @return The index of the texture column that was written.
+	 */
+	uint32_t PushColumn(
+		_In_reads_(coreCount) const float* loads,
+		_In_ uint32_t                      coreCount);
+
+	/**
+	 * @brief Gets the pixels of the column written by the last PushColumn().
+	 * @return A pointer to GetRows() RGBA8 pixels (IM_COL32 layout), top row first.
+	 */
+	[[nodiscard]] const uint32_t* GetColumnPixels() const { return m_column.data(); }
+
+	/**
+	 * @brief Gets the number of texture rows.
+	 * @return The row count, or 0 before the first Resize().
+	 */
+	[[nodiscard]] uint32_t GetRows() const { return static_cast<uint32_t>(m_column.size()); }
+
+	/**
+	 * @brief Gets the number of cores pooled into each texture row.
+	 * @return The pooling factor, 1 when every core has its own row.
+	 */
+	[[nodiscard]] uint32_t GetCoresPerRow() const { return m_coresPerRow; }
+
+	/**
+	 * @brief Adds the heatmap to a draw list as one textured quad, newest column on the right.
+	 *		  The texture must be sampled with wrap addressing on the U axis.
+	 * @param[in] drawList The draw list to add the quad to.
+	 * @param[in] texture The texture holding the column ring.
+	 * @param[in] pos The top-left corner of the quad, in screen space.
+	 * @param[in] size The size of the quad.
+	 */
+	void Draw(
+		_In_ ImDrawList*   drawList,
+		_In_ ImTextureRef  texture,
+		_In_ const ImVec2& pos,
+		_In_ const ImVec2& size) const;
+
+private:
+	uint32_t              m_palette[256];
+	std::vector<uint32_t> m_column;
+	uint32_t              m_coresPerRow;
+	uint32_t              m_head;
+};
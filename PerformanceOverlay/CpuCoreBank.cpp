@@ -0,0 +1,73 @@
+/**
+ * @file CpuCoreBank.cpp
+ * @brief Contains the implementation of the CpuCoreBank class.
+ * @author Alessandro Bellia
+ * @date 10/15/2026
+ */
+
+#include "CpuCoreBank.h"
+#include <algorithm>
+#include <cstddef>
+
+_Use_decl_annotations_
+void CpuCoreBank::Resize(
+	const uint32_t coreCount)
+{
+	m_busy.assign(coreCount, 0);
+	m_total.assign(coreCount, 0);
+	m_prevBusy.assign(coreCount, 0);
+	m_prevTotal.assign(coreCount, 0);
+	m_loads.assign(coreCount, 0.0f);
+	m_hasBaseline = false;
+}
+
+void CpuCoreBank::Compute()
+{
+	const size_t          count     = m_loads.size();
+	const uint64_t* const busy      = m_busy.data();
+	const uint64_t* const total     = m_total.data();
+	const uint64_t* const prevBusy  = m_prevBusy.data();
+	const uint64_t* const prevTotal = m_prevTotal.data();
+	float* const          loads     = m_loads.data();
+
+	// A total delta that does not fit int32 would wrap in the loop below: with 100 ns units
+	// that is a gap of ~214 s (~3.5 minutes), which a backed-off or paused source can reach.
+	// A core that just came online may carry a larger delta than the others, so the largest
+	// one across all cores decides; such a reading only becomes the new baseline and the
+	// previous loads are kept. The reduction is branch-free and vectorizes like the loop.
+	uint64_t maxDeltaTotal = 0;
+	for (size_t i = 0; i < count; i++)
+	{
+		const uint64_t deltaTotal = total[i] - prevTotal[i];
+		maxDeltaTotal             = deltaTotal > maxDeltaTotal ? deltaTotal : maxDeltaTotal;
+	}
+
+	if (m_hasBaseline && maxDeltaTotal <= static_cast<uint64_t>(INT32_MAX))
+	{
+
+		// With the gap checked above the deltas fit 32 bits, and int32 -> float is a single
+		// packed instruction on every SIMD level, whereas uint64 -> float is not. The clamps
+		// are plain selects rather than std::min/std::max, whose reference returns keep the
+		// loop from being if-converted; with no branches left the compiler vectorizes it
+		// across all cores.
+		for (size_t i = 0; i < count; i++)
+		{
+			const auto deltaBusy  = static_cast<int32_t>(busy[i] - prevBusy[i]);
+			const auto deltaTotal = static_cast<int32_t>(total[i] - prevTotal[i]);
+
+			float divisor = static_cast<float>(deltaTotal);
+			divisor       = divisor > 1.0f ? divisor : 1.0f;
+			float load    = static_cast<float>(deltaBusy) * 100.0f / divisor;
+			load          = load > 0.0f ? load : 0.0f;
+			load          = load < 100.0f ? load : 100.0f;
+			loads[i]      = load;
+		}
+	}
+
+	// Copied rather than swapped: a slot the collector did not write this time (an offline
+	// core) then still matches its previous reading next time, and reads as idle instead of
+	// alternating with the reading from two samples ago.
+	std::copy(m_busy.begin(), m_busy.end(), m_prevBusy.begin());
+	std::copy(m_total.begin(), m_total.end(), m_prevTotal.begin());
+	m_hasBaseline = true;
+}
@@ -0,0 +1,72 @@
+/**
+ * @file CpuCoreBank.h
+ * @brief Contains the declaration of the CpuCoreBank class.
+ * @author Alessandro Bellia
+ * @date 10/15/2026
+ */
+
+#pragma once
+
+#include "Platform.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class CpuCoreBank
+ * @brief Holds the raw per-logical-CPU time counters as a structure of arrays and turns two
+ *		  consecutive readings into utilization percentages.
+ *
+ * Collectors write the cumulative busy/total counters of every core in one pass, then call
+ * Compute(), which runs a single branch-free loop over contiguous arrays that the compiler
+ * can vectorize. A core whose counters were not written since the last call, such as an
+ * offline CPU, reads as idle.
+ */
+class CpuCoreBank
+{
+public:
+	/**
+	 * @brief Resizes the bank and clears all counters and loads.
+	 * @param[in] coreCount The number of logical CPUs.
+	 */
+	void Resize(
+		_In_ uint32_t coreCount);
+
+	/**
+	 * @brief Gets the number of logical CPUs tracked by the bank.
+	 * @return The core count.
+	 */
+	[[nodiscard]] uint32_t GetCoreCount() const { return static_cast<uint32_t>(m_loads.size()); }
+
+	/**
+	 * @brief Gets the array collectors write the cumulative busy time of each core into.
+	 * @return A pointer to GetCoreCount() counters, in any unit shared with TotalCounters().
+	 */
+	[[nodiscard]] uint64_t* BusyCounters() { return m_busy.data(); }
+
+	/**
+	 * @brief Gets the array collectors write the cumulative busy+idle time of each core into.
+	 * @return A pointer to GetCoreCount() counters, in any unit shared with BusyCounters().
+	 */
+	[[nodiscard]] uint64_t* TotalCounters() { return m_total.data(); }
+
+	/**
+	 * @brief Computes the per-core utilization from the counters written since the last call.
+	 *		  The first call after Resize(), and a call after which any core's total advanced
+	 *		  by more than INT32_MAX counter units, only establish the baseline.
+	 */
+	void Compute();
+
+	/**
+	 * @brief Gets the utilization of every core computed by the last Compute().
+	 * @return A pointer to GetCoreCount() percentages in the range [0, 100].
+	 */
+	[[nodiscard]] const float* GetLoads() const { return m_loads.data(); }
+
+private:
+	std::vector<uint64_t> m_busy;
+	std::vector<uint64_t> m_total;
+	std::vector<uint64_t> m_prevBusy;
+	std::vector<uint64_t> m_prevTotal;
+	std::vector<float>    m_loads;
+	bool                  m_hasBaseline = false;
+};
@@ -0,0 +1,186 @@
+/**
+ * @file FramePacer.cpp
+ * @brief Contains the implementation of the FramePacer class.
+ * @author Alessandro Bellia
+ * @date 10/15/2026
+ */
+
+#include "FramePacer.h"
+#include <algorithm>
+#include <bit>
+#include <thread>
+
+_Use_decl_annotations_
+FramePacer::FramePacer(
+	const double targetRate)
+	: m_targetRate(0.0),
+	  m_intervalNs(0),
+	  m_started(false),
+	  m_sleepOnly(false),
+	  m_spinWindowNs(std::chrono::nanoseconds(std::chrono::milliseconds(1)).count()),
+	  m_spinTimeNs(0),
+	  m_pacedFrames(0),
+	  m_jitter{}
+{
+	SetTargetRate(targetRate);
+}
+
+_Use_decl_annotations_
+void FramePacer::SetTargetRate(
+	const double targetRate)
+{
+	m_targetRate = targetRate > 0.0 ? targetRate : 0.0;
+	m_intervalNs = m_targetRate > 0.0 ? static_cast<int64_t>(1e9 / m_targetRate) : 0;
+	m_started    = false;
+}
+
+void FramePacer::Wait()
+{
+	if (m_intervalNs == 0)
+	{
+		return;
+	}
+
+	const std::chrono::nanoseconds interval(m_intervalNs);
+	Clock::time_point              now = Clock::now();
+
+	// The first frame, and the first one after the caller sat idle for more than an
+	// interval, start right away and anchor a new grid.
+	if (!m_started || now >= m_deadline + interval)
+	{
+		m_started    = true;
+		m_deadline   = now + interval;
+		m_lastReturn = now;
+		return;
+	}
+
+	if (now < m_deadline && m_sleepOnly)
+	{
+		std::this_thread::sleep_for(m_deadline - now);
+		now = Clock::now();
+	}
+	else if (now < m_deadline)
+	{
+		const std::chrono::nanoseconds remaining = m_deadline - now;
+		const std::chrono::nanoseconds spinWindow(m_spinWindowNs);
+		if (remaining > spinWindow)
+		{
+			const std::chrono::nanoseconds request = remaining - spinWindow;
+			std::this_thread::sleep_for(request);
+
+			const Clock::time_point woke = Clock::now();
+			AdaptSpinWindow((woke - now - request).count());
+			now = woke;
+		}
+
+		const Clock::time_point spinStart = now;
+		while (now < m_deadline)
+		{
+			std::this_thread::yield();
+			now = Clock::now();
+		}
+		m_spinTimeNs += (now - spinStart).count();
+	}
+
+	const int64_t errorNs = (now - m_lastReturn).count() - m_intervalNs;
+	m_jitter[GetJitterBucket(static_cast<uint64_t>(errorNs < 0 ? -errorNs : errorNs))]++;
+	m_pacedFrames++;
+	m_lastReturn = now;
+
+	// Stay on the grid; if this frame is late by whole intervals, skip them.
+	m_deadline += interval;
+	if (m_deadline <= now)
+	{
+		m_deadline += ((now - m_deadline) / interval + 1) * interval;
+	}
+}
+
+_Use_decl_annotations_
+std::chrono::nanoseconds FramePacer::GetJitterPercentile(
+	const double percentile) const
+{
+	if (m_pacedFrames == 0)
+	{
+		return std::chrono::nanoseconds::zero();
+	}
+
+	const auto rank = static_cast<uint64_t>(std::clamp(percentile, 0.0, 1.0) * static_cast<double>(m_pacedFrames - 1));
+
+	uint64_t seen = 0;
+	uint32_t bucket;
+	for (bucket = 0; bucket < kJitterBuckets - 1; bucket++)
+	{
+		seen += m_jitter[bucket];
+		if (seen > rank)
+		{
+			break;
+		}
+	}
+
+	return GetJitterBucketEdge(bucket);
+}
+
+void FramePacer::ResetStats()
+{
+	std::fill_n(m_jitter, kJitterBuckets, 0);
+	m_pacedFrames = 0;
+	m_spinTimeNs  = 0;
+}
+
+_Use_decl_annotations_
+void FramePacer::AdaptSpinWindow(
+	const int64_t oversleepNs)
+{
+	// Keep a quarter of headroom over the oversleep: grow to it at once, so the next
+	// deadline is not missed again, and decay towards it by 1/16 per frame.
+	const int64_t wanted = oversleepNs + oversleepNs / 4;
+	if (wanted > m_spinWindowNs)
+	{
+		m_spinWindowNs = wanted;
+	}
+	else
+	{
+		m_spinWindowNs -= (m_spinWindowNs - wanted) / 16;
+	}
+
+	m_spinWindowNs = std::clamp(
+		m_spinWindowNs,
+		std::chrono::nanoseconds(kMinSpinWindow).count(),
+		std::chrono::nanoseconds(kMaxSpinWindow).count());
+}
+
+_Use_decl_annotations_
+uint32_t FramePacer::GetJitterBucket(
+	const uint64_t errorNs)
+{
+	constexpr auto floorNs = static_cast<uint64_t>(kJitterFloor.count());
+	constexpr int  subBits = std::bit_width(kJitterBucketsPerOctave) - 1;
+	if (errorNs < floorNs)
+	{
+		return 0;
+	}
+
+	// The octave is the position of the leading bit above the floor's, and the next
+	// subBits bits below the leading one pick the bucket within the octave.
+	const int      leading = std::bit_width(errorNs) - 1;
+	const uint32_t octave  = static_cast<uint32_t>(leading - (std::bit_width(floorNs) - 1));
+	const auto     sub     = static_cast<uint32_t>(errorNs >> (leading - subBits)) & (kJitterBucketsPerOctave - 1);
+	return std::min(1 + octave * kJitterBucketsPerOctave + sub, kJitterBuckets - 1);
+}
+
+_Use_decl_annotations_
+std::chrono::nanoseconds FramePacer::GetJitterBucketEdge(
+	const uint32_t bucket)
+{
+	if (bucket == 0)
+	{
+		return kJitterFloor;
+	}
+
+	// The inverse of GetJitterBucket(): the bucket after this one starts at its edge.
+	constexpr int  subBits = std::bit_width(kJitterBucketsPerOctave) - 1;
+	const uint32_t octave  = (bucket - 1) / kJitterBucketsPerOctave;
+	const uint32_t sub     = (bucket - 1) % kJitterBucketsPerOctave;
+	const int      shift   = std::bit_width(static_cast<uint64_t>(kJitterFloor.count())) - 1 + static_cast<int>(octave) - subBits;
+	return std::chrono::nanoseconds(static_cast<int64_t>(kJitterBucketsPerOctave + sub + 1) << shift);
+}
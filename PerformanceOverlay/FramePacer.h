@@ -0,0 +1,171 @@
+/**
+ * @file FramePacer.h
+ * @brief Contains the declaration of the FramePacer class.
+ * @author Alessandro Bellia
+ * @date 10/15/2026
+ */
+
+#pragma once
+
+#include "Platform.h"
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @class FramePacer
+ * @brief Caps the frame rate at a target, waiting out the rest of each frame interval
+ *		  with a coarse sleep followed by a short spin on the steady clock.
+ *
+ * Frames start on a fixed grid of absolute deadlines. The sleep stops a spin window
+ * before the deadline and the remainder is spun, so wake-up precision does not depend on
+ * the OS timer. The spin window follows the oversleep actually observed: it grows at
+ * once when a sleep overshoots and shrinks slowly otherwise, so it settles just above
+ * the platform's timer granularity. When more than a whole interval passed since the
+ * last frame (the caller was idle), the next frame starts immediately and the grid
+ * restarts from it. In sleep-only mode the whole remainder is slept and nothing is spun,
+ * which trades precision for CPU.
+ *
+ * The jitter histogram holds the interval error of every paced frame: how far the time
+ * since the previous Wait() returned is from the target interval, in either direction.
+ * This is what a viewer perceives as uneven pacing; lateness against the deadline would
+ * only measure the spin's exit and read the same whatever the OS timer did. The buckets
+ * are log-scale, four per power of two above kJitterFloor, so sub-microsecond spins and
+ * millisecond oversleeps are both resolved to within a quarter of an octave.
+ */
+class FramePacer
+{
+public:
+	/**
+	 * @brief The upper edge of the first jitter bucket, which counts every smaller error.
+	 */
+	static constexpr std::chrono::nanoseconds kJitterFloor{64};
+
+	/**
+	 * @brief The number of jitter buckets per power of two above kJitterFloor.
+	 */
+	static constexpr uint32_t kJitterBucketsPerOctave = 4;
+
+	/**
+	 * @brief The number of buckets in the jitter histogram, reaching past 4 s; the last one
+	 *		  also counts everything beyond it.
+	 */
+	static constexpr uint32_t kJitterBuckets = 1 + 26 * kJitterBucketsPerOctave;
+
+	/**
+	 * @brief The spin window never shrinks below this.
+	 */
+	static constexpr std::chrono::microseconds kMinSpinWindow{50};
+
+	/**
+	 * @brief The spin window never grows beyond this, bounding the CPU spent per frame
+	 *		  when the OS timer is very coarse.
+	 */
+	static constexpr std::chrono::milliseconds kMaxSpinWindow{4};
+
+	/**
+	 * @brief Constructs a pacer.
+	 * @param[in] targetRate The frame rate cap in frames per second, or 0 for no cap.
+	 */
+	explicit FramePacer(
+		_In_ double targetRate = 0.0);
+
+	/**
+	 * @brief Changes the frame rate cap. Takes effect from the next frame.
+	 * @param[in] targetRate The frame rate cap in frames per second, or 0 for no cap.
+	 */
+	void SetTargetRate(
+		_In_ double targetRate);
+
+	/**
+	 * @brief Gets the frame rate cap.
+	 * @return The cap in frames per second, or 0 if frames are not capped.
+	 */
+	[[nodiscard]] double GetTargetRate() const { return m_targetRate; }
+
+	/**
+	 * @brief Selects between the hybrid sleep/spin wait and a plain sleep.
+	 * @param[in] sleepOnly true to sleep out the whole interval without spinning.
+	 */
+	void SetSleepOnly(
+		_In_ bool sleepOnly) { m_sleepOnly = sleepOnly; }
+
+	/**
+	 * @brief Gets whether the pacer sleeps out the whole interval without spinning.
+	 * @return true in sleep-only mode, false in the default hybrid mode.
+	 */
+	[[nodiscard]] bool IsSleepOnly() const { return m_sleepOnly; }
+
+	/**
+	 * @brief Blocks until the next frame may start. Call right before building each frame.
+	 */
+	void Wait();
+
+	/**
+	 * @brief Gets a percentile of the interval error of paced frames.
+	 * @param[in] percentile The percentile, in [0, 1].
+	 * @return The upper edge of the histogram bucket holding the percentile, or zero if no
+	 *		   frame has been paced yet.
+	 */
+	[[nodiscard]] std::chrono::nanoseconds GetJitterPercentile(
+		_In_ double percentile) const;
+
+	/**
+	 * @brief Gets the number of frames that followed another within one interval and were paced.
+	 * @return The frame count.
+	 */
+	[[nodiscard]] uint64_t GetPacedFrames() const { return m_pacedFrames; }
+
+	/**
+	 * @brief Gets the current spin window.
+	 * @return The time spun before each deadline.
+	 */
+	[[nodiscard]] std::chrono::nanoseconds GetSpinWindow() const { return std::chrono::nanoseconds(m_spinWindowNs); }
+
+	/**
+	 * @brief Gets the total time spent spinning, the CPU the pacer burns beyond its sleeps.
+	 * @return The accumulated spin time.
+	 */
+	[[nodiscard]] std::chrono::nanoseconds GetSpinTime() const { return std::chrono::nanoseconds(m_spinTimeNs); }
+
+	/**
+	 * @brief Clears the jitter histogram and the frame and spin counters.
+	 */
+	void ResetStats();
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	/**
+	 * @brief Adapts the spin window to the oversleep of the last sleep.
+	 * @param[in] oversleepNs How much later than requested the sleep returned.
+	 */
+	void AdaptSpinWindow(
+		_In_ int64_t oversleepNs);
+
+	/**
+	 * @brief Gets the jitter bucket an interval error falls into.
+	 * @param[in] errorNs The interval error, non-negative.
+	 * @return The bucket index, at most kJitterBuckets - 1.
+	 */
+	[[nodiscard]] static uint32_t GetJitterBucket(
+		_In_ uint64_t errorNs);
+
+	/**
+	 * @brief Gets the upper edge of a jitter bucket.
+	 * @param[in] bucket The bucket index.
+	 * @return The smallest error past the bucket.
+	 */
+	[[nodiscard]] static std::chrono::nanoseconds GetJitterBucketEdge(
+		_In_ uint32_t bucket);
+
+	double            m_targetRate;
+	int64_t           m_intervalNs;
+	Clock::time_point m_deadline;
+	Clock::time_point m_lastReturn; ///< When the previous Wait() returned.
+	bool              m_started;
+	bool              m_sleepOnly;
+	int64_t           m_spinWindowNs;
+	int64_t           m_spinTimeNs;
+	uint64_t          m_pacedFrames;
+	uint64_t          m_jitter[kJitterBuckets];
+};
@@ -0,0 +1,97 @@
+/**
+ * @file FrameScheduler.cpp
+ * @brief Contains the implementation of the FrameScheduler class.
+ * @author Alessandro Bellia
+ * @date 10/15/2026
+ */
+
+#include "FrameScheduler.h"
+#include <algorithm>
+
+_Use_decl_annotations_
+FrameScheduler::FrameScheduler(
+	const std::chrono::nanoseconds refreshInterval,
+	const std::chrono::nanoseconds now)
+	: m_refreshNs(std::max<int64_t>(refreshInterval.count(), 1)),
+	  m_startNs(now.count()),
+	  m_animationEndNs(now.count()),
+	  m_lastFrameNs(now.count() - m_refreshNs),
+	  m_framesRendered(0),
+	  m_frameCpuNs(0),
+	  m_followUpFrames(0),
+	  m_inputPending(false),
+	  m_dataPending(true)
+{
+}
+
+_Use_decl_annotations_
+void FrameScheduler::RequestAnimation(
+	const std::chrono::nanoseconds until)
+{
+	m_animationEndNs = std::max(m_animationEndNs, until.count());
+}
+
+_Use_decl_annotations_
+bool FrameScheduler::ShouldRender(
+	const std::chrono::nanoseconds now)
+{
+	if (TimeUntilNextFrame(now).count() > 0)
+	{
+		return false;
+	}
+
+	// Frames that follow input are only owed once the input itself has been drawn.
+	if (!m_dataPending && !m_inputPending && m_followUpFrames > 0)
+	{
+		m_followUpFrames--;
+	}
+
+	m_dataPending  = false;
+	m_inputPending = false;
+	m_lastFrameNs  = now.count();
+	return true;
+}
+
+_Use_decl_annotations_
+void FrameScheduler::OnFrameRendered(
+	const std::chrono::nanoseconds frameCpu)
+{
+	m_framesRendered++;
+	m_frameCpuNs += frameCpu.count();
+}
+
+_Use_decl_annotations_
+std::chrono::nanoseconds FrameScheduler::TimeUntilNextFrame(
+	const std::chrono::nanoseconds now) const
+{
+	// New data and fresh input are drawn right away.
+	if (m_dataPending || m_inputPending)
+	{
+		return std::chrono::nanoseconds::zero();
+	}
+
+	// Follow-up and animation frames are paced at the refresh interval.
+	if (m_followUpFrames > 0 || now.count() < m_animationEndNs)
+	{
+		return std::chrono::nanoseconds(std::max<int64_t>(m_lastFrameNs + m_refreshNs - now.count(), 0));
+	}
+
+	return kNever;
+}
+
+_Use_decl_annotations_
+FrameScheduler::Stats FrameScheduler::GetStats(
+	const std::chrono::nanoseconds now) const
+{
+	// Without the scheduler every refresh interval produced a frame.
+	const auto intervals = static_cast<uint64_t>(std::max<int64_t>(now.count() - m_startNs, 0) / m_refreshNs);
+
+	Stats stats{};
+	stats.framesRendered = m_framesRendered;
+	stats.framesSkipped  = intervals > m_framesRendered ? intervals - m_framesRendered : 0;
+	stats.frameCpuNs     = m_frameCpuNs;
+	stats.cpuSavedNs     = m_framesRendered > 0
+		                       ? static_cast<int64_t>(stats.framesSkipped) * (m_frameCpuNs / static_cast<int64_t>(m_framesRendered))
+		                       : 0;
+	return stats;
+}
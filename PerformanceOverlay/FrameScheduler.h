@@ -0,0 +1,124 @@
+/**
+ * @file FrameScheduler.h
+ * @brief Contains the declaration of the FrameScheduler class.
+ * @author Alessandro Bellia
+ * @date 10/15/2026
+ */
+
+#pragma once
+
+#include "Platform.h"
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @class FrameScheduler
+ * @brief Decides when the overlay needs a new frame, so the render loop can block in between.
+ *
+ * A frame is only built and presented when something that affects it happened: a new
+ * snapshot was published, input or another window message arrived, or an animation is in
+ * flight. Otherwise the loop waits (on Windows, for the sampler's publish event or a
+ * message) until the next deadline returned by TimeUntilNextFrame(). The policy takes
+ * time as a parameter and has no platform dependency, so it can be driven by a fake clock.
+ *
+ * Frames skipped and CPU saved are measured against the previous behavior of rendering
+ * every refresh interval.
+ */
+class FrameScheduler
+{
+public:
+	/**
+	 * @brief The number of frames rendered after input, giving ImGui the frames it needs to
+	 *		  settle hover and focus state.
+	 */
+	static constexpr uint32_t kFramesAfterInput = 2;
+
+	/**
+	 * @brief Returned by TimeUntilNextFrame() when no frame is scheduled.
+	 */
+	static constexpr std::chrono::nanoseconds kNever = std::chrono::nanoseconds::max();
+
+	/**
+	 * @brief Counters describing how much rendering the scheduler avoided.
+	 */
+	struct Stats
+	{
+		uint64_t framesRendered; // Frames built and presented
+		uint64_t framesSkipped;  // Refresh intervals that did not need a frame
+		int64_t  frameCpuNs;     // CPU time spent in rendered frames
+		int64_t  cpuSavedNs;     // Estimated CPU time the skipped frames would have cost
+	};
+
+	/**
+	 * @brief Constructs a scheduler for a display refreshing at a given interval.
+	 * @param[in] refreshInterval The display refresh interval, used to count skipped frames.
+	 * @param[in] now The current time; the first call to ShouldRender() always renders.
+	 */
+	FrameScheduler(
+		_In_ std::chrono::nanoseconds refreshInterval,
+		_In_ std::chrono::nanoseconds now);
+
+	/**
+	 * @brief Reports that a new snapshot was published.
+	 */
+	void NotifyData() { m_dataPending = true; }
+
+	/**
+	 * @brief Reports input or any other window message that may change the frame.
+	 */
+	void NotifyInput()
+	{
+		m_inputPending   = true;
+		m_followUpFrames = kFramesAfterInput - 1;
+	}
+
+	/**
+	 * @brief Keeps rendering one frame per refresh interval until a given time.
+	 * @param[in] until The time the animation ends.
+	 */
+	void RequestAnimation(
+		_In_ std::chrono::nanoseconds until);
+
+	/**
+	 * @brief Checks whether a frame must be rendered now.
+	 * @param[in] now The current time.
+	 * @return True if the caller must render; the call then consumes the pending reasons.
+	 */
+	bool ShouldRender(
+		_In_ std::chrono::nanoseconds now);
+
+	/**
+	 * @brief Records the cost of a frame the caller rendered after ShouldRender() returned true.
+	 * @param[in] frameCpu The CPU time the frame took.
+	 */
+	void OnFrameRendered(
+		_In_ std::chrono::nanoseconds frameCpu);
+
+	/**
+	 * @brief Gets how long the caller may block before the next frame is due.
+	 * @param[in] now The current time.
+	 * @return Zero if a frame is due, kNever if none is scheduled, the remaining time otherwise.
+	 *		   New data or input can still arrive earlier and must wake the caller.
+	 */
+	[[nodiscard]] std::chrono::nanoseconds TimeUntilNextFrame(
+		_In_ std::chrono::nanoseconds now) const;
+
+	/**
+	 * @brief Gets the counters accumulated since construction.
+	 * @param[in] now The current time.
+	 * @return The counters.
+	 */
+	[[nodiscard]] Stats GetStats(
+		_In_ std::chrono::nanoseconds now) const;
+
+private:
+	int64_t  m_refreshNs;
+	int64_t  m_startNs;
+	int64_t  m_animationEndNs;
+	int64_t  m_lastFrameNs;
+	uint64_t m_framesRendered;
+	int64_t  m_frameCpuNs;
+	uint32_t m_followUpFrames;
+	bool     m_inputPending;
+	bool     m_dataPending;
+};
@@ -7,12 +7,44 @@
 
 
 #include "Gui.h"
+#include "AllocationCounter.h"
+#include "PlotDecimation.h"
+#include "Sparkline.h"
 #include "imgui.h"
 #include "imgui_impl_win32.h"
 #include "imgui_impl_dx11.h"
+#include <algorithm>
+#include <filesystem>
 #include <string>
+#include <vector>
 
 
+/**
+ * @brief The freshness the self-profile panel subscribes to the overlay's own usage at.
+ */
+static constexpr std::chrono::seconds kSelfProfileFreshness{1};
+
+/**
+ * @brief The freshness the process panel subscribes to the process scan at while it is shown.
+ */
+static constexpr std::chrono::seconds kProcessPanelFreshness{1};
+
+/**
+ * @brief The number of top processes listed under the CPU, MEM and DISK blocks.
+ */
+static constexpr uint32_t kOverlayTopProcesses = 3;
+
+/**
+ * @brief The run-queue wait, as a percentage of the scan interval, past which a process is
+ *		  flagged under the CPU block as starved for a core.
+ */
+static constexpr float kDelayedWaitPercent = 10.0f;
+
+/**
+ * @brief The size of the process panel; the table scrolls within it.
+ */
+static constexpr ImVec2 kProcessWindowSize{540.0f, 360.0f};
+
 /**
  * @brief Renders a soft, multi-layered shadow behind a rectangle.
  * @param[in] pos The top-left position of the rectangle.
@@ -26,6 +58,30 @@ static void RenderShadow(
 	_In_ ImU32         color,
 	_In_ float         thickness);
 
+/**
+ * @brief Draws a min/max envelope as a framed sparkline, then advances the layout.
+ * @param[in] points The envelope produced by DecimateMinMax(), oldest first.
+ * @param[in] count The number of points.
+ * @param[in] rangeMin The value at the bottom of the graph.
+ * @param[in] rangeMax The value at the top of the graph.
+ * @param[in] overlay The text drawn over the graph.
+ */
+static void PlotEnvelope(
+	_In_reads_(count) const float* points,
+	_In_ uint32_t                  count,
+	_In_ float                     rangeMin,
+	_In_ float                     rangeMax,
+	_In_z_ const char*             overlay);
+
+/**
+ * @brief Draw callback that binds the heatmap's wrapping sampler for the following draw commands.
+ * @param[in] drawList The draw list being rendered.
+ * @param[in] cmd The callback command; its UserCallbackData is the ID3D11SamplerState to bind.
+ */
+static void BindHeatmapSampler(
+	_In_ const ImDrawList* drawList,
+	_In_ const ImDrawCmd*  cmd);
+
 
 _Use_decl_annotations_
 Gui::Gui(
@@ -37,7 +93,20 @@ Gui::Gui(
 	  m_pDevice(pDevice),
 	  m_pDeviceContext(pDeviceContext),
 	  m_pSwapChain(pSwapChain),
-	  m_mainRenderTargetView(nullptr)
+	  m_mainRenderTargetView(nullptr),
+	  m_pHeatmapTexture(nullptr),
+	  m_pHeatmapView(nullptr),
+	  m_pHeatmapSampler(nullptr),
+	  m_lastCoreSequence(0),
+	  m_showCoreHeatmap(true),
+	  m_showSelfProfile(false),
+	  m_showProcesses(false),
+	  m_overlaySubscription(MetricSubscriptions::kInvalidSubscriber),
+	  m_selfProfileSubscription(MetricSubscriptions::kInvalidSubscriber),
+	  m_processSubscription(MetricSubscriptions::kInvalidSubscriber),
+	  m_graphSpan(std::chrono::duration_cast<std::chrono::seconds>(Sampler::kDefaultHistoryWindow)),
+	  m_framePacer(60.0),
+	  m_imguiPool(MemoryAccounting::SubsystemImGui)
 {
 }
 
@@ -50,6 +119,12 @@ bool Gui::Initialize()
 {
 	// Setup Dear ImGui context
 	IMGUI_CHECKVERSION();
+#ifdef PERFOVERLAY_COUNT_ALLOCATIONS
+	InstallImGuiAllocationCounter();
+#else
+	// ImGui's small, short-lived vectors are served from size-class pools instead of the heap.
+	ImGui::SetAllocatorFunctions(PoolAllocator::ImGuiAlloc, PoolAllocator::ImGuiFree, &m_imguiPool);
+#endif
 	ImGui::CreateContext();
 	ImGuiIO& io = ImGui::GetIO();
 	(void)io;
@@ -65,9 +140,33 @@ bool Gui::Initialize()
 		return false;
 	}
 
-	if (!m_perfMonitor.Initialize())
+	// Plugins are picked up from the "plugins" directory next to the executable.
+	wchar_t modulePath[MAX_PATH];
+	const DWORD length = ::GetModuleFileNameW(nullptr, modulePath, MAX_PATH);
+	if (length > 0 && length < MAX_PATH)
+	{
+		m_sampler.SetPluginDirectory(std::filesystem::path(modulePath).parent_path() / L"plugins");
+	}
+
+	// The main window is always shown, so its metrics are always read. It accepts values as
+	// old as the sampler's longest interval, which leaves the adaptive rates free to back off.
+	// The top processes and the run-queue wait come with the process count, from the same scan.
+	uint32_t overlayMetrics[MetricStaticCount];
+	uint32_t overlayCount = 0;
+	for (const MetricDescriptor& descriptor : kStaticMetrics)
 	{
-		return false; // Failed to initialize WMI
+		if (descriptor.flags & MetricFlagOverlay)
+		{
+			overlayMetrics[overlayCount++] = descriptor.id;
+		}
+	}
+	overlayMetrics[overlayCount++] = MetricProcessCount;
+	overlayMetrics[overlayCount++] = MetricRunQueueWait;
+	m_overlaySubscription = m_sampler.Subscribe(overlayMetrics, overlayCount, Sampler::kDefaultMaxInterval);
+
+	if (!m_sampler.Start())
+	{
+		return false; // Failed to initialize the performance monitor
 	}
 
 	// Create render target
@@ -81,7 +180,9 @@ bool Gui::Initialize()
 
 void Gui::Shutdown()
 {
-	m_perfMonitor.Shutdown();
+	m_sampler.Stop();
+
+	ReleaseCoreHeatmapTexture();
 
 	if (m_mainRenderTargetView)
 	{
@@ -99,30 +200,108 @@ void Gui::Shutdown()
 
 void Gui::Render()
 {
-	// Pool for new performance data
-	m_perfMonitor.Update();
+	// Hold back frames that would exceed the frame rate cap.
+	m_framePacer.Wait();
+
+	// Pick up the latest published sample; this never waits for the sampler thread.
+	const PerformanceSnapshot& snapshot = m_sampler.Latest();
+	if (snapshot.coreSequence != m_lastCoreSequence)
+	{
+		m_lastCoreSequence = snapshot.coreSequence;
+		UpdateCoreHeatmap(snapshot);
+	}
 
 	// Start the Dear ImGui frame
-	ImGui_ImplDX11_NewFrame();
-	ImGui_ImplWin32_NewFrame();
+	{
+		ScopedStageTimer timer(StageProfiler::StageNewFrame);
+		ImGui_ImplDX11_NewFrame();
+		ImGui_ImplWin32_NewFrame();
 
-	ImGui::NewFrame();
+		ImGui::NewFrame();
+	}
 
 	// Render the main overlay window
-	RenderPerformanceWindow();
+	{
+		ScopedStageTimer timer(StageProfiler::StageBuildWindow);
+		RenderPerformanceWindow(snapshot);
+	}
+
+	if (m_showSelfProfile)
+	{
+		RenderSelfProfileWindow(snapshot);
+	}
+
+	if (m_showProcesses)
+	{
+		RenderProcessWindow(snapshot);
+	}
 
 	// Rendering
 	// The clear color must have 0 alpha for the DWM Acrylic effect to be visible.
 	constexpr float clearColor[4] = {0.0f, 0.0f, 0.0f, 0.0f};
 	m_pDeviceContext->OMSetRenderTargets(1, &m_mainRenderTargetView, nullptr);
 	m_pDeviceContext->ClearRenderTargetView(m_mainRenderTargetView, clearColor);
-	ImGui::Render();
-	ImGui_ImplDX11_RenderDrawData(ImGui::GetDrawData());
+	{
+		ScopedStageTimer timer(StageProfiler::StageImGuiRender);
+		ImGui::Render();
+	}
+	{
+		ScopedStageTimer timer(StageProfiler::StageRenderDrawData);
+		ImGui_ImplDX11_RenderDrawData(ImGui::GetDrawData());
+	}
 
+	ScopedStageTimer timer(StageProfiler::StagePresent);
 	(void)m_pSwapChain->Present(1, 0); // Present with vsync
 }
 
-void Gui::RenderPerformanceWindow() const
+_Use_decl_annotations_
+void Gui::SetSelfProfileVisible(
+	const bool visible)
+{
+	m_showSelfProfile = visible;
+	StageProfiler::SetEnabled(visible);
+
+	if (visible && m_selfProfileSubscription == MetricSubscriptions::kInvalidSubscriber)
+	{
+		constexpr uint32_t selfMetrics[] = {MetricOverlayCpu, MetricOverlayRss};
+		m_selfProfileSubscription        = m_sampler.Subscribe(selfMetrics, static_cast<uint32_t>(std::size(selfMetrics)), kSelfProfileFreshness);
+	}
+	else if (!visible)
+	{
+		m_sampler.Unsubscribe(m_selfProfileSubscription);
+		m_selfProfileSubscription = MetricSubscriptions::kInvalidSubscriber;
+	}
+}
+
+_Use_decl_annotations_
+void Gui::SetProcessesVisible(
+	const bool visible)
+{
+	m_showProcesses = visible;
+
+	// The overlay lets a stable process count back off; a list being read row by row should not.
+	if (visible && m_processSubscription == MetricSubscriptions::kInvalidSubscriber)
+	{
+		constexpr uint32_t processMetrics[] = {MetricProcessCount};
+		m_processSubscription               = m_sampler.Subscribe(processMetrics, static_cast<uint32_t>(std::size(processMetrics)), kProcessPanelFreshness);
+	}
+	else if (!visible)
+	{
+		m_sampler.Unsubscribe(m_processSubscription);
+		m_processSubscription = MetricSubscriptions::kInvalidSubscriber;
+	}
+}
+
+_Use_decl_annotations_
+void Gui::SetProcessSort(
+	const ProcessPanel::Column column)
+{
+	m_processPanel.SetSort(column, column == ProcessPanel::ColumnName || column == ProcessPanel::ColumnPid);
+}
+
+_Use_decl_annotations_
+void Gui::RenderPerformanceWindow(
+	const PerformanceSnapshot& snapshot)
 {
 	// Set styles for a more "geek" look
 	ImGui::PushStyleColor(ImGuiCol_WindowBg, ImVec4(0.05f, 0.05f, 0.10f, 0.2f));
@@ -155,44 +334,42 @@ void Gui::RenderPerformanceWindow() const
 	// This is drawn before the content to appear behind it.
 	RenderShadow(ImGui::GetWindowPos(), ImGui::GetWindowSize(), IM_COL32(0, 0, 0, 100), 10.0f);
 
-	// --- CPU Usage ---
-	const float cpu = m_perfMonitor.GetCpuLoad();
-	char        cpuBuf[32];
-	(void)sprintf_s(cpuBuf, "%.1f%%", cpu);
-	ImGui::Text("CPU");
-	ImGui::ProgressBar(cpu / 100.0f, ImVec2(-1.0f, 0.0f), cpuBuf); // Show CPU usage bar
-	// CPU usage history graph
-	static float cpuHistory[90] = {}; // 90 frames of history
-	static int   historyIndex   = 0;
-	static bool  filled         = false;
-	// Update history buffer
-	cpuHistory[historyIndex] = cpu;
-	if (historyIndex == 89)
-	{
-		filled = true;
-	}
-	historyIndex = (historyIndex + 1) % 90;
-	// Render graph
-	ImGui::PlotLines("", cpuHistory, 90, filled ? historyIndex : 0, "CPU Graph", 0.0f, 100.0f,
-	                 ImVec2(-1.0f, 50.0f));
-
-	ImGui::Spacing();
-
-	// --- Memory Usage ---
-	const float mem = m_perfMonitor.GetMemoryUsage();
-	char        memBuf[32];
-	(void)sprintf_s(memBuf, "%.1f%%", mem);
-	ImGui::Text("MEM");
-	ImGui::ProgressBar(mem / 100.0f, ImVec2(-1.0f, 0.0f), memBuf); // Show Memory usage bar
-
-	ImGui::Spacing();
-
-	// --- Disk Usage ---
-	const float disk = m_perfMonitor.GetDiskUsage();
-	char        diskBuf[32];
-	(void)sprintf_s(diskBuf, "%.1f%%", disk);
-	ImGui::Text("DISK");
-	ImGui::ProgressBar(disk / 100.0f, ImVec2(-1.0f, 0.0f), diskBuf); // Show Disk usage bar
+	// One block per overlay metric, in descriptor order: label, usage bar and history graph
+	bool first = true;
+	for (const MetricDescriptor& descriptor : kStaticMetrics)
+	{
+		if ((descriptor.flags & MetricFlagOverlay) == 0)
+		{
+			continue;
+		}
+
+		if (!first)
+		{
+			ImGui::Spacing();
+		}
+		first = false;
+
+		const float value    = snapshot.values[descriptor.id];
+		const float fraction = (value - descriptor.rangeMin) / (descriptor.rangeMax - descriptor.rangeMin);
+		ImGui::TextUnformatted(descriptor.label);
+		ImGui::ProgressBar(fraction, ImVec2(-1.0f, 0.0f), m_valueLabels[descriptor.id].Format(value));
+		PlotMetric(descriptor.id, snapshot.timestampNs);
+
+		if (descriptor.id == MetricCpuLoad)
+		{
+			RenderCoreLoads(snapshot);
+			RenderTopProcesses(snapshot.topCpu, snapshot.topCpuCount, TopListCpu);
+			RenderRunQueueWait(snapshot);
+		}
+		else if (descriptor.id == MetricMemoryUsage)
+		{
+			RenderTopProcesses(snapshot.topRss, snapshot.topRssCount, TopListMemory);
+		}
+		else if (descriptor.id == MetricDiskUsage)
+		{
+			RenderTopProcesses(snapshot.topIo, snapshot.topIoCount, TopListIo);
+		}
+	}
 
 	ImGui::End();
 
@@ -201,6 +378,293 @@ void Gui::RenderPerformanceWindow() const
 	ImGui::PopStyleColor(4);
 }
 
+_Use_decl_annotations_
+void Gui::RenderSelfProfileWindow(
+	const PerformanceSnapshot& snapshot) const
+{
+	ImGui::PushStyleColor(ImGuiCol_WindowBg, ImVec4(0.05f, 0.05f, 0.10f, 0.6f));
+	ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.0f, 1.0f, 0.5f, 1.0f));
+	ImGui::PushStyleVar(ImGuiStyleVar_WindowRounding, 4.0f);
+
+	// Bottom-right, out of the way of the main window
+	const ImGuiViewport* mainViewport = ImGui::GetMainViewport();
+	ImGui::SetNextWindowPos(
+		ImVec2(mainViewport->WorkPos.x + mainViewport->WorkSize.x - 20, mainViewport->WorkPos.y + mainViewport->WorkSize.y - 20),
+		ImGuiCond_Always, ImVec2(1.0f, 1.0f));
+
+	constexpr ImGuiWindowFlags windowFlags =
+		ImGuiWindowFlags_NoDecoration |
+		ImGuiWindowFlags_AlwaysAutoResize |
+		ImGuiWindowFlags_NoSavedSettings |
+		ImGuiWindowFlags_NoFocusOnAppearing |
+		ImGuiWindowFlags_NoNav |
+		ImGuiWindowFlags_NoMove;
+
+	ImGui::Begin("Self Profile", nullptr, windowFlags);
+
+	// The default font is monospaced, so fixed-width fields line up as columns.
+	ImGui::Text("%-15s %8s %8s", "STAGE (us)", "p50", "p99");
+	for (uint32_t stage = 0; stage < StageProfiler::StageCount; stage++)
+	{
+		const auto                 id    = static_cast<StageProfiler::Stage>(stage);
+		const StageProfiler::Stats stats = StageProfiler::GetStats(id);
+		ImGui::Text("%-15s %8.1f %8.1f", StageProfiler::GetName(id), stats.p50Ns / 1e3, stats.p99Ns / 1e3);
+	}
+
+	const TimerWheel& scheduler = m_sampler.GetScheduler();
+	ImGui::Text("%-15s %8.1f %8.1f", "sched late",
+	            scheduler.GetLatenessPercentile(0.5).count() / 1e3, scheduler.GetLatenessPercentile(0.99).count() / 1e3);
+	ImGui::Text("MISSED DEADLINES %llu", scheduler.GetMissedCount());
+	ImGui::Text("AVOIDED READS %llu", m_sampler.GetAvoidedReads());
+
+	ImGui::Separator();
+	ImGui::Text("OVERLAY CPU %5.2f%%  RSS %.1f MB",
+	            snapshot.values[MetricOverlayCpu], snapshot.values[MetricOverlayRss] / (1024.0 * 1024.0));
+
+	ImGui::End();
+
+	ImGui::PopStyleVar();
+	ImGui::PopStyleColor(2);
+}
+
+_Use_decl_annotations_
+void Gui::RenderProcessWindow(
+	const PerformanceSnapshot& snapshot)
+{
+	ImGui::PushStyleColor(ImGuiCol_WindowBg, ImVec4(0.05f, 0.05f, 0.10f, 0.6f));
+	ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.0f, 1.0f, 0.5f, 1.0f));
+	ImGui::PushStyleColor(ImGuiCol_TableRowBgAlt, ImVec4(0.0f, 1.0f, 0.5f, 0.04f));
+	ImGui::PushStyleVar(ImGuiStyleVar_WindowRounding, 4.0f);
+
+	// Bottom-left, opposite the self-profile panel
+	const ImGuiViewport* mainViewport = ImGui::GetMainViewport();
+	ImGui::SetNextWindowPos(
+		ImVec2(mainViewport->WorkPos.x + 20, mainViewport->WorkPos.y + mainViewport->WorkSize.y - 20),
+		ImGuiCond_Always, ImVec2(0.0f, 1.0f));
+	ImGui::SetNextWindowSize(kProcessWindowSize, ImGuiCond_Always);
+
+	constexpr ImGuiWindowFlags windowFlags =
+		ImGuiWindowFlags_NoDecoration |
+		ImGuiWindowFlags_NoSavedSettings |
+		ImGuiWindowFlags_NoFocusOnAppearing |
+		ImGuiWindowFlags_NoNav |
+		ImGuiWindowFlags_NoMove;
+
+	ImGui::Begin("Processes", nullptr, windowFlags);
+
+	const auto count = static_cast<uint32_t>(snapshot.processes.size());
+	if (snapshot.ioDeniedCount != 0)
+	{
+		ImGui::Text("PROCESSES %u  (I/O hidden for %u)", count, snapshot.ioDeniedCount);
+	}
+	else
+	{
+		ImGui::Text("PROCESSES %u", count);
+	}
+	m_processPanel.Draw(snapshot.processes.data(), count, snapshot.processSequence, ImGui::GetContentRegionAvail().y);
+
+	ImGui::End();
+
+	ImGui::PopStyleVar();
+	ImGui::PopStyleColor(3);
+}
+
+_Use_decl_annotations_
+void Gui::RenderCoreLoads(
+	const PerformanceSnapshot& snapshot) const
+{
+	// Either the heatmap (one quad whatever the core count) or the hottest logical CPU,
+	// which the total hides on machines with many cores
+	if (m_showCoreHeatmap && m_pHeatmapView)
+	{
+		const float  rows   = static_cast<float>(m_coreHeatmap.GetRows());
+		const ImVec2 pos    = ImGui::GetCursorScreenPos();
+		const ImVec2 size(ImGui::GetContentRegionAvail().x, std::clamp(rows * 4.0f, 24.0f, 128.0f));
+		ImDrawList*  drawList = ImGui::GetWindowDrawList();
+
+		drawList->AddCallback(BindHeatmapSampler, m_pHeatmapSampler);
+		m_coreHeatmap.Draw(drawList, ImTextureRef(static_cast<ImTextureID>(reinterpret_cast<intptr_t>(m_pHeatmapView))), pos, size);
+		drawList->AddCallback(ImDrawCallback_ResetRenderState, nullptr);
+		ImGui::Dummy(size);
+	}
+	else if (!snapshot.coreLoads.empty())
+	{
+		const auto hottest = std::max_element(snapshot.coreLoads.begin(), snapshot.coreLoads.end());
+		ImGui::Text("HOT CORE #%d  %.1f%%", static_cast<int>(hottest - snapshot.coreLoads.begin()), *hottest);
+	}
+}
+
+_Use_decl_annotations_
+void Gui::RenderRunQueueWait(
+	const PerformanceSnapshot& snapshot) const
+{
+	// The per-CPU figure needs CONFIG_SCHEDSTATS, the per-process one only CONFIG_SCHED_INFO,
+	// so either may be missing without the other.
+	if (!snapshot.cpuWaits.empty())
+	{
+		const auto worst = std::max_element(snapshot.cpuWaits.begin(), snapshot.cpuWaits.end());
+		ImGui::Text("RUNQ WAIT %.1f%%  #%d %.1f%%", snapshot.values[MetricRunQueueWait],
+		            static_cast<int>(worst - snapshot.cpuWaits.begin()), *worst);
+	}
+
+	// CPU% hides a process that is runnable but starved of a core, so those are named here.
+	uint32_t delayed = 0;
+	while (delayed < snapshot.topWaitCount && snapshot.topWait[delayed].wait >= kDelayedWaitPercent)
+	{
+		++delayed;
+	}
+	RenderTopProcesses(snapshot.topWait, delayed, TopListWait);
+}
+
+_Use_decl_annotations_
+void Gui::RenderTopProcesses(
+	const ProcessSample* processes,
+	const uint32_t       count,
+	const TopListValue   value) const
+{
+	// The default font is monospaced, so the names are padded into a column.
+	for (uint32_t i = 0; i < std::min(count, kOverlayTopProcesses); i++)
+	{
+		const ProcessSample& process = processes[i];
+		switch (value)
+		{
+		case TopListCpu:
+			ImGui::Text("%-16.16s %8.1f %%", process.name, process.cpu);
+			break;
+		case TopListMemory:
+			ImGui::Text("%-16.16s %8.1f MB", process.name, process.rssBytes / (1024.0 * 1024.0));
+			break;
+		case TopListIo:
+			ImGui::Text("%-16.16s %8.1f MB/s", process.name, (process.readRate + process.writeRate) / (1024.0 * 1024.0));
+			break;
+		case TopListWait:
+			ImGui::Text("%-16.16s %8.1f %% wait", process.name, process.wait);
+			break;
+		}
+	}
+}
+
+_Use_decl_annotations_
+void Gui::PlotMetric(
+	const uint32_t metric,
+	const int64_t  nowNs) const
+{
+	// Drawing more points than pixels only hides spikes, so the graph gets a min/max
+	// envelope of one column per pixel of its inner width.
+	constexpr uint32_t kMaxGraphColumns = kMaxSparklinePoints / 2;
+	RollupBucket       buckets[kMaxGraphColumns];
+	float              points[2 * kMaxGraphColumns];
+
+	const float    innerWidth = ImGui::GetContentRegionAvail().x - 2.0f * ImGui::GetStyle().FramePadding.x;
+	const uint32_t columns    = std::clamp(static_cast<uint32_t>(std::max(innerWidth, 0.0f)), 1u, kMaxGraphColumns);
+	const int64_t  fromNs     = nowNs - std::chrono::nanoseconds(m_graphSpan).count();
+
+	const MetricHistory& history = m_sampler.GetHistory();
+	uint32_t             count;
+	if (m_graphSpan <= history.GetWindow())
+	{
+		count = DecimateMinMax(history.ViewSince(metric, fromNs), fromNs, nowNs, columns, points);
+	}
+	else
+	{
+		// Longer spans come from the rollups, whose buckets already carry their extremes.
+		const RollupRange range = m_sampler.GetRollups().Read(metric, fromNs, nowNs, columns, buckets);
+		count                   = DecimateMinMax(buckets, range.count, points);
+	}
+
+	const MetricRegistry& registry = m_sampler.GetRegistry();
+	PlotEnvelope(points, count, registry.GetRangeMin(metric), registry.GetRangeMax(metric), registry.GetGraphLabel(metric));
+}
+
+_Use_decl_annotations_
+void Gui::UpdateCoreHeatmap(
+	const PerformanceSnapshot& snapshot)
+{
+	const auto coreCount = static_cast<uint32_t>(snapshot.coreLoads.size());
+	if (coreCount == 0)
+	{
+		return;
+	}
+
+	if (!m_pHeatmapTexture)
+	{
+		m_coreHeatmap.Resize(coreCount);
+		if (!CreateCoreHeatmapTexture(m_coreHeatmap.GetRows()))
+		{
+			ReleaseCoreHeatmapTexture();
+			m_showCoreHeatmap = false;
+			return;
+		}
+	}
+
+	// Only the new column is uploaded; the rest of the ring stays resident on the GPU.
+	const uint32_t column = m_coreHeatmap.PushColumn(snapshot.coreLoads.data(), coreCount);
+	const D3D11_BOX box{column, 0, 0, column + 1, m_coreHeatmap.GetRows(), 1};
+	m_pDeviceContext->UpdateSubresource(
+		m_pHeatmapTexture, 0, &box,
+		m_coreHeatmap.GetColumnPixels(),
+		sizeof(uint32_t),
+		sizeof(uint32_t) * m_coreHeatmap.GetRows());
+}
+
+_Use_decl_annotations_
+bool Gui::CreateCoreHeatmapTexture(
+	const uint32_t rows)
+{
+	D3D11_TEXTURE2D_DESC desc = {};
+	desc.Width                = CoreHeatmap::kColumns;
+	desc.Height               = rows;
+	desc.MipLevels            = 1;
+	desc.ArraySize            = 1;
+	desc.Format               = DXGI_FORMAT_R8G8B8A8_UNORM;
+	desc.SampleDesc.Count     = 1;
+	desc.Usage                = D3D11_USAGE_DEFAULT;
+	desc.BindFlags            = D3D11_BIND_SHADER_RESOURCE;
+
+	// Start fully transparent, so columns that have not been sampled yet are invisible.
+	const std::vector<uint32_t>  zeros(static_cast<size_t>(desc.Width) * desc.Height, 0);
+	const D3D11_SUBRESOURCE_DATA initialData{zeros.data(), static_cast<UINT>(desc.Width * sizeof(uint32_t)), 0};
+	if (FAILED(m_pDevice->CreateTexture2D(&desc, &initialData, &m_pHeatmapTexture)))
+	{
+		return false;
+	}
+
+	if (FAILED(m_pDevice->CreateShaderResourceView(m_pHeatmapTexture, nullptr, &m_pHeatmapView)))
+	{
+		return false;
+	}
+
+	// Point sampling keeps cells crisp; wrapping on U lets one quad scroll over the column ring.
+	D3D11_SAMPLER_DESC samplerDesc = {};
+	samplerDesc.Filter             = D3D11_FILTER_MIN_MAG_MIP_POINT;
+	samplerDesc.AddressU           = D3D11_TEXTURE_ADDRESS_WRAP;
+	samplerDesc.AddressV           = D3D11_TEXTURE_ADDRESS_CLAMP;
+	samplerDesc.AddressW           = D3D11_TEXTURE_ADDRESS_CLAMP;
+	samplerDesc.ComparisonFunc     = D3D11_COMPARISON_ALWAYS;
+	return SUCCEEDED(m_pDevice->CreateSamplerState(&samplerDesc, &m_pHeatmapSampler));
+}
+
+void Gui::ReleaseCoreHeatmapTexture()
+{
+	if (m_pHeatmapSampler)
+	{
+		m_pHeatmapSampler->Release();
+		m_pHeatmapSampler = nullptr;
+	}
+
+	if (m_pHeatmapView)
+	{
+		m_pHeatmapView->Release();
+		m_pHeatmapView = nullptr;
+	}
+
+	if (m_pHeatmapTexture)
+	{
+		m_pHeatmapTexture->Release();
+		m_pHeatmapTexture = nullptr;
+	}
+}
+
 
 _Use_decl_annotations_
 static void RenderShadow(
@@ -230,3 +694,48 @@ static void RenderShadow(
 		);
 	}
 }
+
+_Use_decl_annotations_
+static void PlotEnvelope(
+	const float*   points,
+	const uint32_t count,
+	const float    rangeMin,
+	const float    rangeMax,
+	const char*    overlay)
+{
+	const ImGuiStyle& style    = ImGui::GetStyle();
+	const ImVec2      pos      = ImGui::GetCursorScreenPos();
+	const ImVec2      size(ImGui::GetContentRegionAvail().x, 50.0f);
+	ImDrawList*       drawList = ImGui::GetWindowDrawList();
+
+	// Same frame and colors as ImGui::PlotLines, without its per-segment and hover cost.
+	drawList->AddRectFilled(pos, ImVec2(pos.x + size.x, pos.y + size.y), ImGui::GetColorU32(ImGuiCol_FrameBg), style.FrameRounding);
+	DrawSparkline(
+		drawList,
+		ImVec2(pos.x + style.FramePadding.x, pos.y + style.FramePadding.y),
+		ImVec2(size.x - 2.0f * style.FramePadding.x, size.y - 2.0f * style.FramePadding.y),
+		points,
+		count,
+		rangeMin,
+		rangeMax,
+		ImGui::GetColorU32(ImGuiCol_PlotLines),
+		ImGui::GetColorU32(ImGuiCol_PlotLines, 0.15f),
+		1.0f);
+
+	const ImVec2 overlaySize = ImGui::CalcTextSize(overlay);
+	drawList->AddText(ImVec2(pos.x + (size.x - overlaySize.x) * 0.5f, pos.y + style.FramePadding.y), ImGui::GetColorU32(ImGuiCol_Text), overlay);
+
+	ImGui::Dummy(size);
+}
+
+_Use_decl_annotations_
+static void BindHeatmapSampler(
+	const ImDrawList* drawList,
+	const ImDrawCmd*  cmd)
+{
+	UNREFERENCED_PARAMETER(drawList);
+
+	const auto* renderState = static_cast<ImGui_ImplDX11_RenderState*>(ImGui::GetPlatformIO().Renderer_RenderState);
+	auto*       pSampler    = static_cast<ID3D11SamplerState*>(cmd->UserCallbackData);
+	renderState->DeviceContext->PSSetSamplers(0, 1, &pSampler);
+}
@@ -8,7 +8,13 @@
 
 #pragma once
 
-#include "PerformanceMonitor.h"
+#include "CoreHeatmap.h"
+#include "FramePacer.h"
+#include "PercentLabel.h"
+#include "PoolAllocator.h"
+#include "ProcessPanel.h"
+#include "Sampler.h"
+#include "StageProfiler.h"
 #include <d3d11.h>
 
 struct ImGuiContext;
@@ -35,13 +41,13 @@ public:
 	~Gui();
 
 	/**
-	 * @brief Initializes the ImGui context, backends, and the Performance Monitor.
+	 * @brief Initializes the ImGui context, backends, and starts the performance Sampler.
 	 * @return True if initialization is successful, false otherwise.
 	 */
 	bool Initialize();
 
 	/**
-	 * @brief Shuts down the ImGui backends, context, and the Performance Monitor.
+	 * @brief Shuts down the ImGui backends, context, and stops the performance Sampler.
 	 */
 	void Shutdown();
 
@@ -50,17 +56,231 @@ public:
 	 */
 	void Render();
 
+	/**
+	 * @brief Switches the per-core display between the compact heatmap and the hottest-core summary.
+	 * @param[in] visible True to show the heatmap, false to show the summary line.
+	 */
+	void SetCoreHeatmapVisible(
+		_In_ bool visible) { m_showCoreHeatmap = visible; }
+
+	/**
+	 * @brief Checks whether the per-core heatmap is shown.
+	 * @return True if the heatmap is shown, false if the summary line is.
+	 */
+	[[nodiscard]] bool IsCoreHeatmapVisible() const { return m_showCoreHeatmap; }
+
+	/**
+	 * @brief Shows or hides the self-profile panel. Stage timing is only recorded, and the
+	 *		  overlay's own usage only read, while it is shown.
+	 * @param[in] visible True to show the panel and time the hot-path stages, false otherwise.
+	 */
+	void SetSelfProfileVisible(
+		_In_ bool visible);
+
+	/**
+	 * @brief Checks whether the self-profile panel is shown.
+	 * @return True if the panel is shown.
+	 */
+	[[nodiscard]] bool IsSelfProfileVisible() const { return m_showSelfProfile; }
+
+	/**
+	 * @brief Shows or hides the process panel. While it is shown the process list is
+	 *		  rescanned at least every second, even when it looks stable.
+	 * @param[in] visible True to show the panel.
+	 */
+	void SetProcessesVisible(
+		_In_ bool visible);
+
+	/**
+	 * @brief Checks whether the process panel is shown.
+	 * @return True if the panel is shown.
+	 */
+	[[nodiscard]] bool IsProcessesVisible() const { return m_showProcesses; }
+
+	/**
+	 * @brief Sorts the process panel by a column: CPU and memory largest first, name and pid
+	 *		  in ascending order.
+	 * @param[in] column The column.
+	 */
+	void SetProcessSort(
+		_In_ ProcessPanel::Column column);
+
+	/**
+	 * @brief Gets the column the process panel is sorted by.
+	 * @return The column.
+	 */
+	[[nodiscard]] ProcessPanel::Column GetProcessSort() const { return m_processPanel.GetSortColumn(); }
+
+	/**
+	 * @brief Sets the time span covered by the metric graphs. Spans longer than the sampler's
+	 *		  raw history are drawn from the long-term rollups.
+	 * @param[in] span The time span, up to 24 hours.
+	 */
+	void SetGraphSpan(
+		_In_ std::chrono::seconds span) { m_graphSpan = span; }
+
+	/**
+	 * @brief Gets the time span covered by the metric graphs.
+	 * @return The time span.
+	 */
+	[[nodiscard]] std::chrono::seconds GetGraphSpan() const { return m_graphSpan; }
+
+	/**
+	 * @brief Caps the rate at which frames are built and presented.
+	 * @param[in] rate The cap in frames per second, or 0 to only be limited by vsync.
+	 */
+	void SetFrameRateCap(
+		_In_ double rate) { m_framePacer.SetTargetRate(rate); }
+
+	/**
+	 * @brief Gets the frame rate cap.
+	 * @return The cap in frames per second, or 0 if frames are only limited by vsync.
+	 */
+	[[nodiscard]] double GetFrameRateCap() const { return m_framePacer.GetTargetRate(); }
+
+	/**
+	 * @brief Gets the pacer enforcing the frame rate cap, for its jitter statistics.
+	 * @return A reference to the pacer.
+	 */
+	[[nodiscard]] const FramePacer& GetFramePacer() const { return m_framePacer; }
+
+	/**
+	 * @brief Gets the event the sampler signals whenever a new snapshot is ready to be drawn.
+	 * @return The auto-reset event handle, valid after a successful Initialize().
+	 */
+	[[nodiscard]] HANDLE GetPublishEvent() const { return m_sampler.GetPublishEvent(); }
+
+	/**
+	 * @brief Gets the metric-provider plugins loaded by the sampler.
+	 * @return A reference to the plugin host, populated after a successful Initialize().
+	 */
+	[[nodiscard]] const PluginHost& GetPlugins() const { return m_sampler.GetPlugins(); }
+
+	/**
+	 * @brief Gets the scheduler running the sampler's sources, for its lateness statistics.
+	 * @return A reference to the timer wheel, populated after a successful Initialize().
+	 */
+	[[nodiscard]] const TimerWheel& GetScheduler() const { return m_sampler.GetScheduler(); }
+
+	/**
+	 * @brief Gets the number of source reads skipped because no panel showed their metrics.
+	 * @return The count.
+	 */
+	[[nodiscard]] uint64_t GetAvoidedReads() const { return m_sampler.GetAvoidedReads(); }
+
 private:
+	/**
+	 * @brief The value a top list shows beside each process name.
+	 */
+	enum TopListValue : int
+	{
+		TopListCpu = 0,
+		TopListMemory,
+		TopListIo,
+		TopListWait
+	};
+
 	/**
 	 * @brief Renders the main performance overlay window.
+	 * @param[in] snapshot The latest metrics published by the sampler.
+	 */
+	void RenderPerformanceWindow(
+		_In_ const PerformanceSnapshot& snapshot);
+
+	/**
+	 * @brief Renders the self-profile panel: per-stage p50/p99 durations, the lateness of the
+	 *		  sampler's scheduler, and the overlay's own CPU usage and resident memory.
+	 * @param[in] snapshot The latest metrics published by the sampler.
 	 */
-	void RenderPerformanceWindow() const;
+	void RenderSelfProfileWindow(
+		_In_ const PerformanceSnapshot& snapshot) const;
+
+	/**
+	 * @brief Renders the process panel: every process in a sortable, virtualized table.
+	 * @param[in] snapshot The latest metrics published by the sampler.
+	 */
+	void RenderProcessWindow(
+		_In_ const PerformanceSnapshot& snapshot);
+
+	/**
+	 * @brief Renders the per-core view under the CPU graph: the heatmap, or the hottest
+	 *		  logical CPU when the heatmap is off.
+	 * @param[in] snapshot The latest metrics published by the sampler.
+	 */
+	void RenderCoreLoads(
+		_In_ const PerformanceSnapshot& snapshot) const;
+
+	/**
+	 * @brief Renders the run-queue wait under the CPU block: the average and worst CPU, and the
+	 *		  processes delayed past kDelayedWaitPercent. Figures that are unknown are left out.
+	 * @param[in] snapshot The latest metrics published by the sampler.
+	 */
+	void RenderRunQueueWait(
+		_In_ const PerformanceSnapshot& snapshot) const;
+
+	/**
+	 * @brief Lists the first few processes of a top list, by name, under a metric's graph.
+	 * @param[in] processes The top list from the snapshot.
+	 * @param[in] count The number of valid entries.
+	 * @param[in] value The value to show for each process.
+	 */
+	void RenderTopProcesses(
+		_In_reads_(count) const ProcessSample* processes,
+		_In_ uint32_t                          count,
+		_In_ TopListValue                      value) const;
+
+	/**
+	 * @brief Plots the min/max envelope of one metric over the configured span, from the raw
+	 *		  history when it covers the span and from the rollups otherwise.
+	 * @param[in] metric The id of the metric to plot; its descriptor gives the scale and overlay text.
+	 * @param[in] nowNs The timestamp the graph ends at.
+	 */
+	void PlotMetric(
+		_In_ uint32_t metric,
+		_In_ int64_t  nowNs) const;
+
+	/**
+	 * @brief Writes the newest sample into the heatmap texture, creating the texture on first use.
+	 * @param[in] snapshot The snapshot holding the per-core loads.
+	 */
+	void UpdateCoreHeatmap(
+		_In_ const PerformanceSnapshot& snapshot);
+
+	/**
+	 * @brief Creates the heatmap texture, its shader resource view and its wrapping sampler.
+	 * @param[in] rows The number of texture rows.
+	 * @return True if all resources were created, false otherwise.
+	 */
+	bool CreateCoreHeatmapTexture(
+		_In_ uint32_t rows);
+
+	/**
+	 * @brief Releases the heatmap texture resources.
+	 */
+	void ReleaseCoreHeatmapTexture();
 
 
 	HWND                    m_hWnd;
 	ID3D11Device*           m_pDevice;
 	ID3D11DeviceContext*    m_pDeviceContext;
 	IDXGISwapChain*         m_pSwapChain;
-	PerformanceMonitor      m_perfMonitor;
+	Sampler                 m_sampler;
 	ID3D11RenderTargetView* m_mainRenderTargetView;
+
+	CoreHeatmap               m_coreHeatmap;
+	ID3D11Texture2D*          m_pHeatmapTexture;
+	ID3D11ShaderResourceView* m_pHeatmapView;
+	ID3D11SamplerState*       m_pHeatmapSampler;
+	uint64_t                  m_lastCoreSequence;
+	bool                      m_showCoreHeatmap;
+	bool                      m_showSelfProfile;
+	bool                      m_showProcesses;
+	uint32_t                  m_overlaySubscription;     ///< The main window's metrics.
+	uint32_t                  m_selfProfileSubscription; ///< The self-profile panel's metrics, while it is shown.
+	uint32_t                  m_processSubscription;     ///< The process panel's metrics, while it is shown.
+	ProcessPanel              m_processPanel;
+	std::chrono::seconds      m_graphSpan;
+	FramePacer                m_framePacer;
+	PercentLabel              m_valueLabels[MetricStaticCount];
+	PoolAllocator             m_imguiPool;
 };
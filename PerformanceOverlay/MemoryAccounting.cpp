@@ -0,0 +1,68 @@
+/**
+ * @file MemoryAccounting.cpp
+ * @brief Contains the implementation of the MemoryAccounting class.
+ * @author Alessandro Bellia
+ * @date 10/15/2026
+ */
+
+#include "MemoryAccounting.h"
+
+std::atomic<size_t> MemoryAccounting::s_bytes[SubsystemCount]     = {};
+std::atomic<size_t> MemoryAccounting::s_highWater[SubsystemCount] = {};
+
+
+_Use_decl_annotations_
+void MemoryAccounting::Add(
+	const Subsystem subsystem,
+	const size_t    bytes)
+{
+	const size_t total = s_bytes[subsystem].fetch_add(bytes, std::memory_order_relaxed) + bytes;
+	RaiseHighWater(subsystem, total);
+}
+
+_Use_decl_annotations_
+void MemoryAccounting::Remove(
+	const Subsystem subsystem,
+	const size_t    bytes)
+{
+	s_bytes[subsystem].fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+_Use_decl_annotations_
+void MemoryAccounting::Set(
+	const Subsystem subsystem,
+	const size_t    bytes)
+{
+	s_bytes[subsystem].store(bytes, std::memory_order_relaxed);
+	RaiseHighWater(subsystem, bytes);
+}
+
+_Use_decl_annotations_
+MemoryAccounting::Usage MemoryAccounting::Get(
+	const Subsystem subsystem)
+{
+	return {
+		s_bytes[subsystem].load(std::memory_order_relaxed),
+		s_highWater[subsystem].load(std::memory_order_relaxed)
+	};
+}
+
+_Use_decl_annotations_
+const char* MemoryAccounting::GetName(
+	const Subsystem subsystem)
+{
+	static constexpr const char* kNames[SubsystemCount] = {"ImGui", "Sample arena", "History", "Rollups", "Processes"};
+	return subsystem < SubsystemCount ? kNames[subsystem] : "?";
+}
+
+_Use_decl_annotations_
+void MemoryAccounting::RaiseHighWater(
+	const Subsystem subsystem,
+	const size_t    bytes)
+{
+	size_t highWater = s_highWater[subsystem].load(std::memory_order_relaxed);
+	while (bytes > highWater &&
+		!s_highWater[subsystem].compare_exchange_weak(highWater, bytes, std::memory_order_relaxed))
+	{
+	}
+}
@@ -0,0 +1,106 @@
+/**
+ * @file MemoryAccounting.h
+ * @brief Contains the declaration of the MemoryAccounting class.
+ * @author Alessandro Bellia
+ * @date 10/15/2026
+ */
+
+#pragma once
+
+#include "Platform.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @class MemoryAccounting
+ * @brief Process-wide byte counts and high-water marks of the overlay's memory, per subsystem.
+ *
+ * The allocators report the memory they reserve from the heap, not every block they hand
+ * out, so the counts track what the overlay actually costs in RSS. Counters are atomic
+ * and can be updated and read from any thread.
+ */
+class MemoryAccounting
+{
+public:
+	/**
+	 * @brief The subsystems memory is accounted to.
+	 */
+	enum Subsystem : uint32_t
+	{
+		SubsystemImGui = 0,   ///< ImGui draw lists, font atlas and window state (PoolAllocator)
+		SubsystemSampleArena, ///< Per-sample collector scratch (BumpArena)
+		SubsystemHistory,     ///< Raw metric history rings
+		SubsystemRollups,     ///< Long-term rollup tiers
+		SubsystemProcesses,   ///< The process table's columns and interned strings
+		SubsystemCount
+	};
+
+	/**
+	 * @struct Usage
+	 * @brief The current and peak byte counts of one subsystem.
+	 */
+	struct Usage
+	{
+		size_t bytes;
+		size_t highWater;
+	};
+
+	MemoryAccounting() = delete;
+
+	/**
+	 * @brief Records memory reserved by a subsystem.
+	 * @param[in] subsystem The subsystem.
+	 * @param[in] bytes The number of bytes reserved.
+	 */
+	static void Add(
+		_In_ Subsystem subsystem,
+		_In_ size_t    bytes);
+
+	/**
+	 * @brief Records memory released by a subsystem.
+	 * @param[in] subsystem The subsystem.
+	 * @param[in] bytes The number of bytes released.
+	 */
+	static void Remove(
+		_In_ Subsystem subsystem,
+		_In_ size_t    bytes);
+
+	/**
+	 * @brief Replaces the count of a subsystem whose footprint is fixed once configured.
+	 * @param[in] subsystem The subsystem.
+	 * @param[in] bytes The subsystem's footprint.
+	 */
+	static void Set(
+		_In_ Subsystem subsystem,
+		_In_ size_t    bytes);
+
+	/**
+	 * @brief Gets the byte counts of a subsystem.
+	 * @param[in] subsystem The subsystem.
+	 * @return The current and peak bytes.
+	 */
+	[[nodiscard]] static Usage Get(
+		_In_ Subsystem subsystem);
+
+	/**
+	 * @brief Gets the display name of a subsystem.
+	 * @param[in] subsystem The subsystem.
+	 * @return A static, NUL-terminated name.
+	 */
+	[[nodiscard]] static const char* GetName(
+		_In_ Subsystem subsystem);
+
+private:
+	/**
+	 * @brief Raises the high-water mark of a subsystem to a new byte count if it is higher.
+	 * @param[in] subsystem The subsystem.
+	 * @param[in] bytes The new byte count.
+	 */
+	static void RaiseHighWater(
+		_In_ Subsystem subsystem,
+		_In_ size_t    bytes);
+
+	static std::atomic<size_t> s_bytes[SubsystemCount];
+	static std::atomic<size_t> s_highWater[SubsystemCount];
+};
@@ -0,0 +1,122 @@
+/**
+ * @file MetricHistory.cpp
+ * @brief Contains the implementation of the MetricHistory class.
+ * @author Alessandro Bellia
+ * @date 10/15/2026
+ */
+
+#include "MetricHistory.h"
+#include <algorithm>
+#include <bit>
+
+_Use_decl_annotations_
+void MetricHistory::Configure(
+	const uint32_t                 metricCount,
+	const std::chrono::nanoseconds window,
+	const std::chrono::nanoseconds minInterval)
+{
+	const int64_t intervalNs = std::max<int64_t>(minInterval.count(), 1);
+	const auto    samples    = static_cast<uint32_t>(window.count() / intervalNs + 1);
+
+	// Half a window of headroom (at least a few samples) separates the oldest readable
+	// sample from the slot the producer writes next.
+	m_readable    = samples;
+	m_capacity    = std::bit_ceil(samples + std::max(samples / 2, 8u));
+	m_metricCount = metricCount;
+	m_windowNs    = window.count();
+
+	m_rings = std::make_unique<Ring[]>(metricCount);
+	for (uint32_t i = 0; i < metricCount; i++)
+	{
+		m_rings[i].timestamps = std::make_unique<int64_t[]>(m_capacity);
+		m_rings[i].values     = std::make_unique<float[]>(m_capacity);
+	}
+}
+
+_Use_decl_annotations_
+void MetricHistory::Append(
+	const uint32_t metric,
+	const int64_t  timestampNs,
+	const float    value)
+{
+	if (metric >= m_metricCount)
+	{
+		return;
+	}
+
+	Ring&          ring    = m_rings[metric];
+	const uint64_t written = ring.written.load(std::memory_order_relaxed);
+	const uint32_t slot    = static_cast<uint32_t>(written) & (m_capacity - 1);
+
+	ring.timestamps[slot] = timestampNs;
+	ring.values[slot]     = value;
+
+	// Publishes the slot to readers that acquire the counter.
+	ring.written.store(written + 1, std::memory_order_release);
+}
+
+_Use_decl_annotations_
+HistoryView MetricHistory::View(
+	const uint32_t metric) const
+{
+	if (metric >= m_metricCount)
+	{
+		return {};
+	}
+
+	const Ring&    ring    = m_rings[metric];
+	const uint64_t written = ring.written.load(std::memory_order_acquire);
+	if (written == 0)
+	{
+		return {};
+	}
+
+	const int64_t latestNs = ring.timestamps[static_cast<uint32_t>(written - 1) & (m_capacity - 1)];
+	return ViewSince(metric, latestNs - m_windowNs);
+}
+
+_Use_decl_annotations_
+HistoryView MetricHistory::ViewSince(
+	const uint32_t metric,
+	const int64_t  fromNs) const
+{
+	HistoryView view;
+	if (metric >= m_metricCount)
+	{
+		return view;
+	}
+
+	const Ring&    ring      = m_rings[metric];
+	const uint32_t mask      = m_capacity - 1;
+	const uint64_t written   = ring.written.load(std::memory_order_acquire);
+	const uint64_t available = std::min<uint64_t>(written, m_readable);
+
+	// Binary search for the oldest sample inside the window. Indices are logical
+	// (monotonic write counts) and only masked when touching the arrays.
+	uint64_t first = written - available;
+	uint64_t last  = written;
+	while (first < last)
+	{
+		const uint64_t middle = first + (last - first) / 2;
+		if (ring.timestamps[static_cast<uint32_t>(middle) & mask] < fromNs)
+		{
+			first = middle + 1;
+		}
+		else
+		{
+			last = middle;
+		}
+	}
+
+	const auto     count = static_cast<uint32_t>(written - first);
+	const uint32_t start = static_cast<uint32_t>(first) & mask;
+	const uint32_t head  = std::min(count, m_capacity - start);
+
+	view.timestamps[0] = ring.timestamps.get() + start;
+	view.values[0]     = ring.values.get() + start;
+	view.sizes[0]      = head;
+	view.timestamps[1] = ring.timestamps.get();
+	view.values[1]     = ring.values.get();
+	view.sizes[1]      = count - head;
+	return view;
+}
@@ -0,0 +1,151 @@
+/**
+ * @file MetricHistory.h
+ * @brief Contains the declaration of the MetricHistory class and its HistoryView.
+ * @author Alessandro Bellia
+ * @date 10/15/2026
+ */
+
+#pragma once
+
+#include "Platform.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+/**
+ * @struct HistoryView
+ * @brief A zero-copy, read-only view of the samples of one metric inside a time window.
+ *
+ * The samples live in a ring, so the view is made of at most two contiguous pieces:
+ * piece 0 holds the older samples and piece 1 the newer ones. Timestamps are in
+ * nanoseconds on the sampler's monotonic clock and are strictly increasing.
+ */
+struct HistoryView
+{
+	const int64_t* timestamps[2] = {nullptr, nullptr};
+	const float*   values[2]     = {nullptr, nullptr};
+	uint32_t       sizes[2]      = {0, 0};
+
+	/**
+	 * @brief Gets the total number of samples in the view.
+	 * @return The sample count.
+	 */
+	[[nodiscard]] uint32_t Size() const { return sizes[0] + sizes[1]; }
+
+	/**
+	 * @brief Gets the value of the i-th sample, oldest first.
+	 * @param[in] i The sample index, in [0, Size()).
+	 * @return The sample value.
+	 */
+	[[nodiscard]] float ValueAt(
+		_In_ uint32_t i) const { return i < sizes[0] ? values[0][i] : values[1][i - sizes[0]]; }
+
+	/**
+	 * @brief Gets the timestamp of the i-th sample, oldest first.
+	 * @param[in] i The sample index, in [0, Size()).
+	 * @return The sample timestamp in nanoseconds.
+	 */
+	[[nodiscard]] int64_t TimestampAt(
+		_In_ uint32_t i) const { return i < sizes[0] ? timestamps[0][i] : timestamps[1][i - sizes[0]]; }
+};
+
+
+/**
+ * @class MetricHistory
+ * @brief Keeps the recent samples of every metric in per-metric single-producer/multi-consumer
+ *		  ring buffers indexed by sample timestamp.
+ *
+ * The collector appends each sample with the time it was taken, so the covered time span
+ * is independent of how often the UI renders. Readers (the UI, exporters) get HistoryView
+ * pointers straight into the rings without locking or copying. Each ring is sized with
+ * headroom beyond the configured window, so a view taken for the window is not overwritten
+ * while a reader is still using it for the current frame.
+ */
+class MetricHistory
+{
+public:
+	MetricHistory() = default;
+
+	MetricHistory(const MetricHistory& other)            = delete;
+	MetricHistory& operator=(const MetricHistory& other) = delete;
+
+	/**
+	 * @brief Allocates the rings. Must be called before the producer starts.
+	 * @param[in] metricCount The number of metrics (ids 0 to metricCount - 1).
+	 * @param[in] window The time span each metric keeps.
+	 * @param[in] minInterval The shortest expected time between two samples of a metric.
+	 */
+	void Configure(
+		_In_ uint32_t                 metricCount,
+		_In_ std::chrono::nanoseconds window,
+		_In_ std::chrono::nanoseconds minInterval);
+
+	/**
+	 * @brief Appends a sample to a metric. Producer side only.
+	 * @param[in] metric The metric id.
+	 * @param[in] timestampNs The time the sample was taken; must increase from call to call.
+	 * @param[in] value The sample value.
+	 */
+	void Append(
+		_In_ uint32_t metric,
+		_In_ int64_t  timestampNs,
+		_In_ float    value);
+
+	/**
+	 * @brief Gets the samples of a metric within the configured window, ending at its latest sample.
+	 * @param[in] metric The metric id.
+	 * @return A view of the samples, oldest first.
+	 */
+	[[nodiscard]] HistoryView View(
+		_In_ uint32_t metric) const;
+
+	/**
+	 * @brief Gets the samples of a metric taken at or after a given time.
+	 * @param[in] metric The metric id.
+	 * @param[in] fromNs The oldest timestamp to include.
+	 * @return A view of the samples, oldest first.
+	 */
+	[[nodiscard]] HistoryView ViewSince(
+		_In_ uint32_t metric,
+		_In_ int64_t  fromNs) const;
+
+	/**
+	 * @brief Gets the configured window length.
+	 * @return The time span each metric keeps.
+	 */
+	[[nodiscard]] std::chrono::nanoseconds GetWindow() const { return std::chrono::nanoseconds(m_windowNs); }
+
+	/**
+	 * @brief Gets the number of metrics.
+	 * @return The metric count passed to Configure().
+	 */
+	[[nodiscard]] uint32_t GetMetricCount() const { return m_metricCount; }
+
+	/**
+	 * @brief Gets the number of bytes held by the history.
+	 * @return The total size of all rings.
+	 */
+	[[nodiscard]] size_t GetMemoryFootprint() const
+	{
+		return sizeof(*this) + m_metricCount * (sizeof(Ring) + m_capacity * (sizeof(int64_t) + sizeof(float)));
+	}
+
+private:
+	/**
+	 * @struct Ring
+	 * @brief The storage of one metric: parallel timestamp and value arrays plus a write counter.
+	 */
+	struct Ring
+	{
+		std::unique_ptr<int64_t[]> timestamps;
+		std::unique_ptr<float[]>   values;
+		alignas(64) std::atomic<uint64_t> written{0};
+	};
+
+	std::unique_ptr<Ring[]> m_rings;
+	uint32_t                m_metricCount = 0;
+	uint32_t                m_capacity    = 0; ///< Power of two.
+	uint32_t                m_readable    = 0; ///< Samples readers may touch; the rest is headroom.
+	int64_t                 m_windowNs    = 0;
+};
@@ -0,0 +1,113 @@
+/**
+ * @file MetricPlugin.h
+ * @brief Contains the C ABI that metric-provider plugins export to the overlay.
+ * @author Alessandro Bellia
+ * @date 10/15/2026
+ *
+ * A plugin is a shared library (.dll on Windows, .so on Linux) placed in the "plugins"
+ * directory next to the overlay's executable. It exports the four functions below with C
+ * linkage. The overlay calls them on its sampler thread only, in this order:
+ *
+ *	1. PerfOverlayPluginInit() once, with the API version the overlay implements.
+ *	2. PerfOverlayPluginDescribe() once, to learn the plugin's metrics.
+ *	3. PerfOverlayPluginSample() once per sample, for as long as the plugin stays enabled.
+ *	4. PerfOverlayPluginShutdown() once, before the library is unloaded.
+ *
+ * Sample() writes its values straight into a buffer owned by the overlay, one float per
+ * described metric, in the order they were described. It must not keep the pointer past the
+ * call, and it must return quickly and never block: it runs inline on the sampler thread,
+ * which cannot interrupt it, and a plugin whose calls keep exceeding the overlay's latency
+ * budget is disabled only after they return. The header only depends on <stdint.h>, so plugins can be
+ * written in C.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @brief The version of this interface. A plugin should fail Init() for versions it does not know.
+ */
+#define PERFOVERLAY_PLUGIN_API_VERSION 1u
+
+/**
+ * @brief The most metrics one plugin can describe.
+ */
+#define PERFOVERLAY_PLUGIN_MAX_METRICS 32u
+
+/**
+ * @brief The size of a metric name, including the terminator.
+ */
+#define PERFOVERLAY_PLUGIN_MAX_NAME 48u
+
+/**
+ * @brief Units of plugin metrics. They match the overlay's MetricUnit values.
+ */
+#define PERFOVERLAY_UNIT_PERCENT 0u
+#define PERFOVERLAY_UNIT_BYTES   1u
+#define PERFOVERLAY_UNIT_COUNT   2u
+
+#ifdef _WIN32
+#define PERFOVERLAY_PLUGIN_EXPORT __declspec(dllexport)
+#else
+#define PERFOVERLAY_PLUGIN_EXPORT __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @struct PerfOverlayMetricInfo
+ * @brief Describes one metric of a plugin.
+ */
+typedef struct PerfOverlayMetricInfo
+{
+	char     name[PERFOVERLAY_PLUGIN_MAX_NAME]; ///< Unique dotted name, e.g. "app.queue.depth".
+	uint32_t unit;                              ///< One of the PERFOVERLAY_UNIT_ values.
+	float    rangeMin;                          ///< The bottom of the metric's scale.
+	float    rangeMax;                          ///< The top of its scale, or rangeMin for no fixed scale.
+} PerfOverlayMetricInfo;
+
+/**
+ * @brief Initializes the plugin.
+ * @param[in] apiVersion PERFOVERLAY_PLUGIN_API_VERSION of the overlay.
+ * @param[out] context Receives the plugin's state, passed back to every other call.
+ * @return 0 on success; any other value makes the overlay unload the plugin without calling Shutdown().
+ */
+typedef int (*PerfOverlayPluginInitFn)(uint32_t apiVersion, void** context);
+
+/**
+ * @brief Describes the plugin's metrics.
+ * @param[in] context The state returned by Init().
+ * @param[out] metrics Receives up to capacity descriptions.
+ * @param[in] capacity The number of entries metrics can hold.
+ * @return The number of metrics described.
+ */
+typedef uint32_t (*PerfOverlayPluginDescribeFn)(void* context, PerfOverlayMetricInfo* metrics, uint32_t capacity);
+
+/**
+ * @brief Samples the plugin's metrics into the overlay's buffer.
+ * @param[in] context The state returned by Init().
+ * @param[out] values Receives one value per described metric, in description order.
+ * @param[in] count The number of values, as returned by Describe().
+ */
+typedef void (*PerfOverlayPluginSampleFn)(void* context, float* values, uint32_t count);
+
+/**
+ * @brief Releases the plugin's state.
+ * @param[in] context The state returned by Init().
+ */
+typedef void (*PerfOverlayPluginShutdownFn)(void* context);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @brief The names the overlay looks the entry points up by.
+ */
+#define PERFOVERLAY_PLUGIN_INIT_SYMBOL     "PerfOverlayPluginInit"
+#define PERFOVERLAY_PLUGIN_DESCRIBE_SYMBOL "PerfOverlayPluginDescribe"
+#define PERFOVERLAY_PLUGIN_SAMPLE_SYMBOL   "PerfOverlayPluginSample"
+#define PERFOVERLAY_PLUGIN_SHUTDOWN_SYMBOL "PerfOverlayPluginShutdown"
@@ -0,0 +1,93 @@
+/**
+ * @file MetricRegistry.cpp
+ * @brief Contains the implementation of the MetricRegistry class.
+ * @author Alessandro Bellia
+ * @date 10/15/2026
+ */
+
+#include "MetricRegistry.h"
+#include <cstring>
+
+MetricRegistry::MetricRegistry()
+	: m_count(MetricStaticCount),
+	  m_epoch(1),
+	  m_values{},
+	  m_epochs{},
+	  m_names{},
+	  m_labels{},
+	  m_graphLabels{},
+	  m_units{},
+	  m_rangeMins{},
+	  m_rangeMaxes{},
+	  m_sources{},
+	  m_flags{},
+	  m_dynamicNames{}
+{
+	for (const MetricDescriptor& descriptor : kStaticMetrics)
+	{
+		const uint32_t id = descriptor.id;
+
+		m_names[id]       = descriptor.name;
+		m_labels[id]      = descriptor.label;
+		m_graphLabels[id] = descriptor.graphLabel;
+		m_units[id]       = descriptor.unit;
+		m_rangeMins[id]   = descriptor.rangeMin;
+		m_rangeMaxes[id]  = descriptor.rangeMax;
+		m_sources[id]     = descriptor.source;
+		m_flags[id]       = descriptor.flags;
+	}
+}
+
+_Use_decl_annotations_
+uint32_t MetricRegistry::Register(
+	const char*        name,
+	const MetricUnit   unit,
+	const float        rangeMin,
+	const float        rangeMax,
+	const MetricSource source)
+{
+	// Collectors re-register after rediscovery; they get their old id back.
+	const uint32_t existing = Find(name);
+	if (existing != kInvalidMetric)
+	{
+		return existing;
+	}
+
+	const uint32_t id = m_count.load(std::memory_order_relaxed);
+	if (id >= kMaxMetrics)
+	{
+		return kInvalidMetric;
+	}
+
+	char* const storage = m_dynamicNames[id - MetricStaticCount];
+	(void)std::strncpy(storage, name, kMaxNameLength - 1);
+
+	m_values[id]      = 0.0f;
+	m_names[id]       = storage;
+	m_labels[id]      = storage;
+	m_graphLabels[id] = storage;
+	m_units[id]       = unit;
+	m_rangeMins[id]   = rangeMin;
+	m_rangeMaxes[id]  = rangeMax;
+	m_sources[id]     = source;
+	m_flags[id]       = MetricFlagNone;
+
+	// Publishes the descriptor columns to readers that acquire the count.
+	m_count.store(id + 1, std::memory_order_release);
+	return id;
+}
+
+_Use_decl_annotations_
+uint32_t MetricRegistry::Find(
+	const char* name) const
+{
+	const uint32_t count = GetCount();
+	for (uint32_t id = 0; id < count; id++)
+	{
+		if (std::strncmp(m_names[id], name, kMaxNameLength - 1) == 0)
+		{
+			return id;
+		}
+	}
+	return kInvalidMetric;
+}
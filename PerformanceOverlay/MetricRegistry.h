@@ -0,0 +1,320 @@
+/**
+ * @file MetricRegistry.h
+ * @brief Contains the static metric descriptor table and the declaration of the MetricRegistry class.
+ * @author Alessandro Bellia
+ * @date 10/15/2026
+ */
+
+#pragma once
+
+#include "Platform.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+/**
+ * @brief The unit a metric's values are expressed in.
+ */
+enum MetricUnit : uint8_t
+{
+	MetricUnitPercent = 0,
+	MetricUnitBytes,
+	MetricUnitCount,       ///< A plain number, such as a queue depth
+	MetricUnitMicroseconds ///< A duration, such as a source's latency
+};
+
+/**
+ * @brief The collector that produces a metric's values.
+ */
+enum MetricSource : uint8_t
+{
+	MetricSourceMonitor = 0, ///< The PerformanceMonitor (WMI or procfs)
+	MetricSourceSelf,        ///< The overlay's own process counters
+	MetricSourcePlugin       ///< A metric-provider plugin (see PluginHost)
+};
+
+/**
+ * @brief Flags of a metric descriptor.
+ */
+enum MetricFlags : uint8_t
+{
+	MetricFlagNone    = 0,
+	MetricFlagOverlay = 1 << 0 ///< Drawn as a bar and a graph in the main window
+};
+
+/**
+ * @brief Dense ids of the metrics known at compile time. Metrics registered at run time
+ *		  get the ids after MetricStaticCount.
+ */
+enum MetricId : uint32_t
+{
+	MetricCpuLoad = 0,
+	MetricMemoryUsage,
+	MetricDiskUsage,
+	MetricOverlayCpu,
+	MetricOverlayRss,
+	MetricProcessCount,
+	MetricRunQueueWait,
+	MetricStaticCount
+};
+
+/**
+ * @struct MetricDescriptor
+ * @brief Describes one metric. A range whose maximum is not above its minimum has no fixed scale.
+ */
+struct MetricDescriptor
+{
+	uint32_t     id;         ///< Index of the metric in the value store.
+	const char*  name;       ///< Stable dotted name, e.g. "cpu.load".
+	const char*  label;      ///< Short display label.
+	const char*  graphLabel; ///< Text drawn over the metric's graph.
+	MetricUnit   unit;
+	float        rangeMin;
+	float        rangeMax;
+	MetricSource source;
+	uint8_t      flags;      ///< MetricFlags.
+};
+
+/**
+ * @brief The descriptors of the static metrics, indexed by MetricId.
+ */
+inline constexpr MetricDescriptor kStaticMetrics[] = {
+	{MetricCpuLoad,      "cpu.load",          "CPU",         "CPU Graph",   MetricUnitPercent, 0.0f, 100.0f, MetricSourceMonitor, MetricFlagOverlay},
+	{MetricMemoryUsage,  "memory.usage",      "MEM",         "MEM Graph",   MetricUnitPercent, 0.0f, 100.0f, MetricSourceMonitor, MetricFlagOverlay},
+	{MetricDiskUsage,    "disk.usage",        "DISK",        "DISK Graph",  MetricUnitPercent, 0.0f, 100.0f, MetricSourceMonitor, MetricFlagOverlay},
+	{MetricOverlayCpu,   "overlay.cpu",       "OVERLAY CPU", "OVERLAY CPU", MetricUnitPercent, 0.0f, 100.0f, MetricSourceSelf,    MetricFlagNone},
+	{MetricOverlayRss,   "overlay.rss",       "OVERLAY RSS", "OVERLAY RSS", MetricUnitBytes,   0.0f, 0.0f,   MetricSourceSelf,    MetricFlagNone},
+	{MetricProcessCount, "process.count",     "PROCESSES",   "PROCESSES",   MetricUnitCount,   0.0f, 0.0f,   MetricSourceMonitor, MetricFlagNone},
+	{MetricRunQueueWait, "cpu.runqueue.wait", "RUNQ WAIT",   "RUNQ WAIT",   MetricUnitPercent, 0.0f, 0.0f,   MetricSourceMonitor, MetricFlagNone},
+};
+
+/**
+ * @brief Checks at compile time that every static descriptor sits at the index of its id.
+ * @return True if the ids are dense and in order.
+ */
+constexpr bool AreStaticMetricIdsDense()
+{
+	for (uint32_t i = 0; i < std::size(kStaticMetrics); i++)
+	{
+		if (kStaticMetrics[i].id != i)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+static_assert(std::size(kStaticMetrics) == MetricStaticCount, "Every MetricId needs a descriptor");
+static_assert(AreStaticMetricIdsDense(), "Static descriptors must be listed in MetricId order");
+
+
+/**
+ * @class MetricRegistry
+ * @brief Owns the descriptors and current values of all metrics, as a structure of arrays
+ *		  indexed by dense metric ids.
+ *
+ * The static metrics are copied from kStaticMetrics on construction. Dynamic metrics,
+ * such as per-disk series found at run time, are registered by name and get the next free
+ * id. Collectors keep the ids they were given and write values by indexing, so no string
+ * or hash lookup happens on the hot path.
+ *
+ * Every write stamps the metric with the current sample epoch, so the sampler can tell
+ * which metrics a sample actually refreshed (sources run at their own rates) and record
+ * only those.
+ *
+ * The arrays are sized for kMaxMetrics up front and never move. Registration and value
+ * writes belong to the sampler thread. Any thread may read the descriptor columns of ids
+ * below GetCount().
+ */
+class MetricRegistry
+{
+public:
+	/**
+	 * @brief The most metrics the registry holds, static and dynamic together.
+	 */
+	static constexpr uint32_t kMaxMetrics = 256;
+
+	/**
+	 * @brief Returned when a metric cannot be registered or found.
+	 */
+	static constexpr uint32_t kInvalidMetric = UINT32_MAX;
+
+	/**
+	 * @brief The longest name a dynamic metric keeps, including the terminator.
+	 */
+	static constexpr size_t kMaxNameLength = 48;
+
+	MetricRegistry();
+
+	MetricRegistry(const MetricRegistry& other)            = delete;
+	MetricRegistry& operator=(const MetricRegistry& other) = delete;
+
+	/**
+	 * @brief Registers a dynamic metric, or returns the id it already has.
+	 * @param[in] name The metric's dotted name; truncated to kMaxNameLength - 1 characters.
+	 * @param[in] unit The unit of its values.
+	 * @param[in] rangeMin The bottom of its scale.
+	 * @param[in] rangeMax The top of its scale, or rangeMin for no fixed scale.
+	 * @param[in] source The collector producing it.
+	 * @return The metric's id, or kInvalidMetric if the registry is full.
+	 */
+	uint32_t Register(
+		_In_z_ const char* name,
+		_In_ MetricUnit    unit,
+		_In_ float         rangeMin,
+		_In_ float         rangeMax,
+		_In_ MetricSource  source);
+
+	/**
+	 * @brief Finds a metric by name. Walks every name, so keep it off the hot path.
+	 * @param[in] name The metric's dotted name.
+	 * @return The metric's id, or kInvalidMetric if there is none.
+	 */
+	[[nodiscard]] uint32_t Find(
+		_In_z_ const char* name) const;
+
+	/**
+	 * @brief Gets the number of registered metrics; ids run from 0 to GetCount() - 1.
+	 * @return The metric count.
+	 */
+	[[nodiscard]] uint32_t GetCount() const { return m_count.load(std::memory_order_acquire); }
+
+	/**
+	 * @brief Sets the current value of a metric.
+	 * @param[in] id The metric id; kInvalidMetric is ignored.
+	 * @param[in] value The new value.
+	 */
+	void SetValue(
+		_In_ uint32_t id,
+		_In_ float    value)
+	{
+		if (id < kMaxMetrics)
+		{
+			m_values[id] = value;
+			m_epochs[id] = m_epoch;
+		}
+	}
+
+	/**
+	 * @brief Starts a new sample; metrics written after this count as updated in it.
+	 */
+	void BeginSample() { m_epoch++; }
+
+	/**
+	 * @brief Marks a run of metrics written in place through GetValueSlots() as updated.
+	 * @param[in] id The first metric id of the run.
+	 * @param[in] count The length of the run.
+	 */
+	void MarkUpdated(
+		_In_ uint32_t id,
+		_In_ uint32_t count)
+	{
+		std::fill_n(m_epochs + id, count, m_epoch);
+	}
+
+	/**
+	 * @brief Checks whether a metric was written since the last BeginSample().
+	 * @param[in] id A metric id below GetCount().
+	 * @return True if the current sample refreshed the metric.
+	 */
+	[[nodiscard]] bool WasUpdated(
+		_In_ uint32_t id) const { return m_epochs[id] == m_epoch; }
+
+	/**
+	 * @brief Gets the current values of all metrics.
+	 * @return GetCount() values, indexed by id.
+	 */
+	[[nodiscard]] const float* GetValues() const { return m_values; }
+
+	/**
+	 * @brief Gets the value slots from a metric on, for collectors that write a run of
+	 *		  consecutive metrics in place.
+	 * @param[in] id The first metric id of the run.
+	 * @return A pointer to the value of id; the slots up to kMaxMetrics follow it.
+	 */
+	[[nodiscard]] float* GetValueSlots(
+		_In_ uint32_t id) { return m_values + id; }
+
+	/**
+	 * @brief Gets the dotted name of a metric.
+	 * @param[in] id A metric id below GetCount().
+	 * @return The NUL-terminated name.
+	 */
+	[[nodiscard]] const char* GetName(
+		_In_ uint32_t id) const { return m_names[id]; }
+
+	/**
+	 * @brief Gets the display label of a metric.
+	 * @param[in] id A metric id below GetCount().
+	 * @return The NUL-terminated label.
+	 */
+	[[nodiscard]] const char* GetLabel(
+		_In_ uint32_t id) const { return m_labels[id]; }
+
+	/**
+	 * @brief Gets the text drawn over a metric's graph.
+	 * @param[in] id A metric id below GetCount().
+	 * @return The NUL-terminated text.
+	 */
+	[[nodiscard]] const char* GetGraphLabel(
+		_In_ uint32_t id) const { return m_graphLabels[id]; }
+
+	/**
+	 * @brief Gets the unit of a metric's values.
+	 * @param[in] id A metric id below GetCount().
+	 * @return The unit.
+	 */
+	[[nodiscard]] MetricUnit GetUnit(
+		_In_ uint32_t id) const { return m_units[id]; }
+
+	/**
+	 * @brief Gets the bottom of a metric's scale.
+	 * @param[in] id A metric id below GetCount().
+	 * @return The minimum.
+	 */
+	[[nodiscard]] float GetRangeMin(
+		_In_ uint32_t id) const { return m_rangeMins[id]; }
+
+	/**
+	 * @brief Gets the top of a metric's scale.
+	 * @param[in] id A metric id below GetCount().
+	 * @return The maximum; not above the minimum when the scale is not fixed.
+	 */
+	[[nodiscard]] float GetRangeMax(
+		_In_ uint32_t id) const { return m_rangeMaxes[id]; }
+
+	/**
+	 * @brief Gets the collector producing a metric.
+	 * @param[in] id A metric id below GetCount().
+	 * @return The source.
+	 */
+	[[nodiscard]] MetricSource GetSource(
+		_In_ uint32_t id) const { return m_sources[id]; }
+
+	/**
+	 * @brief Gets the flags of a metric.
+	 * @param[in] id A metric id below GetCount().
+	 * @return A combination of MetricFlags.
+	 */
+	[[nodiscard]] uint8_t GetFlags(
+		_In_ uint32_t id) const { return m_flags[id]; }
+
+private:
+	std::atomic<uint32_t> m_count;
+	uint32_t              m_epoch; ///< The current sample; starts above every initial stamp.
+
+	float        m_values[kMaxMetrics];
+	uint32_t     m_epochs[kMaxMetrics]; ///< The sample each value was last written in.
+	const char*  m_names[kMaxMetrics];
+	const char*  m_labels[kMaxMetrics];
+	const char*  m_graphLabels[kMaxMetrics];
+	MetricUnit   m_units[kMaxMetrics];
+	float        m_rangeMins[kMaxMetrics];
+	float        m_rangeMaxes[kMaxMetrics];
+	MetricSource m_sources[kMaxMetrics];
+	uint8_t      m_flags[kMaxMetrics];
+
+	char m_dynamicNames[kMaxMetrics - MetricStaticCount][kMaxNameLength];
+};
@@ -0,0 +1,78 @@
+/**
+ * @file MetricSubscriptions.cpp
+ * @brief Contains the implementation of the MetricSubscriptions class.
+ * @author Alessandro Bellia
+ * @date 10/15/2026
+ */
+
+#include "MetricSubscriptions.h"
+#include <algorithm>
+
+_Use_decl_annotations_
+uint32_t MetricSubscriptions::Subscribe(
+	const uint32_t*                metrics,
+	const uint32_t                 count,
+	const std::chrono::nanoseconds freshness)
+{
+	std::lock_guard lock(m_mutex);
+	for (uint32_t index = 0; index < kMaxSubscribers; index++)
+	{
+		Subscriber& subscriber = m_subscribers[index];
+		if (subscriber.active)
+		{
+			continue;
+		}
+
+		subscriber.metricCount = std::min(count, kMaxMetricsPerSubscriber);
+		std::copy_n(metrics, subscriber.metricCount, subscriber.metrics);
+		subscriber.freshnessNs = std::max<int64_t>(freshness.count(), 1);
+		subscriber.active      = true;
+		m_generation.fetch_add(1, std::memory_order_release);
+		return index;
+	}
+	return kInvalidSubscriber;
+}
+
+_Use_decl_annotations_
+void MetricSubscriptions::Unsubscribe(
+	const uint32_t subscriber)
+{
+	if (subscriber >= kMaxSubscribers)
+	{
+		return;
+	}
+
+	std::lock_guard lock(m_mutex);
+	if (m_subscribers[subscriber].active)
+	{
+		m_subscribers[subscriber].active = false;
+		m_generation.fetch_add(1, std::memory_order_release);
+	}
+}
+
+_Use_decl_annotations_
+uint64_t MetricSubscriptions::Collect(
+	int64_t*       freshnessNs,
+	const uint32_t metricCount) const
+{
+	std::fill_n(freshnessNs, metricCount, kUnsubscribed);
+
+	std::lock_guard lock(m_mutex);
+	for (const Subscriber& subscriber : m_subscribers)
+	{
+		if (!subscriber.active)
+		{
+			continue;
+		}
+
+		for (uint32_t i = 0; i < subscriber.metricCount; i++)
+		{
+			const uint32_t metric = subscriber.metrics[i];
+			if (metric < metricCount)
+			{
+				freshnessNs[metric] = std::min(freshnessNs[metric], subscriber.freshnessNs);
+			}
+		}
+	}
+	return m_generation.load(std::memory_order_relaxed);
+}
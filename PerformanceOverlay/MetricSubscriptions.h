@@ -0,0 +1,107 @@
+/**
+ * @file MetricSubscriptions.h
+ * @brief Contains the declaration of the MetricSubscriptions class.
+ * @author Alessandro Bellia
+ * @date 10/15/2026
+ */
+
+#pragma once
+
+#include "Platform.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+/**
+ * @class MetricSubscriptions
+ * @brief Records which metrics someone is viewing or exporting, and how fresh they need them.
+ *
+ * A consumer, such as a UI panel or an exporter, subscribes to a set of metric ids with the
+ * oldest value it still accepts. The collector asks for the fastest freshness per metric
+ * and only runs the sources that have at least one subscriber. Subscribing and unsubscribing
+ * are rare and take a lock; every change bumps a generation counter, so the collector can
+ * check for changes with a single atomic load and only takes the lock when there was one.
+ * All methods are thread-safe.
+ */
+class MetricSubscriptions
+{
+public:
+	/**
+	 * @brief The most subscriptions alive at once.
+	 */
+	static constexpr uint32_t kMaxSubscribers = 32;
+
+	/**
+	 * @brief The most metrics one subscription covers.
+	 */
+	static constexpr uint32_t kMaxMetricsPerSubscriber = 16;
+
+	/**
+	 * @brief Returned by Subscribe() when there is no room for another subscription.
+	 */
+	static constexpr uint32_t kInvalidSubscriber = UINT32_MAX;
+
+	/**
+	 * @brief The freshness Collect() reports for a metric nobody subscribed to.
+	 */
+	static constexpr int64_t kUnsubscribed = INT64_MAX;
+
+	MetricSubscriptions() = default;
+
+	MetricSubscriptions(const MetricSubscriptions& other)            = delete;
+	MetricSubscriptions& operator=(const MetricSubscriptions& other) = delete;
+
+	/**
+	 * @brief Subscribes to a set of metrics.
+	 * @param[in] metrics The metric ids.
+	 * @param[in] count The number of ids; at most kMaxMetricsPerSubscriber are kept.
+	 * @param[in] freshness The oldest a value may be when it is read.
+	 * @return The subscription's id, or kInvalidSubscriber if every slot is in use.
+	 */
+	uint32_t Subscribe(
+		_In_reads_(count) const uint32_t* metrics,
+		_In_ uint32_t                     count,
+		_In_ std::chrono::nanoseconds     freshness);
+
+	/**
+	 * @brief Ends a subscription. Safe to call with kInvalidSubscriber.
+	 * @param[in] subscriber The subscription's id.
+	 */
+	void Unsubscribe(
+		_In_ uint32_t subscriber);
+
+	/**
+	 * @brief Gets the counter that changes whenever a subscription starts or ends.
+	 * @return The generation.
+	 */
+	[[nodiscard]] uint64_t GetGeneration() const { return m_generation.load(std::memory_order_acquire); }
+
+	/**
+	 * @brief Computes the fastest freshness any subscriber asked for, per metric.
+	 * @param[out] freshnessNs One entry per metric, set to the freshness in nanoseconds, or
+	 *			   kUnsubscribed if the metric has no subscriber.
+	 * @param[in] metricCount The number of entries.
+	 * @return The generation the result reflects.
+	 */
+	uint64_t Collect(
+		_Out_writes_(metricCount) int64_t* freshnessNs,
+		_In_ uint32_t                      metricCount) const;
+
+private:
+	/**
+	 * @struct Subscriber
+	 * @brief One subscription.
+	 */
+	struct Subscriber
+	{
+		uint32_t metrics[kMaxMetricsPerSubscriber];
+		uint32_t metricCount;
+		int64_t  freshnessNs;
+		bool     active;
+	};
+
+	mutable std::mutex    m_mutex;
+	Subscriber            m_subscribers[kMaxSubscribers] = {};
+	std::atomic<uint64_t> m_generation{0};
+};
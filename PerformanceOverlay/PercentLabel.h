@@ -0,0 +1,60 @@
+/**
+ * @file PercentLabel.h
+ * @brief Contains the declaration and implementation of the PercentLabel class.
+ * @author Alessandro Bellia
+ * @date 10/15/2026
+ */
+
+#pragma once
+
+#include "Platform.h"
+#include <charconv>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+
+/**
+ * @class PercentLabel
+ * @brief A memoized "12.3%" label that is only re-formatted when the displayed value changes.
+ *
+ * Formatting goes through std::to_chars on the value in tenths, so it never allocates,
+ * never touches the locale and costs nothing on frames where the value is unchanged.
+ */
+class PercentLabel
+{
+public:
+	/**
+	 * @brief Updates the label for a value and returns its text.
+	 * @param[in] percent The value to display, in percent.
+	 * @return The NUL-terminated label, valid until the next call.
+	 */
+	const char* Format(
+		_In_ float percent)
+	{
+		const long tenths = std::lround(percent * 10.0f);
+		if (tenths == m_tenths)
+		{
+			return m_text;
+		}
+		m_tenths = tenths;
+
+		char*       out = m_text;
+		char* const end = m_text + sizeof(m_text) - 1;
+		if (tenths < 0)
+		{
+			*out++ = '-';
+		}
+		const unsigned long magnitude = tenths < 0 ? 0UL - static_cast<unsigned long>(tenths) : static_cast<unsigned long>(tenths);
+
+		out    = std::to_chars(out, end - 3, magnitude / 10).ptr;
+		*out++ = '.';
+		*out++ = static_cast<char>('0' + magnitude % 10);
+		*out++ = '%';
+		*out   = '\0';
+		return m_text;
+	}
+
+private:
+	long m_tenths   = LONG_MIN;
+	char m_text[16] = {};
+};
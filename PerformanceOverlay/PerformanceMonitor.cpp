@@ -1,19 +1,29 @@
 /**
  * @file PerformanceMonitor.cpp
- * @brief Contains the implementation of the PerformanceMonitor class.
+ * @brief Contains the WMI-based Windows implementation of the PerformanceMonitor class.
  * @author Alessandro Bellia
  * @date 10/22/2025
  */
 
+#ifdef _WIN32
+
 #include "PerformanceMonitor.h"
+#include "TscClock.h"
 #include <comdef.h>
+#include <Psapi.h>
 
 PerformanceMonitor::PerformanceMonitor()
-	: m_pLocator(nullptr),
+	: m_pNtQuerySystemInformationEx(nullptr),
+	  m_pLocator(nullptr),
 	  m_pServices(nullptr),
-	  m_cpuLoad(0.0f),
-	  m_memoryUsage(0.0f),
-	  m_diskUsage(0.0f)
+	  m_comInitialized(false),
+	  m_wqlLanguage(nullptr),
+	  m_cpuQuery(nullptr),
+	  m_memoryQuery(nullptr),
+	  m_diskQuery(nullptr),
+	  m_pRegistry(nullptr),
+	  m_prevSelfCpuNs(0),
+	  m_prevSelfWallNs(0)
 {
 }
 PerformanceMonitor::~PerformanceMonitor()
@@ -21,14 +31,19 @@ PerformanceMonitor::~PerformanceMonitor()
 	Shutdown();
 }
 
-bool PerformanceMonitor::Initialize()
+_Use_decl_annotations_
+bool PerformanceMonitor::Initialize(
+	MetricRegistry& registry)
 {
+	m_pRegistry = &registry;
+
 	// Step 1: Initialize COM.
 	HRESULT hRes = ::CoInitializeEx(nullptr, COINIT_MULTITHREADED);
 	if (FAILED(hRes))
 	{
 		return false; // "Failed to initialize COM library"
 	}
+	m_comInitialized = true;
 
 	// Step 2: Set general COM security levels.
 	hRes = ::CoInitializeSecurity(
@@ -45,7 +60,7 @@ bool PerformanceMonitor::Initialize()
 
 	if (FAILED(hRes))
 	{
-		::CoUninitialize();
+		Shutdown();
 		return false; // "Failed to initialize security"
 	}
 
@@ -59,7 +74,7 @@ bool PerformanceMonitor::Initialize()
 
 	if (FAILED(hRes))
 	{
-		::CoUninitialize();
+		Shutdown();
 		return false; // "Failed to create IWbemLocator object"
 	}
 
@@ -77,8 +92,7 @@ bool PerformanceMonitor::Initialize()
 
 	if (FAILED(hRes))
 	{
-		m_pLocator->Release();
-		::CoUninitialize();
+		Shutdown();
 		return false; // "Could not connect"
 	}
 
@@ -96,17 +110,43 @@ bool PerformanceMonitor::Initialize()
 
 	if (FAILED(hRes))
 	{
-		m_pServices->Release();
-		m_pLocator->Release();
-		::CoUninitialize();
+		Shutdown();
 		return false; // "Could not set proxy blanket"
 	}
 
+	// Step 6: Build the query strings used on every UpdateSource().
+	m_wqlLanguage = ::SysAllocString(L"WQL");
+	m_cpuQuery    = ::SysAllocString(L"SELECT PercentProcessorTime FROM Win32_PerfFormattedData_PerfOS_Processor WHERE Name='_Total'");
+	m_memoryQuery = ::SysAllocString(L"SELECT TotalVisibleMemorySize, FreePhysicalMemory FROM Win32_OperatingSystem");
+	m_diskQuery   = ::SysAllocString(L"SELECT PercentDiskTime FROM Win32_PerfFormattedData_PerfDisk_PhysicalDisk WHERE Name='_Total'");
+	if (!m_wqlLanguage || !m_cpuQuery || !m_memoryQuery || !m_diskQuery)
+	{
+		Shutdown();
+		return false; // "Out of memory"
+	}
+
+	// Per-core loads are optional; the overlay still works with the WMI totals alone.
+	(void)InitializeCores();
+	(void)m_processes.Open();
+	AddSources();
+
+	// Take the baseline of the overlay's own CPU time.
+	(void)UpdateSelf();
+	m_pRegistry->SetValue(MetricOverlayCpu, 0.0f);
+
 	return true;
 }
 
 void PerformanceMonitor::Shutdown()
 {
+	m_processes.Close();
+
+	for (BSTR* pQuery : {&m_wqlLanguage, &m_cpuQuery, &m_memoryQuery, &m_diskQuery})
+	{
+		::SysFreeString(*pQuery); // Accepts null
+		*pQuery = nullptr;
+	}
+
 	if (m_pServices)
 	{
 		m_pServices->Release();
@@ -119,83 +159,292 @@ void PerformanceMonitor::Shutdown()
 		m_pLocator = nullptr;
 	}
 
-	::CoUninitialize();
+	// Only balance a successful CoInitializeEx(), and only once, since Shutdown() is also
+	// called from the destructor and on every failure path of Initialize().
+	if (m_comInitialized)
+	{
+		::CoUninitialize();
+		m_comInitialized = false;
+	}
 }
 
-void PerformanceMonitor::Update()
+_Use_decl_annotations_
+void PerformanceMonitor::UpdateSource(
+	const Source source,
+	BumpArena&   scratch)
 {
 	if (!m_pServices)
 	{
 		return;
 	}
 
-	// Update the CPU load
-	ULONG cpuLoadPercent = 0;
-	if (GetWmiPropertyValue(
-		bstr_t(L"SELECT PercentProcessorTime FROM Win32_PerfFormattedData_PerfOS_Processor WHERE Name='_Total'"),
-		L"PercentProcessorTime",
-		cpuLoadPercent))
+	// Every WMI wait is bounded by its source's deadline, so a stuck provider costs at most
+	// that much and then backs off instead of blocking the sample indefinitely.
+	switch (source)
+	{
+	case SourceCpu:
+		RunSource(SourceCpu, [this, &scratch]
+		{
+			// Update the per-core loads
+			UpdateCores(scratch);
+
+			// Update the CPU load
+			ULONG cpuLoadPercent = 0;
+			if (!GetWmiPropertyValue(
+				m_cpuQuery,
+				L"PercentProcessorTime",
+				m_watchdog.GetDeadlineMs(SourceCpu),
+				cpuLoadPercent))
+			{
+				return false;
+			}
+			m_pRegistry->SetValue(MetricCpuLoad, static_cast<float>(cpuLoadPercent));
+			return true;
+		});
+		break;
+
+	case SourceMemory:
+		RunSource(SourceMemory, [this] { return UpdateMemory(m_watchdog.GetDeadlineMs(SourceMemory)); });
+		break;
+
+	case SourceDisk:
+		RunSource(SourceDisk, [this]
+		{
+			// Update disk usage
+			ULONG diskUsagePercent = 0;
+			if (!GetWmiPropertyValue(
+				m_diskQuery,
+				L"PercentDiskTime",
+				m_watchdog.GetDeadlineMs(SourceDisk),
+				diskUsagePercent))
+			{
+				return false;
+			}
+			m_pRegistry->SetValue(MetricDiskUsage, static_cast<float>(diskUsagePercent));
+			return true;
+		});
+		break;
+
+	case SourceSelf:
+		RunSource(SourceSelf, [this] { return UpdateSelf(); });
+		break;
+
+	case SourceProcesses:
+		RunSource(SourceProcesses, [this] { return UpdateProcesses(); });
+		break;
+
+	default:
+		break;
+	}
+}
+
+_Use_decl_annotations_
+PerformanceMonitor::Source PerformanceMonitor::GetMetricSource(
+	const uint32_t metric) const
+{
+	switch (metric)
 	{
-		m_cpuLoad = static_cast<float>(cpuLoadPercent);
+	case MetricCpuLoad:
+		return SourceCpu;
+	case MetricMemoryUsage:
+		return SourceMemory;
+	case MetricDiskUsage:
+		return SourceDisk;
+	case MetricOverlayCpu:
+	case MetricOverlayRss:
+		return SourceSelf;
+	case MetricProcessCount:
+	case MetricRunQueueWait:
+		return SourceProcesses;
+	default:
+		break;
 	}
 
-	// Update memory usage
+	const uint32_t source = m_watchdog.FindSource(metric);
+	return source != SourceWatchdog::kInvalidSource ? static_cast<Source>(source) : SourceCount;
+}
+
+_Use_decl_annotations_
+bool PerformanceMonitor::UpdateMemory(
+	const long timeoutMs)
+{
 	// For memory, we need to query two properties from the same object
 	IEnumWbemClassObject* pEnumerator = nullptr;
 	const HRESULT         hRes        = m_pServices->ExecQuery(
-		bstr_t("WQL"),
-		bstr_t("SELECT TotalVisibleMemorySize, FreePhysicalMemory FROM Win32_OperatingSystem"),
+		m_wqlLanguage,
+		m_memoryQuery,
 		WBEM_FLAG_FORWARD_ONLY | WBEM_FLAG_RETURN_IMMEDIATELY,
 		nullptr,
 		&pEnumerator);
 
-	if (SUCCEEDED(hRes) && pEnumerator)
+	if (FAILED(hRes) || !pEnumerator)
+	{
+		return false;
+	}
+
+	IWbemClassObject* pClsObj = nullptr;
+	ULONG             uReturn = 0;
+	bool              success = false;
+	if (pEnumerator->Next(timeoutMs, 1, &pClsObj, &uReturn) == WBEM_S_NO_ERROR)
 	{
-		IWbemClassObject* pClsObj = nullptr;
-		ULONG             uReturn = 0;
-		if (pEnumerator->Next(WBEM_INFINITE, 1, &pClsObj, &uReturn) == WBEM_S_NO_ERROR)
+		VARIANT vtProp{};
+		(void)pClsObj->Get(L"TotalVisibleMemorySize", 0, &vtProp, nullptr, nullptr);
+		const ULONG totalMemory = _wtol(vtProp.bstrVal);
+		(void)::VariantClear(&vtProp);
+
+		(void)pClsObj->Get(L"FreePhysicalMemory", 0, &vtProp, nullptr, nullptr);
+		const ULONG freeMemory = _wtol(vtProp.bstrVal);
+		(void)::VariantClear(&vtProp);
+
+		pClsObj->Release();
+
+		if (totalMemory > 0)
 		{
-			VARIANT vtProp{};
-			(void)pClsObj->Get(L"TotalVisibleMemorySize", 0, &vtProp, nullptr, nullptr);
-			const ULONG totalMemory = _wtol(vtProp.bstrVal);
-			(void)::VariantClear(&vtProp);
+			m_pRegistry->SetValue(MetricMemoryUsage,
+			                      static_cast<float>(totalMemory - freeMemory) / static_cast<float>(totalMemory) * 100.0f);
+			success = true;
+		}
+	}
 
-			(void)pClsObj->Get(L"FreePhysicalMemory", 0, &vtProp, nullptr, nullptr);
-			const ULONG freeMemory = _wtol(vtProp.bstrVal);
-			(void)::VariantClear(&vtProp);
+	// Releasing the enumerator of a timed-out query abandons it.
+	pEnumerator->Release();
+	return success;
+}
 
-			pClsObj->Release();
+bool PerformanceMonitor::UpdateSelf()
+{
+	const HANDLE hProcess = ::GetCurrentProcess();
+	bool         success  = true;
 
-			if (totalMemory > 0)
-			{
-				m_memoryUsage = (static_cast<float>(totalMemory - freeMemory) / static_cast<float>(totalMemory)) *
-					100.0f;
-			}
+	FILETIME creationTime, exitTime, kernelTime, userTime;
+	if (!::GetProcessTimes(hProcess, &creationTime, &exitTime, &kernelTime, &userTime))
+	{
+		success = false;
+	}
+	else
+	{
+		// FILETIME counts 100 ns units.
+		const auto toTicks = [](const FILETIME& time)
+		{
+			return static_cast<int64_t>(time.dwHighDateTime) << 32 | time.dwLowDateTime;
+		};
+		const int64_t cpuNs  = (toTicks(kernelTime) + toTicks(userTime)) * 100;
+		const int64_t wallNs = TscClock::NowNs();
+
+		const DWORD cpuCount = ::GetActiveProcessorCount(ALL_PROCESSOR_GROUPS);
+		if (m_prevSelfWallNs != 0 && wallNs > m_prevSelfWallNs && cpuCount > 0)
+		{
+			m_pRegistry->SetValue(MetricOverlayCpu, static_cast<float>(cpuNs - m_prevSelfCpuNs) /
+			                      static_cast<float>(wallNs - m_prevSelfWallNs) / static_cast<float>(cpuCount) * 100.0f);
 		}
+		m_prevSelfCpuNs  = cpuNs;
+		m_prevSelfWallNs = wallNs;
+	}
+
+	PROCESS_MEMORY_COUNTERS counters = {};
+	counters.cb                      = sizeof(counters);
+	if (!::K32GetProcessMemoryInfo(hProcess, &counters, sizeof(counters)))
+	{
+		return false;
+	}
+
+	m_pRegistry->SetValue(MetricOverlayRss, static_cast<float>(counters.WorkingSetSize));
+	return success;
+}
 
-		pEnumerator->Release();
+bool PerformanceMonitor::InitializeCores()
+{
+	const HMODULE hNtdll = ::GetModuleHandleW(L"ntdll.dll");
+	if (!hNtdll)
+	{
+		return false;
 	}
 
-	// Update disk usage
-	ULONG diskUsagePercent = 0;
-	if (GetWmiPropertyValue(
-		bstr_t(L"SELECT PercentDiskTime FROM Win32_PerfFormattedData_PerfDisk_PhysicalDisk WHERE Name='_Total'"),
-		L"PercentDiskTime",
-		diskUsagePercent))
+	m_pNtQuerySystemInformationEx = reinterpret_cast<NtQuerySystemInformationExFn>(
+		::GetProcAddress(hNtdll, "NtQuerySystemInformationEx"));
+	if (!m_pNtQuerySystemInformationEx)
 	{
-		m_diskUsage = static_cast<float>(diskUsagePercent);
+		return false;
 	}
+
+	// Machines with more than 64 logical CPUs split them into processor groups, and the
+	// per-processor query reports one group per call. Size everything once, up front.
+	const WORD groupCount = ::GetActiveProcessorGroupCount();
+	DWORD      coreCount  = 0;
+	m_groupSizes.resize(groupCount);
+	for (WORD group = 0; group < groupCount; group++)
+	{
+		m_groupSizes[group] = static_cast<WORD>(::GetActiveProcessorCount(group));
+		coreCount += m_groupSizes[group];
+	}
+
+	m_cores.Resize(coreCount);
+
+	// Take the baseline so that the first UpdateSource() already yields a delta.
+	BumpArena scratch(MemoryAccounting::SubsystemSampleArena);
+	UpdateCores(scratch);
+	return true;
+}
+
+_Use_decl_annotations_
+void PerformanceMonitor::UpdateCores(
+	BumpArena& scratch)
+{
+	if (!m_pNtQuerySystemInformationEx)
+	{
+		return;
+	}
+
+	constexpr ULONG kSystemProcessorPerformanceInformation = 8;
+
+	const uint32_t        coreCount = m_cores.GetCoreCount();
+	ProcessorTimes* const pAllTimes = scratch.AllocateArray<ProcessorTimes>(coreCount);
+	if (!pAllTimes)
+	{
+		return;
+	}
+
+	ProcessorTimes* pTimes = pAllTimes;
+	for (USHORT group = 0; group < m_groupSizes.size(); group++)
+	{
+		ULONG      returned = 0;
+		const LONG status   = m_pNtQuerySystemInformationEx(
+			kSystemProcessorPerformanceInformation,
+			&group,
+			sizeof(group),
+			pTimes,
+			static_cast<ULONG>(m_groupSizes[group] * sizeof(ProcessorTimes)),
+			&returned);
+
+		if (status < 0)
+		{
+			return; // Keep the previous loads
+		}
+		pTimes += m_groupSizes[group];
+	}
+
+	uint64_t* const busy  = m_cores.BusyCounters();
+	uint64_t* const total = m_cores.TotalCounters();
+	for (uint32_t i = 0; i < coreCount; i++)
+	{
+		const ProcessorTimes& times = pAllTimes[i];
+		total[i]                    = static_cast<uint64_t>(times.kernelTime.QuadPart + times.userTime.QuadPart);
+		busy[i]                     = total[i] - static_cast<uint64_t>(times.idleTime.QuadPart);
+	}
+
+	m_cores.Compute();
 }
 
 _Use_decl_annotations_
 bool PerformanceMonitor::GetWmiPropertyValue(
 	const BSTR     wqlQuery,
 	const wchar_t* propertyName,
+	const long     timeoutMs,
 	ULONG&         value) const
 {
 	IEnumWbemClassObject* pEnumerator = nullptr;
 	HRESULT               hRes        = m_pServices->ExecQuery(
-		bstr_t("WQL"),
+		m_wqlLanguage,
 		wqlQuery,
 		WBEM_FLAG_FORWARD_ONLY | WBEM_FLAG_RETURN_IMMEDIATELY,
 		nullptr,
@@ -210,7 +459,8 @@ bool PerformanceMonitor::GetWmiPropertyValue(
 	ULONG             uReturn = 0;
 	bool              success = false;
 
-	if (pEnumerator->Next(WBEM_INFINITE, 1, &pClsObj, &uReturn) == WBEM_S_NO_ERROR)
+	// Next() returns WBEM_S_TIMEDOUT once timeoutMs has passed without a result.
+	if (pEnumerator->Next(timeoutMs, 1, &pClsObj, &uReturn) == WBEM_S_NO_ERROR)
 	{
 		VARIANT vtProp;
 
@@ -237,3 +487,5 @@ bool PerformanceMonitor::GetWmiPropertyValue(
 	pEnumerator->Release();
 	return success;
 }
+
+#endif // _WIN32
@@ -7,17 +7,57 @@
 
 #pragma once
 
+#include "Platform.h"
+#include "AdaptiveRate.h"
+#include "CpuCoreBank.h"
+#include "MetricRegistry.h"
+#include "ProcessTable.h"
+#include "SourceWatchdog.h"
+#include "TscClock.h"
+#include <algorithm>
+#include <chrono>
+
+#ifdef _WIN32
+#include "BumpArena.h"
 #include <WbemIdl.h>
+#include <vector>
+#else
+#include "ProcFile.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+#endif
 
 /**
  * @class PerformanceMonitor
- * @brief Establishes a connection to WMI and queries for performance data such as
- *		  CPU load, memory usage, and disk activity.
+ * @brief Queries the operating system for performance data such as CPU load, memory usage,
+ *		  disk activity and the processes using the most CPU and memory. On Windows the data comes from WMI; on Linux it is computed from
+ *		  raw procfs counters.
+ *
+ * The CPU, memory, disk, self and process readings are independent sources, each run by a
+ * SourceWatchdog under a per-sample deadline. A source that fails or misses its deadline
+ * keeps its last values and backs off without holding up the others. Each source is also
+ * sampled at its own rate: an AdaptiveRate watches one representative metric of the source
+ * and stretches its interval while the value is stable, so an idle machine is polled rarely
+ * while a busy one is followed at the full rate. Sources that change slowly declare a
+ * longer shortest interval of their own (see GetSourceMinInterval()), and each declares the
+ * phase of its first read (see GetSourcePhase()). The caller schedules the sources and
+ * refreshes each one when it is due.
  */
 class PerformanceMonitor
 {
 public:
 	PerformanceMonitor();
+#ifndef _WIN32
+	/**
+	 * @brief Constructs a monitor that reads from custom procfs and sysfs roots, e.g. a recorded fixture tree.
+	 * @param[in] procRoot The directory procfs is mounted on (normally "/proc").
+	 * @param[in] sysRoot The directory sysfs is mounted on (normally "/sys").
+	 */
+	PerformanceMonitor(
+		_In_z_ const char* procRoot,
+		_In_z_ const char* sysRoot);
+#endif
 	~PerformanceMonitor();
 
 	PerformanceMonitor(const PerformanceMonitor& other)     = delete;
@@ -26,60 +66,392 @@ public:
 	PerformanceMonitor& operator=(const PerformanceMonitor& other)     = delete;
 	PerformanceMonitor& operator=(PerformanceMonitor&& other) noexcept = delete;
 	/**
-	 * @brief Initializes COM and connects to the WMI service.
+	 * @brief Initializes COM and connects to the WMI service (Windows), or opens the procfs
+	 *		  counter files and takes the baseline sample (Linux).
+	 * @param[in,out] registry The registry the values are written to. Metrics discovered at
+	 *				  run time, such as per-disk activity, are registered in it. It must
+	 *				  outlive the monitor.
 	 * @return True if initialization and connection are successful, false otherwise.
 	 */
-	bool Initialize();
+	bool Initialize(
+		_Inout_ MetricRegistry& registry);
 
 	/**
-	 * @brief Shuts down all COM interfaces and uninitializes COM.
+	 * @brief Shuts down all COM interfaces and uninitializes COM, or closes the procfs files.
 	 */
 	void Shutdown();
 
 	/**
-	 * @brief Executes WMI queries to refresh all performance data.
+	 * @brief The sources run by the watchdog, in the order they are registered.
 	 */
-	void Update();
+	enum Source : uint32_t
+	{
+		SourceCpu = 0,
+		SourceMemory,
+		SourceDisk,
+		SourceSelf,
+		SourceProcesses,
+		SourceCount
+	};
+
+	/**
+	 * @brief The interval between two slices of a process scan: a slice takes at most about
+	 *		  half the source's deadline, so the sampler thread stays free at least half the
+	 *		  time while a large table is scanned.
+	 */
+	static constexpr std::chrono::milliseconds kProcessSliceInterval{50};
+
+	/**
+	 * @brief Refreshes the performance data of one source, either through WMI queries or by
+	 *		  re-reading the procfs counters and differencing them against the previous
+	 *		  sample, writes the new values to the registry and adapts the source's interval.
+	 *		  Values that cannot be refreshed keep their previous reading. A source that is
+	 *		  backing off after a miss is skipped.
+	 * @param[in] source The source.
+	 * @param[in,out] scratch The per-sample arena for buffers that do not outlive this call.
+	 *		  Windows only: procfs is read into a persistent buffer sized at discovery.
+	 */
+#ifdef _WIN32
+	void UpdateSource(
+		_In_ Source        source,
+		_Inout_ BumpArena& scratch);
+#else
+	void UpdateSource(
+		_In_ Source source);
+#endif
 
 
 	// --- Accessors ---
 
 	/**
-	 * @brief Gets the current CPU load percentage.
-	 * @return The CPU load as a float.
+	 * @brief Gets the number of logical CPUs with per-core utilization.
+	 * @return The logical CPU count.
+	 */
+	[[nodiscard]] uint32_t GetCoreCount() const { return m_cores.GetCoreCount(); }
+
+	/**
+	 * @brief Gets the utilization of every logical CPU.
+	 * @return A pointer to GetCoreCount() percentages, indexed by logical CPU number.
+	 */
+	[[nodiscard]] const float* GetCoreLoads() const { return m_cores.GetLoads(); }
+
+	/**
+	 * @brief Gets the process table, with the top CPU and memory consumers of the last scan.
+	 * @return A reference to the table; refreshed by the SourceProcesses source.
+	 */
+	[[nodiscard]] const ProcessTable& GetProcesses() const { return m_processes; }
+
+	/**
+	 * @brief Gets the watchdog tracking the health of every source.
+	 * @return A reference to the watchdog; index it with Source.
+	 */
+	[[nodiscard]] const SourceWatchdog& GetWatchdog() const { return m_watchdog; }
+
+	/**
+	 * @brief Sets the range a source's sampling interval adapts within.
+	 * @param[in] source The source.
+	 * @param[in] minInterval The interval while the source's values are changing. A source
+	 *			  that declares a longer shortest interval of its own keeps that one.
+	 * @param[in] maxInterval The interval once they have been stable for a while.
+	 */
+	void SetIntervalRange(
+		_In_ uint32_t                 source,
+		_In_ std::chrono::nanoseconds minInterval,
+		_In_ std::chrono::nanoseconds maxInterval)
+	{
+		const std::chrono::nanoseconds floor = std::max<std::chrono::nanoseconds>(minInterval, kSources[source].minInterval);
+		m_rates[source].SetRange(floor, std::max(maxInterval, floor));
+	}
+
+	/**
+	 * @brief Gets the shortest interval a source declares for itself.
+	 * @param[in] source The source.
+	 * @return The interval; zero if the source follows the sampler's interval.
+	 */
+	[[nodiscard]] static std::chrono::nanoseconds GetSourceMinInterval(
+		_In_ uint32_t source) { return kSources[source].minInterval; }
+
+	/**
+	 * @brief Gets the time a source declares from Initialize() to its first read.
+	 * @param[in] source The source.
+	 * @return The phase; zero to read it right away.
 	 */
-	[[nodiscard]] float GetCpuLoad() const { return m_cpuLoad; }
+	[[nodiscard]] static std::chrono::nanoseconds GetSourcePhase(
+		_In_ uint32_t source) { return kSources[source].phase; }
 
 	/**
-	 * @brief Gets the current memory usage percentage.
-	 * @return The memory usage as a float.
+	 * @brief Gets the current sampling interval of a source.
+	 * @param[in] source The source.
+	 * @return The interval in nanoseconds.
 	 */
-	[[nodiscard]] float GetMemoryUsage() const { return m_memoryUsage; }
+	[[nodiscard]] int64_t GetSourceIntervalNs(
+		_In_ uint32_t source) const
+	{
+		// A process scan stopped at its slice budget is resumed soon, not at the source's rate.
+		return source == SourceProcesses && m_processes.IsScanning()
+			       ? std::chrono::nanoseconds(kProcessSliceInterval).count()
+			       : m_rates[source].GetIntervalNs();
+	}
 
 	/**
-	 * @brief Gets the current disk activity percentage.
-	 * @return The disk activity as a float.
+	 * @brief Finds the source that writes a metric.
+	 * @param[in] metric The metric's id.
+	 * @return The source, or SourceCount if the metric does not come from the monitor.
 	 */
-	[[nodiscard]] float GetDiskUsage() const { return m_diskUsage; }
+	[[nodiscard]] Source GetMetricSource(
+		_In_ uint32_t metric) const;
 
 private:
+	/**
+	 * @struct SourceSpec
+	 * @brief What a source declares about itself.
+	 */
+	struct SourceSpec
+	{
+		const char*               name;
+		std::chrono::milliseconds minInterval;  ///< Zero to follow the sampler's interval.
+		std::chrono::milliseconds phase;        ///< The delay of the first read after Initialize().
+		std::chrono::milliseconds deadline;     ///< The longest one read may take; see SourceWatchdog.
+		uint32_t                  signalMetric; ///< The metric its AdaptiveRate watches.
+	};
+
+	/**
+	 * @brief The sources, indexed by Source. Memory and the overlay's own usage move slowly
+	 *		  enough that reading them more often than this only costs time. The overlay's
+	 *		  CPU usage is a rate over the time since the baseline Initialize() took, so its
+	 *		  first read waits for a full interval instead of dividing by a few milliseconds.
+	 *		  The process table costs a read per process, so it is scanned at most once a
+	 *		  second, and follows the machine's CPU load rather than the process count.
+	 *
+	 *		  The deadlines leave every source several times its usual cost while keeping
+	 *		  the sum of a sample well inside the sampler's 250 ms interval: a WMI query
+	 *		  takes a few milliseconds, the disk counters are the slowest provider to
+	 *		  refresh, and the overlay's own usage is two local calls. The process table
+	 *		  costs a few reads per process, close to 200 ms at 20,000 processes, so it
+	 *		  is scanned in slices that fit its deadline instead (see UpdateProcesses()).
+	 */
+	static constexpr SourceSpec kSources[SourceCount] = {
+		{"cpu", std::chrono::milliseconds(0), std::chrono::milliseconds(0), std::chrono::milliseconds(50), MetricCpuLoad},
+		{"memory", std::chrono::milliseconds(500), std::chrono::milliseconds(0), std::chrono::milliseconds(50), MetricMemoryUsage},
+		{"disk", std::chrono::milliseconds(0), std::chrono::milliseconds(0), std::chrono::milliseconds(100), MetricDiskUsage},
+		{"self", std::chrono::milliseconds(1000), std::chrono::milliseconds(1000), std::chrono::milliseconds(20), MetricOverlayCpu},
+		{"processes", std::chrono::milliseconds(1000), std::chrono::milliseconds(0), std::chrono::milliseconds(50), MetricCpuLoad},
+	};
+
+	/**
+	 * @brief Adds every Source to the watchdog, in enum order, with its deadline, and
+	 *		  registers their health metrics.
+	 */
+	void AddSources()
+	{
+		for (const SourceSpec& spec : kSources)
+		{
+			const uint32_t source = m_watchdog.Add(spec.name, *m_pRegistry);
+			if (source != SourceWatchdog::kInvalidSource)
+			{
+				m_watchdog.SetDeadline(source, spec.deadline);
+			}
+		}
+	}
+
+	/**
+	 * @brief Runs a source through the watchdog and feeds its adaptive rate the source's
+	 *		  representative metric afterwards, unless the call only advanced a sliced scan.
+	 * @param[in] source The source.
+	 * @param[in] update The call refreshing the source; returns true on success.
+	 */
+	template <typename Update>
+	void RunSource(
+		_In_ Source source,
+		_In_ Update update)
+	{
+		m_watchdog.Run(source, update);
+		if (source == SourceProcesses && m_processes.IsScanning())
+		{
+			return;
+		}
+
+		const uint32_t signal = kSources[source].signalMetric;
+		m_rates[source].Observe(AdaptiveRate::Normalize(m_pRegistry->GetValues()[signal],
+		                                                m_pRegistry->GetRangeMin(signal),
+		                                                m_pRegistry->GetRangeMax(signal)));
+	}
+
+	/**
+	 * @brief Recomputes the overlay's own CPU usage (as a percentage of all logical CPUs,
+	 *		  like Task Manager shows it) and resident memory (working set on Windows).
+	 * @return True if both were refreshed.
+	 */
+	bool UpdateSelf();
+
+	/**
+	 * @brief Advances the process scan by one slice and, once the scan completes, publishes
+	 *		  the process count and the run-queue wait. A slice lasts half the source's
+	 *		  deadline, which leaves the other half for the last process's reads and for
+	 *		  sweeping and ranking the table at the end of the scan.
+	 * @return True if the scan completed or stopped at its slice budget, false if it failed.
+	 */
+	bool UpdateProcesses()
+	{
+		const int64_t sliceNs = static_cast<int64_t>(m_watchdog.GetDeadlineMs(SourceProcesses)) * 1'000'000 / 2;
+		if (!m_processes.Update(TscClock::NowNs() + sliceNs))
+		{
+			return m_processes.IsScanning();
+		}
+		m_pRegistry->SetValue(MetricProcessCount, static_cast<float>(m_processes.GetCount()));
+		m_pRegistry->SetValue(MetricRunQueueWait, m_processes.GetRunQueueWait());
+		return true;
+	}
+
+#ifdef _WIN32
 	_Success_(return)
 	/**
 	 * @brief A helper function to execute a WMI query and retrieve a single property value.
 	 * @param[in] wqlQuery The WQL query string.
 	 * @param[in] propertyName The name of the property to retrieve from the result.
+	 * @param[in] timeoutMs The longest to wait for the result.
 	 * @param[out] value The retrieved value is stored here.
 	 * @return True if the query and value retrieval were successful, false otherwise.
 	 */
 	bool GetWmiPropertyValue(
 		_In_ BSTR           wqlQuery,
 		_In_ const wchar_t* propertyName,
+		_In_ long           timeoutMs,
 		_Out_ ULONG&        value) const;
 
+	/**
+	 * @brief Recomputes the memory usage from the free and total physical memory of Win32_OperatingSystem.
+	 * @param[in] timeoutMs The longest to wait for the query result.
+	 * @return True if the usage was refreshed.
+	 */
+	bool UpdateMemory(
+		_In_ long timeoutMs);
+
+	/**
+	 * @brief Sizes the per-core counter bank and the query buffer for all active processor groups.
+	 * @return True if the per-core query is available, false otherwise.
+	 */
+	bool InitializeCores();
+
+	/**
+	 * @brief Reads the idle/kernel/user times of every logical CPU and recomputes the per-core loads.
+	 * @param[in,out] scratch The arena the per-processor query buffer is allocated from.
+	 */
+	void UpdateCores(
+		_Inout_ BumpArena& scratch);
+
+	/**
+	 * @brief Signature of ntdll!NtQuerySystemInformationEx, resolved at run time.
+	 */
+	using NtQuerySystemInformationExFn = LONG(NTAPI*)(
+		ULONG  systemInformationClass,
+		PVOID  inputBuffer,
+		ULONG  inputBufferLength,
+		PVOID  systemInformation,
+		ULONG  systemInformationLength,
+		PULONG returnLength);
+
+	/**
+	 * @struct ProcessorTimes
+	 * @brief Mirrors SYSTEM_PROCESSOR_PERFORMANCE_INFORMATION from winternl.h.
+	 */
+	struct ProcessorTimes
+	{
+		LARGE_INTEGER idleTime;
+		LARGE_INTEGER kernelTime; ///< Includes idleTime.
+		LARGE_INTEGER userTime;
+		LARGE_INTEGER reserved1[2];
+		ULONG         reserved2;
+	};
+
+	NtQuerySystemInformationExFn m_pNtQuerySystemInformationEx;
+	std::vector<WORD>            m_groupSizes;
+
 	IWbemLocator*  m_pLocator;
 	IWbemServices* m_pServices;
+	bool           m_comInitialized;
+
+	// The query strings are allocated once, so that UpdateSource() does not build a BSTR per query.
+	BSTR m_wqlLanguage;
+	BSTR m_cpuQuery;
+	BSTR m_memoryQuery;
+	BSTR m_diskQuery;
+#else
+	/**
+	 * @struct DiskCounters
+	 * @brief The previous io_ticks reading of one physical disk found in /proc/diskstats.
+	 */
+	struct DiskCounters
+	{
+		char     name[32];
+		uint64_t ioTicksMs;
+		uint32_t metric; ///< The disk's activity metric in the registry.
+	};
+
+	/**
+	 * @brief Reads a file into the shared scratch buffer, doubling the buffer and reading
+	 *		  again whenever the file fills it, e.g. after CPUs were hot-plugged or disks added.
+	 * @param[in] file The file to read.
+	 * @return The number of bytes read, or -1 on failure.
+	 */
+	long ReadIntoBuffer(
+		_In_ const ProcFile& file);
+
+	/**
+	 * @brief Recomputes the total and per-core CPU load from the jiffy counters in /proc/stat,
+	 *		  in a single pass over the file.
+	 * @return True if the file was read.
+	 */
+	bool UpdateCpu();
+
+	/**
+	 * @brief Sizes the per-core counter bank from the highest cpuN line in /proc/stat.
+	 */
+	void DiscoverCores();
+
+	/**
+	 * @brief Recomputes the memory usage from MemTotal and MemAvailable in /proc/meminfo.
+	 * @return True if the usage was refreshed.
+	 */
+	bool UpdateMemory();
+
+	/**
+	 * @brief Recomputes the disk activity from the io_ticks counters in /proc/diskstats,
+	 *		  over the time since the disks were last read.
+	 * @return True if the file was read, or there are no disks to read.
+	 */
+	bool UpdateDisks();
+
+	/**
+	 * @brief Finds the physical disks listed in /proc/diskstats, skipping partitions and
+	 *		  virtual devices that have no backing device in sysfs.
+	 */
+	void DiscoverDisks();
+
+	std::string m_procRoot;
+	std::string m_sysRoot;
+
+	ProcFile m_statFile;
+	ProcFile m_meminfoFile;
+	ProcFile m_diskstatsFile;
+	ProcFile m_selfStatmFile;
+
+	std::vector<char>         m_buffer;
+	std::vector<DiskCounters> m_disks;
+
+	uint64_t m_prevCpuBusy;
+	uint64_t m_prevCpuTotal;
+	uint64_t m_prevDiskSampleMs; ///< When the disks were last read; 0 before the first read.
+	uint32_t m_onlineCpuCount;   ///< Online CPUs at Initialize(), which the overlay's CPU is divided by.
+	uint64_t m_pageSize;         ///< The page size statm counts in.
+#endif
+
+	CpuCoreBank     m_cores;
+	ProcessTable    m_processes;
+	MetricRegistry* m_pRegistry;
+	SourceWatchdog  m_watchdog;
+	AdaptiveRate    m_rates[SourceCount];
 
-	float m_cpuLoad;
-	float m_memoryUsage;
-	float m_diskUsage;
+	int64_t m_prevSelfCpuNs;
+	int64_t m_prevSelfWallNs;
 };
@@ -0,0 +1,490 @@
+/**
+ * @file PerformanceMonitorLinux.cpp
+ * @brief Contains the procfs-based Linux implementation of the PerformanceMonitor class.
+ * @author Alessandro Bellia
+ * @date 10/15/2026
+ */
+
+#ifdef __linux__
+
+#include "PerformanceMonitor.h"
+#include "TscClock.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <unistd.h>
+
+
+/**
+ * @brief Initial size of the scratch buffer shared by all procfs reads.
+ */
+static constexpr size_t kInitialBufferSize = 64 * 1024;
+
+/**
+ * @brief Reads a clock in nanoseconds.
+ * @param[in] clock The clock id.
+ * @return The clock's current time in nanoseconds.
+ */
+static int64_t ClockNs(
+	_In_ clockid_t clock);
+
+/**
+ * @brief Extracts the logical CPU number from a "cpuN" token of /proc/stat.
+ * @param[in] token The token, starting with "cpu".
+ * @param[in] length The length of the token.
+ * @return The CPU number N.
+ */
+static uint32_t ParseCoreId(
+	_In_reads_(length) const char* token,
+	_In_ size_t                    length);
+
+
+PerformanceMonitor::PerformanceMonitor()
+	: PerformanceMonitor("/proc", "/sys")
+{
+}
+
+_Use_decl_annotations_
+PerformanceMonitor::PerformanceMonitor(
+	const char* procRoot,
+	const char* sysRoot)
+	: m_procRoot(procRoot),
+	  m_sysRoot(sysRoot),
+	  m_prevCpuBusy(0),
+	  m_prevCpuTotal(0),
+	  m_prevDiskSampleMs(0),
+	  m_onlineCpuCount(1),
+	  m_pageSize(4096),
+	  m_processes(procRoot),
+	  m_pRegistry(nullptr),
+	  m_prevSelfCpuNs(0),
+	  m_prevSelfWallNs(0)
+{
+}
+
+PerformanceMonitor::~PerformanceMonitor()
+{
+	Shutdown();
+}
+
+_Use_decl_annotations_
+bool PerformanceMonitor::Initialize(
+	MetricRegistry& registry)
+{
+	m_pRegistry = &registry;
+
+	// The root paths are only concatenated here; UpdateSource() never builds a path.
+	if (!m_statFile.Open((m_procRoot + "/stat").c_str()) ||
+		!m_meminfoFile.Open((m_procRoot + "/meminfo").c_str()))
+	{
+		Shutdown();
+		return false;
+	}
+
+	// Disk statistics are optional (e.g. containers without block devices).
+	(void)m_diskstatsFile.Open((m_procRoot + "/diskstats").c_str());
+	(void)m_selfStatmFile.Open((m_procRoot + "/self/statm").c_str());
+	(void)m_processes.Open();
+
+	// The system constants are read once; UpdateSelf() runs every sample.
+	m_onlineCpuCount = static_cast<uint32_t>(std::max(::sysconf(_SC_NPROCESSORS_ONLN), 1L));
+	m_pageSize       = static_cast<uint64_t>(std::max(::sysconf(_SC_PAGESIZE), 1L));
+
+	// Grow the scratch buffer once, up front, so that the largest file fits and
+	// steady-state sampling only reallocates if a file outgrows it later.
+	m_buffer.resize(kInitialBufferSize);
+	for (const ProcFile* file : {&m_statFile, &m_meminfoFile, &m_diskstatsFile})
+	{
+		if (file->IsOpen())
+		{
+			(void)ReadIntoBuffer(*file);
+		}
+	}
+
+	DiscoverCores();
+	DiscoverDisks();
+	AddSources();
+
+	// Take the baseline sample so that the first UpdateSource() already yields a delta.
+	(void)UpdateCpu();
+	(void)UpdateDisks();
+	(void)UpdateSelf();
+	m_pRegistry->SetValue(MetricCpuLoad, 0.0f);
+	m_pRegistry->SetValue(MetricOverlayCpu, 0.0f);
+
+	return true;
+}
+
+void PerformanceMonitor::Shutdown()
+{
+	m_statFile.Close();
+	m_meminfoFile.Close();
+	m_diskstatsFile.Close();
+	m_selfStatmFile.Close();
+	m_processes.Close();
+}
+
+_Use_decl_annotations_
+void PerformanceMonitor::UpdateSource(
+	const Source source)
+{
+	if (!m_statFile.IsOpen())
+	{
+		return;
+	}
+
+	// procfs counters are generated from memory, so reads do not block on devices; the
+	// deadlines catch a starved or overloaded host rather than a hung call.
+	switch (source)
+	{
+	case SourceCpu:
+		RunSource(SourceCpu, [this] { return UpdateCpu(); });
+		break;
+	case SourceMemory:
+		RunSource(SourceMemory, [this] { return UpdateMemory(); });
+		break;
+	case SourceDisk:
+		RunSource(SourceDisk, [this] { return UpdateDisks(); });
+		break;
+	case SourceSelf:
+		RunSource(SourceSelf, [this] { return UpdateSelf(); });
+		break;
+	case SourceProcesses:
+		RunSource(SourceProcesses, [this] { return UpdateProcesses(); });
+		break;
+	default:
+		break;
+	}
+}
+
+_Use_decl_annotations_
+long PerformanceMonitor::ReadIntoBuffer(
+	const ProcFile& file)
+{
+	// Read() stops one byte short of the end for the terminator, so a file that reaches it
+	// may have been cut short: grow and read it again rather than parse a truncated file.
+	long length = file.Read(m_buffer.data(), m_buffer.size());
+	while (length >= static_cast<long>(m_buffer.size()) - 1)
+	{
+		m_buffer.resize(m_buffer.size() * 2);
+		length = file.Read(m_buffer.data(), m_buffer.size());
+	}
+	return length;
+}
+
+_Use_decl_annotations_
+PerformanceMonitor::Source PerformanceMonitor::GetMetricSource(
+	const uint32_t metric) const
+{
+	switch (metric)
+	{
+	case MetricCpuLoad:
+		return SourceCpu;
+	case MetricMemoryUsage:
+		return SourceMemory;
+	case MetricDiskUsage:
+		return SourceDisk;
+	case MetricOverlayCpu:
+	case MetricOverlayRss:
+		return SourceSelf;
+	case MetricProcessCount:
+	case MetricRunQueueWait:
+		return SourceProcesses;
+	default:
+		break;
+	}
+
+	for (const DiskCounters& disk : m_disks)
+	{
+		if (disk.metric == metric)
+		{
+			return SourceDisk;
+		}
+	}
+
+	const uint32_t source = m_watchdog.FindSource(metric);
+	return source != SourceWatchdog::kInvalidSource ? static_cast<Source>(source) : SourceCount;
+}
+
+bool PerformanceMonitor::UpdateCpu()
+{
+	const long length = ReadIntoBuffer(m_statFile);
+	if (length <= 0)
+	{
+		return false;
+	}
+
+	// The first line is the aggregate over all CPUs, followed by one cpuN line per online CPU:
+	// cpu  user nice system idle iowait irq softirq steal guest guest_nice
+	// guest and guest_nice are already accounted in user and nice.
+	uint64_t* const busyCounters  = m_cores.BusyCounters();
+	uint64_t* const totalCounters = m_cores.TotalCounters();
+	const uint32_t  coreCount     = m_cores.GetCoreCount();
+
+	ProcParser parser(m_buffer.data(), m_buffer.data() + length);
+	while (parser.StartsWith("cpu"))
+	{
+		const char* token;
+		size_t      tokenLength;
+		(void)parser.ReadToken(token, tokenLength);
+
+		const uint64_t user    = parser.ReadU64();
+		const uint64_t nice    = parser.ReadU64();
+		const uint64_t system  = parser.ReadU64();
+		const uint64_t idle    = parser.ReadU64();
+		const uint64_t iowait  = parser.ReadU64();
+		const uint64_t irq     = parser.ReadU64();
+		const uint64_t softirq = parser.ReadU64();
+		const uint64_t steal   = parser.ReadU64();
+
+		const uint64_t busy  = user + nice + system + irq + softirq + steal;
+		const uint64_t total = busy + idle + iowait;
+
+		if (tokenLength == 3)
+		{
+			// Counters are monotonic, but guard against a fixture tree being swapped underneath us.
+			if (total > m_prevCpuTotal && busy >= m_prevCpuBusy)
+			{
+				const float deltaBusy  = static_cast<float>(busy - m_prevCpuBusy);
+				const float deltaTotal = static_cast<float>(total - m_prevCpuTotal);
+				m_pRegistry->SetValue(MetricCpuLoad, std::clamp(deltaBusy / deltaTotal * 100.0f, 0.0f, 100.0f));
+			}
+
+			m_prevCpuBusy  = busy;
+			m_prevCpuTotal = total;
+		}
+		else
+		{
+			// Offline CPUs have no line; their slots keep a frozen counter and read as idle.
+			const uint32_t core = ParseCoreId(token, tokenLength);
+			if (core < coreCount)
+			{
+				busyCounters[core]  = busy;
+				totalCounters[core] = total;
+			}
+		}
+
+		parser.SkipLine();
+	}
+
+	m_cores.Compute();
+	return true;
+}
+
+void PerformanceMonitor::DiscoverCores()
+{
+	const long length = ReadIntoBuffer(m_statFile);
+	if (length <= 0)
+	{
+		return;
+	}
+
+	uint32_t   coreCount = 0;
+	ProcParser parser(m_buffer.data(), m_buffer.data() + length);
+	while (parser.StartsWith("cpu"))
+	{
+		const char* token;
+		size_t      tokenLength;
+		if (parser.ReadToken(token, tokenLength) && tokenLength > 3)
+		{
+			coreCount = std::max(coreCount, ParseCoreId(token, tokenLength) + 1);
+		}
+		parser.SkipLine();
+	}
+
+	m_cores.Resize(coreCount);
+}
+
+bool PerformanceMonitor::UpdateMemory()
+{
+	const long length = ReadIntoBuffer(m_meminfoFile);
+	if (length <= 0)
+	{
+		return false;
+	}
+
+	uint64_t totalKb     = 0;
+	uint64_t availableKb = 0;
+	bool     hasTotal    = false;
+	bool     hasAvail    = false;
+
+	ProcParser parser(m_buffer.data(), m_buffer.data() + length);
+	while (!parser.AtEnd() && !(hasTotal && hasAvail))
+	{
+		if (parser.StartsWith("MemTotal:"))
+		{
+			parser.SkipTokens(1);
+			totalKb  = parser.ReadU64();
+			hasTotal = true;
+		}
+		else if (parser.StartsWith("MemAvailable:"))
+		{
+			parser.SkipTokens(1);
+			availableKb = parser.ReadU64();
+			hasAvail    = true;
+		}
+		parser.SkipLine();
+	}
+
+	if (!hasTotal || !hasAvail || totalKb == 0 || availableKb > totalKb)
+	{
+		return false;
+	}
+
+	m_pRegistry->SetValue(MetricMemoryUsage, static_cast<float>(totalKb - availableKb) / static_cast<float>(totalKb) * 100.0f);
+	return true;
+}
+
+bool PerformanceMonitor::UpdateDisks()
+{
+	if (m_disks.empty())
+	{
+		return true;
+	}
+
+	const long length = ReadIntoBuffer(m_diskstatsFile);
+	if (length <= 0)
+	{
+		return false;
+	}
+
+	// The interval is measured from the last successful read, which is further back than the
+	// previous sample when the source was backing off.
+	const uint64_t nowMs     = static_cast<uint64_t>(TscClock::NowNs() / 1'000'000);
+	const uint64_t elapsedMs = m_prevDiskSampleMs != 0 ? nowMs - m_prevDiskSampleMs : 0;
+	m_prevDiskSampleMs       = nowMs;
+
+	// Each line: major minor name reads rd_merged rd_sectors rd_ms writes wr_merged wr_sectors wr_ms
+	//            in_flight io_ticks ...
+	// io_ticks is the number of milliseconds the device had at least one request in flight,
+	// so its delta over the elapsed wall time is the busy fraction (PercentDiskTime on Windows).
+	float    busySum   = 0.0f;
+	uint32_t diskCount = 0;
+
+	ProcParser parser(m_buffer.data(), m_buffer.data() + length);
+	while (!parser.AtEnd())
+	{
+		const char* name;
+		size_t      nameLength;
+		parser.SkipTokens(2);
+		if (parser.ReadToken(name, nameLength))
+		{
+			for (DiskCounters& disk : m_disks)
+			{
+				if (std::strlen(disk.name) != nameLength || std::memcmp(disk.name, name, nameLength) != 0)
+				{
+					continue;
+				}
+
+				parser.SkipTokens(9);
+				const uint64_t ioTicksMs = parser.ReadU64();
+				if (elapsedMs > 0 && ioTicksMs >= disk.ioTicksMs)
+				{
+					const float busy = std::min(static_cast<float>(ioTicksMs - disk.ioTicksMs) /
+					                            static_cast<float>(elapsedMs) * 100.0f, 100.0f);
+					busySum += busy;
+					++diskCount;
+					m_pRegistry->SetValue(disk.metric, busy);
+				}
+				disk.ioTicksMs = ioTicksMs;
+				break;
+			}
+		}
+		parser.SkipLine();
+	}
+
+	if (diskCount > 0)
+	{
+		m_pRegistry->SetValue(MetricDiskUsage, busySum / static_cast<float>(diskCount));
+	}
+	return true;
+}
+
+bool PerformanceMonitor::UpdateSelf()
+{
+	const int64_t cpuNs  = ClockNs(CLOCK_PROCESS_CPUTIME_ID);
+	const int64_t wallNs = TscClock::NowNs();
+	if (m_prevSelfWallNs != 0 && wallNs > m_prevSelfWallNs)
+	{
+		m_pRegistry->SetValue(MetricOverlayCpu, static_cast<float>(cpuNs - m_prevSelfCpuNs) /
+		                      static_cast<float>(wallNs - m_prevSelfWallNs) / static_cast<float>(m_onlineCpuCount) * 100.0f);
+	}
+	m_prevSelfCpuNs  = cpuNs;
+	m_prevSelfWallNs = wallNs;
+
+	// statm: size resident shared text lib data dt, all in pages.
+	const long length = ReadIntoBuffer(m_selfStatmFile);
+	if (length <= 0)
+	{
+		return false;
+	}
+
+	ProcParser parser(m_buffer.data(), m_buffer.data() + length);
+	parser.SkipTokens(1);
+	m_pRegistry->SetValue(MetricOverlayRss, static_cast<float>(parser.ReadU64() * m_pageSize));
+	return true;
+}
+
+void PerformanceMonitor::DiscoverDisks()
+{
+	m_disks.clear();
+
+	const long length = ReadIntoBuffer(m_diskstatsFile);
+	if (length <= 0)
+	{
+		return;
+	}
+
+	std::string devicePath;
+	ProcParser  parser(m_buffer.data(), m_buffer.data() + length);
+	while (!parser.AtEnd())
+	{
+		const char* name;
+		size_t      nameLength;
+		parser.SkipTokens(2);
+		if (parser.ReadToken(name, nameLength) && nameLength < sizeof(DiskCounters::name))
+		{
+			// Whole physical disks appear under /sys/block with a "device" link; partitions
+			// are nested under their disk and loop/ram/dm devices have no backing device.
+			devicePath.assign(m_sysRoot).append("/block/").append(name, nameLength).append("/device");
+			if (::access(devicePath.c_str(), F_OK) == 0)
+			{
+				DiskCounters disk{};
+				std::memcpy(disk.name, name, nameLength);
+
+				// Each disk also gets its own series, e.g. "disk.nvme0n1.usage".
+				char metricName[MetricRegistry::kMaxNameLength];
+				(void)std::snprintf(metricName, sizeof(metricName), "disk.%s.usage", disk.name);
+				disk.metric = m_pRegistry->Register(metricName, MetricUnitPercent, 0.0f, 100.0f, MetricSourceMonitor);
+				m_disks.push_back(disk);
+			}
+		}
+		parser.SkipLine();
+	}
+}
+
+
+_Use_decl_annotations_
+int64_t ClockNs(
+	const clockid_t clock)
+{
+	timespec ts{};
+	(void)::clock_gettime(clock, &ts);
+	return static_cast<int64_t>(ts.tv_sec) * 1'000'000'000 + ts.tv_nsec;
+}
+
+_Use_decl_annotations_
+uint32_t ParseCoreId(
+	const char*  token,
+	const size_t length)
+{
+	uint32_t core = 0;
+	for (size_t i = 3; i < length; i++)
+	{
+		core = core * 10 + static_cast<uint32_t>(token[i] - '0');
+	}
+	return core;
+}
+
+#endif // __linux__
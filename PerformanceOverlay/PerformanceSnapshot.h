@@ -0,0 +1,46 @@
+/**
+ * @file PerformanceSnapshot.h
+ * @brief Contains the declaration of the PerformanceSnapshot structure.
+ * @author Alessandro Bellia
+ * @date 10/15/2026
+ */
+
+#pragma once
+
+#include "MetricRegistry.h"
+#include "ProcessTable.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @struct PerformanceSnapshot
+ * @brief An immutable copy of every metric collected in one sampling pass, as published
+ *		  by the Sampler and consumed by the Gui. Snapshot slots are reused, so the per-core
+ *		  array only allocates until it has grown to the core count, and the process list
+ *		  until it has grown to the process count.
+ */
+struct PerformanceSnapshot
+{
+	uint64_t sequence;     ///< Monotonically increasing sample number; 0 means no sample yet.
+	uint64_t coreSequence; ///< The sequence of the last sample that refreshed coreLoads.
+	int64_t  timestampNs;  ///< Monotonic time at which the sample was taken, in nanoseconds.
+	uint32_t metricCount;  ///< The number of valid entries in values.
+
+	float values[MetricRegistry::kMaxMetrics]; ///< Metric values indexed by metric id (see MetricRegistry).
+
+	std::vector<float> coreLoads; ///< Per-logical-CPU load percentages, indexed by CPU number.
+	std::vector<float> cpuWaits;  ///< Per-logical-CPU run-queue wait, as percentages of the scan interval; empty if unknown.
+
+	ProcessSample topCpu[ProcessTable::kTopCount];  ///< The busiest processes, busiest first.
+	ProcessSample topRss[ProcessTable::kTopCount];  ///< The largest processes by resident memory, largest first.
+	ProcessSample topIo[ProcessTable::kTopCount];   ///< The processes doing the most I/O, busiest first.
+	ProcessSample topWait[ProcessTable::kTopCount]; ///< The processes that waited longest for a CPU, most delayed first.
+	uint32_t      topCpuCount;                      ///< The number of valid entries in topCpu.
+	uint32_t      topRssCount;                      ///< The number of valid entries in topRss.
+	uint32_t      topIoCount;                       ///< The number of valid entries in topIo.
+	uint32_t      topWaitCount;                     ///< The number of valid entries in topWait.
+	uint32_t      ioDeniedCount;                    ///< The processes whose I/O could not be read.
+
+	uint64_t                   processSequence; ///< Changes whenever the process list is rescanned; 0 before the first scan.
+	std::vector<ProcessSample> processes;       ///< Every process of the last scan, in table order.
+};
@@ -0,0 +1,26 @@
+/**
+ * @file Platform.h
+ * @brief Contains the portability shims shared by the platform-independent parts of the overlay.
+ * @author Alessandro Bellia
+ * @date 10/15/2026
+ */
+
+#pragma once
+
+#ifdef _MSC_VER
+#include <sal.h>
+#else
+// SAL annotations are only understood by MSVC; everywhere else they expand to nothing.
+#define _In_
+#define _In_z_
+#define _In_opt_
+#define _In_reads_(size)
+#define _Out_
+#define _Out_opt_
+#define _Out_writes_(size)
+#define _Out_writes_to_(size, count)
+#define _Inout_
+#define _Inout_opt_
+#define _Success_(expr)
+#define _Use_decl_annotations_
+#endif
@@ -0,0 +1,147 @@
+/**
+ * @file PlotDecimation.cpp
+ * @brief Contains the implementation of the min/max envelope decimation used by the metric graphs.
+ * @author Alessandro Bellia
+ * @date 10/15/2026
+ */
+
+#include "PlotDecimation.h"
+
+_Use_decl_annotations_
+uint32_t DecimateMinMax(
+	const HistoryView& view,
+	const int64_t      fromNs,
+	const int64_t      toNs,
+	const uint32_t     columns,
+	float*             points)
+{
+	if (view.Size() == 0 || columns == 0 || toNs <= fromNs)
+	{
+		return 0;
+	}
+
+	const int64_t spanNs = toNs - fromNs;
+
+	// Samples are sorted by time, so columns are visited in order and only the column
+	// being accumulated needs any state.
+	uint32_t written   = 0;      // Columns already emitted
+	int64_t  current   = -1;     // Column being accumulated
+	int64_t  edge      = fromNs; // First timestamp past the current column
+	float    low       = 0.0f;   // Its minimum
+	float    high      = 0.0f;   // Its maximum
+	bool     lowIsLast = false;  // Whether the minimum occurred after the maximum
+	float    carry     = view.ValueAt(0);
+
+	const auto flush = [&]
+	{
+		if (current >= 0)
+		{
+			points[2 * written]     = lowIsLast ? high : low;
+			points[2 * written + 1] = lowIsLast ? low : high;
+			written++;
+		}
+	};
+
+	for (int piece = 0; piece < 2; piece++)
+	{
+		const int64_t* const timestamps = view.timestamps[piece];
+		const float* const   values     = view.values[piece];
+		const uint32_t       size       = view.sizes[piece];
+
+		for (uint32_t i = 0; i < size; i++)
+		{
+			const int64_t t = timestamps[i];
+			const float   v = values[i];
+			if (t < fromNs)
+			{
+				carry = v; // Seeds the columns before the first sample in range
+				continue;
+			}
+			if (t > toNs)
+			{
+				break;
+			}
+
+			if (t >= edge)
+			{
+				flush();
+
+				// Advance to the column holding t; the ones no sample fell into hold the last
+				// value seen. Comparing against the column edge keeps the division out of the
+				// per-sample path.
+				current = (t - fromNs) * columns / spanNs;
+				current = current < columns ? current : columns - 1;
+				edge    = current + 1 < columns ? fromNs + ((current + 1) * spanNs + columns - 1) / columns : INT64_MAX;
+				while (written < current)
+				{
+					points[2 * written]     = carry;
+					points[2 * written + 1] = carry;
+					written++;
+				}
+
+				low       = v;
+				high      = v;
+				lowIsLast = false;
+			}
+			else if (v < low)
+			{
+				low       = v;
+				lowIsLast = true;
+			}
+			else if (v > high)
+			{
+				high      = v;
+				lowIsLast = false;
+			}
+
+			carry = v;
+		}
+	}
+
+	flush();
+	while (written < columns)
+	{
+		points[2 * written]     = carry;
+		points[2 * written + 1] = carry;
+		written++;
+	}
+
+	return 2 * columns;
+}
+
+_Use_decl_annotations_
+uint32_t DecimateMinMax(
+	const RollupBucket* buckets,
+	const uint32_t      count,
+	float*              points)
+{
+	// Leading empty buckets take the value of the first bucket that holds data.
+	uint32_t first = 0;
+	while (first < count && buckets[first].count == 0)
+	{
+		first++;
+	}
+	if (first == count)
+	{
+		return 0;
+	}
+
+	float carry = buckets[first].min;
+	for (uint32_t i = 0; i < count; i++)
+	{
+		const RollupBucket& bucket = buckets[i];
+		if (bucket.count > 0)
+		{
+			points[2 * i]     = bucket.min;
+			points[2 * i + 1] = bucket.max;
+			carry             = bucket.max;
+		}
+		else
+		{
+			points[2 * i]     = carry;
+			points[2 * i + 1] = carry;
+		}
+	}
+
+	return 2 * count;
+}
@@ -0,0 +1,53 @@
+/**
+ * @file PlotDecimation.h
+ * @brief Contains the declaration of the min/max envelope decimation used by the metric graphs.
+ * @author Alessandro Bellia
+ * @date 10/15/2026
+ */
+
+#pragma once
+
+#include "Platform.h"
+#include "MetricHistory.h"
+#include "RollupStore.h"
+#include <cstdint>
+
+/**
+ * @brief Reduces the samples of a history view to a per-column min/max envelope.
+ *
+ * The time span is split into equal columns (typically one or half a pixel each). Every
+ * column emits two points, its minimum and its maximum in the order they occurred, so a
+ * one-sample spike survives no matter how many samples share its column. Columns without
+ * samples repeat the previous value, keeping the x axis proportional to time. Runs in one
+ * pass over the view and never allocates.
+ *
+ * @param[in] view The samples to decimate, oldest first.
+ * @param[in] fromNs The time at the left edge of the graph.
+ * @param[in] toNs The time at the right edge of the graph.
+ * @param[in] columns The number of columns; points receives 2 * columns values.
+ * @param[out] points Receives the envelope, ready to be plotted at uniform x spacing.
+ * @return The number of points written: 2 * columns, or 0 if the view is empty.
+ */
+uint32_t DecimateMinMax(
+	_In_ const HistoryView&          view,
+	_In_ int64_t                     fromNs,
+	_In_ int64_t                     toNs,
+	_In_ uint32_t                    columns,
+	_Out_writes_(2 * columns) float* points);
+
+/**
+ * @brief Expands rollup buckets into a min/max envelope, two points per bucket.
+ *
+ * Buckets already carry their extremes, so no sample is lost however coarse the tier.
+ * The order of min and max inside a bucket is unknown and is emitted as min first.
+ * Empty buckets repeat the previous value.
+ *
+ * @param[in] buckets The buckets to expand, oldest first.
+ * @param[in] count The number of buckets.
+ * @param[out] points Receives 2 * count values.
+ * @return The number of points written: 2 * count, or 0 if no bucket holds data.
+ */
+uint32_t DecimateMinMax(
+	_In_reads_(count) const RollupBucket* buckets,
+	_In_ uint32_t                         count,
+	_Out_writes_(2 * count) float*        points);
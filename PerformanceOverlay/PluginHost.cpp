@@ -0,0 +1,254 @@
+/**
+ * @file PluginHost.cpp
+ * @brief Contains the implementation of the PluginHost class.
+ * @author Alessandro Bellia
+ * @date 10/15/2026
+ */
+
+#include "PluginHost.h"
+#include "TscClock.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <system_error>
+#include <vector>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+static_assert(PERFOVERLAY_UNIT_PERCENT == MetricUnitPercent &&
+              PERFOVERLAY_UNIT_BYTES == MetricUnitBytes &&
+              PERFOVERLAY_UNIT_COUNT == MetricUnitCount, "Plugin units must match MetricUnit");
+static_assert(PERFOVERLAY_PLUGIN_MAX_NAME <= MetricRegistry::kMaxNameLength, "Plugin metric names must fit the registry");
+
+/**
+ * @brief The file extension of shared libraries on this platform.
+ */
+#ifdef _WIN32
+static constexpr char kLibraryExtension[] = ".dll";
+#else
+static constexpr char kLibraryExtension[] = ".so";
+#endif
+
+/**
+ * @brief Loads a shared library.
+ * @param[in] path The library's path.
+ * @return The module handle, or null on failure.
+ */
+static void* OpenLibrary(
+	_In_ const std::filesystem::path& path);
+
+/**
+ * @brief Looks up an exported function of a shared library.
+ * @param[in] module The module handle.
+ * @param[in] name The exported name.
+ * @return The function's address, or null if it is not exported.
+ */
+static void* FindSymbol(
+	_In_ void*         module,
+	_In_z_ const char* name);
+
+/**
+ * @brief Unloads a shared library.
+ * @param[in] module The module handle.
+ */
+static void CloseLibrary(
+	_In_ void* module);
+
+
+PluginHost::~PluginHost()
+{
+	UnloadAll();
+}
+
+_Use_decl_annotations_
+uint32_t PluginHost::LoadDirectory(
+	const std::filesystem::path& directory,
+	MetricRegistry&              registry)
+{
+	// Startup only, so a temporary list is fine; sorting keeps metric ids stable across runs.
+	std::vector<std::filesystem::path> paths;
+	std::error_code                    error;
+	for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(directory, error))
+	{
+		if (entry.is_regular_file(error) && entry.path().extension() == kLibraryExtension)
+		{
+			paths.push_back(entry.path());
+		}
+	}
+	std::sort(paths.begin(), paths.end());
+
+	uint32_t loaded = 0;
+	for (const std::filesystem::path& path : paths)
+	{
+		if (m_count == kMaxPlugins)
+		{
+			break;
+		}
+		if (Load(path, registry))
+		{
+			loaded++;
+		}
+	}
+	return loaded;
+}
+
+_Use_decl_annotations_
+bool PluginHost::Sample(
+	const uint32_t index)
+{
+	Plugin& plugin = m_plugins[index];
+	if (!plugin.enabled.load(std::memory_order_relaxed))
+	{
+		return false;
+	}
+
+	const uint64_t start = TscClock::Now();
+	plugin.sample(plugin.context, plugin.values, plugin.metricCount);
+	const int64_t elapsedNs = TscClock::DurationNs(TscClock::Now() - start);
+
+	if (elapsedNs > plugin.maxSampleNs.load(std::memory_order_relaxed))
+	{
+		plugin.maxSampleNs.store(elapsedNs, std::memory_order_relaxed);
+	}
+
+	if (elapsedNs <= m_budgetNs)
+	{
+		plugin.overruns = 0;
+	}
+	else if (++plugin.overruns == kMaxOverruns)
+	{
+		// Stale values would read as live ones, so a disabled plugin's metrics drop to zero.
+		plugin.enabled.store(false, std::memory_order_relaxed);
+		std::fill_n(plugin.values, plugin.metricCount, 0.0f);
+	}
+
+	m_pRegistry->MarkUpdated(plugin.firstMetric, plugin.metricCount);
+	plugin.rate.Observe(AdaptiveRate::Normalize(plugin.values[0],
+	                                            m_pRegistry->GetRangeMin(plugin.firstMetric),
+	                                            m_pRegistry->GetRangeMax(plugin.firstMetric)));
+	return plugin.enabled.load(std::memory_order_relaxed);
+}
+
+void PluginHost::UnloadAll()
+{
+	for (uint32_t index = 0; index < m_count; index++)
+	{
+		Plugin& plugin = m_plugins[index];
+		plugin.shutdown(plugin.context);
+		CloseLibrary(plugin.module);
+		plugin.module = nullptr;
+		plugin.enabled.store(false, std::memory_order_relaxed);
+	}
+	m_count = 0;
+}
+
+_Use_decl_annotations_
+bool PluginHost::Load(
+	const std::filesystem::path& path,
+	MetricRegistry&              registry)
+{
+	void* const module = OpenLibrary(path);
+	if (!module)
+	{
+		return false;
+	}
+
+	const auto init     = reinterpret_cast<PerfOverlayPluginInitFn>(FindSymbol(module, PERFOVERLAY_PLUGIN_INIT_SYMBOL));
+	const auto describe = reinterpret_cast<PerfOverlayPluginDescribeFn>(FindSymbol(module, PERFOVERLAY_PLUGIN_DESCRIBE_SYMBOL));
+	const auto sample   = reinterpret_cast<PerfOverlayPluginSampleFn>(FindSymbol(module, PERFOVERLAY_PLUGIN_SAMPLE_SYMBOL));
+	const auto shutdown = reinterpret_cast<PerfOverlayPluginShutdownFn>(FindSymbol(module, PERFOVERLAY_PLUGIN_SHUTDOWN_SYMBOL));
+
+	void* context = nullptr;
+	if (!init || !describe || !sample || !shutdown || init(PERFOVERLAY_PLUGIN_API_VERSION, &context) != 0)
+	{
+		CloseLibrary(module);
+		return false;
+	}
+
+	PerfOverlayMetricInfo metrics[PERFOVERLAY_PLUGIN_MAX_METRICS] = {};
+	const uint32_t        count = std::min(describe(context, metrics, PERFOVERLAY_PLUGIN_MAX_METRICS), PERFOVERLAY_PLUGIN_MAX_METRICS);
+
+	// The plugin writes its values as one run of slots, so its metrics need consecutive new
+	// ids: reject it up front rather than alias an existing metric or one of its own, since
+	// a name registered for a rejected plugin could not be taken back.
+	const uint32_t first = registry.GetCount();
+	bool           valid = count > 0 && first + count <= MetricRegistry::kMaxMetrics;
+	for (uint32_t i = 0; valid && i < count; i++)
+	{
+		metrics[i].name[PERFOVERLAY_PLUGIN_MAX_NAME - 1] = '\0';
+		valid = metrics[i].unit <= MetricUnitCount && registry.Find(metrics[i].name) == MetricRegistry::kInvalidMetric;
+		for (uint32_t j = 0; valid && j < i; j++)
+		{
+			valid = std::strcmp(metrics[j].name, metrics[i].name) != 0;
+		}
+	}
+	if (!valid)
+	{
+		shutdown(context);
+		CloseLibrary(module);
+		return false;
+	}
+
+	// Every name is new and distinct and the registry has room, so each one gets the next id.
+	for (uint32_t i = 0; i < count; i++)
+	{
+		(void)registry.Register(metrics[i].name, static_cast<MetricUnit>(metrics[i].unit),
+		                        metrics[i].rangeMin, metrics[i].rangeMax, MetricSourcePlugin);
+	}
+
+	m_pRegistry = &registry;
+
+	Plugin& plugin     = m_plugins[m_count++];
+	plugin.module      = module;
+	plugin.context     = context;
+	plugin.sample      = sample;
+	plugin.shutdown    = shutdown;
+	plugin.values      = registry.GetValueSlots(first);
+	plugin.firstMetric = first;
+	plugin.metricCount = count;
+	plugin.overruns    = 0;
+	plugin.rate        = AdaptiveRate();
+	plugin.enabled.store(true, std::memory_order_relaxed);
+	plugin.maxSampleNs.store(0, std::memory_order_relaxed);
+	(void)std::snprintf(plugin.name, sizeof(plugin.name), "%s", path.filename().string().c_str());
+	return true;
+}
+
+
+_Use_decl_annotations_
+void* OpenLibrary(
+	const std::filesystem::path& path)
+{
+#ifdef _WIN32
+	return ::LoadLibraryW(path.c_str());
+#else
+	return ::dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+#endif
+}
+
+_Use_decl_annotations_
+void* FindSymbol(
+	void*       module,
+	const char* name)
+{
+#ifdef _WIN32
+	return reinterpret_cast<void*>(::GetProcAddress(static_cast<HMODULE>(module), name));
+#else
+	return ::dlsym(module, name);
+#endif
+}
+
+_Use_decl_annotations_
+void CloseLibrary(
+	void* module)
+{
+#ifdef _WIN32
+	(void)::FreeLibrary(static_cast<HMODULE>(module));
+#else
+	(void)::dlclose(module);
+#endif
+}
@@ -0,0 +1,206 @@
+/**
+ * @file PluginHost.h
+ * @brief Contains the declaration of the PluginHost class.
+ * @author Alessandro Bellia
+ * @date 10/15/2026
+ */
+
+#pragma once
+
+#include "Platform.h"
+#include "AdaptiveRate.h"
+#include "MetricPlugin.h"
+#include "MetricRegistry.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+
+/**
+ * @class PluginHost
+ * @brief Loads metric-provider plugins (see MetricPlugin.h) and samples them.
+ *
+ * Every plugin's metrics are registered as a run of consecutive ids, and its Sample() entry
+ * point is handed the registry's value slots for that run, so a sample crosses the ABI
+ * boundary without allocating or copying. Each call is timed with the TscClock; a plugin
+ * whose calls exceed the latency budget kMaxOverruns times in a row is disabled, its values
+ * are zeroed, and it is not called again until it is unloaded.
+ *
+ * The budget cannot cut a call short. Sample() runs inline on the sampler thread and the
+ * elapsed time is only checked once the call has returned, so a plugin that blocks holds up
+ * every source and plugin behind it for as long as it blocks, kMaxOverruns times before it
+ * is disabled, and one that never returns stalls the sampler for good. Plugins must not
+ * block; benchmarks/PluginBudgetTest.cpp pins this behavior down.
+ *
+ * Like the monitor's sources, each plugin is sampled at its own rate: an AdaptiveRate
+ * watches the plugin's first metric and stretches the interval while it is stable. The
+ * sampler's scheduler decides when each plugin is due.
+ *
+ * Loading, sampling and unloading belong to the sampler thread. The names, states and
+ * timings of loaded plugins can be read from any thread once loading is done.
+ */
+class PluginHost
+{
+public:
+	/**
+	 * @brief The most plugins loaded at once.
+	 */
+	static constexpr uint32_t kMaxPlugins = 16;
+
+	/**
+	 * @brief The longest a Sample() call may take when no other budget is set.
+	 */
+	static constexpr std::chrono::microseconds kDefaultBudget{1000};
+
+	/**
+	 * @brief The number of consecutive over-budget calls that disables a plugin; a single
+	 *		  late call is more likely a preemption than a slow plugin.
+	 */
+	static constexpr uint32_t kMaxOverruns = 3;
+
+	/**
+	 * @brief The size of a plugin's display name, including the terminator.
+	 */
+	static constexpr size_t kMaxNameLength = 64;
+
+	PluginHost() = default;
+	~PluginHost();
+
+	PluginHost(const PluginHost& other)            = delete;
+	PluginHost& operator=(const PluginHost& other) = delete;
+
+	/**
+	 * @brief Loads every plugin in a directory, in file name order, and registers their metrics.
+	 *		  Libraries that do not export the entry points, fail Init(), describe no metrics,
+	 *		  or describe a name that is already registered or repeated within the plugin are
+	 *		  skipped without registering any of their metrics.
+	 * @param[in] directory The directory to scan; a missing directory loads nothing.
+	 * @param[in,out] registry The registry the metrics are registered in and written to. It
+	 *				  must outlive the host.
+	 * @return The number of plugins loaded.
+	 */
+	uint32_t LoadDirectory(
+		_In_ const std::filesystem::path& directory,
+		_Inout_ MetricRegistry&           registry);
+
+	/**
+	 * @brief Calls Sample() on a plugin, disables it if it is over budget, and adapts its interval.
+	 * @param[in] index A plugin index below GetCount().
+	 * @return True if the plugin is still enabled, false if it is (or has just been) disabled.
+	 */
+	bool Sample(
+		_In_ uint32_t index);
+
+	/**
+	 * @brief Calls Shutdown() on every plugin and unloads it. Safe to call more than once.
+	 */
+	void UnloadAll();
+
+	/**
+	 * @brief Sets the latency budget of one Sample() call.
+	 * @param[in] budget The budget; takes effect from the next sample.
+	 */
+	void SetBudget(
+		_In_ std::chrono::nanoseconds budget) { m_budgetNs = budget.count(); }
+
+	/**
+	 * @brief Sets the range a plugin's sampling interval adapts within.
+	 * @param[in] index A plugin index below GetCount().
+	 * @param[in] minInterval The interval while the plugin's values are changing.
+	 * @param[in] maxInterval The interval once they have been stable for a while.
+	 */
+	void SetIntervalRange(
+		_In_ uint32_t                 index,
+		_In_ std::chrono::nanoseconds minInterval,
+		_In_ std::chrono::nanoseconds maxInterval) { m_plugins[index].rate.SetRange(minInterval, maxInterval); }
+
+	/**
+	 * @brief Gets the number of loaded plugins.
+	 * @return The plugin count; plugin indices run from 0 to GetCount() - 1.
+	 */
+	[[nodiscard]] uint32_t GetCount() const { return m_count; }
+
+	/**
+	 * @brief Gets the display name of a plugin, which is its file name.
+	 * @param[in] index A plugin index below GetCount().
+	 * @return The NUL-terminated name.
+	 */
+	[[nodiscard]] const char* GetName(
+		_In_ uint32_t index) const { return m_plugins[index].name; }
+
+	/**
+	 * @brief Checks whether a plugin is still sampled.
+	 * @param[in] index A plugin index below GetCount().
+	 * @return False once the plugin was disabled for exceeding its budget.
+	 */
+	[[nodiscard]] bool IsEnabled(
+		_In_ uint32_t index) const { return m_plugins[index].enabled.load(std::memory_order_relaxed); }
+
+	/**
+	 * @brief Gets the longest Sample() call of a plugin so far.
+	 * @param[in] index A plugin index below GetCount().
+	 * @return The duration in nanoseconds.
+	 */
+	[[nodiscard]] int64_t GetMaxSampleNs(
+		_In_ uint32_t index) const { return m_plugins[index].maxSampleNs.load(std::memory_order_relaxed); }
+
+	/**
+	 * @brief Gets the current sampling interval of a plugin.
+	 * @param[in] index A plugin index below GetCount().
+	 * @return The interval in nanoseconds.
+	 */
+	[[nodiscard]] int64_t GetIntervalNs(
+		_In_ uint32_t index) const { return m_plugins[index].rate.GetIntervalNs(); }
+
+	/**
+	 * @brief Gets the id of a plugin's first metric; its metrics have consecutive ids.
+	 * @param[in] index A plugin index below GetCount().
+	 * @return The metric id.
+	 */
+	[[nodiscard]] uint32_t GetFirstMetric(
+		_In_ uint32_t index) const { return m_plugins[index].firstMetric; }
+
+	/**
+	 * @brief Gets the number of metrics a plugin provides.
+	 * @param[in] index A plugin index below GetCount().
+	 * @return The metric count.
+	 */
+	[[nodiscard]] uint32_t GetMetricCount(
+		_In_ uint32_t index) const { return m_plugins[index].metricCount; }
+
+private:
+	/**
+	 * @struct Plugin
+	 * @brief A loaded plugin and its sampling state.
+	 */
+	struct Plugin
+	{
+		void*                       module;      ///< The HMODULE or dlopen() handle.
+		void*                       context;     ///< The state returned by Init().
+		PerfOverlayPluginSampleFn   sample;
+		PerfOverlayPluginShutdownFn shutdown;
+		float*                      values;      ///< The registry's slots for the plugin's metrics.
+		uint32_t                    firstMetric;
+		uint32_t                    metricCount;
+		AdaptiveRate                rate;
+		uint32_t                    overruns;    ///< Consecutive over-budget calls.
+		std::atomic<bool>           enabled;
+		std::atomic<int64_t>        maxSampleNs;
+		char                        name[kMaxNameLength];
+	};
+
+	/**
+	 * @brief Loads one plugin into the next free slot.
+	 * @param[in] path The library's path.
+	 * @param[in,out] registry The registry the metrics are registered in.
+	 * @return True if the plugin was loaded, false if it was skipped.
+	 */
+	bool Load(
+		_In_ const std::filesystem::path& path,
+		_Inout_ MetricRegistry&           registry);
+
+	Plugin          m_plugins[kMaxPlugins] = {};
+	uint32_t        m_count                = 0;
+	int64_t         m_budgetNs             = std::chrono::nanoseconds(kDefaultBudget).count();
+	MetricRegistry* m_pRegistry            = nullptr;
+};
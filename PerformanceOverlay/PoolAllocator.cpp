@@ -0,0 +1,184 @@
+/**
+ * @file PoolAllocator.cpp
+ * @brief Contains the implementation of the PoolAllocator class.
+ * @author Alessandro Bellia
+ * @date 10/15/2026
+ */
+
+#include "PoolAllocator.h"
+#include <cstdlib>
+
+/**
+ * @struct BlockHeader
+ * @brief Precedes every block handed out, so Free() knows where the block came from.
+ */
+struct alignas(16) BlockHeader
+{
+	uint32_t sizeClass; ///< kClassCount for blocks allocated straight from the heap
+	uint32_t reserved;
+	uint64_t size;      ///< The block size, rounded up to the size class for pooled blocks
+};
+
+static_assert(sizeof(BlockHeader) == 16, "Blocks must stay 16-byte aligned");
+
+/**
+ * @brief Gets the size class serving a request.
+ * @param[in] size The number of bytes requested, at most PoolAllocator::kMaxPooledSize.
+ * @return The index of the smallest class that fits.
+ */
+static uint32_t SizeClassOf(
+	_In_ size_t size);
+
+
+_Use_decl_annotations_
+PoolAllocator::PoolAllocator(
+	const MemoryAccounting::Subsystem subsystem)
+	: m_subsystem(subsystem),
+	  m_freeLists{},
+	  m_chunks(nullptr),
+	  m_bytesInUse(0),
+	  m_bytesReserved(0)
+{
+}
+
+PoolAllocator::~PoolAllocator()
+{
+	while (m_chunks)
+	{
+		Chunk* const next = m_chunks->next;
+		std::free(m_chunks);
+		m_chunks = next;
+		AccountReserved(-static_cast<ptrdiff_t>(kChunkSize));
+	}
+}
+
+_Use_decl_annotations_
+void* PoolAllocator::Allocate(
+	const size_t size)
+{
+	if (size > kMaxPooledSize)
+	{
+		auto* const header = static_cast<BlockHeader*>(std::malloc(sizeof(BlockHeader) + size));
+		if (!header)
+		{
+			return nullptr;
+		}
+
+		header->sizeClass = kClassCount;
+		header->size      = size;
+		m_bytesInUse += size;
+		AccountReserved(static_cast<ptrdiff_t>(sizeof(BlockHeader) + size));
+		return header + 1;
+	}
+
+	const uint32_t sizeClass = SizeClassOf(size);
+	if (!m_freeLists[sizeClass] && !Refill(sizeClass))
+	{
+		return nullptr;
+	}
+
+	void* const block      = m_freeLists[sizeClass];
+	m_freeLists[sizeClass] = *static_cast<void**>(block);
+	auto* const header     = static_cast<BlockHeader*>(block) - 1;
+	header->sizeClass      = sizeClass;
+	header->size           = size_t{16} << sizeClass;
+	m_bytesInUse += header->size;
+	return block;
+}
+
+_Use_decl_annotations_
+void PoolAllocator::Free(
+	void* ptr)
+{
+	if (!ptr)
+	{
+		return;
+	}
+
+	BlockHeader* const header = static_cast<BlockHeader*>(ptr) - 1;
+	m_bytesInUse -= header->size;
+
+	if (header->sizeClass == kClassCount)
+	{
+		AccountReserved(-static_cast<ptrdiff_t>(sizeof(BlockHeader) + header->size));
+		std::free(header);
+		return;
+	}
+
+	*static_cast<void**>(ptr)      = m_freeLists[header->sizeClass];
+	m_freeLists[header->sizeClass] = ptr;
+}
+
+_Use_decl_annotations_
+void* PoolAllocator::ImGuiAlloc(
+	const size_t size,
+	void*        userData)
+{
+	return static_cast<PoolAllocator*>(userData)->Allocate(size);
+}
+
+_Use_decl_annotations_
+void PoolAllocator::ImGuiFree(
+	void* ptr,
+	void* userData)
+{
+	static_cast<PoolAllocator*>(userData)->Free(ptr);
+}
+
+_Use_decl_annotations_
+bool PoolAllocator::Refill(
+	const uint32_t sizeClass)
+{
+	auto* const chunk = static_cast<Chunk*>(std::malloc(kChunkSize));
+	if (!chunk)
+	{
+		return false;
+	}
+	chunk->next = m_chunks;
+	m_chunks    = chunk;
+	AccountReserved(static_cast<ptrdiff_t>(kChunkSize));
+
+	// The chunk starts with its link, padded to a header's size; then come the slots, each
+	// a header followed by the block. Blocks are pushed so the list hands them out in order.
+	const size_t slotSize = sizeof(BlockHeader) + (size_t{16} << sizeClass);
+	char* const  first    = reinterpret_cast<char*>(chunk) + sizeof(BlockHeader);
+	const size_t slots    = (kChunkSize - sizeof(BlockHeader)) / slotSize;
+
+	void* list = m_freeLists[sizeClass];
+	for (size_t slot = slots; slot-- > 0;)
+	{
+		void* const block           = first + slot * slotSize + sizeof(BlockHeader);
+		*static_cast<void**>(block) = list;
+		list                        = block;
+	}
+	m_freeLists[sizeClass] = list;
+	return true;
+}
+
+_Use_decl_annotations_
+void PoolAllocator::AccountReserved(
+	const ptrdiff_t bytes)
+{
+	m_bytesReserved += bytes;
+	if (bytes >= 0)
+	{
+		MemoryAccounting::Add(m_subsystem, static_cast<size_t>(bytes));
+	}
+	else
+	{
+		MemoryAccounting::Remove(m_subsystem, static_cast<size_t>(-bytes));
+	}
+}
+
+
+_Use_decl_annotations_
+static uint32_t SizeClassOf(
+	const size_t size)
+{
+	uint32_t sizeClass = 0;
+	while ((size_t{16} << sizeClass) < size)
+	{
+		sizeClass++;
+	}
+	return sizeClass;
+}
@@ -0,0 +1,134 @@
+/**
+ * @file PoolAllocator.h
+ * @brief Contains the declaration of the PoolAllocator class.
+ * @author Alessandro Bellia
+ * @date 10/15/2026
+ */
+
+#pragma once
+
+#include "Platform.h"
+#include "MemoryAccounting.h"
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @class PoolAllocator
+ * @brief A size-class pool allocator, meant to back ImGui through ImGui::SetAllocatorFunctions().
+ *
+ * Requests up to kMaxPooledSize are rounded up to a power-of-two size class and served from
+ * that class's free list, which is refilled by carving fixed-size chunks. Freed blocks go
+ * back to their list and chunks are kept until the allocator is destroyed, so the steady
+ * churn of ImGui's small vectors reuses the same memory instead of fragmenting the heap.
+ * Larger requests (font atlas, big draw buffers) go straight to the heap.
+ *
+ * Every block carries a 16-byte header recording its size class, keeping the 16-byte
+ * alignment malloc provides. Not thread-safe: use it from the thread that owns the ImGui
+ * context.
+ */
+class PoolAllocator
+{
+public:
+	/**
+	 * @brief The number of size classes: 16, 32, ..., kMaxPooledSize bytes.
+	 */
+	static constexpr uint32_t kClassCount = 9;
+
+	/**
+	 * @brief The largest request served from the pools.
+	 */
+	static constexpr size_t kMaxPooledSize = size_t{16} << (kClassCount - 1);
+
+	/**
+	 * @brief The size of the chunks carved into blocks of one size class.
+	 */
+	static constexpr size_t kChunkSize = 16 * 1024;
+
+	/**
+	 * @brief Constructs an empty allocator.
+	 * @param[in] subsystem The subsystem the reserved memory is accounted to.
+	 */
+	explicit PoolAllocator(
+		_In_ MemoryAccounting::Subsystem subsystem);
+	~PoolAllocator();
+
+	PoolAllocator(const PoolAllocator& other)            = delete;
+	PoolAllocator& operator=(const PoolAllocator& other) = delete;
+
+	/**
+	 * @brief Allocates a block.
+	 * @param[in] size The number of bytes.
+	 * @return A 16-byte aligned block, or nullptr if the heap is exhausted.
+	 */
+	void* Allocate(
+		_In_ size_t size);
+
+	/**
+	 * @brief Returns a block to its pool, or to the heap if it was not pooled.
+	 * @param[in] ptr A block returned by Allocate(), or nullptr.
+	 */
+	void Free(
+		_In_opt_ void* ptr);
+
+	/**
+	 * @brief Gets the bytes currently handed out, rounded up to their size class.
+	 * @return The bytes in use.
+	 */
+	[[nodiscard]] size_t GetBytesInUse() const { return m_bytesInUse; }
+
+	/**
+	 * @brief Gets the bytes reserved from the heap: all chunks plus the unpooled blocks.
+	 * @return The bytes reserved.
+	 */
+	[[nodiscard]] size_t GetBytesReserved() const { return m_bytesReserved; }
+
+	/**
+	 * @brief ImGuiMemAllocFunc adapter.
+	 * @param[in] size The number of bytes.
+	 * @param[in] userData The PoolAllocator.
+	 * @return The allocated block.
+	 */
+	static void* ImGuiAlloc(
+		_In_ size_t size,
+		_In_ void*  userData);
+
+	/**
+	 * @brief ImGuiMemFreeFunc adapter.
+	 * @param[in] ptr The block to free, or nullptr.
+	 * @param[in] userData The PoolAllocator.
+	 */
+	static void ImGuiFree(
+		_In_opt_ void* ptr,
+		_In_ void*     userData);
+
+private:
+	/**
+	 * @struct Chunk
+	 * @brief A chunk carved into blocks, linked so it can be released on destruction.
+	 */
+	struct Chunk
+	{
+		Chunk* next;
+	};
+
+	/**
+	 * @brief Carves a new chunk into free blocks of one size class.
+	 * @param[in] sizeClass The size class to refill.
+	 * @return True if a chunk could be allocated, false otherwise.
+	 */
+	bool Refill(
+		_In_ uint32_t sizeClass);
+
+	/**
+	 * @brief Records bytes reserved from or released to the heap.
+	 * @param[in] bytes The byte count, positive when reserved.
+	 */
+	void AccountReserved(
+		_In_ ptrdiff_t bytes);
+
+	MemoryAccounting::Subsystem m_subsystem;
+	void*                       m_freeLists[kClassCount];
+	Chunk*                      m_chunks;
+	size_t                      m_bytesInUse;
+	size_t                      m_bytesReserved;
+};
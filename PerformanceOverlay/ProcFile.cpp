@@ -0,0 +1,206 @@
+/**
+ * @file ProcFile.cpp
+ * @brief Contains the implementation of the ProcFile and ProcParser classes.
+ * @author Alessandro Bellia
+ * @date 10/15/2026
+ */
+
+#ifdef __linux__
+
+#include "ProcFile.h"
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+
+ProcFile::~ProcFile()
+{
+	Close();
+}
+
+ProcFile::ProcFile(ProcFile&& other) noexcept
+	: m_fd(other.m_fd)
+{
+	other.m_fd = -1;
+}
+
+ProcFile& ProcFile::operator=(ProcFile&& other) noexcept
+{
+	if (this != &other)
+	{
+		Close();
+		m_fd       = other.m_fd;
+		other.m_fd = -1;
+	}
+	return *this;
+}
+
+_Use_decl_annotations_
+bool ProcFile::Open(
+	const char* path)
+{
+	Close();
+	m_fd = ::open(path, O_RDONLY | O_CLOEXEC);
+	return m_fd >= 0;
+}
+
+_Use_decl_annotations_
+bool ProcFile::OpenAt(
+	const int   dirFd,
+	const char* relativePath)
+{
+	Close();
+	m_fd = ::openat(dirFd, relativePath, O_RDONLY | O_CLOEXEC);
+	return m_fd >= 0;
+}
+
+void ProcFile::Close()
+{
+	if (m_fd >= 0)
+	{
+		::close(m_fd);
+		m_fd = -1;
+	}
+}
+
+_Use_decl_annotations_
+long ProcFile::Read(
+	char*        buffer,
+	const size_t size) const
+{
+	if (m_fd < 0 || size == 0)
+	{
+		return -1;
+	}
+
+	// procfs generates the whole text on the first read at offset 0, but may hand it
+	// back in page-sized pieces, so keep reading until EOF or the buffer is full.
+	size_t total = 0;
+	while (total < size - 1)
+	{
+		const ssize_t n = ::pread(m_fd, buffer + total, size - 1 - total, static_cast<off_t>(total));
+		if (n < 0)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+			return -1;
+		}
+		if (n == 0)
+		{
+			break;
+		}
+		total += static_cast<size_t>(n);
+	}
+
+	buffer[total] = '\0';
+	return static_cast<long>(total);
+}
+
+_Use_decl_annotations_
+long ProcFile::ReadOnce(
+	char*        buffer,
+	const size_t size) const
+{
+	if (m_fd < 0 || size == 0)
+	{
+		return -1;
+	}
+
+	ssize_t n;
+	do
+	{
+		n = ::pread(m_fd, buffer, size - 1, 0);
+	}
+	while (n < 0 && errno == EINTR);
+
+	if (n < 0)
+	{
+		return -1;
+	}
+
+	buffer[n] = '\0';
+	return static_cast<long>(n);
+}
+
+
+_Use_decl_annotations_
+bool ProcParser::StartsWith(
+	const char* prefix) const
+{
+	const char* p = m_cur;
+	while (*prefix != '\0')
+	{
+		if (p >= m_end || *p != *prefix)
+		{
+			return false;
+		}
+		++p;
+		++prefix;
+	}
+	return true;
+}
+
+void ProcParser::SkipLine()
+{
+	while (m_cur < m_end && *m_cur != '\n')
+	{
+		++m_cur;
+	}
+	if (m_cur < m_end)
+	{
+		++m_cur;
+	}
+}
+
+_Use_decl_annotations_
+void ProcParser::SkipTokens(
+	const int count)
+{
+	const char* token;
+	size_t      length;
+	for (int i = 0; i < count; i++)
+	{
+		if (!ReadToken(token, length))
+		{
+			return;
+		}
+	}
+}
+
+_Use_decl_annotations_
+bool ProcParser::ReadToken(
+	const char*& token,
+	size_t&      length)
+{
+	SkipBlanks();
+	token = m_cur;
+	while (m_cur < m_end && *m_cur != ' ' && *m_cur != '\t' && *m_cur != '\n')
+	{
+		++m_cur;
+	}
+	length = static_cast<size_t>(m_cur - token);
+	return length > 0;
+}
+
+uint64_t ProcParser::ReadU64()
+{
+	SkipBlanks();
+	uint64_t value = 0;
+	while (m_cur < m_end && *m_cur >= '0' && *m_cur <= '9')
+	{
+		value = value * 10 + static_cast<uint64_t>(*m_cur - '0');
+		++m_cur;
+	}
+	return value;
+}
+
+void ProcParser::SkipBlanks()
+{
+	while (m_cur < m_end && (*m_cur == ' ' || *m_cur == '\t'))
+	{
+		++m_cur;
+	}
+}
+
+#endif // __linux__
@@ -0,0 +1,165 @@
+/**
+ * @file ProcFile.h
+ * @brief Contains the declaration of the ProcFile and ProcParser classes used by the Linux collectors.
+ * @author Alessandro Bellia
+ * @date 10/15/2026
+ */
+
+#pragma once
+
+#include "Platform.h"
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @class ProcFile
+ * @brief Keeps a procfs/sysfs file open and re-reads it from offset zero with pread(),
+ *		  so refreshing a counter costs one syscall and no allocation.
+ */
+class ProcFile
+{
+public:
+	ProcFile() = default;
+	~ProcFile();
+
+	ProcFile(const ProcFile& other)            = delete;
+	ProcFile& operator=(const ProcFile& other) = delete;
+
+	ProcFile(ProcFile&& other) noexcept;
+	ProcFile& operator=(ProcFile&& other) noexcept;
+
+	/**
+	 * @brief Opens a file for reading, closing any previously opened one.
+	 * @param[in] path The absolute path of the file.
+	 * @return True if the file was opened, false otherwise.
+	 */
+	bool Open(
+		_In_z_ const char* path);
+
+	/**
+	 * @brief Opens a file relative to an already open directory descriptor.
+	 * @param[in] dirFd The directory descriptor the path is relative to.
+	 * @param[in] relativePath The path of the file relative to dirFd.
+	 * @return True if the file was opened, false otherwise.
+	 */
+	bool OpenAt(
+		_In_ int           dirFd,
+		_In_z_ const char* relativePath);
+
+	/**
+	 * @brief Closes the file descriptor, if any.
+	 */
+	void Close();
+
+	/**
+	 * @brief Reads the file from the beginning into a caller-provided buffer.
+	 * @param[out] buffer The destination buffer. It is always NUL-terminated on success.
+	 * @param[in] size The size of the destination buffer, including room for the terminator.
+	 * @return The number of bytes read, or -1 on failure.
+	 */
+	[[nodiscard]] long Read(
+		_Out_writes_(size) char* buffer,
+		_In_ size_t              size) const;
+
+	/**
+	 * @brief Reads the start of the file with a single pread(), for small files that procfs
+	 *		  generates whole on the first read, such as /proc/[pid]/stat. Saves Read()'s
+	 *		  extra call that only confirms EOF.
+	 * @param[out] buffer The destination buffer. It is always NUL-terminated on success.
+	 * @param[in] size The size of the destination buffer, including room for the terminator.
+	 * @return The number of bytes read, or -1 on failure.
+	 */
+	[[nodiscard]] long ReadOnce(
+		_Out_writes_(size) char* buffer,
+		_In_ size_t              size) const;
+
+	/**
+	 * @brief Checks whether the file is currently open.
+	 * @return True if a descriptor is held, false otherwise.
+	 */
+	[[nodiscard]] bool IsOpen() const { return m_fd >= 0; }
+
+private:
+	int m_fd = -1;
+};
+
+
+/**
+ * @class ProcParser
+ * @brief A minimal forward-only cursor over the text of a procfs file. It never allocates
+ *		  and never copies; tokens are returned as pointers into the source buffer.
+ */
+class ProcParser
+{
+public:
+	/**
+	 * @brief Constructs a parser over the given text range.
+	 * @param[in] begin The first character of the text.
+	 * @param[in] end One past the last character of the text.
+	 */
+	ProcParser(
+		_In_ const char* begin,
+		_In_ const char* end)
+		: m_cur(begin),
+		  m_end(end)
+	{
+	}
+
+	/**
+	 * @brief Checks whether the whole text has been consumed.
+	 * @return True if the cursor is at the end of the text.
+	 */
+	[[nodiscard]] bool AtEnd() const { return m_cur >= m_end; }
+
+	/**
+	 * @brief Checks whether the current line starts with the given prefix.
+	 * @param[in] prefix The NUL-terminated prefix to compare against.
+	 * @return True if the text at the cursor starts with prefix.
+	 */
+	[[nodiscard]] bool StartsWith(
+		_In_z_ const char* prefix) const;
+
+	/**
+	 * @brief Advances the cursor past the next newline.
+	 */
+	void SkipLine();
+
+	/**
+	 * @brief Advances the cursor past the given number of whitespace-separated tokens.
+	 * @param[in] count The number of tokens to skip.
+	 */
+	void SkipTokens(
+		_In_ int count);
+
+	/**
+	 * @brief Reads the next whitespace-separated token on the current line.
+	 * @param[out] token Receives a pointer to the first character of the token.
+	 * @param[out] length Receives the length of the token.
+	 * @return True if a token was found before the end of the line.
+	 */
+	_Success_(return)
+	bool ReadToken(
+		_Out_ const char*& token,
+		_Out_ size_t&      length);
+
+	/**
+	 * @brief Parses the next unsigned decimal number on the current line.
+	 * @return The parsed value, or 0 if no digits were found before the end of the line.
+	 */
+	uint64_t ReadU64();
+
+	/**
+	 * @brief Gets the current cursor position.
+	 * @return A pointer to the next unread character.
+	 */
+	[[nodiscard]] const char* Position() const { return m_cur; }
+
+private:
+	/**
+	 * @brief Advances the cursor past spaces and tabs, stopping at a newline.
+	 */
+	void SkipBlanks();
+
+	const char* m_cur;
+	const char* m_end;
+};
@@ -0,0 +1,212 @@
+/**
+ * @file ProcessPanel.cpp
+ * @brief Contains the implementation of the ProcessPanel class.
+ * @author Alessandro Bellia
+ * @date 10/16/2026
+ */
+
+#include "ProcessPanel.h"
+#include "imgui_internal.h"
+#include <algorithm>
+#include <cstring>
+
+
+/**
+ * @brief Above one displaced row in this many, a full sort is cheaper than a merge.
+ */
+static constexpr uint32_t kMaxDisplacedFraction = 4;
+
+
+_Use_decl_annotations_
+void ProcessPanel::Draw(
+	const ProcessSample* processes,
+	const uint32_t       count,
+	const uint64_t       listSequence,
+	const float          height)
+{
+	constexpr ImGuiTableFlags tableFlags =
+		ImGuiTableFlags_Sortable |
+		ImGuiTableFlags_ScrollY |
+		ImGuiTableFlags_RowBg |
+		ImGuiTableFlags_BordersInnerV |
+		ImGuiTableFlags_SizingFixedFit;
+
+	if (!ImGui::BeginTable("processes", ColumnCount, tableFlags, ImVec2(0.0f, height)))
+	{
+		return;
+	}
+
+	// Set up in Column order, so a column's index is also its sort id.
+	ImGui::TableSetupScrollFreeze(0, 1);
+	ImGui::TableSetupColumn("NAME", ImGuiTableColumnFlags_WidthStretch, 0.0f, ColumnName);
+	ImGui::TableSetupColumn("PID", ImGuiTableColumnFlags_WidthFixed, 0.0f, ColumnPid);
+	ImGui::TableSetupColumn("CPU %", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_DefaultSort |
+	                        ImGuiTableColumnFlags_PreferSortDescending, 0.0f, ColumnCpu);
+	ImGui::TableSetupColumn("MEM MB", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_PreferSortDescending, 0.0f, ColumnMemory);
+	ImGui::TableSetupColumn("IO KB/s", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_PreferSortDescending, 0.0f, ColumnIo);
+	ImGui::TableSetupColumn("WAIT %", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_PreferSortDescending, 0.0f, ColumnWait);
+	ImGui::TableSetupColumn("S", ImGuiTableColumnFlags_WidthFixed, 0.0f, ColumnState);
+	ImGui::TableHeadersRow();
+
+	// The overlay is click-through, so the tray menu sorts the table in place of a header click.
+	if (m_pendingSort)
+	{
+		ImGui::TableSetColumnSortDirection(m_sortColumn, m_ascending ? ImGuiSortDirection_Ascending : ImGuiSortDirection_Descending, false);
+		m_pendingSort = false;
+	}
+
+	bool                       newOrder = false;
+	ImGuiTableSortSpecs* const specs    = ImGui::TableGetSortSpecs();
+	if (specs && specs->SpecsDirty)
+	{
+		if (specs->SpecsCount > 0)
+		{
+			m_sortColumn = static_cast<Column>(specs->Specs[0].ColumnUserID);
+			m_ascending  = specs->Specs[0].SortDirection == ImGuiSortDirection_Ascending;
+		}
+		specs->SpecsDirty = false;
+		newOrder          = true;
+	}
+
+	if (newOrder || listSequence != m_listSequence || m_order.size() != count)
+	{
+		Sort(processes, count, newOrder);
+		m_listSequence = listSequence;
+	}
+
+	// Only the visible rows are submitted; the clipper accounts for the others with one
+	// cursor jump, so the cost does not depend on the number of processes.
+	ImGuiListClipper clipper;
+	clipper.Begin(static_cast<int>(count));
+	while (clipper.Step())
+	{
+		for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++)
+		{
+			const ProcessSample& process = processes[m_order[row]];
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			ImGui::TextUnformatted(process.name);
+			ImGui::TableNextColumn();
+			ImGui::Text("%u", process.pid);
+			ImGui::TableNextColumn();
+			ImGui::Text("%5.1f", process.cpu);
+			ImGui::TableNextColumn();
+			ImGui::Text("%8.1f", process.rssBytes / (1024.0 * 1024.0));
+			ImGui::TableNextColumn();
+			ImGui::Text("%8.0f", (process.readRate + process.writeRate) / 1024.0f);
+			ImGui::TableNextColumn();
+			ImGui::Text("%6.1f", process.wait);
+			ImGui::TableNextColumn();
+			ImGui::Text("%c", process.state ? process.state : ' ');
+		}
+	}
+
+	ImGui::EndTable();
+}
+
+_Use_decl_annotations_
+void ProcessPanel::SetSort(
+	const Column column,
+	const bool   ascending)
+{
+	m_sortColumn  = column;
+	m_ascending   = ascending;
+	m_pendingSort = true;
+}
+
+_Use_decl_annotations_
+void ProcessPanel::Sort(
+	const ProcessSample* processes,
+	const uint32_t       count,
+	const bool           full)
+{
+	// Start from the previous order: rows past the end of a shorter list are dropped and the
+	// new rows of a longer one appended, which keeps it a permutation of the list.
+	if (m_order.size() > count)
+	{
+		std::erase_if(m_order, [count](const uint32_t index) { return index >= count; });
+	}
+	for (auto index = static_cast<uint32_t>(m_order.size()); index < count; index++)
+	{
+		m_order.push_back(index);
+	}
+
+	const auto less = [this, processes](const uint32_t a, const uint32_t b)
+	{
+		return Less(processes[a], processes[b]);
+	};
+
+	if (!full)
+	{
+		// One pass splits the rows into an ordered run and the rows that broke it. A row out
+		// of order with the last kept one lifts out whichever of the two is the outlier, so a
+		// single row that jumped does not displace everything after it.
+		m_kept.clear();
+		m_displaced.clear();
+		for (const uint32_t index : m_order)
+		{
+			if (m_kept.empty() || !less(index, m_kept.back()))
+			{
+				m_kept.push_back(index);
+			}
+			else if (m_kept.size() >= 2 && !less(index, m_kept[m_kept.size() - 2]))
+			{
+				m_displaced.push_back(m_kept.back());
+				m_kept.back() = index;
+			}
+			else
+			{
+				m_displaced.push_back(index);
+			}
+		}
+
+		if (m_displaced.size() <= count / kMaxDisplacedFraction)
+		{
+			std::sort(m_displaced.begin(), m_displaced.end(), less);
+			std::merge(m_kept.begin(), m_kept.end(), m_displaced.begin(), m_displaced.end(), m_order.begin(), less);
+			++m_mergeSorts;
+			return;
+		}
+	}
+
+	std::sort(m_order.begin(), m_order.end(), less);
+	++m_fullSorts;
+}
+
+_Use_decl_annotations_
+bool ProcessPanel::Less(
+	const ProcessSample& a,
+	const ProcessSample& b) const
+{
+	int order = 0;
+	switch (m_sortColumn)
+	{
+	case ColumnName:
+		order = std::strcmp(a.name, b.name);
+		break;
+	case ColumnCpu:
+		order = a.cpu < b.cpu ? -1 : a.cpu > b.cpu ? 1 : 0;
+		break;
+	case ColumnMemory:
+		order = a.rssBytes < b.rssBytes ? -1 : a.rssBytes > b.rssBytes ? 1 : 0;
+		break;
+	case ColumnIo:
+		order = a.readRate + a.writeRate < b.readRate + b.writeRate ? -1 : a.readRate + a.writeRate > b.readRate + b.writeRate ? 1 : 0;
+		break;
+	case ColumnWait:
+		order = a.wait < b.wait ? -1 : a.wait > b.wait ? 1 : 0;
+		break;
+	case ColumnState:
+		order = a.state - b.state;
+		break;
+	default:
+		break;
+	}
+
+	// Ties keep pid order, so equal rows do not trade places from one list to the next.
+	if (order == 0)
+	{
+		return m_ascending || m_sortColumn != ColumnPid ? a.pid < b.pid : a.pid > b.pid;
+	}
+	return m_ascending ? order < 0 : order > 0;
+}
@@ -0,0 +1,126 @@
+/**
+ * @file ProcessPanel.h
+ * @brief Contains the declaration of the ProcessPanel class.
+ * @author Alessandro Bellia
+ * @date 10/16/2026
+ */
+
+#pragma once
+
+#include "Platform.h"
+#include "ProcessTable.h"
+#include "imgui.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class ProcessPanel
+ * @brief Draws the full process list as a sortable ImGui table whose cost does not grow with
+ *		  the number of processes.
+ *
+ * Rows are laid out through an ImGuiListClipper, so only the rows inside the table's
+ * scrolling region are submitted and formatted; the rest only cost their share of the
+ * scrollbar. The rows are shown through a permutation of indices into the published list,
+ * which is kept across lists: the process table updates its entries in place, so the index
+ * of a process rarely changes between two scans, and the previous order is already nearly
+ * sorted for the new values. Re-sorting lifts out the few rows that broke the order, sorts
+ * only those and merges them back, in O(n + k log k) for k displaced rows; a new sort
+ * column, or a list that changed too much, falls back to a full sort. Nothing is sorted on
+ * frames where neither the list nor the sort order changed.
+ */
+class ProcessPanel
+{
+public:
+	/**
+	 * @brief The table's columns, also used as their sort ids.
+	 */
+	enum Column : int
+	{
+		ColumnName = 0,
+		ColumnPid,
+		ColumnCpu,
+		ColumnMemory,
+		ColumnIo,
+		ColumnWait,
+		ColumnState,
+		ColumnCount
+	};
+
+	ProcessPanel() = default;
+
+	ProcessPanel(const ProcessPanel& other)            = delete;
+	ProcessPanel& operator=(const ProcessPanel& other) = delete;
+
+	/**
+	 * @brief Draws the table into the current window.
+	 * @param[in] processes The process list.
+	 * @param[in] count The number of processes.
+	 * @param[in] listSequence Changes whenever the list does; the rows are only re-sorted then.
+	 * @param[in] height The height of the table, including its header row.
+	 */
+	void Draw(
+		_In_reads_(count) const ProcessSample* processes,
+		_In_ uint32_t                          count,
+		_In_ uint64_t                          listSequence,
+		_In_ float                             height);
+
+	/**
+	 * @brief Sorts the table by a column, as clicking its header would. Applied by the next Draw().
+	 * @param[in] column The column.
+	 * @param[in] ascending True for ascending order, false for descending.
+	 */
+	void SetSort(
+		_In_ Column column,
+		_In_ bool   ascending);
+
+	/**
+	 * @brief Gets the column the table is sorted by.
+	 * @return The column.
+	 */
+	[[nodiscard]] Column GetSortColumn() const { return m_sortColumn; }
+
+	/**
+	 * @brief Gets the number of times the rows were sorted from scratch.
+	 * @return The count.
+	 */
+	[[nodiscard]] uint64_t GetFullSortCount() const { return m_fullSorts; }
+
+	/**
+	 * @brief Gets the number of times a new list was merged into the previous order.
+	 * @return The count.
+	 */
+	[[nodiscard]] uint64_t GetMergeSortCount() const { return m_mergeSorts; }
+
+private:
+	/**
+	 * @brief Brings the row order up to date with a new list or a new sort order.
+	 * @param[in] processes The process list.
+	 * @param[in] count The number of processes.
+	 * @param[in] full True to sort from scratch instead of merging into the previous order.
+	 */
+	void Sort(
+		_In_reads_(count) const ProcessSample* processes,
+		_In_ uint32_t                          count,
+		_In_ bool                              full);
+
+	/**
+	 * @brief Compares two processes under the current sort order, breaking ties by pid.
+	 * @param[in] a The first process.
+	 * @param[in] b The second process.
+	 * @return True if a goes before b.
+	 */
+	[[nodiscard]] bool Less(
+		_In_ const ProcessSample& a,
+		_In_ const ProcessSample& b) const;
+
+	std::vector<uint32_t> m_order;     ///< Row index -> index in the list.
+	std::vector<uint32_t> m_kept;      ///< Scratch: the rows still in order.
+	std::vector<uint32_t> m_displaced; ///< Scratch: the rows that broke the order.
+
+	Column   m_sortColumn   = ColumnCpu;
+	bool     m_ascending    = false;
+	bool     m_pendingSort  = false; ///< SetSort() was called since the last Draw().
+	uint64_t m_listSequence = 0;
+	uint64_t m_fullSorts    = 0;
+	uint64_t m_mergeSorts   = 0;
+};
@@ -0,0 +1,703 @@
+/**
+ * @file ProcessTable.cpp
+ * @brief Contains the platform-independent part of the ProcessTable class and its
+ *		  NtQuerySystemInformation-based Windows scan.
+ * @author Alessandro Bellia
+ * @date 10/16/2026
+ */
+
+#include "ProcessTable.h"
+#include "TscClock.h"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <numeric>
+
+
+/**
+ * @brief The smallest pid index, in slots.
+ */
+static constexpr size_t kMinIndexSize = 1024;
+
+
+template <typename Less>
+_Use_decl_annotations_
+uint32_t ProcessTable::SelectTop(
+	Less           less,
+	ProcessSample* top)
+{
+	const uint32_t entryCount = GetCount();
+	const uint32_t count      = std::min(kTopCount, entryCount);
+
+	// O(n log k): only the first kTopCount positions end up ordered.
+	m_order.resize(entryCount);
+	std::iota(m_order.begin(), m_order.end(), 0u);
+	std::partial_sort(m_order.begin(), m_order.begin() + count, m_order.end(), less);
+
+	for (uint32_t i = 0; i < count; i++)
+	{
+		CopySample(m_order[i], top[i]);
+	}
+	return count;
+}
+
+_Use_decl_annotations_
+bool ProcessTable::Update(
+	const int64_t deadlineNs)
+{
+	// The CPU time deltas are turned into a share of all CPUs over the wall time since the
+	// previous scan, like the overlay's own CPU usage. A sliced scan reads each process at
+	// about the same point of every pass, so the passes' start times are the interval.
+	if (!m_scanning)
+	{
+		const int64_t nowNs = TscClock::NowNs();
+		m_cpuScale          = m_prevScanNs != 0 && nowNs > m_prevScanNs && m_cpuCount > 0
+			                      ? static_cast<float>(100.0 * 1e9 / (static_cast<double>(m_ticksPerSecond) *
+			                                                          static_cast<double>(nowNs - m_prevScanNs) * m_cpuCount))
+			                      : 0.0f;
+		m_rateScale   = m_prevScanNs != 0 && nowNs > m_prevScanNs ? static_cast<float>(1e9 / static_cast<double>(nowNs - m_prevScanNs)) : 0.0f;
+		m_scanStartNs = nowNs;
+		++m_scan;
+	}
+
+	// A failed or unfinished scan would sweep the processes it did not get to, so it changes nothing else.
+	if (!Scan(deadlineNs) || m_scanning)
+	{
+		return false;
+	}
+
+	Sweep();
+	m_prevScanNs    = m_scanStartNs;
+	m_prevScanClock = m_scanClock;
+
+	m_topCpuCount = SelectTop([this](const uint32_t a, const uint32_t b)
+	{
+		return m_cpu[a] != m_cpu[b] ? m_cpu[a] > m_cpu[b] : m_pids[a] < m_pids[b];
+	}, m_topCpu);
+	while (m_topCpuCount > 0 && m_topCpu[m_topCpuCount - 1].cpu <= 0.0f)
+	{
+		--m_topCpuCount; // Idle processes are not consumers
+	}
+	m_topRssCount = SelectTop([this](const uint32_t a, const uint32_t b)
+	{
+		return m_rssBytes[a] != m_rssBytes[b] ? m_rssBytes[a] > m_rssBytes[b] : m_pids[a] < m_pids[b];
+	}, m_topRss);
+	m_topIoCount = SelectTop([this](const uint32_t a, const uint32_t b)
+	{
+		const float ioA = m_readRates[a] + m_writeRates[a];
+		const float ioB = m_readRates[b] + m_writeRates[b];
+		return ioA != ioB ? ioA > ioB : m_pids[a] < m_pids[b];
+	}, m_topIo);
+	while (m_topIoCount > 0 && m_topIo[m_topIoCount - 1].readRate + m_topIo[m_topIoCount - 1].writeRate <= 0.0f)
+	{
+		--m_topIoCount;
+	}
+	m_topWaitCount = SelectTop([this](const uint32_t a, const uint32_t b)
+	{
+		return m_waits[a] != m_waits[b] ? m_waits[a] > m_waits[b] : m_pids[a] < m_pids[b];
+	}, m_topWait);
+	while (m_topWaitCount > 0 && m_topWait[m_topWaitCount - 1].wait <= 0.0f)
+	{
+		--m_topWaitCount;
+	}
+
+	m_ioDeniedCount = static_cast<uint32_t>(std::count(m_ioDenied.begin(), m_ioDenied.end(), 1));
+	return true;
+}
+
+_Use_decl_annotations_
+void ProcessTable::CopySamples(
+	std::vector<ProcessSample>& samples) const
+{
+	samples.resize(m_pids.size());
+	for (uint32_t i = 0; i < GetCount(); i++)
+	{
+		CopySample(i, samples[i]);
+	}
+}
+
+_Use_decl_annotations_
+const char* ProcessTable::GetExecutable(
+	const uint32_t pid) const
+{
+	const uint32_t slot = FindEntry(pid);
+	return m_strings.Get(slot != 0 ? m_executableIds[slot - 1] : StringInterner::kEmpty);
+}
+
+_Use_decl_annotations_
+const char* ProcessTable::GetCommandLine(
+	const uint32_t pid) const
+{
+	const uint32_t slot = FindEntry(pid);
+	return m_strings.Get(slot != 0 ? m_commandLineIds[slot - 1] : StringInterner::kEmpty);
+}
+
+size_t ProcessTable::GetMemoryFootprint() const
+{
+	const size_t columns = m_pids.capacity() * sizeof(uint32_t) + m_scans.capacity() * sizeof(uint32_t) +
+		m_startTimes.capacity() * sizeof(uint64_t) + m_cpuTimes.capacity() * sizeof(uint64_t) +
+		m_rssBytes.capacity() * sizeof(uint64_t) + m_cpu.capacity() * sizeof(float) + m_states.capacity() +
+		(m_readBytes.capacity() + m_writeBytes.capacity() + m_syscalls.capacity()) * sizeof(uint64_t) +
+		(m_readRates.capacity() + m_writeRates.capacity() + m_syscallRates.capacity()) * sizeof(float) +
+		m_ioDenied.capacity() + m_commandPending.capacity() + m_runDelays.capacity() * sizeof(uint64_t) + m_waits.capacity() * sizeof(float) +
+		(m_nameIds.capacity() + m_executableIds.capacity() + m_commandLineIds.capacity()) * sizeof(uint32_t);
+	size_t scratch = m_buffer.capacity() + m_text.capacity() +
+		m_cpuRunDelays.capacity() * sizeof(uint64_t) + m_cpuWaits.capacity() * sizeof(float);
+#ifdef _WIN32
+	scratch += m_wideText.capacity() * sizeof(WCHAR);
+#else
+	scratch += m_schedstatText.capacity();
+#endif
+	return sizeof(*this) + columns + m_strings.GetMemoryFootprint() +
+		(m_index.capacity() + m_order.capacity()) * sizeof(uint32_t) + scratch;
+}
+
+_Use_decl_annotations_
+bool ProcessTable::Record(
+	const uint32_t pid,
+	const uint64_t startTime,
+	const uint64_t cpuTime,
+	const uint64_t rssBytes,
+	const char     state,
+	const char*    name,
+	const size_t   nameLength,
+	uint32_t&      index)
+{
+	uint32_t&  slot  = FindSlot(pid);
+	const bool found = slot != 0;
+	if (!found)
+	{
+		AppendEntry(pid);
+		slot = GetCount();
+	}
+	index = slot - 1;
+
+	uint64_t baseline   = m_cpuTimes[index];
+	bool     newCommand = !found;
+	if (!found || m_startTimes[index] != startTime)
+	{
+		m_reusedPids += found ? 1 : 0;
+		newCommand = true;
+
+		// A process started since the previous scan spent all of its CPU time, I/O and waits
+		// within the interval; one that was already running when first seen has no usable baseline.
+		const bool startedInInterval = m_prevScanClock != 0 && startTime > m_prevScanClock;
+		baseline                     = startedInInterval ? 0 : cpuTime;
+		m_readBytes[index]           = startedInInterval ? 0 : kNoBaseline;
+		m_writeBytes[index]          = 0;
+		m_syscalls[index]            = 0;
+		m_runDelays[index]           = startedInInterval ? 0 : kNoBaseline;
+		m_startTimes[index]          = startTime;
+	}
+
+	m_cpu[index]      = cpuTime >= baseline ? static_cast<float>(cpuTime - baseline) * m_cpuScale : 0.0f;
+	m_cpuTimes[index] = cpuTime;
+	m_rssBytes[index] = rssBytes;
+	m_states[index]   = state;
+	m_scans[index]    = m_scan;
+
+	// Until RecordIo() and RecordWait() say otherwise, the process did no I/O and did not wait.
+	m_readRates[index]    = 0.0f;
+	m_writeRates[index]   = 0.0f;
+	m_syscallRates[index] = 0.0f;
+	m_waits[index]        = 0.0f;
+
+	// exec() keeps the pid and start time but renames the process. The name is compared in
+	// place, so a process that kept its name costs no copy and no lookup.
+	if (newCommand || !m_strings.Equals(m_nameIds[index], name, nameLength))
+	{
+		const uint32_t nameId = m_strings.Intern(name, nameLength);
+		m_strings.Release(m_nameIds[index]);
+		m_nameIds[index] = nameId;
+		newCommand       = true;
+	}
+
+	// exec() can also change the credentials the io file is checked against.
+	if (newCommand)
+	{
+		m_ioDenied[index] = 0;
+	}
+
+	if (!found && m_pids.size() * 2 > m_index.size())
+	{
+		RebuildIndex();
+	}
+	return newCommand;
+}
+
+_Use_decl_annotations_
+void ProcessTable::RecordIo(
+	const uint32_t index,
+	const uint64_t readBytes,
+	const uint64_t writeBytes,
+	const uint64_t syscalls)
+{
+	// Counters only grow for the life of a process, so a lower value is a missed reset.
+	if (m_readBytes[index] != kNoBaseline && readBytes >= m_readBytes[index] &&
+		writeBytes >= m_writeBytes[index] && syscalls >= m_syscalls[index])
+	{
+		m_readRates[index]    = static_cast<float>(readBytes - m_readBytes[index]) * m_rateScale;
+		m_writeRates[index]   = static_cast<float>(writeBytes - m_writeBytes[index]) * m_rateScale;
+		m_syscallRates[index] = static_cast<float>(syscalls - m_syscalls[index]) * m_rateScale;
+	}
+	m_readBytes[index]  = readBytes;
+	m_writeBytes[index] = writeBytes;
+	m_syscalls[index]   = syscalls;
+}
+
+_Use_decl_annotations_
+void ProcessTable::RecordWait(
+	const uint32_t index,
+	const uint64_t runDelayNs)
+{
+	// Nanoseconds per second of wall time, as a percentage.
+	if (m_runDelays[index] != kNoBaseline && runDelayNs >= m_runDelays[index])
+	{
+		m_waits[index] = static_cast<float>(runDelayNs - m_runDelays[index]) * m_rateScale * 1e-7f;
+	}
+	m_runDelays[index] = runDelayNs;
+}
+
+_Use_decl_annotations_
+void ProcessTable::SetCommand(
+	const uint32_t index,
+	const char*    executable,
+	const size_t   executableLength,
+	const char*    commandLine,
+	const size_t   commandLineLength)
+{
+	// Interned before the old strings are released, so an unchanged path is not freed and re-added.
+	const uint32_t executableId  = m_strings.Intern(executable, executableLength);
+	const uint32_t commandLineId = m_strings.Intern(commandLine, commandLineLength);
+	m_strings.Release(m_executableIds[index]);
+	m_strings.Release(m_commandLineIds[index]);
+	m_executableIds[index]  = executableId;
+	m_commandLineIds[index] = commandLineId;
+}
+
+_Use_decl_annotations_
+void ProcessTable::AppendEntry(
+	const uint32_t pid)
+{
+	m_pids.push_back(pid);
+	m_scans.push_back(0);
+	m_startTimes.push_back(0);
+	m_cpuTimes.push_back(0);
+	m_rssBytes.push_back(0);
+	m_cpu.push_back(0.0f);
+	m_states.push_back('\0');
+	m_readBytes.push_back(kNoBaseline);
+	m_writeBytes.push_back(0);
+	m_syscalls.push_back(0);
+	m_readRates.push_back(0.0f);
+	m_writeRates.push_back(0.0f);
+	m_syscallRates.push_back(0.0f);
+	m_ioDenied.push_back(0);
+	m_commandPending.push_back(0);
+	m_runDelays.push_back(kNoBaseline);
+	m_waits.push_back(0.0f);
+	m_nameIds.push_back(StringInterner::kEmpty);
+	m_executableIds.push_back(StringInterner::kEmpty);
+	m_commandLineIds.push_back(StringInterner::kEmpty);
+}
+
+_Use_decl_annotations_
+void ProcessTable::RemoveEntry(
+	const uint32_t index)
+{
+	m_strings.Release(m_nameIds[index]);
+	m_strings.Release(m_executableIds[index]);
+	m_strings.Release(m_commandLineIds[index]);
+
+	const auto moveLast = [index](auto& column)
+	{
+		column[index] = column.back();
+		column.pop_back();
+	};
+	moveLast(m_pids);
+	moveLast(m_scans);
+	moveLast(m_startTimes);
+	moveLast(m_cpuTimes);
+	moveLast(m_rssBytes);
+	moveLast(m_cpu);
+	moveLast(m_states);
+	moveLast(m_readBytes);
+	moveLast(m_writeBytes);
+	moveLast(m_syscalls);
+	moveLast(m_readRates);
+	moveLast(m_writeRates);
+	moveLast(m_syscallRates);
+	moveLast(m_ioDenied);
+	moveLast(m_commandPending);
+	moveLast(m_runDelays);
+	moveLast(m_waits);
+	moveLast(m_nameIds);
+	moveLast(m_executableIds);
+	moveLast(m_commandLineIds);
+}
+
+_Use_decl_annotations_
+void ProcessTable::CopySample(
+	const uint32_t index,
+	ProcessSample& sample) const
+{
+	sample.pid         = m_pids[index];
+	sample.cpu         = m_cpu[index];
+	sample.rssBytes    = m_rssBytes[index];
+	sample.readRate    = m_readRates[index];
+	sample.writeRate   = m_writeRates[index];
+	sample.syscallRate = m_syscallRates[index];
+	sample.wait        = m_waits[index];
+	sample.state       = m_states[index];
+
+	const uint32_t nameId = m_nameIds[index];
+	const size_t   length = std::min<size_t>(m_strings.GetLength(nameId), sizeof(sample.name) - 1);
+	std::memcpy(sample.name, m_strings.Get(nameId), length);
+	sample.name[length] = '\0';
+}
+
+_Use_decl_annotations_
+uint32_t ProcessTable::FindEntry(
+	const uint32_t pid) const
+{
+	const size_t mask = m_index.size() - 1;
+	for (size_t i = (pid * 2654435761u) >> m_indexShift;; i = (i + 1) & mask)
+	{
+		const uint32_t slot = m_index[i];
+		if (slot == 0 || m_pids[slot - 1] == pid)
+		{
+			return slot;
+		}
+	}
+}
+
+void ProcessTable::Sweep()
+{
+	bool removed = false;
+	for (uint32_t i = 0; i < GetCount();)
+	{
+		if (m_scans[i] != m_scan)
+		{
+			RemoveEntry(i);
+			removed = true;
+		}
+		else
+		{
+			++i;
+		}
+	}
+
+	// Moving entries changes their indices, and open addressing cannot simply clear a slot,
+	// so the index is rebuilt; that is one pass over the table and no syscalls.
+	if (removed)
+	{
+		RebuildIndex();
+	}
+}
+
+void ProcessTable::RebuildIndex()
+{
+	// Rebuilt at most a quarter full, so it grows again only after the table doubles.
+	size_t size = kMinIndexSize;
+	while (size < m_pids.size() * 4)
+	{
+		size *= 2;
+	}
+
+	m_index.assign(size, 0);
+	m_indexShift = 32 - static_cast<uint32_t>(std::countr_zero(size));
+	for (uint32_t i = 0; i < GetCount(); i++)
+	{
+		FindSlot(m_pids[i]) = i + 1;
+	}
+}
+
+_Use_decl_annotations_
+uint32_t& ProcessTable::FindSlot(
+	const uint32_t pid)
+{
+	// Fibonacci hashing spreads the mostly sequential pids over the whole index.
+	const size_t mask = m_index.size() - 1;
+	for (size_t i = (pid * 2654435761u) >> m_indexShift;; i = (i + 1) & mask)
+	{
+		uint32_t& slot = m_index[i];
+		if (slot == 0 || m_pids[slot - 1] == pid)
+		{
+			return slot;
+		}
+	}
+}
+
+
+#ifdef _WIN32
+
+/**
+ * @brief The size the process list buffer starts at; it grows to fit the list.
+ */
+static constexpr size_t kInitialBufferSize = 256 * 1024;
+
+/**
+ * @brief The SYSTEM_INFORMATION_CLASS of the process list.
+ */
+static constexpr ULONG kSystemProcessInformation = 5;
+
+/**
+ * @brief STATUS_INFO_LENGTH_MISMATCH, returned while the buffer is too small.
+ */
+static constexpr LONG kStatusInfoLengthMismatch = static_cast<LONG>(0xC0000004);
+
+/**
+ * @brief The PROCESSINFOCLASS of a process's command line, a UNICODE_STRING (Windows 8.1 and later).
+ */
+static constexpr ULONG kProcessCommandLineInformation = 60;
+
+/**
+ * @brief The most of an executable path or command line that is kept, in UTF-16 units.
+ */
+static constexpr size_t kCommandBufferLength = 4096;
+
+/**
+ * @struct CommandLineInformation
+ * @brief Mirrors UNICODE_STRING, followed by the characters it points to.
+ */
+struct CommandLineInformation
+{
+	USHORT length; ///< In bytes.
+	USHORT maximumLength;
+	PWSTR  buffer;
+};
+
+/**
+ * @struct ProcessInformation
+ * @brief Mirrors the documented prefix of SYSTEM_PROCESS_INFORMATION from winternl.h, with
+ *		  the reserved fields named, up to the I/O counters.
+ */
+struct ProcessInformation
+{
+	ULONG         nextEntryOffset;
+	ULONG         numberOfThreads;
+	LARGE_INTEGER workingSetPrivateSize;
+	ULONG         hardFaultCount;
+	ULONG         numberOfThreadsHighWatermark;
+	ULONGLONG     cycleTime;
+	LARGE_INTEGER createTime;
+	LARGE_INTEGER userTime;
+	LARGE_INTEGER kernelTime;
+	USHORT        imageNameLength; ///< In bytes.
+	USHORT        imageNameMaximumLength;
+	PWSTR         imageNameBuffer;
+	LONG          basePriority;
+	HANDLE        uniqueProcessId;
+	HANDLE        inheritedFromUniqueProcessId;
+	ULONG         handleCount;
+	ULONG         sessionId;
+	ULONG_PTR     uniqueProcessKey;
+	SIZE_T        peakVirtualSize;
+	SIZE_T        virtualSize;
+	ULONG         pageFaultCount;
+	SIZE_T        peakWorkingSetSize;
+	SIZE_T        workingSetSize;
+	SIZE_T        quotaPeakPagedPoolUsage;
+	SIZE_T        quotaPagedPoolUsage;
+	SIZE_T        quotaPeakNonPagedPoolUsage;
+	SIZE_T        quotaNonPagedPoolUsage;
+	SIZE_T        pagefileUsage;
+	SIZE_T        peakPagefileUsage;
+	SIZE_T        privatePageCount;
+	LARGE_INTEGER readOperationCount;
+	LARGE_INTEGER writeOperationCount;
+	LARGE_INTEGER otherOperationCount;
+	LARGE_INTEGER readTransferCount;
+	LARGE_INTEGER writeTransferCount;
+	LARGE_INTEGER otherTransferCount;
+};
+
+
+ProcessTable::ProcessTable()
+	: m_indexShift(0),
+	  m_topCpu{},
+	  m_topRss{},
+	  m_topIo{},
+	  m_topWait{},
+	  m_topCpuCount(0),
+	  m_topRssCount(0),
+	  m_topIoCount(0),
+	  m_topWaitCount(0),
+	  m_ioDeniedCount(0),
+	  m_runQueueWait(0.0f),
+	  m_scan(0),
+	  m_scanning(false),
+	  m_scanStartNs(0),
+	  m_cpuCount(0),
+	  m_ticksPerSecond(10'000'000),
+	  m_scanClock(0),
+	  m_prevScanClock(0),
+	  m_prevScanNs(0),
+	  m_cpuScale(0.0f),
+	  m_rateScale(0.0f),
+	  m_reusedPids(0),
+	  m_pNtQuerySystemInformation(nullptr),
+	  m_pNtQueryInformationProcess(nullptr)
+{
+	RebuildIndex();
+}
+
+ProcessTable::~ProcessTable()
+{
+	Close();
+}
+
+bool ProcessTable::Open()
+{
+	const HMODULE hNtdll = ::GetModuleHandleW(L"ntdll.dll");
+	if (!hNtdll)
+	{
+		return false;
+	}
+
+	m_pNtQuerySystemInformation = reinterpret_cast<NtQuerySystemInformationFn>(
+		::GetProcAddress(hNtdll, "NtQuerySystemInformation"));
+	m_pNtQueryInformationProcess = reinterpret_cast<NtQueryInformationProcessFn>(
+		::GetProcAddress(hNtdll, "NtQueryInformationProcess"));
+	m_cpuCount = ::GetActiveProcessorCount(ALL_PROCESSOR_GROUPS);
+	m_buffer.resize(kInitialBufferSize);
+	m_wideText.resize(kCommandBufferLength);
+	m_text.resize(kCommandBufferLength * 3 * 2); // Two halves, each fitting a whole buffer in UTF-8
+	return m_pNtQuerySystemInformation != nullptr;
+}
+
+void ProcessTable::Close()
+{
+	m_pNtQuerySystemInformation  = nullptr;
+	m_pNtQueryInformationProcess = nullptr;
+}
+
+_Use_decl_annotations_
+bool ProcessTable::Scan(
+	const int64_t deadlineNs)
+{
+	// One call returns the whole list, so there is no pass to slice.
+	(void)deadlineNs;
+	if (!m_pNtQuerySystemInformation)
+	{
+		return false;
+	}
+
+	// CreateTime is a FILETIME, so "now" is one too.
+	FILETIME now;
+	::GetSystemTimeAsFileTime(&now);
+	m_scanClock = static_cast<uint64_t>(now.dwHighDateTime) << 32 | now.dwLowDateTime;
+
+	// The whole list comes back in one call. The buffer is kept, and grown with some
+	// headroom when processes start between the size query and the retry.
+	LONG status = kStatusInfoLengthMismatch;
+	for (int attempt = 0; attempt < 4 && status == kStatusInfoLengthMismatch; attempt++)
+	{
+		ULONG returned = 0;
+		status         = m_pNtQuerySystemInformation(kSystemProcessInformation, m_buffer.data(),
+		                                             static_cast<ULONG>(m_buffer.size()), &returned);
+		if (status == kStatusInfoLengthMismatch)
+		{
+			m_buffer.resize(std::max<size_t>(returned + returned / 4, m_buffer.size() * 2));
+		}
+	}
+	if (status < 0)
+	{
+		return false;
+	}
+
+	char        name[sizeof(ProcessSample::name)];
+	const char* pCursor = m_buffer.data();
+	for (;;)
+	{
+		const ProcessInformation& info = *reinterpret_cast<const ProcessInformation*>(pCursor);
+		const uint32_t            pid  = static_cast<uint32_t>(reinterpret_cast<ULONG_PTR>(info.uniqueProcessId));
+
+		// Pid 0 is the idle process, whose CPU time is the machine's idle time.
+		if (pid != 0)
+		{
+			// Long names are cut to whole characters that fit.
+			int length = 0;
+			for (int chars = std::min<int>(info.imageNameLength / sizeof(WCHAR), sizeof(name) - 1); chars > 0 && length == 0; chars--)
+			{
+				length = ::WideCharToMultiByte(CP_UTF8, 0, info.imageNameBuffer, chars, name, sizeof(name) - 1, nullptr, nullptr);
+			}
+
+			// A process whose threads have all exited lingers while handles to it are open.
+			uint32_t index;
+			if (Record(pid,
+			           static_cast<uint64_t>(info.createTime.QuadPart),
+			           static_cast<uint64_t>(info.userTime.QuadPart + info.kernelTime.QuadPart),
+			           info.workingSetSize,
+			           info.numberOfThreads == 0 ? 'Z' : '\0',
+			           name,
+			           static_cast<size_t>(length),
+			           index))
+			{
+				ReadCommand(pid, index);
+			}
+
+			// Unlike read_bytes and write_bytes on Linux, these count every transfer, including
+			// those served from the cache and those to pipes and devices. The list carries them
+			// for every process, so none is ever refused.
+			RecordIo(index,
+			         static_cast<uint64_t>(info.readTransferCount.QuadPart),
+			         static_cast<uint64_t>(info.writeTransferCount.QuadPart),
+			         static_cast<uint64_t>(info.readOperationCount.QuadPart + info.writeOperationCount.QuadPart));
+		}
+
+		if (info.nextEntryOffset == 0)
+		{
+			break;
+		}
+		pCursor += info.nextEntryOffset;
+	}
+	return true;
+}
+
+_Use_decl_annotations_
+void ProcessTable::ReadCommand(
+	const uint32_t pid,
+	const uint32_t index)
+{
+	// Limited query access is enough for both, but protected processes and those of other
+	// sessions refuse even that; they are left empty. This only runs once per process.
+	const HANDLE hProcess = ::OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, pid);
+	if (!hProcess)
+	{
+		SetCommand(index, nullptr, 0, nullptr, 0);
+		return;
+	}
+
+	const auto toUtf8 = [this](const WCHAR* text, const size_t length, char* out) -> size_t
+	{
+		const int bytes = ::WideCharToMultiByte(CP_UTF8, 0, text, static_cast<int>(length), out,
+		                                        static_cast<int>(m_text.size() / 2), nullptr, nullptr);
+		return static_cast<size_t>(std::max(bytes, 0));
+	};
+
+	char* const executable       = m_text.data();
+	size_t      executableLength = 0;
+	DWORD       wideLength       = static_cast<DWORD>(m_wideText.size());
+	if (::QueryFullProcessImageNameW(hProcess, 0, m_wideText.data(), &wideLength))
+	{
+		executableLength = toUtf8(m_wideText.data(), wideLength, executable);
+	}
+
+	// The command line comes back as a UNICODE_STRING whose characters follow it in the buffer.
+	char* const commandLine       = m_text.data() + m_text.size() / 2;
+	size_t      commandLineLength = 0;
+	ULONG       returned          = 0;
+	if (m_pNtQueryInformationProcess &&
+		m_pNtQueryInformationProcess(hProcess, kProcessCommandLineInformation, m_wideText.data(),
+		                             static_cast<ULONG>(m_wideText.size() * sizeof(WCHAR)), &returned) >= 0)
+	{
+		const auto& information = *reinterpret_cast<const CommandLineInformation*>(m_wideText.data());
+		commandLineLength       = toUtf8(information.buffer, information.length / sizeof(WCHAR), commandLine);
+	}
+
+	::CloseHandle(hProcess);
+	SetCommand(index, executable, executableLength, commandLine, commandLineLength);
+}
+
+#endif // _WIN32
@@ -0,0 +1,534 @@
+/**
+ * @file ProcessTable.h
+ * @brief Contains the declaration of the ProcessTable class.
+ * @author Alessandro Bellia
+ * @date 10/16/2026
+ */
+
+#pragma once
+
+#include "Platform.h"
+#include "StringInterner.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include "ProcFile.h"
+#include <string>
+#endif
+
+/**
+ * @struct ProcessSample
+ * @brief One row of a top-N list.
+ */
+struct ProcessSample
+{
+	uint32_t pid;
+	float    cpu;         ///< Percentage of all logical CPUs over the last scan interval.
+	uint64_t rssBytes;    ///< Resident memory (working set on Windows).
+	float    readRate;    ///< Bytes per second read from storage (from any file on Windows); 0 if unknown.
+	float    writeRate;   ///< Bytes per second written to storage (to any file on Windows); 0 if unknown.
+	float    syscallRate; ///< Read and write calls per second; 0 if unknown.
+	float    wait;        ///< Percentage of the interval the main thread was runnable but not running; 0 if unknown.
+	char     name[32];    ///< NUL-terminated, truncated if longer.
+	char     state;       ///< The one-letter state of /proc/[pid]/stat (R, S, D, Z...); Z or 0 on Windows.
+};
+
+/**
+ * @class ProcessTable
+ * @brief Keeps every running process in a pid-keyed table that is updated in place by each
+ *		  scan, and selects the top CPU, memory and I/O consumers.
+ *
+ * On Linux a scan lists the cached /proc directory descriptor with getdents64 and reads each
+ * process's stat and io files through openat() relative to it, so no path is resolved from the
+ * root. A process whose io file is refused for lack of permission is remembered, and not tried
+ * again until it execs. On Windows a scan is one
+ * NtQuerySystemInformation(SystemProcessInformation) call into a persistent buffer, which
+ * carries the I/O counters too. Either way each entry keeps the CPU time and I/O counters it
+ * was last seen with, and its usage and rates are the deltas since the previous scan. On Linux
+ * the same pass reads each process's schedstat file for the time its main thread spent waiting
+ * on a run queue, and /proc/schedstat for the same figure per CPU. An entry is also keyed by
+ * its start time, so a pid that was reused by a new process between two scans starts over
+ * instead of inheriting the old process's counters. Entries live in dense parallel columns
+ * (pid, CPU time, resident memory, state, name id...) indexed by an open-addressing hash of
+ * the pid, so a scan or a selection over one field only touches that field's array. Processes
+ * that were not seen in a scan are swap-removed afterwards. Names, executable paths and
+ * command lines are interned in a StringInterner: processes sharing a name share its bytes,
+ * and a string is freed with the last process using it. The executable and command line are
+ * only read when a process is first seen or renamed by exec(). The top lists are picked by
+ * partial selection, not a full sort of the table.
+ *
+ * On Linux a scan can be cut into slices by a deadline: Update() stops between two processes
+ * once the deadline passes, and the next call carries on from the directory offset the
+ * kernel keeps for the descriptor, so thousands of processes never hold the caller for a
+ * whole pass. The table is swept and the top lists recomputed only when the pass completes;
+ * until then they describe the previous pass. The command line is read from the process's
+ * memory under its memory map lock, which a process in uninterruptible sleep can hold for as
+ * long as it sleeps, so it is not read while the process is in state D but on a later scan.
+ */
+class ProcessTable
+{
+public:
+	/**
+	 * @brief The length of each top list.
+	 */
+	static constexpr uint32_t kTopCount = 8;
+
+	ProcessTable();
+#ifndef _WIN32
+	/**
+	 * @brief Constructs a table that scans a custom procfs root, e.g. a recorded fixture tree.
+	 * @param[in] procRoot The directory procfs is mounted on (normally "/proc").
+	 */
+	explicit ProcessTable(
+		_In_z_ const char* procRoot);
+#endif
+	~ProcessTable();
+
+	ProcessTable(const ProcessTable& other)            = delete;
+	ProcessTable& operator=(const ProcessTable& other) = delete;
+
+	/**
+	 * @brief Opens the /proc directory (Linux) or resolves NtQuerySystemInformation (Windows).
+	 * @return True if the table can be scanned.
+	 */
+	bool Open();
+
+	/**
+	 * @brief Releases the directory descriptor. Safe to call more than once.
+	 */
+	void Close();
+
+	/**
+	 * @brief Scans the running processes, updates the table and recomputes the top lists.
+	 *		  CPU usage is only known from the second scan on, except for processes started
+	 *		  since the previous scan, whose whole CPU time falls within the interval. A scan
+	 *		  stopped by the deadline is resumed by the next call rather than restarted.
+	 * @param[in] deadlineNs The TscClock time to stop at, checked between processes; the
+	 *			  default runs the scan to the end. Ignored on Windows, where the whole list
+	 *			  comes back in one call.
+	 * @return True if the scan completed, false if it failed or is still in progress (see IsScanning()).
+	 */
+	bool Update(
+		_In_ int64_t deadlineNs = INT64_MAX);
+
+	/**
+	 * @brief Checks whether a scan stopped by its deadline is waiting to be resumed.
+	 * @return True between the slices of a scan; always false on Windows.
+	 */
+	[[nodiscard]] bool IsScanning() const { return m_scanning; }
+
+	/**
+	 * @brief Gets the number of processes seen by the last scan.
+	 * @return The count.
+	 */
+	[[nodiscard]] uint32_t GetCount() const { return static_cast<uint32_t>(m_pids.size()); }
+
+	/**
+	 * @brief Gets the processes using the most CPU, busiest first. Idle processes are left out.
+	 * @return A pointer to GetTopCpuCount() samples.
+	 */
+	[[nodiscard]] const ProcessSample* GetTopCpu() const { return m_topCpu; }
+
+	/**
+	 * @brief Gets the length of the CPU top list.
+	 * @return At most kTopCount.
+	 */
+	[[nodiscard]] uint32_t GetTopCpuCount() const { return m_topCpuCount; }
+
+	/**
+	 * @brief Gets the processes using the most resident memory, largest first.
+	 * @return A pointer to GetTopRssCount() samples.
+	 */
+	[[nodiscard]] const ProcessSample* GetTopRss() const { return m_topRss; }
+
+	/**
+	 * @brief Gets the length of the memory top list.
+	 * @return At most kTopCount.
+	 */
+	[[nodiscard]] uint32_t GetTopRssCount() const { return m_topRssCount; }
+
+	/**
+	 * @brief Gets the processes doing the most storage I/O, read and write rates summed,
+	 *		  busiest first. Processes without I/O are left out.
+	 * @return A pointer to GetTopIoCount() samples.
+	 */
+	[[nodiscard]] const ProcessSample* GetTopIo() const { return m_topIo; }
+
+	/**
+	 * @brief Gets the length of the I/O top list.
+	 * @return At most kTopCount.
+	 */
+	[[nodiscard]] uint32_t GetTopIoCount() const { return m_topIoCount; }
+
+	/**
+	 * @brief Gets the number of processes whose I/O counters the overlay may not read.
+	 * @return The count; always 0 on Windows.
+	 */
+	[[nodiscard]] uint32_t GetIoDeniedCount() const { return m_ioDeniedCount; }
+
+	/**
+	 * @brief Gets the processes that waited longest for a CPU, most delayed first. Processes
+	 *		  that did not wait are left out.
+	 * @return A pointer to GetTopWaitCount() samples.
+	 */
+	[[nodiscard]] const ProcessSample* GetTopWait() const { return m_topWait; }
+
+	/**
+	 * @brief Gets the length of the run-queue wait top list.
+	 * @return At most kTopCount; always 0 on Windows.
+	 */
+	[[nodiscard]] uint32_t GetTopWaitCount() const { return m_topWaitCount; }
+
+	/**
+	 * @brief Gets how long tasks waited on each CPU's run queue over the last scan interval.
+	 *		  Several tasks can wait on one CPU at once, so a value can exceed 100.
+	 * @return A pointer to GetCpuWaitCount() percentages of the interval, indexed by CPU number.
+	 */
+	[[nodiscard]] const float* GetCpuWaits() const { return m_cpuWaits.data(); }
+
+	/**
+	 * @brief Gets the number of entries of GetCpuWaits().
+	 * @return The highest CPU number seen plus one; 0 where /proc/schedstat is unavailable.
+	 */
+	[[nodiscard]] uint32_t GetCpuWaitCount() const { return static_cast<uint32_t>(m_cpuWaits.size()); }
+
+	/**
+	 * @brief Gets the run-queue wait averaged over the CPUs.
+	 * @return A percentage of the last scan interval.
+	 */
+	[[nodiscard]] float GetRunQueueWait() const { return m_runQueueWait; }
+
+	/**
+	 * @brief Copies every process of the last scan, in table order. The order only changes
+	 *		  where processes exited or started, so a view sorted by a previous copy stays
+	 *		  nearly sorted.
+	 * @param[out] samples Receives one sample per process; its capacity is reused.
+	 */
+	void CopySamples(
+		_Out_ std::vector<ProcessSample>& samples) const;
+
+	/**
+	 * @brief Gets the executable path of a process, where the scan was allowed to read it.
+	 * @param[in] pid The process id.
+	 * @return The NUL-terminated path, empty if unknown. Valid until the next Update().
+	 */
+	[[nodiscard]] const char* GetExecutable(
+		_In_ uint32_t pid) const;
+
+	/**
+	 * @brief Gets the command line of a process, arguments separated by spaces.
+	 * @param[in] pid The process id.
+	 * @return The NUL-terminated command line, empty if unknown. Valid until the next Update().
+	 */
+	[[nodiscard]] const char* GetCommandLine(
+		_In_ uint32_t pid) const;
+
+	/**
+	 * @brief Gets the number of times a pid was found reused by a new process.
+	 * @return The count.
+	 */
+	[[nodiscard]] uint64_t GetReusedPidCount() const { return m_reusedPids; }
+
+	/**
+	 * @brief Gets the interned names, executable paths and command lines.
+	 * @return A reference to the interner.
+	 */
+	[[nodiscard]] const StringInterner& GetStrings() const { return m_strings; }
+
+	/**
+	 * @brief Gets the number of bytes held by the table.
+	 * @return The capacity of the columns, the pid index, the scan buffer and the strings.
+	 */
+	[[nodiscard]] size_t GetMemoryFootprint() const;
+
+private:
+	/**
+	 * @brief Marks cumulative counters that have no earlier reading to compute a rate from.
+	 */
+	static constexpr uint64_t kNoBaseline = UINT64_MAX;
+
+	/**
+	 * @brief Reads the running processes and records them, starting a new pass or resuming
+	 *		  the one in progress, and sets m_scanning while the pass is incomplete.
+	 * @param[in] deadlineNs The TscClock time to stop at.
+	 * @return False if the list could not be read.
+	 */
+	bool Scan(
+		_In_ int64_t deadlineNs);
+
+	/**
+	 * @brief Records one process seen by the current scan, adding it or updating its entry.
+	 * @param[in] pid The process id.
+	 * @param[in] startTime The start time, in the units of m_scanClock.
+	 * @param[in] cpuTime The cumulative CPU time, in m_ticksPerSecond units.
+	 * @param[in] rssBytes The resident memory.
+	 * @param[in] state The process state.
+	 * @param[in] name The process name; need not be NUL-terminated.
+	 * @param[in] nameLength The length of name.
+	 * @param[out] index Receives the process's entry.
+	 * @return True if the process is new, reused its pid or was renamed, so its executable
+	 *		   and command line must be read and passed to SetCommand().
+	 */
+	bool Record(
+		_In_ uint32_t                      pid,
+		_In_ uint64_t                      startTime,
+		_In_ uint64_t                      cpuTime,
+		_In_ uint64_t                      rssBytes,
+		_In_ char                          state,
+		_In_reads_(nameLength) const char* name,
+		_In_ size_t                        nameLength,
+		_Out_ uint32_t&                    index);
+
+	/**
+	 * @brief Records the cumulative I/O counters of a process recorded by the current scan.
+	 *		  Processes whose counters are not recorded show no I/O for the scan.
+	 * @param[in] index The process's entry.
+	 * @param[in] readBytes The bytes read.
+	 * @param[in] writeBytes The bytes written.
+	 * @param[in] syscalls The read and write calls.
+	 */
+	void RecordIo(
+		_In_ uint32_t index,
+		_In_ uint64_t readBytes,
+		_In_ uint64_t writeBytes,
+		_In_ uint64_t syscalls);
+
+	/**
+	 * @brief Records the cumulative run-queue wait of a process recorded by the current scan.
+	 *		  Processes whose wait is not recorded show none for the scan.
+	 * @param[in] index The process's entry.
+	 * @param[in] runDelayNs The time spent runnable but not running, in nanoseconds.
+	 */
+	void RecordWait(
+		_In_ uint32_t index,
+		_In_ uint64_t runDelayNs);
+
+	/**
+	 * @brief Replaces the executable path and command line of an entry.
+	 * @param[in] index The entry.
+	 * @param[in] executable The path; need not be NUL-terminated.
+	 * @param[in] executableLength The length of executable, 0 if unknown.
+	 * @param[in] commandLine The command line; need not be NUL-terminated.
+	 * @param[in] commandLineLength The length of commandLine, 0 if unknown.
+	 */
+	void SetCommand(
+		_In_ uint32_t                             index,
+		_In_reads_(executableLength) const char*  executable,
+		_In_ size_t                               executableLength,
+		_In_reads_(commandLineLength) const char* commandLine,
+		_In_ size_t                               commandLineLength);
+
+	/**
+	 * @brief Reads the executable path and command line of a process into m_text and passes
+	 *		  them to SetCommand(). Either is left empty where it cannot be read.
+	 * @param[in] pid The process id.
+	 * @param[in] index The process's entry.
+	 */
+	void ReadCommand(
+		_In_ uint32_t pid,
+		_In_ uint32_t index);
+
+#ifndef _WIN32
+	/**
+	 * @brief Reads the I/O counters of a process and passes them to RecordIo(), or marks it in
+	 *		  m_ioDenied if reading them is refused.
+	 * @param[in] pid The process id.
+	 * @param[in] index The process's entry.
+	 * @param[out] buffer Scratch for the file's contents.
+	 * @param[in] size The size of buffer.
+	 */
+	void ReadIo(
+		_In_ uint32_t            pid,
+		_In_ uint32_t            index,
+		_Out_writes_(size) char* buffer,
+		_In_ size_t              size);
+
+	/**
+	 * @brief Reads one process's stat file and records it, then its command, I/O counters and
+	 *		  run-queue wait as they are due.
+	 * @param[in] pid The process id.
+	 * @param[in] directory The process's directory name under m_procFd.
+	 * @param[out] buffer Scratch for the files' contents.
+	 * @param[in] size The size of buffer.
+	 */
+	void ReadProcess(
+		_In_ uint32_t            pid,
+		_In_z_ const char*       directory,
+		_Out_writes_(size) char* buffer,
+		_In_ size_t              size);
+
+	/**
+	 * @brief Reads the run-queue wait of a process's main thread and passes it to RecordWait().
+	 * @param[in] pid The process id.
+	 * @param[in] index The process's entry.
+	 * @param[out] buffer Scratch for the file's contents.
+	 * @param[in] size The size of buffer.
+	 * @return True if the schedstat file was read.
+	 */
+	bool ReadWait(
+		_In_ uint32_t            pid,
+		_In_ uint32_t            index,
+		_Out_writes_(size) char* buffer,
+		_In_ size_t              size);
+
+	/**
+	 * @brief Reads the run-queue wait of every CPU from /proc/schedstat into m_cpuWaits and
+	 *		  m_runQueueWait. Leaves them empty where the file is unavailable.
+	 */
+	void ReadCpuWaits();
+#endif
+
+	/**
+	 * @brief Appends an entry for a process, with its strings empty.
+	 * @param[in] pid The process id.
+	 */
+	void AppendEntry(
+		_In_ uint32_t pid);
+
+	/**
+	 * @brief Releases an entry's strings and moves the last entry into its place.
+	 * @param[in] index The entry.
+	 */
+	void RemoveEntry(
+		_In_ uint32_t index);
+
+	/**
+	 * @brief Copies an entry out as a sample.
+	 * @param[in] index The entry.
+	 * @param[out] sample Receives the sample.
+	 */
+	void CopySample(
+		_In_ uint32_t        index,
+		_Out_ ProcessSample& sample) const;
+
+	/**
+	 * @brief Finds the entry of a pid without inserting it.
+	 * @param[in] pid The process id.
+	 * @return The entry's index plus one, or 0 if the pid is not in the table.
+	 */
+	[[nodiscard]] uint32_t FindEntry(
+		_In_ uint32_t pid) const;
+
+	/**
+	 * @brief Removes the entries of processes the current scan did not see.
+	 */
+	void Sweep();
+
+	/**
+	 * @brief Rebuilds the pid index for the current entries, resizing it to keep it at most half full.
+	 */
+	void RebuildIndex();
+
+	/**
+	 * @brief Finds the index slot of a pid: the slot holding it, or the empty slot it would go in.
+	 * @param[in] pid The process id.
+	 * @return A reference to the slot; 0 if empty, otherwise the entry's index plus one.
+	 */
+	uint32_t& FindSlot(
+		_In_ uint32_t pid);
+
+	/**
+	 * @brief Picks the top entries by a key with partial selection and copies them out.
+	 * @param[in] less The ordering of two entry indices; the first kTopCount entries under it are kept.
+	 * @param[out] top Receives the samples.
+	 * @return The number of samples written.
+	 */
+	template <typename Less>
+	uint32_t SelectTop(
+		_In_ Less                          less,
+		_Out_writes_(kTopCount) ProcessSample* top);
+
+	// One column per field, all indexed by entry.
+	std::vector<uint32_t> m_pids;
+	std::vector<uint32_t> m_scans;          ///< The scan that last saw the process.
+	std::vector<uint64_t> m_startTimes;     ///< Ticks since boot (Linux) or FILETIME (Windows); tells reused pids apart.
+	std::vector<uint64_t> m_cpuTimes;       ///< Cumulative user and kernel time, in platform ticks.
+	std::vector<uint64_t> m_rssBytes;
+	std::vector<float>    m_cpu;
+	std::vector<char>     m_states;
+	std::vector<uint64_t> m_readBytes;      ///< Cumulative; kNoBaseline until there is a reading to diff against.
+	std::vector<uint64_t> m_writeBytes;     ///< Cumulative.
+	std::vector<uint64_t> m_syscalls;       ///< Cumulative read and write calls.
+	std::vector<float>    m_readRates;
+	std::vector<float>    m_writeRates;
+	std::vector<float>    m_syscallRates;
+	std::vector<uint8_t>  m_ioDenied;       ///< 1 once the io file was refused; cleared by exec().
+	std::vector<uint8_t>  m_commandPending; ///< 1 while the command is due but was put off.
+	std::vector<uint64_t> m_runDelays;      ///< Cumulative, in nanoseconds; kNoBaseline until there is a reading.
+	std::vector<float>    m_waits;
+	std::vector<uint32_t> m_nameIds;        ///< Into m_strings.
+	std::vector<uint32_t> m_executableIds;  ///< Into m_strings.
+	std::vector<uint32_t> m_commandLineIds; ///< Into m_strings.
+
+	StringInterner        m_strings;
+	std::vector<uint32_t> m_index; ///< Open-addressing pid hash; a power of two in size.
+	std::vector<uint32_t> m_order; ///< Scratch for the top-N selection.
+	uint32_t              m_indexShift;
+	std::vector<char>     m_buffer;
+	std::vector<char>     m_text; ///< Scratch for a process's executable path and command line.
+
+	ProcessSample m_topCpu[kTopCount];
+	ProcessSample m_topRss[kTopCount];
+	ProcessSample m_topIo[kTopCount];
+	ProcessSample m_topWait[kTopCount];
+	uint32_t      m_topCpuCount;
+	uint32_t      m_topRssCount;
+	uint32_t      m_topIoCount;
+	uint32_t      m_topWaitCount;
+	uint32_t      m_ioDeniedCount;
+
+	std::vector<uint64_t> m_cpuRunDelays; ///< Cumulative per CPU, in nanoseconds; kNoBaseline until there is a reading.
+	std::vector<float>    m_cpuWaits;
+	float                 m_runQueueWait;
+
+	uint32_t m_scan;          ///< Incremented by every new scan; 0 before the first.
+	bool     m_scanning;      ///< A scan stopped by its deadline is waiting to be resumed.
+	int64_t  m_scanStartNs;   ///< When the current scan started.
+	uint32_t m_cpuCount;
+	uint64_t m_ticksPerSecond;
+	uint64_t m_scanClock;     ///< When the current scan started, in start-time units.
+	uint64_t m_prevScanClock; ///< When the previous scan started.
+	int64_t  m_prevScanNs;
+	float    m_cpuScale;      ///< Converts a CPU time delta to a percentage of all CPUs; 0 without a previous scan.
+	float    m_rateScale;     ///< Converts a counter delta to a rate per second; 0 without a previous scan.
+	uint64_t m_reusedPids;
+
+#ifdef _WIN32
+	/**
+	 * @brief Signature of ntdll!NtQuerySystemInformation, resolved at run time.
+	 */
+	using NtQuerySystemInformationFn = LONG(NTAPI*)(
+		ULONG  systemInformationClass,
+		PVOID  systemInformation,
+		ULONG  systemInformationLength,
+		PULONG returnLength);
+
+	/**
+	 * @brief Signature of ntdll!NtQueryInformationProcess, resolved at run time.
+	 */
+	using NtQueryInformationProcessFn = LONG(NTAPI*)(
+		HANDLE processHandle,
+		ULONG  processInformationClass,
+		PVOID  processInformation,
+		ULONG  processInformationLength,
+		PULONG returnLength);
+
+	NtQuerySystemInformationFn  m_pNtQuerySystemInformation;
+	NtQueryInformationProcessFn m_pNtQueryInformationProcess;
+	std::vector<WCHAR>          m_wideText; ///< Scratch for the UTF-16 path and command line.
+#else
+	std::string       m_procRoot;
+	int               m_procFd;
+	uint64_t          m_pageSize;
+	ProcFile          m_schedstatFile; ///< /proc/schedstat; closed where the kernel has no scheduler statistics.
+	std::vector<char> m_schedstatText;
+	bool              m_readTaskWaits; ///< False once a whole scan found no per-process schedstat file.
+	long              m_listLength;    ///< The bytes getdents64 last listed into m_buffer.
+	long              m_listOffset;    ///< The next entry of m_buffer the scan reads.
+	uint32_t          m_waitsRead;     ///< The schedstat files the current scan read.
+#endif
+};
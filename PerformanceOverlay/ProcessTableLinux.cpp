@@ -0,0 +1,447 @@
+/**
+ * @file ProcessTableLinux.cpp
+ * @brief Contains the procfs-based Linux scan of the ProcessTable class.
+ * @author Alessandro Bellia
+ * @date 10/16/2026
+ */
+
+#ifdef __linux__
+
+#include "ProcessTable.h"
+#include "ProcFile.h"
+#include "TscClock.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+
+/**
+ * @brief The size of the buffer directory entries are listed into; a few hundred pids per call.
+ */
+static constexpr size_t kDirectoryBufferSize = 32 * 1024;
+
+/**
+ * @brief The most of /proc/[pid]/stat that is read; the fields used end well before this.
+ */
+static constexpr size_t kStatBufferSize = 1024;
+
+/**
+ * @brief The most of an executable path or command line that is kept.
+ */
+static constexpr size_t kCommandBufferSize = 4096;
+
+/**
+ * @brief The initial size of the /proc/schedstat buffer, doubled at Open() until the file fits.
+ */
+static constexpr size_t kSchedstatBufferSize = 16 * 1024;
+
+/**
+ * @struct DirectoryEntry
+ * @brief Mirrors struct linux_dirent64, the record getdents64 returns.
+ */
+struct DirectoryEntry
+{
+	uint64_t inode;
+	int64_t  offset;
+	uint16_t recordLength;
+	uint8_t  type;
+	char     name[1]; ///< NUL-terminated, extends to recordLength.
+};
+
+/**
+ * @brief Parses a directory name that is a pid.
+ * @param[in] name The NUL-terminated name.
+ * @param[out] pid Receives the pid.
+ * @return True if the name is all digits.
+ */
+_Success_(return)
+static bool ParsePid(
+	_In_z_ const char* name,
+	_Out_ uint32_t&    pid);
+
+
+ProcessTable::ProcessTable()
+	: ProcessTable("/proc")
+{
+}
+
+_Use_decl_annotations_
+ProcessTable::ProcessTable(
+	const char* procRoot)
+	: m_indexShift(0),
+	  m_topCpu{},
+	  m_topRss{},
+	  m_topIo{},
+	  m_topWait{},
+	  m_topCpuCount(0),
+	  m_topRssCount(0),
+	  m_topIoCount(0),
+	  m_topWaitCount(0),
+	  m_ioDeniedCount(0),
+	  m_runQueueWait(0.0f),
+	  m_scan(0),
+	  m_scanning(false),
+	  m_scanStartNs(0),
+	  m_cpuCount(0),
+	  m_ticksPerSecond(0),
+	  m_scanClock(0),
+	  m_prevScanClock(0),
+	  m_prevScanNs(0),
+	  m_cpuScale(0.0f),
+	  m_rateScale(0.0f),
+	  m_reusedPids(0),
+	  m_procRoot(procRoot),
+	  m_procFd(-1),
+	  m_pageSize(0),
+	  m_readTaskWaits(true),
+	  m_listLength(0),
+	  m_listOffset(0),
+	  m_waitsRead(0)
+{
+	RebuildIndex();
+}
+
+ProcessTable::~ProcessTable()
+{
+	Close();
+}
+
+bool ProcessTable::Open()
+{
+	Close();
+
+	// Every pid is opened relative to this descriptor, so the kernel only resolves
+	// "<pid>/stat" instead of walking the whole path from the root for each process.
+	m_procFd = ::open(m_procRoot.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+	if (m_procFd < 0)
+	{
+		return false;
+	}
+
+	m_cpuCount       = static_cast<uint32_t>(std::max(::sysconf(_SC_NPROCESSORS_ONLN), 1L));
+	m_ticksPerSecond = static_cast<uint64_t>(::sysconf(_SC_CLK_TCK));
+	m_pageSize       = static_cast<uint64_t>(::sysconf(_SC_PAGESIZE));
+	m_buffer.resize(kDirectoryBufferSize);
+	m_text.resize(kCommandBufferSize);
+	m_readTaskWaits = true;
+
+	// Scheduler statistics need CONFIG_SCHEDSTATS. The file lists every CPU and its scheduling
+	// domains, so the buffer is grown once here to fit it.
+	m_schedstatText.resize(kSchedstatBufferSize);
+	if (m_schedstatFile.Open((m_procRoot + "/schedstat").c_str()))
+	{
+		while (m_schedstatFile.Read(m_schedstatText.data(), m_schedstatText.size()) >= static_cast<long>(m_schedstatText.size()) - 1)
+		{
+			m_schedstatText.resize(m_schedstatText.size() * 2);
+		}
+	}
+	return true;
+}
+
+void ProcessTable::Close()
+{
+	// A pass in progress cannot resume on another descriptor.
+	m_scanning = false;
+	if (m_procFd >= 0)
+	{
+		::close(m_procFd);
+		m_procFd = -1;
+	}
+	m_schedstatFile.Close();
+}
+
+_Use_decl_annotations_
+bool ProcessTable::Scan(
+	const int64_t deadlineNs)
+{
+	if (m_procFd < 0)
+	{
+		return false;
+	}
+
+	// A new pass rewinds the listing. One stopped by its deadline carries on from the entries
+	// left in the buffer, then from the offset the kernel kept for the descriptor: procfs
+	// offsets are pids, so processes that exit in between do not shift it.
+	if (!m_scanning)
+	{
+		if (::lseek(m_procFd, 0, SEEK_SET) < 0)
+		{
+			return false;
+		}
+
+		// Start times are clock ticks since boot, including time spent suspended.
+		timespec now{};
+		(void)::clock_gettime(CLOCK_BOOTTIME, &now);
+		m_scanClock = static_cast<uint64_t>(now.tv_sec) * m_ticksPerSecond +
+			static_cast<uint64_t>(now.tv_nsec) * m_ticksPerSecond / 1'000'000'000;
+		ReadCpuWaits();
+
+		m_listLength = 0;
+		m_listOffset = 0;
+		m_waitsRead  = 0;
+		m_scanning   = true;
+	}
+
+	char stat[kStatBufferSize];
+	for (;;)
+	{
+		if (m_listOffset == m_listLength)
+		{
+			const long length = ::syscall(SYS_getdents64, m_procFd, m_buffer.data(), m_buffer.size());
+			if (length <= 0)
+			{
+				// Without CONFIG_SCHED_INFO no process has a schedstat file, so stop looking.
+				m_readTaskWaits = m_readTaskWaits && (length < 0 || m_waitsRead > 0 || GetCount() == 0);
+				m_scanning      = false;
+				return length == 0;
+			}
+			m_listLength = length;
+			m_listOffset = 0;
+		}
+
+		const DirectoryEntry& entry = *reinterpret_cast<const DirectoryEntry*>(m_buffer.data() + m_listOffset);
+		m_listOffset += entry.recordLength;
+
+		uint32_t pid;
+		if (ParsePid(entry.name, pid))
+		{
+			ReadProcess(pid, entry.name, stat, sizeof(stat));
+		}
+
+		// Checked after each process, so every slice makes progress and overruns its deadline
+		// by one process's reads at most.
+		if (TscClock::NowNs() >= deadlineNs)
+		{
+			return true;
+		}
+	}
+}
+
+_Use_decl_annotations_
+void ProcessTable::ReadProcess(
+	const uint32_t pid,
+	const char*    directory,
+	char*          buffer,
+	const size_t   size)
+{
+	// A process that exits between the listing and the open is simply not recorded.
+	char         path[32];
+	const size_t directoryLength = std::strlen(directory);
+	std::memcpy(path, directory, directoryLength);
+	std::memcpy(path + directoryLength, "/stat", sizeof("/stat"));
+
+	ProcFile file;
+	if (!file.OpenAt(m_procFd, path))
+	{
+		return;
+	}
+	const long statLength = file.ReadOnce(buffer, size);
+	if (statLength <= 0)
+	{
+		return;
+	}
+
+	// pid (comm) state ppid ... The name may itself contain spaces and parentheses,
+	// so it ends at the last ')'.
+	const char* const open  = static_cast<const char*>(std::memchr(buffer, '(', static_cast<size_t>(statLength)));
+	const char* const close = static_cast<const char*>(::memrchr(buffer, ')', static_cast<size_t>(statLength)));
+	if (!open || !close || close < open)
+	{
+		return;
+	}
+
+	// Fields after the name, counting from 1 at the pid: the state is 3, utime 14,
+	// stime 15, starttime 22 and rss (in pages) 24.
+	const char state = close + 2 < buffer + statLength ? close[2] : '\0';
+	ProcParser parser(close + 1, buffer + statLength);
+	parser.SkipTokens(11);
+	const uint64_t userTicks   = parser.ReadU64();
+	const uint64_t systemTicks = parser.ReadU64();
+	parser.SkipTokens(6);
+	const uint64_t startTime = parser.ReadU64();
+	parser.SkipTokens(1);
+	const uint64_t rssPages = parser.ReadU64();
+
+	uint32_t   index;
+	const bool newCommand = Record(pid, startTime, userTicks + systemTicks, rssPages * m_pageSize, state,
+	                               open + 1, static_cast<size_t>(close - open - 1), index);
+
+	// A process in uninterruptible sleep may hold its memory map lock until it wakes, and the
+	// command line is read under that lock, so the read waits for a scan that finds it awake.
+	if (newCommand || m_commandPending[index])
+	{
+		m_commandPending[index] = state == 'D' ? 1 : 0;
+		if (state != 'D')
+		{
+			ReadCommand(pid, index);
+		}
+	}
+	if (!m_ioDenied[index])
+	{
+		ReadIo(pid, index, buffer, size);
+	}
+	if (m_readTaskWaits && ReadWait(pid, index, buffer, size))
+	{
+		++m_waitsRead;
+	}
+}
+
+_Use_decl_annotations_
+void ProcessTable::ReadIo(
+	const uint32_t pid,
+	const uint32_t index,
+	char*          buffer,
+	const size_t   size)
+{
+	// The io file is only readable by the process's owner (or with CAP_SYS_PTRACE): the open
+	// fails for other users' processes, and the read for ones that cannot be traced. Either
+	// refusal is remembered, so it costs one syscall per process rather than one per scan.
+	// errno only describes a failed call: an empty read (an exiting process) proves nothing.
+	char path[32];
+	(void)std::snprintf(path, sizeof(path), "%u/io", pid);
+	ProcFile   file;
+	const long length = file.OpenAt(m_procFd, path) ? file.ReadOnce(buffer, size) : -1;
+	if (length < 0)
+	{
+		m_ioDenied[index] = errno == EACCES || errno == EPERM ? 1 : 0;
+		return;
+	}
+	if (length == 0)
+	{
+		return;
+	}
+
+	// rchar, wchar, syscr, syscw, read_bytes, write_bytes and cancelled_write_bytes, one
+	// "name: value" pair per line. rchar and wchar count every read() and write(), cached or
+	// not; read_bytes and write_bytes are what reached the storage layer.
+	ProcParser parser(buffer, buffer + length);
+	uint64_t   values[6];
+	for (uint64_t& value : values)
+	{
+		parser.SkipTokens(1);
+		value = parser.ReadU64();
+		parser.SkipLine();
+	}
+	RecordIo(index, values[4], values[5], values[2] + values[3]);
+}
+
+_Use_decl_annotations_
+bool ProcessTable::ReadWait(
+	const uint32_t pid,
+	const uint32_t index,
+	char*          buffer,
+	const size_t   size)
+{
+	// "<on-CPU ns> <run-queue wait ns> <timeslices>", for the main thread only: summing every
+	// thread would mean walking task/, a directory per process. Readable by anyone.
+	char path[32];
+	(void)std::snprintf(path, sizeof(path), "%u/schedstat", pid);
+	ProcFile   file;
+	const long length = file.OpenAt(m_procFd, path) ? file.ReadOnce(buffer, size) : -1;
+	if (length <= 0)
+	{
+		return false;
+	}
+
+	ProcParser parser(buffer, buffer + length);
+	parser.SkipTokens(1);
+	RecordWait(index, parser.ReadU64());
+	return true;
+}
+
+void ProcessTable::ReadCpuWaits()
+{
+	const long length = m_schedstatFile.IsOpen() ? m_schedstatFile.Read(m_schedstatText.data(), m_schedstatText.size()) : -1;
+	if (length <= 0)
+	{
+		return;
+	}
+
+	// One "cpu<N> yld_count 0 sched_count sched_goidle ttwu_count ttwu_local rq_cpu_time
+	// run_delay pcount" line per online CPU, each followed by its domain lines. run_delay
+	// sums the waits of every task that queued on the CPU, in nanoseconds.
+	ProcParser parser(m_schedstatText.data(), m_schedstatText.data() + length);
+	float      total  = 0.0f;
+	uint32_t   online = 0;
+	for (; !parser.AtEnd(); parser.SkipLine())
+	{
+		const char* token;
+		size_t      tokenLength;
+		if (!parser.StartsWith("cpu") || !parser.ReadToken(token, tokenLength))
+		{
+			continue;
+		}
+		ProcParser     number(token + 3, token + tokenLength);
+		const uint32_t cpu = static_cast<uint32_t>(number.ReadU64());
+		parser.SkipTokens(7);
+		const uint64_t runDelayNs = parser.ReadU64();
+
+		if (cpu >= m_cpuRunDelays.size())
+		{
+			m_cpuRunDelays.resize(cpu + 1, kNoBaseline);
+			m_cpuWaits.resize(cpu + 1, 0.0f);
+		}
+		m_cpuWaits[cpu] = m_cpuRunDelays[cpu] != kNoBaseline && runDelayNs >= m_cpuRunDelays[cpu]
+			                  ? static_cast<float>(runDelayNs - m_cpuRunDelays[cpu]) * m_rateScale * 1e-7f
+			                  : 0.0f;
+		m_cpuRunDelays[cpu] = runDelayNs;
+		total += m_cpuWaits[cpu];
+		++online;
+	}
+
+	// Offline CPUs are not listed, and do not count towards the average.
+	m_runQueueWait = online != 0 ? total / static_cast<float>(online) : 0.0f;
+}
+
+_Use_decl_annotations_
+void ProcessTable::ReadCommand(
+	const uint32_t pid,
+	const uint32_t index)
+{
+	// Reading another user's exe link is refused, and kernel threads have neither; those
+	// are left empty. Either way this only runs once per process, not once per scan.
+	char       path[32];
+	const int  pathLength       = std::snprintf(path, sizeof(path), "%u/exe", pid);
+	const long executableLength = ::readlinkat(m_procFd, path, m_text.data(), m_text.size() / 2);
+
+	// The arguments are NUL-separated; they are joined with spaces.
+	char* const commandLine       = m_text.data() + m_text.size() / 2;
+	long        commandLineLength = 0;
+	std::memcpy(path + pathLength - 3, "cmdline", sizeof("cmdline"));
+	ProcFile file;
+	if (file.OpenAt(m_procFd, path))
+	{
+		commandLineLength = std::max(file.ReadOnce(commandLine, m_text.size() / 2), 0L);
+	}
+	while (commandLineLength > 0 && commandLine[commandLineLength - 1] == '\0')
+	{
+		--commandLineLength;
+	}
+	std::replace(commandLine, commandLine + commandLineLength, '\0', ' ');
+
+	SetCommand(index, m_text.data(), static_cast<size_t>(std::max(executableLength, 0L)),
+	           commandLine, static_cast<size_t>(commandLineLength));
+}
+
+
+_Use_decl_annotations_
+bool ParsePid(
+	const char* name,
+	uint32_t&   pid)
+{
+	// Pids are at most 7 digits (pid_max is capped at 2^22).
+	pid = 0;
+	const char* p = name;
+	for (; *p >= '0' && *p <= '9' && p - name < 8; p++)
+	{
+		pid = pid * 10 + static_cast<uint32_t>(*p - '0');
+	}
+	return p != name && *p == '\0';
+}
+
+#endif // __linux__
@@ -0,0 +1,189 @@
+/**
+ * @file RollupStore.cpp
+ * @brief Contains the implementation of the RollupStore class.
+ * @author Alessandro Bellia
+ * @date 10/15/2026
+ */
+
+#include "RollupStore.h"
+#include <algorithm>
+#include <cfloat>
+#include <limits>
+
+/**
+ * @brief Marks a tier of a metric that has not received any sample yet.
+ */
+static constexpr int64_t kNoData = std::numeric_limits<int64_t>::min();
+
+/**
+ * @brief The weight, in seconds, of a sample that has no previous sample to measure from.
+ */
+static constexpr float kMinWeight = 1e-6f;
+
+/**
+ * @brief A bucket that holds no samples.
+ */
+static constexpr RollupBucket kEmptyBucket = {FLT_MAX, -FLT_MAX, 0.0f, 0.0f, 0};
+
+
+_Use_decl_annotations_
+void RollupStore::Configure(
+	const uint32_t metricCount)
+{
+	m_metricCount = metricCount;
+
+	for (uint32_t tier = 0; tier < kTierCount; tier++)
+	{
+		const size_t slots = static_cast<size_t>(metricCount) * kTiers[tier].bucketCount;
+		m_tiers[tier]      = std::make_unique<RollupBucket[]>(slots);
+		m_heads[tier]      = std::make_unique<int64_t[]>(metricCount);
+		std::fill_n(m_tiers[tier].get(), slots, kEmptyBucket);
+		std::fill_n(m_heads[tier].get(), metricCount, kNoData);
+	}
+
+	m_sequences      = std::make_unique<std::atomic<uint32_t>[]>(metricCount);
+	m_lastTimestamps = std::make_unique<int64_t[]>(metricCount);
+	std::fill_n(m_lastTimestamps.get(), metricCount, kNoData);
+}
+
+_Use_decl_annotations_
+void RollupStore::Append(
+	const uint32_t metric,
+	const int64_t  timestampNs,
+	const float    value)
+{
+	if (metric >= m_metricCount)
+	{
+		return;
+	}
+
+	// Odd sequence numbers tell readers an update is in progress.
+	std::atomic<uint32_t>& sequence = m_sequences[metric];
+	const uint32_t         begin    = sequence.load(std::memory_order_relaxed);
+	sequence.store(begin + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	// The first sample describes no span yet; a token weight keeps its bucket's mean defined.
+	int64_t&    lastTimestamp = m_lastTimestamps[metric];
+	const float weight        = lastTimestamp == kNoData || timestampNs <= lastTimestamp
+		? kMinWeight
+		: static_cast<float>(timestampNs - lastTimestamp) / 1e9f;
+	lastTimestamp = timestampNs;
+
+	for (uint32_t tier = 0; tier < kTierCount; tier++)
+	{
+		const int64_t  bucketIndex = timestampNs / kTiers[tier].bucketNs;
+		const uint32_t capacity    = kTiers[tier].bucketCount;
+		int64_t&       head        = m_heads[tier][metric];
+
+		if (head == kNoData)
+		{
+			head = bucketIndex;
+		}
+		else if (bucketIndex > head)
+		{
+			// Clear the buckets the ring skipped over (at most one full turn), so gaps in
+			// sampling read back as empty buckets rather than as data from a turn ago.
+			const int64_t last = std::min(bucketIndex, head + capacity);
+			for (int64_t index = head + 1; index <= last; index++)
+			{
+				m_tiers[tier][SlotOffset(tier, metric, index)] = kEmptyBucket;
+			}
+			head = bucketIndex;
+		}
+		else if (bucketIndex <= head - capacity)
+		{
+			continue; // Older than this tier's retention
+		}
+
+		RollupBucket& bucket = m_tiers[tier][SlotOffset(tier, metric, bucketIndex)];
+		bucket.min           = std::min(bucket.min, value);
+		bucket.max           = std::max(bucket.max, value);
+		bucket.sum += value * weight;
+		bucket.weight += weight;
+		bucket.count++;
+	}
+
+	sequence.store(begin + 2, std::memory_order_release);
+}
+
+_Use_decl_annotations_
+RollupRange RollupStore::Read(
+	const uint32_t metric,
+	const int64_t  fromNs,
+	const int64_t  toNs,
+	const uint32_t maxBuckets,
+	RollupBucket*  buckets) const
+{
+	RollupRange range{kTiers[0].bucketNs, fromNs, 0};
+	if (metric >= m_metricCount || maxBuckets == 0 || toNs < fromNs)
+	{
+		return range;
+	}
+
+	// Pick the finest tier that both retains the whole span and fits it into the budget.
+	const int64_t span = toNs - fromNs;
+	uint32_t      tier = kTierCount - 1;
+	for (uint32_t candidate = 0; candidate < kTierCount; candidate++)
+	{
+		const int64_t bucketNs = kTiers[candidate].bucketNs;
+		if (span / bucketNs + 1 <= maxBuckets && span <= bucketNs * kTiers[candidate].bucketCount)
+		{
+			tier = candidate;
+			break;
+		}
+	}
+
+	const int64_t  bucketNs = kTiers[tier].bucketNs;
+	const uint32_t capacity = kTiers[tier].bucketCount;
+	const int64_t  last     = toNs / bucketNs;
+	const int64_t  first    = std::max(fromNs / bucketNs, last - static_cast<int64_t>(maxBuckets) + 1);
+
+	range.bucketNs      = bucketNs;
+	range.firstBucketNs = first * bucketNs;
+	range.count         = static_cast<uint32_t>(last - first + 1);
+
+	// Copy under the sequence lock and retry if the sampler updated the metric meanwhile.
+	const std::atomic<uint32_t>& sequence = m_sequences[metric];
+	for (;;)
+	{
+		const uint32_t begin = sequence.load(std::memory_order_acquire);
+		if ((begin & 1) != 0)
+		{
+			continue;
+		}
+
+		const int64_t head = m_heads[tier][metric];
+		for (int64_t index = first; index <= last; index++)
+		{
+			const bool retained    = head != kNoData && index <= head && index > head - capacity;
+			buckets[index - first] = retained ? m_tiers[tier][SlotOffset(tier, metric, index)] : kEmptyBucket;
+		}
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (sequence.load(std::memory_order_relaxed) == begin)
+		{
+			return range;
+		}
+	}
+}
+
+size_t RollupStore::GetMemoryFootprint() const
+{
+	size_t bytes = sizeof(*this) + m_metricCount * (sizeof(std::atomic<uint32_t>) + sizeof(int64_t));
+	for (const TierSpec& spec : kTiers)
+	{
+		bytes += static_cast<size_t>(m_metricCount) * (spec.bucketCount * sizeof(RollupBucket) + sizeof(int64_t));
+	}
+	return bytes;
+}
+
+_Use_decl_annotations_
+size_t RollupStore::SlotOffset(
+	const uint32_t tier,
+	const uint32_t metric,
+	const int64_t  bucketIndex)
+{
+	const uint32_t capacity = kTiers[tier].bucketCount;
+	return static_cast<size_t>(metric) * capacity + static_cast<size_t>(bucketIndex % capacity);
+}
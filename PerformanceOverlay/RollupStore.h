@@ -0,0 +1,155 @@
+/**
+ * @file RollupStore.h
+ * @brief Contains the declaration of the RollupStore class and the RollupBucket structure.
+ * @author Alessandro Bellia
+ * @date 10/15/2026
+ */
+
+#pragma once
+
+#include "Platform.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/**
+ * @struct RollupBucket
+ * @brief The aggregate of all samples of a metric that fell into one time bucket.
+ */
+struct RollupBucket
+{
+	float    min;    ///< Smallest sample value.
+	float    max;    ///< Largest sample value.
+	float    sum;    ///< Sum of the sample values, each multiplied by its weight.
+	float    weight; ///< Sum of the sample weights, in seconds.
+	uint32_t count;  ///< Number of samples; 0 means the bucket holds no data.
+
+	/**
+	 * @brief Gets the time-weighted mean of the samples in the bucket.
+	 * @return The mean value, or 0 for an empty bucket.
+	 */
+	[[nodiscard]] float Mean() const { return weight > 0.0f ? sum / weight : 0.0f; }
+};
+
+
+/**
+ * @struct RollupRange
+ * @brief Describes the buckets returned by RollupStore::Read().
+ */
+struct RollupRange
+{
+	int64_t  bucketNs;      ///< Duration of each bucket.
+	int64_t  firstBucketNs; ///< Start time of the first returned bucket.
+	uint32_t count;         ///< Number of buckets written to the output array.
+};
+
+
+/**
+ * @class RollupStore
+ * @brief Keeps hours of metric history in a few fixed-size tiers of min/max/mean/count buckets.
+ *
+ * Raw samples cascade into 1 s, 10 s, 1 min and 10 min tiers; each tier is a ring covering
+ * a longer span with coarser buckets, so memory grows logarithmically with the time kept.
+ * A reader asks for a time span and a bucket budget (typically the graph width in pixels)
+ * and gets the finest tier that covers the span within that budget, so a graph reads about
+ * one bucket per pixel whatever the span. The sampler thread is the only writer; readers
+ * copy the buckets out under a per-metric sequence lock and never block it.
+ *
+ * Sources are sampled at irregular intervals, so a bucket mean weighs every sample by the
+ * time since the metric's previous sample, the span its value describes: a reading held for
+ * two seconds counts eight times as much as one held for a quarter second.
+ */
+class RollupStore
+{
+public:
+	/**
+	 * @struct TierSpec
+	 * @brief The bucket duration and retention of one tier.
+	 */
+	struct TierSpec
+	{
+		int64_t  bucketNs;
+		uint32_t bucketCount;
+	};
+
+	/**
+	 * @brief The number of tiers.
+	 */
+	static constexpr uint32_t kTierCount = 4;
+
+	/**
+	 * @brief The tiers, finest first: 10 min of 1 s buckets, 1 h of 10 s buckets,
+	 *		  6 h of 1 min buckets and 24 h of 10 min buckets.
+	 */
+	static constexpr TierSpec kTiers[kTierCount] = {
+		{1'000'000'000LL, 600},
+		{10'000'000'000LL, 360},
+		{60'000'000'000LL, 360},
+		{600'000'000'000LL, 144},
+	};
+
+	RollupStore() = default;
+
+	RollupStore(const RollupStore& other)            = delete;
+	RollupStore& operator=(const RollupStore& other) = delete;
+
+	/**
+	 * @brief Allocates the tiers. Must be called before the producer starts.
+	 * @param[in] metricCount The number of metrics (ids 0 to metricCount - 1).
+	 */
+	void Configure(
+		_In_ uint32_t metricCount);
+
+	/**
+	 * @brief Folds a sample into the open bucket of every tier. Producer side only.
+	 * @param[in] metric The metric id.
+	 * @param[in] timestampNs The time the sample was taken.
+	 * @param[in] value The sample value.
+	 */
+	void Append(
+		_In_ uint32_t metric,
+		_In_ int64_t  timestampNs,
+		_In_ float    value);
+
+	/**
+	 * @brief Copies the buckets covering a time span from the finest tier that fits the budget.
+	 * @param[in] metric The metric id.
+	 * @param[in] fromNs The start of the span.
+	 * @param[in] toNs The end of the span.
+	 * @param[in] maxBuckets The maximum number of buckets to return, e.g. the graph width in pixels.
+	 * @param[out] buckets Receives up to maxBuckets buckets, oldest first. Empty buckets mark gaps.
+	 * @return The tier resolution, the start time of buckets[0] and the number of buckets written.
+	 */
+	RollupRange Read(
+		_In_ uint32_t                          metric,
+		_In_ int64_t                           fromNs,
+		_In_ int64_t                           toNs,
+		_In_ uint32_t                          maxBuckets,
+		_Out_writes_(maxBuckets) RollupBucket* buckets) const;
+
+	/**
+	 * @brief Gets the number of bytes held by the store.
+	 * @return The total size of all tiers and bookkeeping arrays.
+	 */
+	[[nodiscard]] size_t GetMemoryFootprint() const;
+
+private:
+	/**
+	 * @brief Gets the position of a bucket of a metric within a tier array.
+	 * @param[in] tier The tier index.
+	 * @param[in] metric The metric id.
+	 * @param[in] bucketIndex The absolute bucket index (timestamp / bucket duration).
+	 * @return The offset of the ring slot holding the bucket.
+	 */
+	[[nodiscard]] static size_t SlotOffset(
+		_In_ uint32_t tier,
+		_In_ uint32_t metric,
+		_In_ int64_t  bucketIndex);
+
+	std::unique_ptr<RollupBucket[]>          m_tiers[kTierCount];
+	std::unique_ptr<int64_t[]>               m_heads[kTierCount]; ///< Newest bucket index per metric.
+	std::unique_ptr<std::atomic<uint32_t>[]> m_sequences;         ///< Sequence lock per metric.
+	std::unique_ptr<int64_t[]>               m_lastTimestamps;    ///< Previous sample time per metric.
+	uint32_t                                 m_metricCount = 0;
+};
@@ -0,0 +1,441 @@
+/**
+ * @file Sampler.cpp
+ * @brief Contains the implementation of the Sampler class.
+ * @author Alessandro Bellia
+ * @date 10/15/2026
+ */
+
+#include "Sampler.h"
+#include <algorithm>
+
+
+Sampler::~Sampler()
+{
+	Stop();
+
+#ifdef _WIN32
+	if (m_publishEvent)
+	{
+		::CloseHandle(m_publishEvent);
+	}
+#endif
+}
+
+_Use_decl_annotations_
+bool Sampler::Start(
+	const std::chrono::nanoseconds interval,
+	const std::chrono::nanoseconds historyWindow)
+{
+	if (m_thread.joinable())
+	{
+		return true;
+	}
+
+	// Timestamps from here on read the TSC where it is usable.
+	TscClock::Calibrate();
+
+	SetInterval(interval);
+	m_historyWindow = historyWindow;
+	m_stopRequested = false;
+
+#ifdef _WIN32
+	if (!m_publishEvent)
+	{
+		m_publishEvent = ::CreateEvent(nullptr, FALSE, FALSE, nullptr);
+	}
+#endif
+
+	// The monitor is initialized on the sampler thread itself, so that thread-affine state
+	// (the COM apartment on Windows) belongs to the thread that will use it.
+	bool initialized = false;
+	bool ready       = false;
+	m_thread         = std::thread(&Sampler::Run, this, std::ref(initialized), std::ref(ready));
+
+	std::unique_lock lock(m_mutex);
+	m_wakeup.wait(lock, [&ready] { return ready; });
+	lock.unlock();
+
+	if (!initialized)
+	{
+		m_thread.join();
+		return false;
+	}
+
+	return true;
+}
+
+void Sampler::Stop()
+{
+	if (!m_thread.joinable())
+	{
+		return;
+	}
+
+	{
+		std::lock_guard lock(m_mutex);
+		m_stopRequested = true;
+	}
+	m_wakeup.notify_all();
+	m_thread.join();
+}
+
+_Use_decl_annotations_
+void Sampler::SetInterval(
+	const std::chrono::nanoseconds interval)
+{
+	m_intervalNs.store(std::max<int64_t>(interval.count(), 1), std::memory_order_relaxed);
+}
+
+_Use_decl_annotations_
+void Sampler::SetMaxInterval(
+	const std::chrono::nanoseconds maxInterval)
+{
+	m_maxIntervalNs.store(std::max<int64_t>(maxInterval.count(), 1), std::memory_order_relaxed);
+}
+
+_Use_decl_annotations_
+uint32_t Sampler::Subscribe(
+	const uint32_t*                metrics,
+	const uint32_t                 count,
+	const std::chrono::nanoseconds freshness)
+{
+	const uint32_t subscriber = m_subscriptions.Subscribe(metrics, count, freshness);
+
+	// Passing through the mutex orders the change before the sampler's next wait check.
+	{
+		std::lock_guard lock(m_mutex);
+	}
+	m_wakeup.notify_all();
+	return subscriber;
+}
+
+_Use_decl_annotations_
+void Sampler::Unsubscribe(
+	const uint32_t subscriber)
+{
+	m_subscriptions.Unsubscribe(subscriber);
+
+	{
+		std::lock_guard lock(m_mutex);
+	}
+	m_wakeup.notify_all();
+}
+
+_Use_decl_annotations_
+void Sampler::Run(
+	bool& initialized,
+	bool& ready)
+{
+	const bool monitorReady = m_monitor.Initialize(m_registry);
+	if (monitorReady)
+	{
+		if (!m_pluginDirectory.empty())
+		{
+			(void)m_plugins.LoadDirectory(m_pluginDirectory, m_registry);
+		}
+
+		// Sized after initialization, so metrics the monitor and the plugins registered are kept too.
+		const std::chrono::nanoseconds interval(m_intervalNs.load(std::memory_order_relaxed));
+		m_history.Configure(m_registry.GetCount(), m_historyWindow, interval);
+		m_rollups.Configure(m_registry.GetCount());
+		MemoryAccounting::Set(MemoryAccounting::SubsystemHistory, m_history.GetMemoryFootprint());
+		MemoryAccounting::Set(MemoryAccounting::SubsystemRollups, m_rollups.GetMemoryFootprint());
+		ScheduleSources(interval, std::chrono::nanoseconds(m_maxIntervalNs.load(std::memory_order_relaxed)));
+	}
+
+	{
+		std::lock_guard lock(m_mutex);
+		initialized = monitorReady;
+		ready       = true;
+	}
+	m_wakeup.notify_all();
+
+	if (!monitorReady)
+	{
+		return;
+	}
+
+	using Clock = std::chrono::steady_clock;
+
+	std::unique_lock lock(m_mutex);
+	while (!m_stopRequested)
+	{
+		lock.unlock();
+		const std::chrono::nanoseconds interval(m_intervalNs.load(std::memory_order_relaxed));
+		const std::chrono::nanoseconds maxInterval(m_maxIntervalNs.load(std::memory_order_relaxed));
+		SampleOnce(interval, maxInterval);
+		TscClock::Resync();
+		lock.lock();
+
+		// Sleep until the earliest deadline on the wheel, or until a subscription changes;
+		// TscClock nanoseconds share the steady_clock epoch. A source that overran its period
+		// has already been re-armed past it by the wheel, so missed deadlines are skipped
+		// rather than caught up.
+		const int64_t  nextNs     = std::min(m_scheduler.NextDeadlineNs(), TscClock::NowNs() + maxInterval.count());
+		const uint64_t generation = m_subscriptionGeneration;
+		m_wakeup.wait_until(lock, Clock::time_point(std::chrono::nanoseconds(nextNs)), [this, generation]
+		{
+			return m_stopRequested || m_subscriptions.GetGeneration() != generation;
+		});
+	}
+	lock.unlock();
+
+	m_plugins.UnloadAll();
+	m_monitor.Shutdown();
+}
+
+_Use_decl_annotations_
+void Sampler::ScheduleSources(
+	const std::chrono::nanoseconds interval,
+	const std::chrono::nanoseconds maxInterval)
+{
+	const uint32_t pluginCount = m_plugins.GetCount();
+	const int64_t  nowNs       = TscClock::NowNs();
+	m_producerCount            = PerformanceMonitor::SourceCount + pluginCount;
+	m_scheduler.Configure(m_producerCount, nowNs);
+
+	// Every producer starts parked; the first sample gives the subscribed ones a timer. The
+	// monitor's sources start at the phase they declare. Plugins start half an interval in,
+	// so a slow plugin call does not delay the system sources it would otherwise share
+	// every wakeup with.
+	for (uint32_t producer = 0; producer < m_producerCount; producer++)
+	{
+		SetProducerRange(producer, interval, maxInterval);
+
+		Producer& entry        = m_producers[producer];
+		entry.timer            = TimerWheel::kInvalidTimer;
+		entry.freshnessNs      = MetricSubscriptions::kUnsubscribed;
+		entry.phaseNs          = producer < PerformanceMonitor::SourceCount
+			                         ? std::chrono::nanoseconds(PerformanceMonitor::GetSourcePhase(producer)).count()
+			                         : (interval / 2).count();
+		entry.parkedSinceNs    = nowNs;
+		entry.parkedIntervalNs = GetProducerIntervalNs(producer);
+	}
+
+	std::fill_n(m_metricProducers, MetricRegistry::kMaxMetrics, kMaxProducers);
+	for (uint32_t metric = 0; metric < m_registry.GetCount(); metric++)
+	{
+		const PerformanceMonitor::Source source = m_monitor.GetMetricSource(metric);
+		if (source != PerformanceMonitor::SourceCount)
+		{
+			m_metricProducers[metric] = source;
+		}
+	}
+	for (uint32_t index = 0; index < pluginCount; index++)
+	{
+		std::fill_n(m_metricProducers + m_plugins.GetFirstMetric(index), m_plugins.GetMetricCount(index),
+		            PerformanceMonitor::SourceCount + index);
+	}
+}
+
+void Sampler::ApplySubscriptions()
+{
+	if (m_subscriptions.GetGeneration() == m_subscriptionGeneration)
+	{
+		return;
+	}
+
+	int64_t        freshnessNs[MetricRegistry::kMaxMetrics];
+	const uint32_t metricCount = m_registry.GetCount();
+	m_subscriptionGeneration   = m_subscriptions.Collect(freshnessNs, metricCount);
+
+	for (uint32_t producer = 0; producer < m_producerCount; producer++)
+	{
+		m_producers[producer].freshnessNs = MetricSubscriptions::kUnsubscribed;
+	}
+	for (uint32_t metric = 0; metric < metricCount; metric++)
+	{
+		const uint32_t producer = m_metricProducers[metric];
+		if (producer < m_producerCount)
+		{
+			int64_t& fastest = m_producers[producer].freshnessNs;
+			fastest          = std::min(fastest, freshnessNs[metric]);
+		}
+	}
+}
+
+_Use_decl_annotations_
+void Sampler::UpdateProducers(
+	const int64_t                  nowNs,
+	const std::chrono::nanoseconds interval,
+	const std::chrono::nanoseconds maxInterval)
+{
+	uint64_t avoidedOpen = 0;
+	for (uint32_t producer = 0; producer < m_producerCount; producer++)
+	{
+		Producer&  entry   = m_producers[producer];
+		const bool enabled = IsProducerEnabled(producer);
+		const bool wanted  = enabled && entry.freshnessNs != MetricSubscriptions::kUnsubscribed;
+
+		if (wanted)
+		{
+			// The rate may still back off, but never past what the subscribers accept.
+			const std::chrono::nanoseconds ceiling = std::max(interval, maxInterval);
+			SetProducerRange(producer, interval, std::clamp(std::chrono::nanoseconds(entry.freshnessNs), interval, ceiling));
+
+			if (entry.timer == TimerWheel::kInvalidTimer)
+			{
+				m_avoidedReadsClosed += static_cast<uint64_t>((nowNs - entry.parkedSinceNs) / entry.parkedIntervalNs);
+
+				const int64_t phaseNs = std::max<int64_t>(entry.parkedSinceNs + entry.phaseNs - nowNs, 0);
+				entry.timer           = m_scheduler.Add(nowNs, std::chrono::nanoseconds(GetProducerIntervalNs(producer)),
+				                                        std::chrono::nanoseconds(phaseNs), producer);
+			}
+		}
+		else if (entry.timer != TimerWheel::kInvalidTimer)
+		{
+			m_scheduler.Cancel(entry.timer);
+			entry.timer            = TimerWheel::kInvalidTimer;
+			entry.parkedSinceNs    = nowNs;
+			entry.parkedIntervalNs = GetProducerIntervalNs(producer);
+		}
+
+		if (enabled && entry.timer == TimerWheel::kInvalidTimer)
+		{
+			avoidedOpen += static_cast<uint64_t>((nowNs - entry.parkedSinceNs) / entry.parkedIntervalNs);
+		}
+	}
+	m_avoidedReads.store(m_avoidedReadsClosed + avoidedOpen, std::memory_order_relaxed);
+}
+
+_Use_decl_annotations_
+void Sampler::SetProducerRange(
+	const uint32_t                 producer,
+	const std::chrono::nanoseconds minInterval,
+	const std::chrono::nanoseconds maxInterval)
+{
+	if (producer < PerformanceMonitor::SourceCount)
+	{
+		m_monitor.SetIntervalRange(producer, minInterval, maxInterval);
+	}
+	else
+	{
+		m_plugins.SetIntervalRange(producer - PerformanceMonitor::SourceCount, minInterval, maxInterval);
+	}
+}
+
+_Use_decl_annotations_
+int64_t Sampler::GetProducerIntervalNs(
+	const uint32_t producer) const
+{
+	return producer < PerformanceMonitor::SourceCount
+		       ? m_monitor.GetSourceIntervalNs(producer)
+		       : m_plugins.GetIntervalNs(producer - PerformanceMonitor::SourceCount);
+}
+
+_Use_decl_annotations_
+bool Sampler::IsProducerEnabled(
+	const uint32_t producer) const
+{
+	return producer < PerformanceMonitor::SourceCount || m_plugins.IsEnabled(producer - PerformanceMonitor::SourceCount);
+}
+
+_Use_decl_annotations_
+void Sampler::SampleOnce(
+	const std::chrono::nanoseconds interval,
+	const std::chrono::nanoseconds maxInterval)
+{
+	ScopedStageTimer timer(StageProfiler::StageSample);
+
+	const int64_t timestampNs = TscClock::NowNs();
+
+	// Cheap enough to apply every wakeup, which keeps the setters free of cross-thread calls.
+	ApplySubscriptions();
+	UpdateProducers(timestampNs, interval, maxInterval);
+
+#ifdef _WIN32
+	m_sampleArena.Reset();
+#endif
+	m_registry.BeginSample();
+
+	// Each fired source picks the interval to its next deadline from its adaptive rate.
+	(void)m_scheduler.Advance(timestampNs, [this](const uint32_t timer, const uint32_t producer)
+	{
+		if (producer >= PerformanceMonitor::SourceCount)
+		{
+			if (!m_plugins.Sample(producer - PerformanceMonitor::SourceCount))
+			{
+				m_scheduler.Cancel(timer); // Disabled for good
+				m_producers[producer].timer = TimerWheel::kInvalidTimer;
+				return;
+			}
+		}
+		else
+		{
+#ifdef _WIN32
+			m_monitor.UpdateSource(static_cast<PerformanceMonitor::Source>(producer), m_sampleArena);
+#else
+			m_monitor.UpdateSource(static_cast<PerformanceMonitor::Source>(producer));
+#endif
+		}
+		m_scheduler.SetInterval(timer, GetProducerIntervalNs(producer));
+	});
+
+	// Only the metrics refreshed by this sample are recorded, each under its own timestamp,
+	// so a stable source that was skipped does not repeat its old value into the history.
+	const float*   values       = m_registry.GetValues();
+	const uint32_t historyCount = m_history.GetMetricCount();
+	bool           updated      = false;
+	for (uint32_t metric = 0; metric < historyCount; metric++)
+	{
+		if (m_registry.WasUpdated(metric))
+		{
+			m_history.Append(metric, timestampNs, values[metric]);
+			m_rollups.Append(metric, timestampNs, values[metric]);
+			updated = true;
+		}
+	}
+
+	if (!updated)
+	{
+		return;
+	}
+	if (m_registry.WasUpdated(MetricCpuLoad))
+	{
+		m_coreSequence = m_sequence + 1;
+	}
+	if (m_registry.WasUpdated(MetricProcessCount))
+	{
+		m_processSequence = m_sequence + 1;
+		MemoryAccounting::Set(MemoryAccounting::SubsystemProcesses, m_monitor.GetProcesses().GetMemoryFootprint());
+	}
+
+	PerformanceSnapshot& snapshot = m_snapshots.WriteSlot();
+	snapshot.sequence             = ++m_sequence;
+	snapshot.coreSequence         = m_coreSequence;
+	snapshot.timestampNs          = timestampNs;
+	snapshot.metricCount          = m_registry.GetCount();
+	std::copy_n(values, snapshot.metricCount, snapshot.values);
+
+	const float* coreLoads = m_monitor.GetCoreLoads();
+	snapshot.coreLoads.assign(coreLoads, coreLoads + m_monitor.GetCoreCount());
+
+	const ProcessTable& processes = m_monitor.GetProcesses();
+	snapshot.topCpuCount          = processes.GetTopCpuCount();
+	snapshot.topRssCount          = processes.GetTopRssCount();
+	snapshot.topIoCount           = processes.GetTopIoCount();
+	snapshot.topWaitCount         = processes.GetTopWaitCount();
+	snapshot.ioDeniedCount        = processes.GetIoDeniedCount();
+	std::copy_n(processes.GetTopCpu(), snapshot.topCpuCount, snapshot.topCpu);
+	std::copy_n(processes.GetTopRss(), snapshot.topRssCount, snapshot.topRss);
+	std::copy_n(processes.GetTopIo(), snapshot.topIoCount, snapshot.topIo);
+	std::copy_n(processes.GetTopWait(), snapshot.topWaitCount, snapshot.topWait);
+	snapshot.cpuWaits.assign(processes.GetCpuWaits(), processes.GetCpuWaits() + processes.GetCpuWaitCount());
+
+	// A slot keeps its process list until the next rescan reaches it, so each scan is
+	// copied at most once per slot rather than into every snapshot.
+	if (snapshot.processSequence != m_processSequence)
+	{
+		processes.CopySamples(snapshot.processes);
+		snapshot.processSequence = m_processSequence;
+	}
+
+	m_snapshots.Publish();
+
+#ifdef _WIN32
+	if (m_publishEvent)
+	{
+		::SetEvent(m_publishEvent);
+	}
+#endif
+}
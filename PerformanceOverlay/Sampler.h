@@ -0,0 +1,332 @@
+/**
+ * @file Sampler.h
+ * @brief Contains the declaration of the Sampler class.
+ * @author Alessandro Bellia
+ * @date 10/15/2026
+ */
+
+#pragma once
+
+#include "Platform.h"
+#include "AdaptiveRate.h"
+#include "BumpArena.h"
+#include "MetricHistory.h"
+#include "MetricRegistry.h"
+#include "MetricSubscriptions.h"
+#include "PerformanceMonitor.h"
+#include "PerformanceSnapshot.h"
+#include "PluginHost.h"
+#include "RollupStore.h"
+#include "StageProfiler.h"
+#include "TimerWheel.h"
+#include "TscClock.h"
+#include "TripleBuffer.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+
+/**
+ * @class Sampler
+ * @brief Runs the PerformanceMonitor on a dedicated thread and publishes each result as an
+ *		  immutable PerformanceSnapshot.
+ *
+ * Every source of the monitor and every plugin has its own timer on a TimerWheel, and the
+ * thread sleeps until the earliest deadline, so each source is read on its own schedule
+ * rather than on a shared tick. Deadlines are absolute, so a period does not drift by the
+ * time spent collecting, and deadlines within the wheel's coalescing window share one
+ * wakeup. The sampling interval is the floor of an adaptive range: after each read, the
+ * source's AdaptiveRate sets the interval to its next deadline, backing off towards the
+ * maximum interval while its values are stable.
+ *
+ * Collection is lazy: a source only runs while one of its metrics has a subscriber (a UI
+ * panel or an exporter, see Subscribe()), and its interval never backs off past the
+ * fastest freshness any subscriber asked for. A source without subscribers is taken off
+ * the wheel, and the reads it would have made are counted as avoided. The snapshot hand-off is a TripleBuffer: the render thread never blocks
+ * on collection and the sampler thread never blocks on rendering. The metrics a sample refreshed
+ * are also appended, with its timestamp, to a MetricHistory that readers can view without
+ * copying, and folded into a RollupStore that keeps the last 24 hours at decreasing
+ * resolution; both keep each metric's own, irregular timestamps.
+ * On Windows, collectors take their per-sample scratch from a BumpArena that is reset before
+ * each sample; procfs needs none beyond the buffer sized at discovery.
+ * Values are written to a MetricRegistry by metric id; the history and rollups keep every
+ * metric registered by the time the monitor and the plugins are initialized. Metric-provider
+ * plugins are loaded and sampled by a PluginHost on the same thread, right after the monitor.
+ */
+class Sampler
+{
+public:
+	/**
+	 * @brief The sampling interval used when none is specified.
+	 */
+	static constexpr std::chrono::milliseconds kDefaultInterval = AdaptiveRate::kDefaultMinInterval;
+
+	/**
+	 * @brief The longest interval a stable source backs off to when none is specified.
+	 */
+	static constexpr std::chrono::milliseconds kDefaultMaxInterval = AdaptiveRate::kDefaultMaxInterval;
+
+	/**
+	 * @brief The history window used when none is specified.
+	 */
+	static constexpr std::chrono::seconds kDefaultHistoryWindow{60};
+
+	Sampler() = default;
+	~Sampler();
+
+	Sampler(const Sampler& other)     = delete;
+	Sampler(Sampler&& other) noexcept = delete;
+
+	Sampler& operator=(const Sampler& other)     = delete;
+	Sampler& operator=(Sampler&& other) noexcept = delete;
+
+	/**
+	 * @brief Sets the directory metric-provider plugins are loaded from. Must be called before Start().
+	 * @param[in] directory The plugin directory; empty (the default) loads no plugins.
+	 */
+	void SetPluginDirectory(
+		_In_ const std::filesystem::path& directory) { m_pluginDirectory = directory; }
+
+	/**
+	 * @brief Starts the sampler thread and waits until the monitor has been initialized on it.
+	 * @param[in] interval The shortest interval a source is sampled at.
+	 * @param[in] historyWindow The time span kept in the metric history. Its capacity is sized for
+	 *			  interval, so shortening the interval later also shortens the span actually kept.
+	 * @return True if the monitor was initialized and the thread is running, false otherwise.
+	 */
+	bool Start(
+		_In_ std::chrono::nanoseconds interval      = kDefaultInterval,
+		_In_ std::chrono::nanoseconds historyWindow = kDefaultHistoryWindow);
+
+	/**
+	 * @brief Stops the sampler thread and waits for it to exit. Safe to call more than once.
+	 */
+	void Stop();
+
+	/**
+	 * @brief Changes the sampling interval. Takes effect from each source's next deadline.
+	 * @param[in] interval The new shortest interval a source is sampled at.
+	 */
+	void SetInterval(
+		_In_ std::chrono::nanoseconds interval);
+
+	/**
+	 * @brief Changes the longest interval a stable source backs off to. Takes effect from each source's next deadline.
+	 * @param[in] maxInterval The new maximum; never below the sampling interval.
+	 */
+	void SetMaxInterval(
+		_In_ std::chrono::nanoseconds maxInterval);
+
+	/**
+	 * @brief Gets the most recently published snapshot. Must only be called from one (the render) thread.
+	 * @return A reference that stays valid and unchanged until the next call to Latest().
+	 */
+	const PerformanceSnapshot& Latest() { return m_snapshots.Read(); }
+
+	/**
+	 * @brief Checks whether a snapshot newer than the one returned by the last Latest() is available.
+	 * @return True if the sampler has published since the last Latest().
+	 */
+	[[nodiscard]] bool HasUpdate() const { return m_snapshots.HasUpdate(); }
+
+	/**
+	 * @brief Gets the registry describing every metric in the snapshots, history and rollups.
+	 * @return A reference to the registry; its descriptors are safe to read from any thread.
+	 */
+	[[nodiscard]] const MetricRegistry& GetRegistry() const { return m_registry; }
+
+	/**
+	 * @brief Gets the timestamped history of every metric. Safe to read from any thread.
+	 * @return A reference to the history.
+	 */
+	[[nodiscard]] const MetricHistory& GetHistory() const { return m_history; }
+
+	/**
+	 * @brief Gets the long-term rollups of every metric. Safe to read from any thread.
+	 * @return A reference to the rollup store.
+	 */
+	[[nodiscard]] const RollupStore& GetRollups() const { return m_rollups; }
+
+	/**
+	 * @brief Gets the loaded metric-provider plugins. Safe to read from any thread after Start().
+	 * @return A reference to the plugin host.
+	 */
+	[[nodiscard]] const PluginHost& GetPlugins() const { return m_plugins; }
+
+	/**
+	 * @brief Gets the scheduler running the sources. Its statistics are safe to read from any thread.
+	 * @return A reference to the timer wheel.
+	 */
+	[[nodiscard]] const TimerWheel& GetScheduler() const { return m_scheduler; }
+
+	/**
+	 * @brief Subscribes to a set of metrics, so the sources writing them are read. Safe to
+	 *		  call from any thread, before or after Start(); the sampler picks it up at once.
+	 * @param[in] metrics The metric ids.
+	 * @param[in] count The number of ids; at most MetricSubscriptions::kMaxMetricsPerSubscriber.
+	 * @param[in] freshness The oldest a value may be when it is read. The sources are read at
+	 *			  least this often, but never more often than the sampling interval.
+	 * @return The subscription's id, or MetricSubscriptions::kInvalidSubscriber if there is
+	 *		   no room for another one.
+	 */
+	uint32_t Subscribe(
+		_In_reads_(count) const uint32_t* metrics,
+		_In_ uint32_t                     count,
+		_In_ std::chrono::nanoseconds     freshness);
+
+	/**
+	 * @brief Ends a subscription. Sources left without subscribers stop being read. Safe to
+	 *		  call from any thread, and with MetricSubscriptions::kInvalidSubscriber.
+	 * @param[in] subscriber The subscription's id.
+	 */
+	void Unsubscribe(
+		_In_ uint32_t subscriber);
+
+	/**
+	 * @brief Gets the number of source reads skipped because nobody subscribed to the
+	 *		  source's metrics, counted at the interval the source was last read at. Safe
+	 *		  to read from any thread.
+	 * @return The count.
+	 */
+	[[nodiscard]] uint64_t GetAvoidedReads() const { return m_avoidedReads.load(std::memory_order_relaxed); }
+
+#ifdef _WIN32
+	/**
+	 * @brief Gets the auto-reset event signaled every time a snapshot is published, so the
+	 *		  render loop can block until there is something new to draw.
+	 * @return The event handle, owned by the sampler; null before Start().
+	 */
+	[[nodiscard]] HANDLE GetPublishEvent() const { return m_publishEvent; }
+#endif
+
+private:
+	/**
+	 * @brief The body of the sampler thread.
+	 * @param[out] initialized Set to the result of PerformanceMonitor::Initialize() once it is known.
+	 * @param[out] ready Set once initialized holds its final value.
+	 */
+	void Run(
+		_Out_ bool& initialized,
+		_Out_ bool& ready);
+
+	/**
+	 * @brief Sets up a producer for every monitor source and every loaded plugin, and maps
+	 *		  every metric to its producer. Producers start without a timer.
+	 * @param[in] interval The sampling interval.
+	 * @param[in] maxInterval The maximum interval.
+	 */
+	void ScheduleSources(
+		_In_ std::chrono::nanoseconds interval,
+		_In_ std::chrono::nanoseconds maxInterval);
+
+	/**
+	 * @brief Recomputes the freshness each producer's subscribers ask for, if any
+	 *		  subscription changed since the last call.
+	 */
+	void ApplySubscriptions();
+
+	/**
+	 * @brief Adapts every producer's interval range to its subscribers, adds a timer for
+	 *		  the producers that gained a subscriber, removes the timers of the ones that lost
+	 *		  their last, and updates the avoided read count.
+	 * @param[in] nowNs The current time.
+	 * @param[in] interval The current sampling interval.
+	 * @param[in] maxInterval The current maximum interval.
+	 */
+	void UpdateProducers(
+		_In_ int64_t                  nowNs,
+		_In_ std::chrono::nanoseconds interval,
+		_In_ std::chrono::nanoseconds maxInterval);
+
+	/**
+	 * @brief Sets the range a producer's sampling interval adapts within.
+	 * @param[in] producer The producer.
+	 * @param[in] minInterval The shortest interval.
+	 * @param[in] maxInterval The longest interval.
+	 */
+	void SetProducerRange(
+		_In_ uint32_t                 producer,
+		_In_ std::chrono::nanoseconds minInterval,
+		_In_ std::chrono::nanoseconds maxInterval);
+
+	/**
+	 * @brief Gets a producer's current sampling interval.
+	 * @param[in] producer The producer.
+	 * @return The interval in nanoseconds.
+	 */
+	[[nodiscard]] int64_t GetProducerIntervalNs(
+		_In_ uint32_t producer) const;
+
+	/**
+	 * @brief Checks whether a producer can run at all; a plugin disabled for going over budget cannot.
+	 * @param[in] producer The producer.
+	 * @return True if the producer can run.
+	 */
+	[[nodiscard]] bool IsProducerEnabled(
+		_In_ uint32_t producer) const;
+
+	/**
+	 * @brief Collects the sources that are due and publishes the result.
+	 * @param[in] interval The current sampling interval.
+	 * @param[in] maxInterval The current maximum interval.
+	 */
+	void SampleOnce(
+		_In_ std::chrono::nanoseconds interval,
+		_In_ std::chrono::nanoseconds maxInterval);
+
+	MetricRegistry                    m_registry;
+	PerformanceMonitor                m_monitor;
+	PluginHost                        m_plugins;
+	TripleBuffer<PerformanceSnapshot> m_snapshots;
+	MetricHistory                     m_history;
+	RollupStore                       m_rollups;
+	TimerWheel                        m_scheduler;
+	MetricSubscriptions               m_subscriptions;
+	uint64_t                          m_sequence        = 0;
+	uint64_t                          m_coreSequence    = 0; ///< The sequence of the last sample that read the CPU source.
+	uint64_t                          m_processSequence = 0; ///< The sequence of the last sample that rescanned the processes.
+
+	/**
+	 * @brief The number of producers: the monitor's sources, then the plugins.
+	 */
+	static constexpr uint32_t kMaxProducers = PerformanceMonitor::SourceCount + PluginHost::kMaxPlugins;
+
+	/**
+	 * @struct Producer
+	 * @brief One independently scheduled source: a monitor Source, or a plugin at
+	 *		  index - PerformanceMonitor::SourceCount. Its timer is tagged with its index.
+	 */
+	struct Producer
+	{
+		uint32_t timer;            ///< TimerWheel::kInvalidTimer while parked.
+		int64_t  freshnessNs;      ///< The fastest freshness asked for, or MetricSubscriptions::kUnsubscribed.
+		int64_t  phaseNs;          ///< The delay of the first read after the producer was parked.
+		int64_t  parkedSinceNs;    ///< When the producer lost its timer.
+		int64_t  parkedIntervalNs; ///< Its interval at that time.
+	};
+
+	Producer m_producers[kMaxProducers]                     = {};
+	uint32_t m_producerCount                                = 0;
+	uint32_t m_metricProducers[MetricRegistry::kMaxMetrics] = {};         ///< The producer of each metric, or kMaxProducers.
+	uint64_t m_subscriptionGeneration                       = UINT64_MAX; ///< The generation last applied.
+	uint64_t m_avoidedReadsClosed                           = 0;          ///< Avoided reads of parks that have ended.
+
+	std::atomic<uint64_t> m_avoidedReads{0};
+
+	std::thread             m_thread;
+	std::mutex              m_mutex;
+	std::condition_variable m_wakeup;
+	bool                    m_stopRequested = false;
+
+	std::atomic<int64_t>     m_intervalNs{std::chrono::nanoseconds(kDefaultInterval).count()};
+	std::atomic<int64_t>     m_maxIntervalNs{std::chrono::nanoseconds(kDefaultMaxInterval).count()};
+	std::chrono::nanoseconds m_historyWindow{kDefaultHistoryWindow};
+	std::filesystem::path    m_pluginDirectory;
+
+#ifdef _WIN32
+	HANDLE    m_publishEvent = nullptr;
+	BumpArena m_sampleArena{MemoryAccounting::SubsystemSampleArena};
+#endif
+};
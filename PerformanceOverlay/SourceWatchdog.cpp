@@ -0,0 +1,96 @@
+/**
+ * @file SourceWatchdog.cpp
+ * @brief Contains the implementation of the SourceWatchdog class.
+ * @author Alessandro Bellia
+ * @date 10/15/2026
+ */
+
+#include "SourceWatchdog.h"
+#include <algorithm>
+#include <cstdio>
+
+_Use_decl_annotations_
+uint32_t SourceWatchdog::Add(
+	const char*     name,
+	MetricRegistry& registry)
+{
+	if (m_count == kMaxSources)
+	{
+		return kInvalidSource;
+	}
+
+	m_pRegistry = &registry;
+
+	Source& source    = m_sources[m_count];
+	source            = {};
+	source.deadlineNs = std::chrono::nanoseconds(kDefaultDeadline).count();
+
+	char metricName[MetricRegistry::kMaxNameLength];
+	(void)std::snprintf(metricName, sizeof(metricName), "source.%s.state", name);
+	source.stateMetric = registry.Register(metricName, MetricUnitCount, 0.0f, static_cast<float>(StateFailing), MetricSourceMonitor);
+	(void)std::snprintf(metricName, sizeof(metricName), "source.%s.latency", name);
+	source.latencyMetric = registry.Register(metricName, MetricUnitMicroseconds, 0.0f, 0.0f, MetricSourceMonitor);
+
+	return m_count++;
+}
+
+_Use_decl_annotations_
+long SourceWatchdog::GetDeadlineMs(
+	const uint32_t source) const
+{
+	return static_cast<long>(std::max<int64_t>(m_sources[source].deadlineNs / 1'000'000, 1));
+}
+
+_Use_decl_annotations_
+uint32_t SourceWatchdog::FindSource(
+	const uint32_t metric) const
+{
+	for (uint32_t index = 0; index < m_count; index++)
+	{
+		if (m_sources[index].stateMetric == metric || m_sources[index].latencyMetric == metric)
+		{
+			return index;
+		}
+	}
+	return kInvalidSource;
+}
+
+_Use_decl_annotations_
+bool SourceWatchdog::IsDue(
+	const uint32_t source)
+{
+	Source& state = m_sources[source];
+	if (state.skipRemaining == 0)
+	{
+		return true;
+	}
+	state.skipRemaining--;
+	return false;
+}
+
+_Use_decl_annotations_
+void SourceWatchdog::Report(
+	const uint32_t source,
+	const bool     succeeded,
+	const int64_t  latencyNs)
+{
+	Source& state   = m_sources[source];
+	state.latencyNs = latencyNs;
+
+	if (succeeded && latencyNs <= state.deadlineNs)
+	{
+		state.misses        = 0;
+		state.skipRemaining = 0;
+		state.state         = StateOk;
+	}
+	else
+	{
+		// Back off 1, 2, 4, ... samples; the shift is capped well before it could overflow.
+		state.misses++;
+		state.skipRemaining = std::min(1u << std::min(state.misses - 1, 31u), kMaxBackoffSamples);
+		state.state         = state.misses >= kFailingAfter ? StateFailing : StateStale;
+	}
+
+	m_pRegistry->SetValue(state.stateMetric, static_cast<float>(state.state));
+	m_pRegistry->SetValue(state.latencyMetric, static_cast<float>(latencyNs) / 1e3f);
+}
@@ -0,0 +1,187 @@
+/**
+ * @file SourceWatchdog.h
+ * @brief Contains the declaration of the SourceWatchdog class.
+ * @author Alessandro Bellia
+ * @date 10/15/2026
+ */
+
+#pragma once
+
+#include "Platform.h"
+#include "MetricRegistry.h"
+#include "TscClock.h"
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @class SourceWatchdog
+ * @brief Runs the metric sources of a collector under a per-sample deadline and tracks
+ *		  their health.
+ *
+ * A source is one independent group of readings, such as the CPU counters or the disk
+ * statistics. Run() times each call. A call that fails or overruns the source's deadline
+ * marks the source stale; its metrics keep their last value, and the source is skipped for
+ * an exponentially growing number of samples (1, 2, 4, ... up to kMaxBackoffSamples) before
+ * it is retried, so a slow source stops costing the other sources its full latency on every
+ * sample. After kFailingAfter misses in a row the source is reported as failing. The first
+ * call that succeeds in time makes it ok again.
+ *
+ * The deadline is checked after the call returns; calls that can block take the deadline
+ * from GetDeadlineMs() and pass it on as their own timeout. Every source publishes its state
+ * and the latency of its last call as the metrics "source.<name>.state" (a State value) and
+ * "source.<name>.latency" (in microseconds). All methods belong to the collector's thread.
+ */
+class SourceWatchdog
+{
+public:
+	/**
+	 * @brief The health of a source.
+	 */
+	enum State : uint8_t
+	{
+		StateOk = 0, ///< The last call succeeded within its deadline
+		StateStale,  ///< The last call missed; the metrics hold older values
+		StateFailing ///< kFailingAfter or more calls in a row missed
+	};
+
+	/**
+	 * @brief The most sources one watchdog tracks.
+	 */
+	static constexpr uint32_t kMaxSources = 8;
+
+	/**
+	 * @brief The deadline of a source when none is set.
+	 */
+	static constexpr std::chrono::milliseconds kDefaultDeadline{100};
+
+	/**
+	 * @brief The number of consecutive misses after which a source is failing.
+	 */
+	static constexpr uint32_t kFailingAfter = 3;
+
+	/**
+	 * @brief The most samples a source is skipped for between two retries.
+	 */
+	static constexpr uint32_t kMaxBackoffSamples = 64;
+
+	/**
+	 * @brief Returned by Add() when there is no room for another source.
+	 */
+	static constexpr uint32_t kInvalidSource = UINT32_MAX;
+
+	SourceWatchdog() = default;
+
+	SourceWatchdog(const SourceWatchdog& other)            = delete;
+	SourceWatchdog& operator=(const SourceWatchdog& other) = delete;
+
+	/**
+	 * @brief Adds a source and registers its health metrics.
+	 * @param[in] name The source's short name, e.g. "cpu".
+	 * @param[in,out] registry The registry the health metrics are registered in and written
+	 *				  to. It must outlive the watchdog.
+	 * @return The source's index, or kInvalidSource if the watchdog is full.
+	 */
+	uint32_t Add(
+		_In_z_ const char*      name,
+		_Inout_ MetricRegistry& registry);
+
+	/**
+	 * @brief Runs one call of a source, unless the source is backing off, and records its outcome.
+	 * @param[in] source The source's index.
+	 * @param[in] update The call; returns true if it refreshed the source's metrics.
+	 */
+	template <typename Update>
+	void Run(
+		_In_ uint32_t source,
+		_In_ Update   update)
+	{
+		if (!IsDue(source))
+		{
+			return;
+		}
+
+		const uint64_t start     = TscClock::Now();
+		const bool     succeeded = update();
+		Report(source, succeeded, TscClock::DurationNs(TscClock::Now() - start));
+	}
+
+	/**
+	 * @brief Sets the deadline of one source.
+	 * @param[in] source The source's index.
+	 * @param[in] deadline The longest one call of the source may take.
+	 */
+	void SetDeadline(
+		_In_ uint32_t                 source,
+		_In_ std::chrono::nanoseconds deadline) { m_sources[source].deadlineNs = deadline.count(); }
+
+	/**
+	 * @brief Gets the deadline of a source, for calls that accept a timeout.
+	 * @param[in] source The source's index.
+	 * @return The deadline in milliseconds, at least 1.
+	 */
+	[[nodiscard]] long GetDeadlineMs(
+		_In_ uint32_t source) const;
+
+	/**
+	 * @brief Gets the health of a source.
+	 * @param[in] source The source's index.
+	 * @return The state.
+	 */
+	[[nodiscard]] State GetState(
+		_In_ uint32_t source) const { return m_sources[source].state; }
+
+	/**
+	 * @brief Gets how long the last call of a source took.
+	 * @param[in] source The source's index.
+	 * @return The latency in nanoseconds.
+	 */
+	[[nodiscard]] int64_t GetLatencyNs(
+		_In_ uint32_t source) const { return m_sources[source].latencyNs; }
+
+	/**
+	 * @brief Finds the source a health metric belongs to.
+	 * @param[in] metric The metric's id.
+	 * @return The source, or kInvalidSource if the metric is not a health metric of this watchdog.
+	 */
+	[[nodiscard]] uint32_t FindSource(
+		_In_ uint32_t metric) const;
+
+private:
+	/**
+	 * @struct Source
+	 * @brief The deadline and backoff state of one source.
+	 */
+	struct Source
+	{
+		int64_t  deadlineNs;
+		int64_t  latencyNs;     ///< The duration of the last call.
+		uint32_t misses;        ///< Consecutive failed or late calls.
+		uint32_t skipRemaining; ///< Samples left to skip before the next retry.
+		uint32_t stateMetric;
+		uint32_t latencyMetric;
+		State    state;
+	};
+
+	/**
+	 * @brief Checks whether a source should run in this sample, counting down its backoff.
+	 * @param[in] source The source's index.
+	 * @return True if the source should be called.
+	 */
+	bool IsDue(
+		_In_ uint32_t source);
+
+	/**
+	 * @brief Records the outcome of a call and updates the source's state, backoff and metrics.
+	 * @param[in] source The source's index.
+	 * @param[in] succeeded Whether the call refreshed the source's metrics.
+	 * @param[in] latencyNs How long the call took.
+	 */
+	void Report(
+		_In_ uint32_t source,
+		_In_ bool     succeeded,
+		_In_ int64_t  latencyNs);
+
+	Source          m_sources[kMaxSources] = {};
+	uint32_t        m_count                = 0;
+	MetricRegistry* m_pRegistry            = nullptr;
+};
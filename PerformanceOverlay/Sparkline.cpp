@@ -0,0 +1,114 @@
+/**
+ * @file Sparkline.cpp
+ * @brief Contains the implementation of the batched sparkline renderer.
+ * @author Alessandro Bellia
+ * @date 10/15/2026
+ */
+
+#include "Sparkline.h"
+#include <cmath>
+
+_Use_decl_annotations_
+void DrawSparkline(
+	ImDrawList*   drawList,
+	const ImVec2& pos,
+	const ImVec2& size,
+	const float*  values,
+	uint32_t      count,
+	const float   scaleMin,
+	const float   scaleMax,
+	const ImU32   lineColor,
+	const ImU32   fillColor,
+	const float   thickness)
+{
+	count = count < kMaxSparklinePoints ? count : kMaxSparklinePoints;
+	if (count < 2 || size.x <= 0.0f || size.y <= 0.0f)
+	{
+		return;
+	}
+
+	// Map the series to screen space first, in a loop with no branches that vectorizes.
+	float xs[kMaxSparklinePoints];
+	float ys[kMaxSparklinePoints];
+
+	const float stepX  = size.x / static_cast<float>(count - 1);
+	const float range  = scaleMax - scaleMin;
+	const float scaleY = range != 0.0f ? size.y / range : 0.0f;
+	const float bottom = pos.y + size.y;
+	for (uint32_t i = 0; i < count; i++)
+	{
+		float height = (values[i] - scaleMin) * scaleY;
+		height       = height > 0.0f ? height : 0.0f;
+		height       = height < size.y ? height : size.y;
+		xs[i]        = pos.x + static_cast<float>(i) * stepX;
+		ys[i]        = bottom - height;
+	}
+
+	// Fill: two vertices per point (on the line and on the bottom edge), one quad per segment.
+	// Line: one quad per segment, offset along the segment's normal.
+	const bool     filled    = (fillColor & IM_COL32_A_MASK) != 0;
+	const uint32_t segments  = count - 1;
+	const uint32_t fillVtx   = filled ? 2 * count : 0;
+	const uint32_t fillIdx   = filled ? 6 * segments : 0;
+	const uint32_t lineVtx   = 4 * segments;
+	const uint32_t lineIdx   = 6 * segments;
+	const ImVec2   uv        = ImGui::GetFontTexUvWhitePixel();
+	const float    halfThick = thickness * 0.5f;
+
+	drawList->PrimReserve(static_cast<int>(fillIdx + lineIdx), static_cast<int>(fillVtx + lineVtx));
+
+	ImDrawVert* vtx  = drawList->_VtxWritePtr;
+	ImDrawIdx*  idx  = drawList->_IdxWritePtr;
+	const auto  base = static_cast<uint32_t>(drawList->_VtxCurrentIdx);
+
+	if (filled)
+	{
+		for (uint32_t i = 0; i < count; i++)
+		{
+			vtx[2 * i]     = {ImVec2(xs[i], ys[i]), uv, fillColor};
+			vtx[2 * i + 1] = {ImVec2(xs[i], bottom), uv, fillColor};
+		}
+		for (uint32_t i = 0; i < segments; i++)
+		{
+			const uint32_t v = base + 2 * i;
+			idx[6 * i]       = static_cast<ImDrawIdx>(v);
+			idx[6 * i + 1]   = static_cast<ImDrawIdx>(v + 2);
+			idx[6 * i + 2]   = static_cast<ImDrawIdx>(v + 3);
+			idx[6 * i + 3]   = static_cast<ImDrawIdx>(v);
+			idx[6 * i + 4]   = static_cast<ImDrawIdx>(v + 3);
+			idx[6 * i + 5]   = static_cast<ImDrawIdx>(v + 1);
+		}
+		vtx += fillVtx;
+		idx += fillIdx;
+	}
+
+	const uint32_t lineBase = base + fillVtx;
+	for (uint32_t i = 0; i < segments; i++)
+	{
+		// The step along x is never zero, so the segment length is never zero either.
+		const float dx    = xs[i + 1] - xs[i];
+		const float dy    = ys[i + 1] - ys[i];
+		const float scale = halfThick / std::sqrt(dx * dx + dy * dy);
+		const float nx    = -dy * scale;
+		const float ny    = dx * scale;
+
+		vtx[4 * i]     = {ImVec2(xs[i] + nx, ys[i] + ny), uv, lineColor};
+		vtx[4 * i + 1] = {ImVec2(xs[i + 1] + nx, ys[i + 1] + ny), uv, lineColor};
+		vtx[4 * i + 2] = {ImVec2(xs[i + 1] - nx, ys[i + 1] - ny), uv, lineColor};
+		vtx[4 * i + 3] = {ImVec2(xs[i] - nx, ys[i] - ny), uv, lineColor};
+	}
+	for (uint32_t i = 0; i < segments; i++)
+	{
+		const uint32_t v = lineBase + 4 * i;
+		idx[6 * i]       = static_cast<ImDrawIdx>(v);
+		idx[6 * i + 1]   = static_cast<ImDrawIdx>(v + 1);
+		idx[6 * i + 2]   = static_cast<ImDrawIdx>(v + 2);
+		idx[6 * i + 3]   = static_cast<ImDrawIdx>(v);
+		idx[6 * i + 4]   = static_cast<ImDrawIdx>(v + 2);
+		idx[6 * i + 5]   = static_cast<ImDrawIdx>(v + 3);
+	}
+
+	drawList->_VtxWritePtr += fillVtx + lineVtx;
+	drawList->_IdxWritePtr += fillIdx + lineIdx;
+	drawList->_VtxCurrentIdx += fillVtx + lineVtx;
+}
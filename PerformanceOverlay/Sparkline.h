@@ -0,0 +1,48 @@
+/**
+ * @file Sparkline.h
+ * @brief Contains the declaration of the batched sparkline renderer used by the metric graphs.
+ * @author Alessandro Bellia
+ * @date 10/15/2026
+ */
+
+#pragma once
+
+#include "Platform.h"
+#include "imgui.h"
+#include <cstdint>
+
+/**
+ * @brief The maximum number of values a single sparkline draws; extra values are ignored.
+ */
+constexpr uint32_t kMaxSparklinePoints = 1024;
+
+/**
+ * @brief Adds a line graph of a series, with an optional filled area under it, to a draw list.
+ *
+ * Unlike ImGui::PlotLines there is no per-point callback, per-segment AddLine or hover test:
+ * the vertices and indices of the whole series are reserved with a single PrimReserve()
+ * and filled in straight loops over the values. Values are spread evenly over the width
+ * and clamped to the scale.
+ *
+ * @param[in] drawList The draw list to add the graph to.
+ * @param[in] pos The top-left corner of the graph, in screen space.
+ * @param[in] size The size of the graph.
+ * @param[in] values The series, oldest first.
+ * @param[in] count The number of values; fewer than 2 draws nothing.
+ * @param[in] scaleMin The value drawn at the bottom edge.
+ * @param[in] scaleMax The value drawn at the top edge.
+ * @param[in] lineColor The color of the line.
+ * @param[in] fillColor The color of the area under the line, or 0 for no fill.
+ * @param[in] thickness The thickness of the line, in pixels.
+ */
+void DrawSparkline(
+	_In_ ImDrawList*               drawList,
+	_In_ const ImVec2&             pos,
+	_In_ const ImVec2&             size,
+	_In_reads_(count) const float* values,
+	_In_ uint32_t                  count,
+	_In_ float                     scaleMin,
+	_In_ float                     scaleMax,
+	_In_ ImU32                     lineColor,
+	_In_ ImU32                     fillColor,
+	_In_ float                     thickness);
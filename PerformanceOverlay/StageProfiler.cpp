@@ -0,0 +1,62 @@
+/**
+ * @file StageProfiler.cpp
+ * @brief Contains the implementation of the StageProfiler class.
+ * @author Alessandro Bellia
+ * @date 10/15/2026
+ */
+
+#include "StageProfiler.h"
+#include <algorithm>
+
+std::atomic<bool>     StageProfiler::s_enabled{false};
+std::atomic<uint64_t> StageProfiler::s_recorded[StageCount]             = {};
+std::atomic<uint32_t> StageProfiler::s_durations[StageCount][kRingSize] = {};
+
+
+_Use_decl_annotations_
+void StageProfiler::Record(
+	const Stage   stage,
+	const int64_t durationNs)
+{
+	const uint64_t index    = s_recorded[stage].load(std::memory_order_relaxed);
+	const auto     duration = static_cast<uint32_t>(std::clamp<int64_t>(durationNs, 0, UINT32_MAX));
+	s_durations[stage][index % kRingSize].store(duration, std::memory_order_relaxed);
+	s_recorded[stage].store(index + 1, std::memory_order_release);
+}
+
+_Use_decl_annotations_
+StageProfiler::Stats StageProfiler::GetStats(
+	const Stage stage)
+{
+	// A slot the producer overwrites while it is copied yields a newer duration of the same
+	// stage, which is harmless for percentiles.
+	const uint64_t recorded = s_recorded[stage].load(std::memory_order_acquire);
+	const auto     count    = static_cast<uint32_t>(std::min<uint64_t>(recorded, kRingSize));
+	if (count == 0)
+	{
+		return {0, 0, 0};
+	}
+
+	uint32_t durations[kRingSize];
+	for (uint32_t i = 0; i < count; i++)
+	{
+		durations[i] = s_durations[stage][i].load(std::memory_order_relaxed);
+	}
+
+	const uint32_t p99Index = std::min(count - 1, count * 99 / 100);
+	std::nth_element(durations, durations + p99Index, durations + count);
+	const uint32_t p99 = durations[p99Index];
+
+	// The 99th percentile partitioned the array, so the median is found in the lower part.
+	const uint32_t p50Index = count / 2;
+	std::nth_element(durations, durations + p50Index, durations + p99Index);
+	return {durations[p50Index], p99, count};
+}
+
+_Use_decl_annotations_
+const char* StageProfiler::GetName(
+	const Stage stage)
+{
+	static constexpr const char* kNames[StageCount] = {"Sample", "NewFrame", "Build window", "ImGui::Render", "RenderDrawData", "Present"};
+	return stage < StageCount ? kNames[stage] : "?";
+}
@@ -0,0 +1,145 @@
+/**
+ * @file StageProfiler.h
+ * @brief Contains the declaration of the StageProfiler and ScopedStageTimer classes.
+ * @author Alessandro Bellia
+ * @date 10/15/2026
+ */
+
+#pragma once
+
+#include "Platform.h"
+#include "TscClock.h"
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @class StageProfiler
+ * @brief Process-wide recorder of how long each hot-path stage of the overlay takes.
+ *
+ * Every stage keeps its most recent durations in its own lock-free ring. A stage is only
+ * ever timed from one thread (sampling on the sampler thread, the frame stages on the
+ * render thread), so each ring has a single producer and recording is two relaxed stores
+ * and a release store. Readers on any thread copy a ring out to compute percentiles.
+ * Recording is off until SetEnabled(true); while it is off a ScopedStageTimer costs one
+ * relaxed load and a branch.
+ */
+class StageProfiler
+{
+public:
+	/**
+	 * @brief The timed stages.
+	 */
+	enum Stage : uint32_t
+	{
+		StageSample = 0,     ///< One collection pass on the sampler thread
+		StageNewFrame,       ///< Backend and ImGui::NewFrame()
+		StageBuildWindow,    ///< Gui::RenderPerformanceWindow()
+		StageImGuiRender,    ///< ImGui::Render()
+		StageRenderDrawData, ///< ImGui_ImplDX11_RenderDrawData()
+		StagePresent,        ///< IDXGISwapChain::Present()
+		StageCount
+	};
+
+	/**
+	 * @brief The number of recent durations each stage keeps.
+	 */
+	static constexpr uint32_t kRingSize = 256;
+
+	/**
+	 * @struct Stats
+	 * @brief Percentiles of the durations currently in a stage's ring.
+	 */
+	struct Stats
+	{
+		uint32_t p50Ns;   ///< Median duration, in nanoseconds.
+		uint32_t p99Ns;   ///< 99th percentile duration, in nanoseconds.
+		uint32_t samples; ///< The number of durations the percentiles were taken over.
+	};
+
+	StageProfiler() = delete;
+
+	/**
+	 * @brief Turns recording on or off. Durations recorded before are kept.
+	 * @param[in] enabled True to record, false to make the timers no-ops.
+	 */
+	static void SetEnabled(
+		_In_ bool enabled) { s_enabled.store(enabled, std::memory_order_relaxed); }
+
+	/**
+	 * @brief Checks whether recording is on.
+	 * @return True if the timers record.
+	 */
+	[[nodiscard]] static bool IsEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+	/**
+	 * @brief Records one duration of a stage. Must only be called from the thread that times the stage.
+	 * @param[in] stage The stage.
+	 * @param[in] durationNs The duration in nanoseconds; saturated to 32 bits (about 4.3 s).
+	 */
+	static void Record(
+		_In_ Stage   stage,
+		_In_ int64_t durationNs);
+
+	/**
+	 * @brief Computes the percentiles of a stage's recent durations.
+	 * @param[in] stage The stage.
+	 * @return The percentiles, all zero if nothing was recorded.
+	 */
+	[[nodiscard]] static Stats GetStats(
+		_In_ Stage stage);
+
+	/**
+	 * @brief Gets the display name of a stage.
+	 * @param[in] stage The stage.
+	 * @return A static, NUL-terminated name.
+	 */
+	[[nodiscard]] static const char* GetName(
+		_In_ Stage stage);
+
+private:
+	static std::atomic<bool>     s_enabled;
+	static std::atomic<uint64_t> s_recorded[StageCount];
+	static std::atomic<uint32_t> s_durations[StageCount][kRingSize];
+};
+
+
+/**
+ * @class ScopedStageTimer
+ * @brief Times the enclosing scope and records it against a stage, if recording is on when
+ *		  the scope is entered.
+ */
+class ScopedStageTimer
+{
+public:
+	/**
+	 * @brief Starts timing a stage.
+	 * @param[in] stage The stage the scope belongs to.
+	 */
+	explicit ScopedStageTimer(
+		_In_ StageProfiler::Stage stage)
+		: m_stage(stage),
+		  m_started(StageProfiler::IsEnabled()),
+		  m_start(0)
+	{
+		if (m_started)
+		{
+			m_start = TscClock::Now();
+		}
+	}
+
+	~ScopedStageTimer()
+	{
+		if (m_started)
+		{
+			StageProfiler::Record(m_stage, TscClock::DurationNs(TscClock::Now() - m_start));
+		}
+	}
+
+	ScopedStageTimer(const ScopedStageTimer& other)            = delete;
+	ScopedStageTimer& operator=(const ScopedStageTimer& other) = delete;
+
+private:
+	StageProfiler::Stage m_stage;
+	bool                 m_started;
+	uint64_t             m_start;
+};
@@ -0,0 +1,252 @@
+/**
+ * @file StringInterner.cpp
+ * @brief Contains the implementation of the StringInterner class.
+ * @author Alessandro Bellia
+ * @date 10/16/2026
+ */
+
+#include "StringInterner.h"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+
+/**
+ * @brief The smallest hash index, in entries.
+ */
+static constexpr size_t kMinIndexSize = 256;
+
+/**
+ * @brief The arena's initial capacity.
+ */
+static constexpr size_t kInitialArenaSize = 4096;
+
+/**
+ * @brief When the arena is full, it is compacted rather than grown if at least this fraction of it was released.
+ */
+static constexpr size_t kCompactFraction = 8;
+
+/**
+ * @struct StringHeader
+ * @brief Precedes each string in the arena, so a compaction can walk it without the slots.
+ */
+struct StringHeader
+{
+	uint32_t id;
+	uint32_t length;
+};
+
+/**
+ * @brief The size of a string's header.
+ */
+static constexpr uint32_t kHeaderSize = sizeof(StringHeader);
+
+/**
+ * @brief Hashes a string with 32-bit FNV-1a.
+ * @param[in] text The string.
+ * @param[in] length The length of text.
+ * @return The hash.
+ */
+static uint32_t HashString(
+	_In_reads_(length) const char* text,
+	_In_ size_t                    length);
+
+
+StringInterner::StringInterner()
+	: m_indexShift(0),
+	  m_liveCount(0),
+	  m_deletedEntries(0),
+	  m_garbageBytes(0)
+{
+	// The empty string is slot 0 at the start of the arena, and is never released or moved.
+	m_arena.reserve(kInitialArenaSize);
+	m_arena.assign(kHeaderSize + 1, '\0');
+	m_slots.push_back(Slot{kHeaderSize, 0, HashString(nullptr, 0), 0});
+	RebuildIndex();
+}
+
+_Use_decl_annotations_
+uint32_t StringInterner::Intern(
+	const char*  text,
+	const size_t length)
+{
+	if (length == 0)
+	{
+		return kEmpty;
+	}
+
+	const uint32_t hash  = HashString(text, length);
+	uint32_t&      entry = FindEntry(text, length, hash);
+	if (entry != 0 && entry != kDeletedEntry)
+	{
+		++m_slots[entry].references;
+		return entry;
+	}
+
+	uint32_t id;
+	if (!m_freeIds.empty())
+	{
+		id = m_freeIds.back();
+		m_freeIds.pop_back();
+	}
+	else
+	{
+		id = static_cast<uint32_t>(m_slots.size());
+		m_slots.push_back(Slot{});
+	}
+
+	m_deletedEntries -= entry == kDeletedEntry ? 1 : 0;
+	entry = id;
+	++m_liveCount;
+
+	// Released strings are reclaimed before the arena grows, so it only grows for live ones,
+	// and by half rather than double, since it holds most of the table's memory.
+	const size_t size = kHeaderSize + length + 1;
+	if (m_arena.size() + size > m_arena.capacity())
+	{
+		if (m_garbageBytes >= m_arena.capacity() / kCompactFraction)
+		{
+			Compact();
+		}
+		if (m_arena.size() + size > m_arena.capacity())
+		{
+			m_arena.reserve(std::max(m_arena.size() + size, m_arena.capacity() + m_arena.capacity() / 2));
+		}
+	}
+
+	const auto         offset = static_cast<uint32_t>(m_arena.size());
+	const StringHeader header{id, static_cast<uint32_t>(length)};
+	m_arena.resize(offset + size);
+	std::memcpy(m_arena.data() + offset, &header, kHeaderSize);
+	std::memcpy(m_arena.data() + offset + kHeaderSize, text, length);
+	m_arena[offset + kHeaderSize + length] = '\0';
+	m_slots[id]                            = Slot{offset + kHeaderSize, static_cast<uint32_t>(length), hash, 1};
+
+	// entry is not used past this point, so the index can be rebuilt under it.
+	if ((m_liveCount + m_deletedEntries) * 2 > m_index.size())
+	{
+		RebuildIndex();
+	}
+	return id;
+}
+
+_Use_decl_annotations_
+void StringInterner::Release(
+	const uint32_t id)
+{
+	if (id == kEmpty || --m_slots[id].references != 0)
+	{
+		return;
+	}
+
+	// The entry stays behind as a marker, so the strings probed past it are still found.
+	Slot& slot = m_slots[id];
+	FindEntry(Get(id), slot.length, slot.hash) = kDeletedEntry;
+	++m_deletedEntries;
+	--m_liveCount;
+	m_freeIds.push_back(id);
+	m_garbageBytes += kHeaderSize + slot.length + 1;
+}
+
+_Use_decl_annotations_
+bool StringInterner::Equals(
+	const uint32_t id,
+	const char*    text,
+	const size_t   length) const
+{
+	const Slot& slot = m_slots[id];
+	return slot.length == length && std::memcmp(m_arena.data() + slot.offset, text, length) == 0;
+}
+
+size_t StringInterner::GetMemoryFootprint() const
+{
+	return sizeof(*this) + m_arena.capacity() + m_slots.capacity() * sizeof(Slot) +
+		(m_freeIds.capacity() + m_index.capacity()) * sizeof(uint32_t);
+}
+
+_Use_decl_annotations_
+uint32_t& StringInterner::FindEntry(
+	const char*    text,
+	const size_t   length,
+	const uint32_t hash)
+{
+	const size_t mask     = m_index.size() - 1;
+	uint32_t*    pDeleted = nullptr;
+	for (size_t i = (hash * 2654435761u) >> m_indexShift;; i = (i + 1) & mask)
+	{
+		uint32_t& entry = m_index[i];
+		if (entry == 0)
+		{
+			return pDeleted ? *pDeleted : entry;
+		}
+		if (entry == kDeletedEntry)
+		{
+			pDeleted = pDeleted ? pDeleted : &entry;
+		}
+		else if (m_slots[entry].hash == hash && Equals(entry, text, length))
+		{
+			return entry;
+		}
+	}
+}
+
+void StringInterner::RebuildIndex()
+{
+	// Rebuilt at most a quarter full, so it grows again only after the strings double.
+	size_t size = kMinIndexSize;
+	while (size < static_cast<size_t>(m_liveCount) * 4)
+	{
+		size *= 2;
+	}
+
+	m_index.assign(size, 0);
+	m_indexShift     = 32 - static_cast<uint32_t>(std::countr_zero(size));
+	m_deletedEntries = 0;
+	for (uint32_t id = 1; id < m_slots.size(); id++)
+	{
+		const Slot& slot = m_slots[id];
+		if (slot.references != 0)
+		{
+			FindEntry(Get(id), slot.length, slot.hash) = id;
+		}
+	}
+}
+
+void StringInterner::Compact()
+{
+	// Each string is preceded by its header, so one pass over the arena finds which strings are
+	// still live: a slot that was freed, or reused for a string elsewhere, no longer points here.
+	size_t write = kHeaderSize + 1;
+	for (size_t read = write; read < m_arena.size();)
+	{
+		StringHeader header;
+		std::memcpy(&header, m_arena.data() + read, kHeaderSize);
+		Slot&        slot = m_slots[header.id];
+		const size_t size = kHeaderSize + header.length + 1;
+
+		if (slot.references != 0 && slot.offset == read + kHeaderSize)
+		{
+			std::memmove(m_arena.data() + write, m_arena.data() + read, size);
+			slot.offset = static_cast<uint32_t>(write + kHeaderSize);
+			write += size;
+		}
+		read += size;
+	}
+
+	m_arena.resize(write);
+	m_garbageBytes = 0;
+}
+
+
+_Use_decl_annotations_
+uint32_t HashString(
+	const char*  text,
+	const size_t length)
+{
+	uint32_t hash = 2166136261u;
+	for (size_t i = 0; i < length; i++)
+	{
+		hash = (hash ^ static_cast<uint8_t>(text[i])) * 16777619u;
+	}
+	return hash;
+}
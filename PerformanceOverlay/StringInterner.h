@@ -0,0 +1,153 @@
+/**
+ * @file StringInterner.h
+ * @brief Contains the declaration of the StringInterner class.
+ * @author Alessandro Bellia
+ * @date 10/16/2026
+ */
+
+#pragma once
+
+#include "Platform.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class StringInterner
+ * @brief Stores each distinct string once, behind a small id, and frees it when the last
+ *		  reference is released.
+ *
+ * Strings are kept back to back in one growing arena, each NUL-terminated and preceded by
+ * its id and length; an id indexes a slot holding the string's offset, length, hash and reference
+ * count. Interning a string that is already present only bumps its count, found through an
+ * open-addressing hash of the contents. Released strings leave their bytes behind; when the
+ * arena is full and enough of it was released, it is compacted in place, in one pass over
+ * it, instead of growing. Ids stay stable through compaction, since only the slots' offsets
+ * change. Id 0 is the empty string and is never counted.
+ */
+class StringInterner
+{
+public:
+	/**
+	 * @brief The id of the empty string.
+	 */
+	static constexpr uint32_t kEmpty = 0;
+
+	StringInterner();
+
+	StringInterner(const StringInterner& other)            = delete;
+	StringInterner& operator=(const StringInterner& other) = delete;
+
+	/**
+	 * @brief Takes a reference to a string, adding it if it is not present.
+	 * @param[in] text The string; need not be NUL-terminated.
+	 * @param[in] length The length of text.
+	 * @return The string's id, or kEmpty if length is 0.
+	 */
+	[[nodiscard]] uint32_t Intern(
+		_In_reads_(length) const char* text,
+		_In_ size_t                    length);
+
+	/**
+	 * @brief Drops a reference taken by Intern(). The last one frees the string, whose bytes
+	 *		  are reclaimed by a later compaction.
+	 * @param[in] id The string's id; kEmpty is ignored.
+	 */
+	void Release(
+		_In_ uint32_t id);
+
+	/**
+	 * @brief Gets a string. The pointer is only valid until the next Intern().
+	 * @param[in] id The string's id.
+	 * @return The NUL-terminated string.
+	 */
+	[[nodiscard]] const char* Get(
+		_In_ uint32_t id) const { return m_arena.data() + m_slots[id].offset; }
+
+	/**
+	 * @brief Gets the length of a string.
+	 * @param[in] id The string's id.
+	 * @return The length, without the terminator.
+	 */
+	[[nodiscard]] uint32_t GetLength(
+		_In_ uint32_t id) const { return m_slots[id].length; }
+
+	/**
+	 * @brief Checks whether a string equals a given one, without interning it.
+	 * @param[in] id The string's id.
+	 * @param[in] text The string to compare with; need not be NUL-terminated.
+	 * @param[in] length The length of text.
+	 * @return True if they are equal.
+	 */
+	[[nodiscard]] bool Equals(
+		_In_ uint32_t                  id,
+		_In_reads_(length) const char* text,
+		_In_ size_t                    length) const;
+
+	/**
+	 * @brief Gets the number of distinct strings held.
+	 * @return The count, not including the empty string.
+	 */
+	[[nodiscard]] uint32_t GetCount() const { return m_liveCount; }
+
+	/**
+	 * @brief Gets the number of arena bytes used by live strings, headers and terminators included.
+	 * @return The byte count.
+	 */
+	[[nodiscard]] size_t GetLiveBytes() const { return m_arena.size() - m_garbageBytes; }
+
+	/**
+	 * @brief Gets the number of bytes held by the interner.
+	 * @return The capacity of the arena, the slots and the hash index.
+	 */
+	[[nodiscard]] size_t GetMemoryFootprint() const;
+
+private:
+	/**
+	 * @brief The index entry of a released string; lookups probe past it, inserts reuse it.
+	 */
+	static constexpr uint32_t kDeletedEntry = UINT32_MAX;
+
+	/**
+	 * @struct Slot
+	 * @brief One string.
+	 */
+	struct Slot
+	{
+		uint32_t offset;     ///< Of the first character, in the arena.
+		uint32_t length;
+		uint32_t hash;
+		uint32_t references; ///< 0 for a free slot.
+	};
+
+	/**
+	 * @brief Finds the index entry of a string: the entry holding it, or the entry it would go in.
+	 * @param[in] text The string.
+	 * @param[in] length The length of text.
+	 * @param[in] hash The hash of text.
+	 * @return A reference to the entry: the string's id, or 0 or kDeletedEntry if it is absent.
+	 */
+	uint32_t& FindEntry(
+		_In_reads_(length) const char* text,
+		_In_ size_t                    length,
+		_In_ uint32_t                  hash);
+
+	/**
+	 * @brief Rebuilds the hash index for the live strings, resizing it to keep it at most half full.
+	 */
+	void RebuildIndex();
+
+	/**
+	 * @brief Slides the live strings down over the released ones, keeping their order.
+	 */
+	void Compact();
+
+	std::vector<char>     m_arena;
+	std::vector<Slot>     m_slots;   ///< Indexed by id; slot 0 is the empty string.
+	std::vector<uint32_t> m_freeIds; ///< Slots to reuse before growing m_slots.
+	std::vector<uint32_t> m_index;   ///< Open-addressing hash of the contents; a power of two in size.
+	uint32_t              m_indexShift;
+	uint32_t              m_liveCount;
+	uint32_t              m_deletedEntries; ///< Index entries left by released strings, until the next rebuild.
+	size_t                m_garbageBytes;   ///< Arena bytes of released strings.
+};
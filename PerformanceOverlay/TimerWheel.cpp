@@ -0,0 +1,316 @@
+/**
+ * @file TimerWheel.cpp
+ * @brief Contains the implementation of the TimerWheel class.
+ * @author Alessandro Bellia
+ * @date 10/15/2026
+ */
+
+#include "TimerWheel.h"
+#include <bit>
+
+/**
+ * @brief The number of tick bits each level covers.
+ */
+static constexpr uint32_t kSlotBits = 6;
+
+static_assert(TimerWheel::kSlots == 1u << kSlotBits, "The occupancy masks are 64 bits wide");
+
+/**
+ * @brief Finds the first tick at or after a tick whose slot is occupied on one level.
+ * @param[in] occupied The level's occupancy mask.
+ * @param[in] tick The current tick.
+ * @param[in] shift The number of tick bits below the level's slot index.
+ * @return The first tick of the next occupied slot strictly after the current one, or
+ *		   INT64_MAX if the level is empty.
+ */
+static int64_t NextOccupiedTick(
+	_In_ uint64_t occupied,
+	_In_ int64_t  tick,
+	_In_ uint32_t shift);
+
+
+_Use_decl_annotations_
+void TimerWheel::Configure(
+	const uint32_t                 capacity,
+	const int64_t                  nowNs,
+	const std::chrono::nanoseconds resolution)
+{
+	m_timers       = std::make_unique<Timer[]>(capacity);
+	m_capacity     = capacity;
+	m_originNs     = nowNs;
+	m_resolutionNs = std::max<int64_t>(resolution.count(), 1);
+	m_tick         = 0;
+
+	// Thread the free list through the next links, lowest id first.
+	for (uint32_t timer = 0; timer < capacity; timer++)
+	{
+		m_timers[timer]      = {};
+		m_timers[timer].next = timer + 1 < capacity ? timer + 1 : kInvalidTimer;
+		m_timers[timer].slot = kInvalidTimer;
+	}
+	m_freeHead = capacity > 0 ? 0 : kInvalidTimer;
+
+	std::fill_n(&m_heads[0][0], kLevels * kSlots, kInvalidTimer);
+	std::fill_n(m_occupied, kLevels, 0);
+}
+
+_Use_decl_annotations_
+uint32_t TimerWheel::Add(
+	const int64_t                  nowNs,
+	const std::chrono::nanoseconds interval,
+	const std::chrono::nanoseconds phase,
+	const uint32_t                 tag)
+{
+	const uint32_t timer = m_freeHead;
+	if (timer == kInvalidTimer)
+	{
+		return kInvalidTimer;
+	}
+	m_freeHead = m_timers[timer].next;
+
+	// The first deadline is rounded up to a whole tick, so with an interval of whole ticks
+	// every later deadline falls on a tick too and lateness only measures the wakeup.
+	const int64_t firstNs = nowNs + std::max<int64_t>(phase.count(), 0) - m_originNs;
+	Timer&        entry   = m_timers[timer];
+	entry.deadlineNs      = m_originNs + (firstNs + m_resolutionNs - 1) / m_resolutionNs * m_resolutionNs;
+	entry.intervalNs = std::max<int64_t>(interval.count(), 1);
+	entry.tag        = tag;
+	Insert(timer, m_tick + 1);
+	return timer;
+}
+
+_Use_decl_annotations_
+void TimerWheel::Cancel(
+	const uint32_t timer)
+{
+	Timer& entry = m_timers[timer];
+	if (entry.intervalNs == 0)
+	{
+		return;
+	}
+
+	if (entry.slot != kInvalidTimer)
+	{
+		Unlink(timer);
+	}
+	entry.intervalNs = 0;
+	entry.next       = m_freeHead;
+	m_freeHead       = timer;
+}
+
+int64_t TimerWheel::NextDeadlineNs() const
+{
+	// A coarser slot is due when it must be cascaded, which is never later than its timers.
+	int64_t next = INT64_MAX;
+	for (uint32_t level = 0; level < kLevels; level++)
+	{
+		next = std::min(next, NextOccupiedTick(m_occupied[level], m_tick, level * kSlotBits));
+	}
+	return next == INT64_MAX ? INT64_MAX : m_originNs + next * m_resolutionNs;
+}
+
+_Use_decl_annotations_
+std::chrono::nanoseconds TimerWheel::GetLatenessPercentile(
+	const double percentile) const
+{
+	const uint64_t fired = m_fired.load(std::memory_order_relaxed);
+	if (fired == 0)
+	{
+		return std::chrono::nanoseconds::zero();
+	}
+
+	const auto rank = static_cast<uint64_t>(std::clamp(percentile, 0.0, 1.0) * static_cast<double>(fired - 1));
+
+	uint64_t seen = 0;
+	uint32_t bucket;
+	for (bucket = 0; bucket < kLatenessBuckets - 1; bucket++)
+	{
+		seen += m_lateness[bucket].load(std::memory_order_relaxed);
+		if (seen > rank)
+		{
+			break;
+		}
+	}
+
+	return std::chrono::nanoseconds(kLatenessBucketWidth) * (bucket + 1);
+}
+
+_Use_decl_annotations_
+void TimerWheel::Insert(
+	const uint32_t timer,
+	const int64_t  firstTick)
+{
+	Timer& entry = m_timers[timer];
+
+	// Round up, so a timer never fires before its deadline outside the coalescing window; a
+	// deadline already passed goes into the first tick still to be fired.
+	int64_t tick = (entry.deadlineNs - m_originNs + m_resolutionNs - 1) / m_resolutionNs;
+	tick         = std::max(tick, firstTick);
+
+	// The level is the first whose slots are coarse enough to reach the tick; past the
+	// last level the timer waits in the farthest slot and is placed again when it cascades.
+	const int64_t delta = tick - m_tick;
+	uint32_t      level = 0;
+	while (level < kLevels - 1 && delta >= static_cast<int64_t>(1) << ((level + 1) * kSlotBits))
+	{
+		level++;
+	}
+	if (level == kLevels - 1)
+	{
+		tick = std::min(tick, m_tick + (static_cast<int64_t>(1) << (kLevels * kSlotBits)) - 1);
+	}
+
+	const auto index = static_cast<uint32_t>((tick >> (level * kSlotBits)) & (kSlots - 1));
+	uint32_t&  head  = m_heads[level][index];
+
+	entry.slot = level * kSlots + index;
+	entry.prev = kInvalidTimer;
+	entry.next = head;
+	if (head != kInvalidTimer)
+	{
+		m_timers[head].prev = timer;
+	}
+	head = timer;
+	m_occupied[level] |= 1ull << index;
+}
+
+_Use_decl_annotations_
+void TimerWheel::Unlink(
+	const uint32_t timer)
+{
+	Timer&         entry = m_timers[timer];
+	const uint32_t level = entry.slot / kSlots;
+	const uint32_t index = entry.slot % kSlots;
+
+	if (entry.prev != kInvalidTimer)
+	{
+		m_timers[entry.prev].next = entry.next;
+	}
+	else
+	{
+		m_heads[level][index] = entry.next;
+	}
+	if (entry.next != kInvalidTimer)
+	{
+		m_timers[entry.next].prev = entry.prev;
+	}
+	if (m_heads[level][index] == kInvalidTimer)
+	{
+		m_occupied[level] &= ~(1ull << index);
+	}
+	entry.slot = kInvalidTimer;
+}
+
+_Use_decl_annotations_
+void TimerWheel::Rearm(
+	const uint32_t timer,
+	const int64_t  nowNs,
+	const int64_t  lastTick)
+{
+	Timer& entry = m_timers[timer];
+	if (entry.intervalNs == 0)
+	{
+		return; // Cancelled by the fire callback
+	}
+
+	// Single writer: a plain load and store keep the counters cheap and still tear-free.
+	const int64_t lateNs = std::max<int64_t>(nowNs - entry.deadlineNs, 0);
+	const auto    bucket = static_cast<uint64_t>(lateNs / std::chrono::nanoseconds(kLatenessBucketWidth).count());
+	std::atomic<uint64_t>& count = m_lateness[std::min<uint64_t>(bucket, kLatenessBuckets - 1)];
+	count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	m_fired.store(m_fired.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+	// Stay on the timer's own grid; deadlines it slept through are skipped, not replayed.
+	entry.deadlineNs += entry.intervalNs;
+	if (entry.deadlineNs <= nowNs)
+	{
+		const int64_t missed = (nowNs - entry.deadlineNs) / entry.intervalNs + 1;
+		entry.deadlineNs += missed * entry.intervalNs;
+		m_missed.store(m_missed.load(std::memory_order_relaxed) + static_cast<uint64_t>(missed), std::memory_order_relaxed);
+	}
+
+	// Deadlines that round to a tick this Advance() still fires were coalesced into this
+	// firing; re-armed on them, a timer shorter than the window would fire again and again.
+	const int64_t windowEndNs = m_originNs + lastTick * m_resolutionNs;
+	if (entry.deadlineNs <= windowEndNs)
+	{
+		entry.deadlineNs += ((windowEndNs - entry.deadlineNs) / entry.intervalNs + 1) * entry.intervalNs;
+	}
+	Insert(timer, m_tick + 1);
+}
+
+_Use_decl_annotations_
+bool TimerWheel::StepTo(
+	const int64_t target)
+{
+	while (m_tick < target)
+	{
+		// The next stop is the next occupied level-0 slot or the next wrap of level 0,
+		// whichever comes first; nothing can happen on the ticks in between.
+		const int64_t boundary = (m_tick | (kSlots - 1)) + 1;
+		const int64_t occupied = NextOccupiedTick(m_occupied[0], m_tick, 0);
+		m_tick                 = std::min({target, boundary, occupied});
+
+		if (m_tick == boundary)
+		{
+			// Each wrap cascades the next slot of the level above, and so on up while
+			// those wrap too.
+			for (uint32_t level = 1; level < kLevels; level++)
+			{
+				const auto index = static_cast<uint32_t>((m_tick >> (level * kSlotBits)) & (kSlots - 1));
+				Cascade(level, index);
+				if (index != 0)
+				{
+					break;
+				}
+			}
+		}
+
+		if ((m_occupied[0] & (1ull << (m_tick & (kSlots - 1)))) != 0)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+_Use_decl_annotations_
+void TimerWheel::Cascade(
+	const uint32_t level,
+	const uint32_t index)
+{
+	uint32_t timer        = m_heads[level][index];
+	m_heads[level][index] = kInvalidTimer;
+	m_occupied[level] &= ~(1ull << index);
+
+	while (timer != kInvalidTimer)
+	{
+		// The current tick has not fired yet, so timers due on it can still land there.
+		const uint32_t next = m_timers[timer].next;
+		Insert(timer, m_tick);
+		timer = next;
+	}
+}
+
+
+_Use_decl_annotations_
+int64_t NextOccupiedTick(
+	const uint64_t occupied,
+	const int64_t  tick,
+	const uint32_t shift)
+{
+	if (occupied == 0)
+	{
+		return INT64_MAX;
+	}
+
+	// Slots after the current one belong to this turn of the level, the others to the next.
+	const int64_t  slotTick = tick >> shift;
+	const auto     current  = static_cast<uint32_t>(slotTick & (TimerWheel::kSlots - 1));
+	const int64_t  turn     = slotTick - current;
+	const uint64_t later    = current == TimerWheel::kSlots - 1 ? 0 : occupied & (~0ull << (current + 1));
+
+	const int64_t slot = later != 0 ? turn + std::countr_zero(later)
+	                                : turn + TimerWheel::kSlots + std::countr_zero(occupied);
+	return slot << shift;
+}
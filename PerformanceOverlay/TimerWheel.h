@@ -0,0 +1,266 @@
+/**
+ * @file TimerWheel.h
+ * @brief Contains the declaration of the TimerWheel class.
+ * @author Alessandro Bellia
+ * @date 10/15/2026
+ */
+
+#pragma once
+
+#include "Platform.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+/**
+ * @class TimerWheel
+ * @brief Schedules periodic timers, each with its own interval and phase, on a hierarchical
+ *		  timer wheel.
+ *
+ * Time is cut into ticks of a fixed resolution. Level 0 holds the timers due in the next
+ * kSlots ticks, one slot per tick; each higher level holds kSlots times coarser slots, and
+ * its slots are cascaded into the level below whenever that level wraps. Timers are linked
+ * into their slot by index, so adding, cancelling and firing a timer are O(1) whatever the
+ * number of timers, and a tick only touches its own slot. A 64-bit occupancy mask per
+ * level lets Advance() jump over empty ticks and NextDeadlineNs() find the next wakeup
+ * without walking the slots.
+ *
+ * Advance() fires every timer due up to the coalescing window past the current time, so
+ * deadlines that fall close together share one wakeup. A fired timer is re-armed one
+ * interval after its deadline, so its phase does not drift. If it fired a whole interval
+ * or more late, the periods it slept through count as missed deadlines and are skipped.
+ * A timer fires at most once per Advance(): its later deadlines that still fall within the
+ * window are served by the same firing, so a timer whose interval is shorter than the
+ * window fires once per wakeup. Coalescing only ever fires a timer early, by up to one
+ * window; how late each timer fires, which is down to the wakeup alone, goes into a histogram.
+ *
+ * The wheel belongs to one thread; the statistics can be read from any thread.
+ */
+class TimerWheel
+{
+public:
+	/**
+	 * @brief The number of slots per level; a power of two matching the occupancy mask width.
+	 */
+	static constexpr uint32_t kSlots = 64;
+
+	/**
+	 * @brief The number of levels. With 1 ms ticks they cover 64 ms, 4 s, 4 min and 4.6 h.
+	 */
+	static constexpr uint32_t kLevels = 4;
+
+	/**
+	 * @brief The tick resolution when none is set.
+	 */
+	static constexpr std::chrono::milliseconds kDefaultResolution{1};
+
+	/**
+	 * @brief The coalescing window when none is set.
+	 */
+	static constexpr std::chrono::milliseconds kDefaultCoalesceWindow{5};
+
+	/**
+	 * @brief The number of buckets in the lateness histogram; the last one also counts
+	 *		  everything later.
+	 */
+	static constexpr uint32_t kLatenessBuckets = 200;
+
+	/**
+	 * @brief The width of one lateness histogram bucket.
+	 */
+	static constexpr std::chrono::microseconds kLatenessBucketWidth{100};
+
+	/**
+	 * @brief Returned by Add() when every timer is in use.
+	 */
+	static constexpr uint32_t kInvalidTimer = UINT32_MAX;
+
+	TimerWheel() = default;
+
+	TimerWheel(const TimerWheel& other)            = delete;
+	TimerWheel& operator=(const TimerWheel& other) = delete;
+
+	/**
+	 * @brief Allocates the timers and starts the wheel. Must be called before any other method.
+	 * @param[in] capacity The most timers armed at once.
+	 * @param[in] nowNs The current time; tick 0 starts here.
+	 * @param[in] resolution The tick length; deadlines are rounded up to a whole tick.
+	 */
+	void Configure(
+		_In_ uint32_t                 capacity,
+		_In_ int64_t                  nowNs,
+		_In_ std::chrono::nanoseconds resolution = kDefaultResolution);
+
+	/**
+	 * @brief Sets how far ahead of the current time Advance() fires timers.
+	 * @param[in] window The coalescing window.
+	 */
+	void SetCoalesceWindow(
+		_In_ std::chrono::nanoseconds window) { m_coalesceNs = window.count(); }
+
+	/**
+	 * @brief Adds a periodic timer.
+	 * @param[in] nowNs The current time.
+	 * @param[in] interval The time between two deadlines.
+	 * @param[in] phase The time from now to the first deadline, which is rounded up to a whole tick.
+	 * @param[in] tag A value passed back to the fire callback, e.g. what the timer runs.
+	 * @return The timer's id, or kInvalidTimer if the wheel is full.
+	 */
+	uint32_t Add(
+		_In_ int64_t                  nowNs,
+		_In_ std::chrono::nanoseconds interval,
+		_In_ std::chrono::nanoseconds phase,
+		_In_ uint32_t                 tag);
+
+	/**
+	 * @brief Removes a timer; its id may be handed out again by Add().
+	 * @param[in] timer The timer's id.
+	 */
+	void Cancel(
+		_In_ uint32_t timer);
+
+	/**
+	 * @brief Changes the interval of a timer. Takes effect when the timer is next re-armed,
+	 *		  so a fire callback can set the interval that follows the current deadline.
+	 * @param[in] timer The timer's id.
+	 * @param[in] intervalNs The new interval in nanoseconds.
+	 */
+	void SetInterval(
+		_In_ uint32_t timer,
+		_In_ int64_t  intervalNs) { m_timers[timer].intervalNs = std::max<int64_t>(intervalNs, 1); }
+
+	/**
+	 * @brief Fires every timer due up to nowNs plus the coalescing window, and re-arms it.
+	 * @param[in] nowNs The current time.
+	 * @param[in] fire Called as fire(timer, tag) for each timer, tick by tick. It may call
+	 *			  SetInterval() or Cancel() on the timer it was called for.
+	 * @return The number of timers fired.
+	 */
+	template <typename Fire>
+	uint32_t Advance(
+		_In_ int64_t nowNs,
+		_In_ Fire    fire)
+	{
+		const int64_t target = (nowNs + m_coalesceNs - m_originNs) / m_resolutionNs;
+		uint32_t      fired  = 0;
+		while (StepTo(target))
+		{
+			// Firing re-arms the timer in a later slot, so the current one drains.
+			const uint32_t& head = m_heads[0][m_tick & (kSlots - 1)];
+			while (head != kInvalidTimer)
+			{
+				const uint32_t timer = head;
+				Unlink(timer);
+				fire(timer, m_timers[timer].tag);
+				Rearm(timer, nowNs, target);
+				fired++;
+			}
+		}
+		return fired;
+	}
+
+	/**
+	 * @brief Gets the time of the next wakeup: the earliest deadline, or the tick at which
+	 *		  a coarser slot must be cascaded to place its timers precisely.
+	 * @return The time in nanoseconds, or INT64_MAX if no timer is armed.
+	 */
+	[[nodiscard]] int64_t NextDeadlineNs() const;
+
+	/**
+	 * @brief Gets the number of timers fired so far.
+	 * @return The count.
+	 */
+	[[nodiscard]] uint64_t GetFiredCount() const { return m_fired.load(std::memory_order_relaxed); }
+
+	/**
+	 * @brief Gets the number of deadlines skipped because a timer fired a whole interval late.
+	 * @return The count.
+	 */
+	[[nodiscard]] uint64_t GetMissedCount() const { return m_missed.load(std::memory_order_relaxed); }
+
+	/**
+	 * @brief Gets a percentile of the lateness with which timers fired.
+	 * @param[in] percentile The percentile, from 0 to 1.
+	 * @return The upper edge of the histogram bucket holding the percentile, or zero if no
+	 *		   timer fired yet.
+	 */
+	[[nodiscard]] std::chrono::nanoseconds GetLatenessPercentile(
+		_In_ double percentile) const;
+
+private:
+	/**
+	 * @struct Timer
+	 * @brief One timer and its links within a slot.
+	 */
+	struct Timer
+	{
+		int64_t  deadlineNs;
+		int64_t  intervalNs; ///< 0 while the timer is free.
+		uint32_t next;
+		uint32_t prev;
+		uint32_t slot; ///< level * kSlots + slot index, or kInvalidTimer if not linked.
+		uint32_t tag;
+	};
+
+	/**
+	 * @brief Links a timer into the slot its deadline falls in, relative to the current tick.
+	 * @param[in] timer The timer's id.
+	 * @param[in] firstTick The earliest tick the timer may be placed on.
+	 */
+	void Insert(
+		_In_ uint32_t timer,
+		_In_ int64_t  firstTick);
+
+	/**
+	 * @brief Unlinks a timer from its slot.
+	 * @param[in] timer The timer's id.
+	 */
+	void Unlink(
+		_In_ uint32_t timer);
+
+	/**
+	 * @brief Records the lateness of a fired timer and links it again at its next deadline
+	 *		  past the ticks the current Advance() fires.
+	 * @param[in] timer The timer's id.
+	 * @param[in] nowNs The time it fired.
+	 * @param[in] lastTick The last tick the current Advance() fires.
+	 */
+	void Rearm(
+		_In_ uint32_t timer,
+		_In_ int64_t  nowNs,
+		_In_ int64_t  lastTick);
+
+	/**
+	 * @brief Moves the current tick forward to the next tick with timers to fire, cascading
+	 *		  coarser slots on the way.
+	 * @param[in] target The last tick to move to.
+	 * @return True if the current tick has timers to fire, false once target is reached without any.
+	 */
+	bool StepTo(
+		_In_ int64_t target);
+
+	/**
+	 * @brief Re-inserts every timer of a slot, which places them on finer levels.
+	 * @param[in] level The slot's level.
+	 * @param[in] index The slot's index.
+	 */
+	void Cascade(
+		_In_ uint32_t level,
+		_In_ uint32_t index);
+
+	std::unique_ptr<Timer[]> m_timers;
+	uint32_t                 m_capacity = 0;
+	uint32_t                 m_freeHead = kInvalidTimer;
+	uint32_t                 m_heads[kLevels][kSlots];
+	uint64_t                 m_occupied[kLevels] = {}; ///< One bit per non-empty slot.
+	int64_t                  m_tick              = 0;  ///< The last tick fired.
+	int64_t                  m_originNs          = 0;
+	int64_t                  m_resolutionNs      = std::chrono::nanoseconds(kDefaultResolution).count();
+	int64_t                  m_coalesceNs        = std::chrono::nanoseconds(kDefaultCoalesceWindow).count();
+
+	std::atomic<uint64_t> m_fired{0};
+	std::atomic<uint64_t> m_missed{0};
+	std::atomic<uint64_t> m_lateness[kLatenessBuckets] = {};
+};
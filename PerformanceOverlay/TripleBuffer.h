@@ -0,0 +1,84 @@
+/**
+ * @file TripleBuffer.h
+ * @brief Contains the declaration and implementation of the TripleBuffer class template.
+ * @author Alessandro Bellia
+ * @date 10/15/2026
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @class TripleBuffer
+ * @brief A wait-free single-producer/single-consumer hand-off of the latest value.
+ *
+ * The producer fills the back slot and publishes it by swapping it with the shared
+ * middle slot; the consumer swaps the middle slot with its front slot only when a new
+ * value is available. Neither side ever waits for the other, and a slot handed to the
+ * consumer is never touched by the producer until the consumer gives it back.
+ *
+ * @tparam T The value type. It is default-constructed three times and then reused, so
+ *			 types owning storage (e.g. vectors) stop allocating once they have grown.
+ */
+template <typename T>
+class TripleBuffer
+{
+public:
+	TripleBuffer() = default;
+
+	TripleBuffer(const TripleBuffer& other)            = delete;
+	TripleBuffer& operator=(const TripleBuffer& other) = delete;
+
+	/**
+	 * @brief Gets the slot the producer is allowed to fill. Producer side only.
+	 * @return A reference to the back slot.
+	 */
+	[[nodiscard]] T& WriteSlot() { return m_slots[m_writeIndex]; }
+
+	/**
+	 * @brief Publishes the back slot and takes ownership of a free slot to write next. Producer side only.
+	 */
+	void Publish()
+	{
+		const uint8_t previous = m_shared.exchange(
+			static_cast<uint8_t>(m_writeIndex | kFreshBit),
+			std::memory_order_acq_rel);
+		m_writeIndex = previous & kIndexMask;
+	}
+
+	/**
+	 * @brief Checks whether a value newer than the one returned by the last Read() is available.
+	 * @return True if the producer has published since the last Read().
+	 */
+	[[nodiscard]] bool HasUpdate() const
+	{
+		return (m_shared.load(std::memory_order_relaxed) & kFreshBit) != 0;
+	}
+
+	/**
+	 * @brief Gets the most recently published value. Consumer side only.
+	 * @return A reference that stays valid and unchanged until the next call to Read().
+	 */
+	const T& Read()
+	{
+		if (HasUpdate())
+		{
+			const uint8_t previous = m_shared.exchange(m_readIndex, std::memory_order_acq_rel);
+			m_readIndex            = previous & kIndexMask;
+		}
+		return m_slots[m_readIndex];
+	}
+
+private:
+	static constexpr uint8_t kIndexMask = 0x3;
+	static constexpr uint8_t kFreshBit  = 0x4;
+
+	T m_slots[3]{};
+
+	// Keep each side's index on its own cache line so producer and consumer never false-share.
+	alignas(64) std::atomic<uint8_t> m_shared{1};
+	alignas(64) uint8_t m_writeIndex = 0;
+	alignas(64) uint8_t m_readIndex = 2;
+};
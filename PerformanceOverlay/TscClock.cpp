@@ -0,0 +1,222 @@
+/**
+ * @file TscClock.cpp
+ * @brief Contains the implementation of the TscClock class.
+ * @author Alessandro Bellia
+ * @date 10/15/2026
+ */
+
+#include "TscClock.h"
+#include <thread>
+
+#if PERFOVERLAY_HAS_TSC && !defined(_MSC_VER)
+#include <cpuid.h>
+#endif
+
+#ifdef __linux__
+#include "ProcFile.h"
+#include <cstring>
+#endif
+
+std::atomic<bool>     TscClock::s_useTsc{false};
+std::atomic<uint32_t> TscClock::s_sequence{0};
+std::atomic<uint64_t> TscClock::s_baseTicks{0};
+std::atomic<int64_t>  TscClock::s_baseNs{0};
+std::atomic<double>   TscClock::s_nsPerTick{1.0};
+std::atomic<int64_t>  TscClock::s_lastResyncErrorNs{0};
+
+bool     TscClock::s_calibrated       = false;
+uint64_t TscClock::s_calibrationTicks = 0;
+int64_t  TscClock::s_calibrationNs    = 0;
+
+/**
+ * @brief The time between the two readings Calibrate() derives the first rate from.
+ */
+static constexpr std::chrono::milliseconds kCalibrationTime{10};
+
+/**
+ * @brief Checks whether this machine has a TSC that ticks at a constant rate across power
+ *		  states and that the OS still trusts.
+ * @return True if the TSC can back the clock.
+ */
+static bool IsInvariantTscUsable();
+
+/**
+ * @brief Reads the steady clock.
+ * @return The time in nanoseconds since the steady clock's epoch.
+ */
+static int64_t SteadyNs();
+
+
+void TscClock::Calibrate()
+{
+	if (s_calibrated)
+	{
+		return;
+	}
+	s_calibrated = true;
+
+	if (!IsInvariantTscUsable())
+	{
+		return; // Keep reading the steady clock, at 1 ns per tick
+	}
+
+	uint64_t startTicks;
+	int64_t  startNs;
+	ReadPair(startTicks, startNs);
+	std::this_thread::sleep_for(kCalibrationTime);
+
+	uint64_t endTicks;
+	int64_t  endNs;
+	ReadPair(endTicks, endNs);
+	if (endTicks <= startTicks || endNs <= startNs)
+	{
+		return;
+	}
+
+	s_calibrationTicks = startTicks;
+	s_calibrationNs    = startNs;
+	Publish(endTicks, endNs, static_cast<double>(endNs - startNs) / static_cast<double>(endTicks - startTicks));
+	s_useTsc.store(true, std::memory_order_relaxed);
+}
+
+void TscClock::Resync()
+{
+	if (!s_useTsc.load(std::memory_order_relaxed))
+	{
+		return;
+	}
+
+	uint64_t ticks;
+	int64_t  ns;
+	ReadPair(ticks, ns);
+	if (ns - s_baseNs.load(std::memory_order_relaxed) < std::chrono::nanoseconds(kResyncPeriod).count())
+	{
+		return;
+	}
+
+	// The rate is taken over the whole time since calibration, so the error of the two
+	// readings it comes from shrinks as the baseline grows.
+	s_lastResyncErrorNs.store(ToNanoseconds(ticks) - ns, std::memory_order_relaxed);
+	Publish(ticks, ns, static_cast<double>(ns - s_calibrationNs) / static_cast<double>(ticks - s_calibrationTicks));
+}
+
+_Use_decl_annotations_
+int64_t TscClock::ToNanoseconds(
+	const uint64_t ticks)
+{
+	if (!s_useTsc.load(std::memory_order_relaxed))
+	{
+		return static_cast<int64_t>(ticks);
+	}
+
+	uint64_t baseTicks;
+	int64_t  baseNs;
+	double   nsPerTick;
+	uint32_t begin;
+	do
+	{
+		begin     = s_sequence.load(std::memory_order_acquire);
+		baseTicks = s_baseTicks.load(std::memory_order_relaxed);
+		baseNs    = s_baseNs.load(std::memory_order_relaxed);
+		nsPerTick = s_nsPerTick.load(std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_acquire);
+	}
+	while ((begin & 1) != 0 || s_sequence.load(std::memory_order_relaxed) != begin);
+
+	// Readings taken just before a re-anchoring are older than the anchor.
+	const auto delta = static_cast<int64_t>(ticks - baseTicks);
+	return baseNs + static_cast<int64_t>(static_cast<double>(delta) * nsPerTick);
+}
+
+_Use_decl_annotations_
+void TscClock::ReadPair(
+	uint64_t& ticks,
+	int64_t&  ns)
+{
+	// Bracket the TSC reading between two steady clock readings and keep the tightest of a
+	// few tries, so a preemption between the reads does not skew the pair.
+	int64_t bestWindow = INT64_MAX;
+	ticks              = 0;
+	ns                 = 0;
+	for (int attempt = 0; attempt < 5; attempt++)
+	{
+		const int64_t before = SteadyNs();
+#if PERFOVERLAY_HAS_TSC
+		const uint64_t tsc = __rdtsc();
+#else
+		const uint64_t tsc = Now();
+#endif
+		const int64_t after = SteadyNs();
+		if (after - before < bestWindow)
+		{
+			bestWindow = after - before;
+			ticks      = tsc;
+			ns         = before + (after - before) / 2;
+		}
+	}
+}
+
+_Use_decl_annotations_
+void TscClock::Publish(
+	const uint64_t ticks,
+	const int64_t  ns,
+	const double   nsPerTick)
+{
+	const uint32_t begin = s_sequence.load(std::memory_order_relaxed);
+	s_sequence.store(begin + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	s_baseTicks.store(ticks, std::memory_order_relaxed);
+	s_baseNs.store(ns, std::memory_order_relaxed);
+	s_nsPerTick.store(nsPerTick, std::memory_order_relaxed);
+
+	s_sequence.store(begin + 2, std::memory_order_release);
+}
+
+
+bool IsInvariantTscUsable()
+{
+#if PERFOVERLAY_HAS_TSC
+	// CPUID 8000_0007h EDX bit 8: the TSC runs at a constant rate in all ACPI P-, C- and T-states.
+	uint32_t edx = 0;
+#ifdef _MSC_VER
+	int registers[4] = {};
+	__cpuid(registers, 0x80000000);
+	if (static_cast<uint32_t>(registers[0]) >= 0x80000007)
+	{
+		__cpuid(registers, 0x80000007);
+		edx = static_cast<uint32_t>(registers[3]);
+	}
+#else
+	uint32_t eax, ebx, ecx;
+	if (__get_cpuid_max(0x80000000, nullptr) >= 0x80000007)
+	{
+		__cpuid(0x80000007, eax, ebx, ecx, edx);
+	}
+#endif
+	if ((edx & (1u << 8)) == 0)
+	{
+		return false;
+	}
+
+#ifdef __linux__
+	// The kernel switches away from the TSC when it finds it unsynchronized across CPUs
+	// or unstable; follow its verdict when it is visible.
+	ProcFile clocksource;
+	char     name[32];
+	if (clocksource.Open("/sys/devices/system/clocksource/clocksource0/current_clocksource") &&
+		clocksource.Read(name, sizeof(name)) > 0)
+	{
+		return std::strncmp(name, "tsc", 3) == 0;
+	}
+#endif
+	return true;
+#else
+	return false;
+#endif
+}
+
+int64_t SteadyNs()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
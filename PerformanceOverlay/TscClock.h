@@ -0,0 +1,157 @@
+/**
+ * @file TscClock.h
+ * @brief Contains the declaration of the TscClock class.
+ * @author Alessandro Bellia
+ * @date 10/15/2026
+ */
+
+#pragma once
+
+#include "Platform.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#if defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#define PERFOVERLAY_HAS_TSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define PERFOVERLAY_HAS_TSC 1
+#else
+#define PERFOVERLAY_HAS_TSC 0
+#endif
+
+/**
+ * @class TscClock
+ * @brief The process-wide timestamp source shared by the collectors, the history and the profiler.
+ *
+ * Now() reads the invariant TSC, which costs a few nanoseconds and no system call. Where
+ * there is no invariant TSC (other architectures, some virtual machines, or a kernel that
+ * marked it unstable), Now() reads the steady clock instead, which is the vDSO
+ * clock_gettime() on Linux and QueryPerformanceCounter() on Windows. Ticks are only
+ * converted to nanoseconds at the edges, with ToNanoseconds() for timestamps and
+ * DurationNs() for tick deltas. The nanoseconds use the steady clock's epoch, so they can
+ * be compared with std::chrono::steady_clock.
+ *
+ * Calibrate() measures the tick rate against the steady clock at startup. Resync() then
+ * re-anchors the conversion from time to time and refines the rate over the whole time
+ * since calibration, so the drift between the two clocks stays bounded. Resync() must only
+ * be called from one thread. The conversion parameters are published under a sequence
+ * lock, so readers on any thread never block.
+ */
+class TscClock
+{
+public:
+	/**
+	 * @brief The minimum time between two re-anchorings; Resync() returns early before that.
+	 */
+	static constexpr std::chrono::seconds kResyncPeriod{1};
+
+	TscClock() = delete;
+
+	/**
+	 * @brief Decides whether the TSC can be used and measures its rate against the steady
+	 *		  clock, which takes about 10 ms. Only the first call does anything. Timestamps
+	 *		  taken before it are steady-clock nanoseconds.
+	 */
+	static void Calibrate();
+
+	/**
+	 * @brief Re-anchors the tick-to-nanosecond conversion at the current time, if at least
+	 *		  kResyncPeriod has passed since the last anchor. Must only be called from one thread.
+	 */
+	static void Resync();
+
+	/**
+	 * @brief Reads the clock.
+	 * @return The current time in ticks, only meaningful to ToNanoseconds() and DurationNs().
+	 */
+	[[nodiscard]] static uint64_t Now()
+	{
+#if PERFOVERLAY_HAS_TSC
+		if (s_useTsc.load(std::memory_order_relaxed))
+		{
+			return __rdtsc();
+		}
+#endif
+		return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count());
+	}
+
+	/**
+	 * @brief Converts a tick delta to nanoseconds.
+	 * @param[in] ticks The difference of two Now() readings.
+	 * @return The elapsed nanoseconds.
+	 */
+	[[nodiscard]] static int64_t DurationNs(
+		_In_ uint64_t ticks)
+	{
+		return static_cast<int64_t>(static_cast<double>(ticks) * s_nsPerTick.load(std::memory_order_relaxed));
+	}
+
+	/**
+	 * @brief Converts a Now() reading to a timestamp.
+	 * @param[in] ticks The reading.
+	 * @return The time in nanoseconds since the steady clock's epoch.
+	 */
+	[[nodiscard]] static int64_t ToNanoseconds(
+		_In_ uint64_t ticks);
+
+	/**
+	 * @brief Reads the clock as a timestamp.
+	 * @return The current time in nanoseconds since the steady clock's epoch.
+	 */
+	[[nodiscard]] static int64_t NowNs() { return ToNanoseconds(Now()); }
+
+	/**
+	 * @brief Checks whether the TSC is used.
+	 * @return True if Now() reads the TSC, false if it reads the steady clock.
+	 */
+	[[nodiscard]] static bool IsUsingTsc() { return s_useTsc.load(std::memory_order_relaxed); }
+
+	/**
+	 * @brief Gets the measured tick rate.
+	 * @return The ticks per second; 1e9 when the steady clock is used.
+	 */
+	[[nodiscard]] static double GetTicksPerSecond() { return 1e9 / s_nsPerTick.load(std::memory_order_relaxed); }
+
+	/**
+	 * @brief Gets how far the conversion had drifted from the steady clock when it was last re-anchored.
+	 * @return The signed error in nanoseconds, positive when the TSC-based time ran ahead.
+	 */
+	[[nodiscard]] static int64_t GetLastResyncErrorNs() { return s_lastResyncErrorNs.load(std::memory_order_relaxed); }
+
+private:
+	/**
+	 * @brief Reads the TSC and the steady clock as close together as possible.
+	 * @param[out] ticks The TSC reading.
+	 * @param[out] ns The steady clock reading taken at the same moment, in nanoseconds.
+	 */
+	static void ReadPair(
+		_Out_ uint64_t& ticks,
+		_Out_ int64_t&  ns);
+
+	/**
+	 * @brief Publishes a new anchor and rate under the sequence lock.
+	 * @param[in] ticks The anchor's TSC reading.
+	 * @param[in] ns The anchor's time in nanoseconds.
+	 * @param[in] nsPerTick The new rate.
+	 */
+	static void Publish(
+		_In_ uint64_t ticks,
+		_In_ int64_t  ns,
+		_In_ double   nsPerTick);
+
+	static std::atomic<bool>     s_useTsc;
+	static std::atomic<uint32_t> s_sequence;
+	static std::atomic<uint64_t> s_baseTicks;
+	static std::atomic<int64_t>  s_baseNs;
+	static std::atomic<double>   s_nsPerTick;
+	static std::atomic<int64_t>  s_lastResyncErrorNs;
+
+	// Written by Calibrate() and then only by the thread calling Resync().
+	static bool     s_calibrated;
+	static uint64_t s_calibrationTicks;
+	static int64_t  s_calibrationNs;
+};
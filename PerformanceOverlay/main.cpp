@@ -13,16 +13,37 @@
 #include <Windows.h>
 #include <dwmapi.h>
 #include <shellapi.h>
+#include <timeapi.h>
+#include "AllocationCounter.h"
 #include "D3D11Renderer.h"
+#include "FrameScheduler.h"
 #include "Gui.h"
+#include "TscClock.h"
 #include "resource.h"
 #include "imgui.h"
+#include <cstdio>
 
 
 // --- Defines for Tray Icon ---
 #define WM_APP_TRY_MSG (WM_APP + 1) // Custom message for Tray Icon events
 #define TRAY_ICON_ID 1				// Unique ID for Tray Icon
 #define IDM_EXIT 1001				// Menu item ID for "Exit"
+#define IDM_CORE_HEATMAP 1002		// Menu item ID for "Per-core Heatmap"
+#define IDM_SPAN_MINUTE 1003		// Menu item ID for "Graph Span > 1 Minute"
+#define IDM_SPAN_HOUR 1004			// Menu item ID for "Graph Span > 1 Hour"
+#define IDM_SPAN_DAY 1005			// Menu item ID for "Graph Span > 24 Hours"
+#define IDM_FPS_10 1006				// Menu item ID for "Frame Rate Cap > 10 FPS"
+#define IDM_FPS_30 1007				// Menu item ID for "Frame Rate Cap > 30 FPS"
+#define IDM_FPS_60 1008				// Menu item ID for "Frame Rate Cap > 60 FPS"
+#define IDM_FPS_VSYNC 1009			// Menu item ID for "Frame Rate Cap > Vsync Only"
+#define IDM_SELF_PROFILE 1010		// Menu item ID for "Self Profile"
+#define IDM_PROCESSES 1011			// Menu item ID for "Processes"
+#define IDM_SORT_NAME 1012			// Menu item ID for "Sort Processes By > Name"
+#define IDM_SORT_PID 1013			// Menu item ID for "Sort Processes By > PID"
+#define IDM_SORT_CPU 1014			// Menu item ID for "Sort Processes By > CPU"
+#define IDM_SORT_MEMORY 1015		// Menu item ID for "Sort Processes By > Memory"
+#define IDM_SORT_IO 1016			// Menu item ID for "Sort Processes By > I/O"
+#define IDM_SORT_WAIT 1017			// Menu item ID for "Sort Processes By > Run-Queue Wait"
 
 
 /**
@@ -68,6 +89,27 @@ static void RemoveTrayIcon(
 static void ShowContextMenu(
 	_In_ HWND hWnd);
 
+/**
+ * @brief Gets the refresh interval of the display the compositor presents to.
+ * 
+ * @return The refresh interval, or that of a 60 Hz display if it cannot be queried.
+ */
+static std::chrono::nanoseconds GetRefreshInterval();
+
+/**
+ * @brief Gets the CPU time consumed so far by the calling thread.
+ * 
+ * @return The user plus kernel time of the thread.
+ */
+static std::chrono::nanoseconds GetThreadCpuTime();
+
+/**
+ * @brief Gets the current time on the steady clock the frame scheduler runs on.
+ * 
+ * @return The time since the clock's epoch.
+ */
+static std::chrono::nanoseconds SchedulerNow();
+
 /**
  * @brief The entrypoint of the Windows application.
  * @param[in] hInstance A handle to the current instance of the application.
@@ -152,29 +194,120 @@ int WINAPI WinMain(
 	}
 
 
+	// Let the tray menu reach the GUI settings
+	::SetWindowLongPtr(hwnd, GWLP_USERDATA, reinterpret_cast<LONG_PTR>(&gui));
+
+	// Ask for 1 ms timer resolution so the frame pacer's sleeps, and with them its spin
+	// window, stay short; Windows scopes the request to this process.
+	(void)::timeBeginPeriod(1);
+
 	// Main loop
-	MSG msg;
+	// Frames are only built when the sampler published, a message arrived, or ImGui still
+	// owes a follow-up frame; in between the thread sleeps on the publish event and the queue.
+	FrameScheduler scheduler(GetRefreshInterval(), SchedulerNow());
+	const HANDLE   publishEvent = gui.GetPublishEvent();
+	int            exitCode     = 0;
+	MSG            msg;
 	msg.message = WM_NULL;
+
+#ifdef PERFOVERLAY_COUNT_ALLOCATIONS
+	// Test mode: once everything has grown to its working size, the sample and frame path
+	// must not allocate any more. The first offending frame quits with exit code 3.
+	AllocationCheck allocationCheck(std::chrono::seconds(10));
+#endif
 	while (msg.message != WM_QUIT)
 	{
 		if (::PeekMessage(&msg, nullptr, 0U, 0U, PM_REMOVE) != 0)
 		{
+			// Input, tray commands, resizes and DPI changes can all alter the next frame.
+			scheduler.NotifyInput();
 			::TranslateMessage(&msg);
 			::DispatchMessage(&msg);
+			continue;
 		}
-		else
+
+		if (::WaitForSingleObject(publishEvent, 0) == WAIT_OBJECT_0)
 		{
+			scheduler.NotifyData();
+		}
+
+		const std::chrono::nanoseconds now = SchedulerNow();
+		if (scheduler.ShouldRender(now))
+		{
+			const std::chrono::nanoseconds cpuBefore = GetThreadCpuTime();
 			gui.Render();
+			scheduler.OnFrameRendered(GetThreadCpuTime() - cpuBefore);
+
+#ifdef PERFOVERLAY_COUNT_ALLOCATIONS
+			if (!allocationCheck.Check() && exitCode == 0)
+			{
+				::OutputDebugStringA("PerformanceOverlay: heap allocation in the steady-state frame path\n");
+				exitCode = 3;
+				::DestroyWindow(hwnd);
+			}
+#endif
+			continue;
+		}
+
+		const std::chrono::nanoseconds wait    = scheduler.TimeUntilNextFrame(now);
+		const DWORD                    timeout = wait == FrameScheduler::kNever
+			                                         ? INFINITE
+			                                         : static_cast<DWORD>(std::chrono::ceil<std::chrono::milliseconds>(wait).count());
+		// Waking on the auto-reset event consumes it, so it has to be recorded here.
+		if (::MsgWaitForMultipleObjectsEx(1, &publishEvent, timeout, QS_ALLINPUT, MWMO_INPUTAVAILABLE) == WAIT_OBJECT_0)
+		{
+			scheduler.NotifyData();
 		}
 	}
 
+	const FrameScheduler::Stats stats = scheduler.GetStats(SchedulerNow());
+	char                        report[160];
+	(void)sprintf_s(report, "PerformanceOverlay: %llu frames rendered, %llu skipped, %.1f ms CPU spent, ~%.1f ms CPU saved\n",
+	                stats.framesRendered, stats.framesSkipped, stats.frameCpuNs / 1e6, stats.cpuSavedNs / 1e6);
+	::OutputDebugStringA(report);
+
+	const FramePacer& pacer = gui.GetFramePacer();
+	(void)sprintf_s(report, "PerformanceOverlay: %llu paced frames, interval error p50 %.2f us, p99 %.2f us, %.1f ms spent spinning\n",
+	                pacer.GetPacedFrames(), pacer.GetJitterPercentile(0.5).count() / 1e3,
+	                pacer.GetJitterPercentile(0.99).count() / 1e3, pacer.GetSpinTime().count() / 1e6);
+	::OutputDebugStringA(report);
+
+	for (uint32_t subsystem = 0; subsystem < MemoryAccounting::SubsystemCount; subsystem++)
+	{
+		const auto                    id    = static_cast<MemoryAccounting::Subsystem>(subsystem);
+		const MemoryAccounting::Usage usage = MemoryAccounting::Get(id);
+		(void)sprintf_s(report, "PerformanceOverlay: %-12s %8zu KB, high-water %8zu KB\n",
+		                MemoryAccounting::GetName(id), usage.bytes / 1024, usage.highWater / 1024);
+		::OutputDebugStringA(report);
+	}
+
+	const TimerWheel& sources = gui.GetScheduler();
+	(void)sprintf_s(report, "PerformanceOverlay: %llu source reads, %llu avoided, lateness p50 %lld us, p99 %lld us, %llu deadlines missed\n",
+	                sources.GetFiredCount(),
+	                gui.GetAvoidedReads(),
+	                std::chrono::duration_cast<std::chrono::microseconds>(sources.GetLatenessPercentile(0.5)).count(),
+	                std::chrono::duration_cast<std::chrono::microseconds>(sources.GetLatenessPercentile(0.99)).count(),
+	                sources.GetMissedCount());
+	::OutputDebugStringA(report);
+
+	const PluginHost& plugins = gui.GetPlugins();
+	for (uint32_t plugin = 0; plugin < plugins.GetCount(); plugin++)
+	{
+		(void)sprintf_s(report, "PerformanceOverlay: plugin %s %s, slowest sample %.1f us\n",
+		                plugins.GetName(plugin), plugins.IsEnabled(plugin) ? "enabled" : "disabled (over budget)",
+		                plugins.GetMaxSampleNs(plugin) / 1e3);
+		::OutputDebugStringA(report);
+	}
+	(void)::timeEndPeriod(1);
+
 	// Cleanup
+	::SetWindowLongPtr(hwnd, GWLP_USERDATA, 0);
 	//gui.Shutdown();
 	//renderer.Shutdown();
 	::DestroyWindow(hwnd);
 	::UnregisterClass(wc.lpszClassName, wc.hInstance);
 
-	return static_cast<int>(msg.wParam);
+	return exitCode != 0 ? exitCode : static_cast<int>(msg.wParam);
 }
 
 // Forward declare message handler from imgui_impl_win32.cpp
@@ -213,6 +346,55 @@ LRESULT CALLBACK WndProc(
 		case IDM_EXIT:
 			::DestroyWindow(hWnd);
 			break;
+		case IDM_CORE_HEATMAP:
+			if (auto* pGui = reinterpret_cast<Gui*>(::GetWindowLongPtr(hWnd, GWLP_USERDATA)))
+			{
+				pGui->SetCoreHeatmapVisible(!pGui->IsCoreHeatmapVisible());
+			}
+			break;
+		case IDM_SELF_PROFILE:
+			if (auto* pGui = reinterpret_cast<Gui*>(::GetWindowLongPtr(hWnd, GWLP_USERDATA)))
+			{
+				pGui->SetSelfProfileVisible(!pGui->IsSelfProfileVisible());
+			}
+			break;
+		case IDM_PROCESSES:
+			if (auto* pGui = reinterpret_cast<Gui*>(::GetWindowLongPtr(hWnd, GWLP_USERDATA)))
+			{
+				pGui->SetProcessesVisible(!pGui->IsProcessesVisible());
+			}
+			break;
+		case IDM_SORT_NAME:
+		case IDM_SORT_PID:
+		case IDM_SORT_CPU:
+		case IDM_SORT_MEMORY:
+		case IDM_SORT_IO:
+		case IDM_SORT_WAIT:
+			if (auto* pGui = reinterpret_cast<Gui*>(::GetWindowLongPtr(hWnd, GWLP_USERDATA)))
+			{
+				// The ids follow the panel's column order.
+				pGui->SetProcessSort(static_cast<ProcessPanel::Column>(LOWORD(wParam) - IDM_SORT_NAME));
+			}
+			break;
+		case IDM_SPAN_MINUTE:
+		case IDM_SPAN_HOUR:
+		case IDM_SPAN_DAY:
+			if (auto* pGui = reinterpret_cast<Gui*>(::GetWindowLongPtr(hWnd, GWLP_USERDATA)))
+			{
+				const std::chrono::seconds spans[] = {std::chrono::minutes(1), std::chrono::hours(1), std::chrono::hours(24)};
+				pGui->SetGraphSpan(spans[LOWORD(wParam) - IDM_SPAN_MINUTE]);
+			}
+			break;
+		case IDM_FPS_10:
+		case IDM_FPS_30:
+		case IDM_FPS_60:
+		case IDM_FPS_VSYNC:
+			if (auto* pGui = reinterpret_cast<Gui*>(::GetWindowLongPtr(hWnd, GWLP_USERDATA)))
+			{
+				constexpr double rates[] = {10.0, 30.0, 60.0, 0.0};
+				pGui->SetFrameRateCap(rates[LOWORD(wParam) - IDM_FPS_10]);
+			}
+			break;
 		}
 		return 0;
 	case WM_DESTROY:
@@ -263,6 +445,67 @@ void ShowContextMenu(
 	const HMENU hMenu = ::CreatePopupMenu();
 	if (hMenu)
 	{
+		const auto* pGui = reinterpret_cast<const Gui*>(::GetWindowLongPtr(hWnd, GWLP_USERDATA));
+		if (pGui)
+		{
+			const UINT checked = pGui->IsCoreHeatmapVisible() ? MF_CHECKED : MF_UNCHECKED;
+			::InsertMenu(hMenu, -1, MF_BYPOSITION | checked, IDM_CORE_HEATMAP, L"Per-core Heatmap");
+
+			const UINT profileChecked = pGui->IsSelfProfileVisible() ? MF_CHECKED : MF_UNCHECKED;
+			::InsertMenu(hMenu, -1, MF_BYPOSITION | profileChecked, IDM_SELF_PROFILE, L"Self Profile");
+
+			const UINT processesChecked = pGui->IsProcessesVisible() ? MF_CHECKED : MF_UNCHECKED;
+			::InsertMenu(hMenu, -1, MF_BYPOSITION | processesChecked, IDM_PROCESSES, L"Processes");
+
+			const HMENU hSortMenu = ::CreatePopupMenu();
+			if (hSortMenu)
+			{
+				::InsertMenu(hSortMenu, -1, MF_BYPOSITION, IDM_SORT_NAME, L"Name");
+				::InsertMenu(hSortMenu, -1, MF_BYPOSITION, IDM_SORT_PID, L"PID");
+				::InsertMenu(hSortMenu, -1, MF_BYPOSITION, IDM_SORT_CPU, L"CPU");
+				::InsertMenu(hSortMenu, -1, MF_BYPOSITION, IDM_SORT_MEMORY, L"Memory");
+				::InsertMenu(hSortMenu, -1, MF_BYPOSITION, IDM_SORT_IO, L"I/O");
+				::InsertMenu(hSortMenu, -1, MF_BYPOSITION, IDM_SORT_WAIT, L"Run-Queue Wait");
+				::CheckMenuRadioItem(hSortMenu, IDM_SORT_NAME, IDM_SORT_WAIT, IDM_SORT_NAME + pGui->GetProcessSort(), MF_BYCOMMAND);
+
+				::InsertMenu(hMenu, -1, MF_BYPOSITION | MF_POPUP, reinterpret_cast<UINT_PTR>(hSortMenu), L"Sort Processes By");
+			}
+
+			const HMENU hSpanMenu = ::CreatePopupMenu();
+			if (hSpanMenu)
+			{
+				::InsertMenu(hSpanMenu, -1, MF_BYPOSITION, IDM_SPAN_MINUTE, L"1 Minute");
+				::InsertMenu(hSpanMenu, -1, MF_BYPOSITION, IDM_SPAN_HOUR, L"1 Hour");
+				::InsertMenu(hSpanMenu, -1, MF_BYPOSITION, IDM_SPAN_DAY, L"24 Hours");
+
+				const auto span   = pGui->GetGraphSpan();
+				const UINT spanId = span >= std::chrono::hours(24)
+					                    ? IDM_SPAN_DAY
+					                    : span >= std::chrono::hours(1) ? IDM_SPAN_HOUR : IDM_SPAN_MINUTE;
+				::CheckMenuRadioItem(hSpanMenu, IDM_SPAN_MINUTE, IDM_SPAN_DAY, spanId, MF_BYCOMMAND);
+
+				// The parent menu takes ownership of the submenu and destroys it with itself.
+				::InsertMenu(hMenu, -1, MF_BYPOSITION | MF_POPUP, reinterpret_cast<UINT_PTR>(hSpanMenu), L"Graph Span");
+			}
+
+			const HMENU hRateMenu = ::CreatePopupMenu();
+			if (hRateMenu)
+			{
+				::InsertMenu(hRateMenu, -1, MF_BYPOSITION, IDM_FPS_10, L"10 FPS");
+				::InsertMenu(hRateMenu, -1, MF_BYPOSITION, IDM_FPS_30, L"30 FPS");
+				::InsertMenu(hRateMenu, -1, MF_BYPOSITION, IDM_FPS_60, L"60 FPS");
+				::InsertMenu(hRateMenu, -1, MF_BYPOSITION, IDM_FPS_VSYNC, L"Vsync Only");
+
+				const double rate   = pGui->GetFrameRateCap();
+				const UINT   rateId = rate <= 0.0
+					                      ? IDM_FPS_VSYNC
+					                      : rate <= 10.0 ? IDM_FPS_10 : rate <= 30.0 ? IDM_FPS_30 : IDM_FPS_60;
+				::CheckMenuRadioItem(hRateMenu, IDM_FPS_10, IDM_FPS_VSYNC, rateId, MF_BYCOMMAND);
+
+				::InsertMenu(hMenu, -1, MF_BYPOSITION | MF_POPUP, reinterpret_cast<UINT_PTR>(hRateMenu), L"Frame Rate Cap");
+			}
+			::InsertMenu(hMenu, -1, MF_BYPOSITION | MF_SEPARATOR, 0, nullptr);
+		}
 		::InsertMenu(hMenu, -1, MF_BYPOSITION, IDM_EXIT, L"Exit");
 		// Set the foreground window to ensure the menu is displayed correctly
 		::SetForegroundWindow(hWnd);
@@ -278,3 +521,36 @@ void ShowContextMenu(
 		::DestroyMenu(hMenu);
 	}
 }
+
+std::chrono::nanoseconds GetRefreshInterval()
+{
+	DWM_TIMING_INFO timingInfo = {};
+	timingInfo.cbSize          = sizeof(DWM_TIMING_INFO);
+	if (SUCCEEDED(::DwmGetCompositionTimingInfo(nullptr, &timingInfo)) && timingInfo.rateRefresh.uiNumerator != 0)
+	{
+		return std::chrono::nanoseconds(1'000'000'000LL * timingInfo.rateRefresh.uiDenominator / timingInfo.rateRefresh.uiNumerator);
+	}
+
+	return std::chrono::nanoseconds(1'000'000'000LL / 60);
+}
+
+std::chrono::nanoseconds GetThreadCpuTime()
+{
+	FILETIME creationTime, exitTime, kernelTime, userTime;
+	if (!::GetThreadTimes(::GetCurrentThread(), &creationTime, &exitTime, &kernelTime, &userTime))
+	{
+		return std::chrono::nanoseconds::zero();
+	}
+
+	// FILETIME counts 100 ns units.
+	const auto toTicks = [](const FILETIME& time)
+	{
+		return static_cast<int64_t>(time.dwHighDateTime) << 32 | time.dwLowDateTime;
+	};
+	return std::chrono::nanoseconds((toTicks(kernelTime) + toTicks(userTime)) * 100);
+}
+
+std::chrono::nanoseconds SchedulerNow()
+{
+	return std::chrono::nanoseconds(TscClock::NowNs());
+}
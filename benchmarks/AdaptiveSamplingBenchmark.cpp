@@ -0,0 +1,485 @@
+/**
+ * @file AdaptiveSamplingBenchmark.cpp
+ * @brief Replays CPU load traces through fixed-rate samplers and AdaptiveRate, comparing
+ *		  the number of reads against how quickly load spikes show up.
+ * @author Alessandro Bellia
+ * @date 10/15/2026
+ *
+ * Build and run from the repository root:
+ *
+ *	g++ -O2 -std=c++20 -IPerformanceOverlay benchmarks/AdaptiveSamplingBenchmark.cpp \
+ *		PerformanceOverlay/AdaptiveRate.cpp PerformanceOverlay/ProcFile.cpp -o adaptive-bench
+ *	./adaptive-bench record trace.csv [seconds]
+ *	./adaptive-bench [trace.csv ...]
+ *
+ * "record" samples the aggregate busy and total jiffies of /proc/stat every 10 ms for the
+ * given number of seconds (120 by default) into a CSV file. Replaying reads every trace given,
+ * or a built-in synthetic trace when there is none. A replayed read at time t returns the load
+ * averaged since the sampler's previous read, as the real CPU source does, so a long interval
+ * dilutes a short spike just as it would live.
+ *
+ * A spike starts on the first 250 ms window at or above kSpikeLevel after at least a second
+ * below it. Its latency is the time from the end of that window, when a sampler reading every
+ * tick would first show it, to the first read at or above kSpikeLevel; a spike that never
+ * reaches it before kDetectTimeout counts as missed. Reads are counted per source, which is
+ * what the sampler pays for: each one is a procfs read or a WMI query. The error column is
+ * the mean distance, in percentage points, between the value on screen (the last read) and
+ * the true load of every 250 ms tick, i.e. how faithful the graph is.
+ *
+ * The default range, AdaptiveRate::kDefaultMinInterval to kDefaultMaxInterval, is the one the
+ * sampler ships with, so it must pay for its reads: if any fixed sampler detects at least as
+ * many spikes with at most as many reads, the default is dominated and the program exits
+ * with 1.
+ */
+
+#ifdef __linux__
+
+#include "AdaptiveRate.h"
+#include "ProcFile.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+/**
+ * @struct TraceRow
+ * @brief The cumulative CPU counters at one point of a trace.
+ */
+struct TraceRow
+{
+	int64_t  timestampNs;
+	uint64_t busy;
+	uint64_t total;
+};
+
+/**
+ * @struct Result
+ * @brief The outcome of replaying one trace through one sampler.
+ */
+struct Result
+{
+	uint64_t             reads;
+	double               errorSum;  ///< Sum over all ticks of |value shown - true tick load|.
+	uint64_t             ticks;
+	uint32_t             detected;
+	std::vector<int64_t> latenciesNs;
+};
+
+/**
+ * @brief The sampler tick, and the shortest adaptive interval.
+ */
+static constexpr int64_t kTickNs = 250'000'000;
+
+/**
+ * @brief The load, in percent, that counts as a spike.
+ */
+static constexpr float kSpikeLevel = 50.0f;
+
+/**
+ * @brief The time after which an undetected spike counts as missed.
+ */
+static constexpr int64_t kDetectTimeoutNs = 10'000'000'000;
+
+/**
+ * @brief The interval the trace recorder samples /proc/stat at.
+ */
+static constexpr std::chrono::milliseconds kRecordInterval{10};
+
+/**
+ * @brief Records /proc/stat into a trace file.
+ * @param[in] path The CSV file to write.
+ * @param[in] seconds How long to record.
+ * @return The process exit code.
+ */
+static int Record(
+	_In_z_ const char* path,
+	_In_ int           seconds);
+
+/**
+ * @brief Loads a trace file written by Record().
+ * @param[in] path The CSV file to read.
+ * @return The rows, empty on failure.
+ */
+static std::vector<TraceRow> LoadTrace(
+	_In_z_ const char* path);
+
+/**
+ * @brief Builds a ten-minute synthetic trace: an idle baseline with noise, short and long
+ *		  spikes at random times, and a minute of busy, fluctuating load.
+ * @return The rows, 10 ms apart.
+ */
+static std::vector<TraceRow> SynthesizeTrace();
+
+/**
+ * @brief Finds the spike onsets of a trace.
+ * @param[in] trace The trace.
+ * @return The end times of the 250 ms windows each spike starts in.
+ */
+static std::vector<int64_t> FindSpikes(
+	_In_ const std::vector<TraceRow>& trace);
+
+/**
+ * @brief Replays a trace through a sampler that reads whenever the rate says it is due.
+ * @param[in] trace The trace.
+ * @param[in] spikes The spike onsets found by FindSpikes().
+ * @param[in] isDue Called with the tick time; returns true to read.
+ * @param[in] observe Called with the tick time and the value read.
+ * @return The read count and spike latencies.
+ */
+template <typename IsDue, typename Observe>
+static Result Replay(
+	_In_ const std::vector<TraceRow>& trace,
+	_In_ const std::vector<int64_t>&  spikes,
+	_In_ IsDue                        isDue,
+	_In_ Observe                      observe);
+
+/**
+ * @brief Prints one line of the result table.
+ * @param[in] name The sampler's label.
+ * @param[in] result Its result.
+ * @param[in] baselineReads The reads of the fixed-tick sampler, for the saving column.
+ * @param[in] spikeCount The number of spikes in the trace.
+ */
+static void PrintResult(
+	_In_z_ const char* name,
+	_In_ const Result& result,
+	_In_ uint64_t      baselineReads,
+	_In_ size_t        spikeCount);
+
+/**
+ * @brief Computes the load between two points of a trace.
+ * @param[in] from The earlier row.
+ * @param[in] to The later row.
+ * @return The busy share of the elapsed time, in percent.
+ */
+static float LoadBetween(
+	_In_ const TraceRow& from,
+	_In_ const TraceRow& to);
+
+/**
+ * @brief Gets the CPU counters at a time, from the last row at or before it.
+ * @param[in] trace The trace.
+ * @param[in] timestampNs The time.
+ * @return The row.
+ */
+static const TraceRow& RowAt(
+	_In_ const std::vector<TraceRow>& trace,
+	_In_ int64_t                      timestampNs);
+
+
+int main(
+	_In_ const int          argc,
+	_In_reads_(argc) char** argv)
+{
+	if (argc > 2 && std::strcmp(argv[1], "record") == 0)
+	{
+		return Record(argv[2], argc > 3 ? std::max(std::atoi(argv[3]), 1) : 120);
+	}
+
+	const int traceCount = std::max(argc - 1, 1);
+	int       exitCode   = 0;
+	for (int index = 0; index < traceCount; index++)
+	{
+		const char* const           name  = argc > 1 ? argv[index + 1] : "synthetic";
+		const std::vector<TraceRow> trace = argc > 1 ? LoadTrace(name) : SynthesizeTrace();
+		if (trace.size() < 2)
+		{
+			std::fprintf(stderr, "%s: not a trace\n", name);
+			return 1;
+		}
+
+		const std::vector<int64_t> spikes = FindSpikes(trace);
+		std::printf("%s: %.0f s, %zu spikes\n", name, (trace.back().timestampNs - trace.front().timestampNs) / 1e9, spikes.size());
+		std::printf("  %-32s %8s %7s %7s %9s %10s %10s %10s\n", "sampler", "reads", "saved", "error", "detected", "mean", "p95", "max");
+
+		uint64_t            baselineReads = 0;
+		std::vector<Result> fixed;
+		for (const int64_t intervalNs : {kTickNs, 2 * kTickNs, 4 * kTickNs, 8 * kTickNs})
+		{
+			int64_t      nextNs = INT64_MIN;
+			const Result result = Replay(trace, spikes,
+			                             [&nextNs](const int64_t nowNs) { return nowNs >= nextNs; },
+			                             [&nextNs, intervalNs](const int64_t nowNs, float) { nextNs = nowNs + intervalNs; });
+			baselineReads = baselineReads == 0 ? result.reads : baselineReads;
+
+			char label[32];
+			(void)std::snprintf(label, sizeof(label), "fixed %lld ms", static_cast<long long>(intervalNs / 1'000'000));
+			PrintResult(label, result, baselineReads, spikes.size());
+			fixed.push_back(result);
+		}
+
+		constexpr int64_t kDefaultMinNs = std::chrono::nanoseconds(AdaptiveRate::kDefaultMinInterval).count();
+		constexpr int64_t kDefaultMaxNs = std::chrono::nanoseconds(AdaptiveRate::kDefaultMaxInterval).count();
+		static_assert(kDefaultMinNs == kTickNs, "the replay ticks at the default minimum interval");
+
+		static_assert(kDefaultMaxNs == 4 * kTickNs || kDefaultMaxNs == 8 * kTickNs || kDefaultMaxNs == 16 * kTickNs,
+		              "the default range is one of those replayed");
+		for (const int64_t maxIntervalNs : {4 * kTickNs, 8 * kTickNs, 16 * kTickNs})
+		{
+
+			AdaptiveRate rate;
+			int64_t      nextNs = INT64_MIN;
+			rate.SetRange(std::chrono::nanoseconds(kTickNs), std::chrono::nanoseconds(maxIntervalNs));
+			const Result result = Replay(trace, spikes,
+			                             [&nextNs](const int64_t nowNs) { return nowNs >= nextNs; },
+			                             [&rate, &nextNs](const int64_t nowNs, const float value)
+			                             {
+				                             rate.Observe(value);
+				                             nextNs = nowNs + rate.GetIntervalNs();
+			                             });
+
+			char label[48];
+			(void)std::snprintf(label, sizeof(label), "adaptive 250-%lld ms%s", static_cast<long long>(maxIntervalNs / 1'000'000),
+			                    maxIntervalNs == kDefaultMaxNs ? " (default)" : "");
+			PrintResult(label, result, baselineReads, spikes.size());
+
+			for (size_t i = 0; maxIntervalNs == kDefaultMaxNs && i < fixed.size(); i++)
+			{
+				if (fixed[i].reads <= result.reads && fixed[i].detected >= result.detected)
+				{
+					std::fprintf(stderr, "%s: fixed %lld ms detects %u spikes with %llu reads, the default range %u with %llu\n",
+					             name, static_cast<long long>((kTickNs << i) / 1'000'000), fixed[i].detected,
+					             static_cast<unsigned long long>(fixed[i].reads), result.detected,
+					             static_cast<unsigned long long>(result.reads));
+					exitCode = 1;
+				}
+			}
+		}
+	}
+
+	std::printf(exitCode == 0 ? "ok\n" : "FAILED\n");
+	return exitCode;
+}
+
+
+_Use_decl_annotations_
+int Record(
+	const char* path,
+	const int   seconds)
+{
+	ProcFile stat;
+	if (!stat.Open("/proc/stat"))
+	{
+		std::fprintf(stderr, "cannot open /proc/stat\n");
+		return 1;
+	}
+	FILE* const file = std::fopen(path, "w");
+	if (!file)
+	{
+		std::fprintf(stderr, "cannot create %s\n", path);
+		return 1;
+	}
+
+	char       buffer[4096];
+	auto       deadline = std::chrono::steady_clock::now();
+	const auto end      = deadline + std::chrono::seconds(seconds);
+	while (deadline < end)
+	{
+		const long length = stat.Read(buffer, sizeof(buffer) - 1);
+		if (length > 0)
+		{
+			// The aggregate "cpu" line: user nice system idle iowait irq softirq steal.
+			buffer[length]          = '\0';
+			unsigned long long v[8] = {};
+			if (std::sscanf(buffer, "cpu %llu %llu %llu %llu %llu %llu %llu %llu",
+			                &v[0], &v[1], &v[2], &v[3], &v[4], &v[5], &v[6], &v[7]) == 8)
+			{
+				const unsigned long long idle  = v[3] + v[4];
+				const unsigned long long total = v[0] + v[1] + v[2] + v[3] + v[4] + v[5] + v[6] + v[7];
+				std::fprintf(file, "%lld,%llu,%llu\n",
+				             static_cast<long long>(std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch()).count()),
+				             total - idle, total);
+			}
+		}
+		deadline += kRecordInterval;
+		std::this_thread::sleep_until(deadline);
+	}
+
+	std::fclose(file);
+	return 0;
+}
+
+_Use_decl_annotations_
+std::vector<TraceRow> LoadTrace(
+	const char* path)
+{
+	std::vector<TraceRow> trace;
+	FILE* const           file = std::fopen(path, "r");
+	if (!file)
+	{
+		return trace;
+	}
+
+	long long          timestampNs = 0;
+	unsigned long long busy        = 0;
+	unsigned long long total       = 0;
+	while (std::fscanf(file, "%lld,%llu,%llu", &timestampNs, &busy, &total) == 3)
+	{
+		trace.push_back({timestampNs, busy, total});
+	}
+	std::fclose(file);
+	return trace;
+}
+
+std::vector<TraceRow> SynthesizeTrace()
+{
+	static constexpr int64_t  kStepNs = 10'000'000;
+	static constexpr int      kSteps  = 60'000;
+	static constexpr uint64_t kScale  = 1000; // Counter units per step
+
+	// A fixed-seed LCG keeps the trace identical across runs and compilers.
+	uint32_t   seed   = 12345;
+	const auto random = [&seed]
+	{
+		seed = seed * 1664525u + 1013904223u;
+		return static_cast<float>(seed >> 8) / static_cast<float>(1u << 24);
+	};
+
+	std::vector<TraceRow> trace;
+	trace.reserve(kSteps + 1);
+	trace.push_back({0, 0, 0});
+
+	int   spikeEnd   = 0;
+	int   nextSpike  = 1000;
+	float spikeLevel = 0.0f;
+	for (int step = 1; step <= kSteps; step++)
+	{
+		if (step == nextSpike)
+		{
+			spikeEnd   = step + 50 + static_cast<int>(450.0f * random()); // 0.5 to 5 s
+			spikeLevel = 60.0f + 40.0f * random();
+			nextSpike  = spikeEnd + 1500 + static_cast<int>(4500.0f * random()); // 15 to 60 s apart
+		}
+
+		float load = step < spikeEnd ? spikeLevel : 1.0f + 5.0f * random(); // Idle baseline
+		if (step >= 36'000 && step < 42'000)
+		{
+			load = 30.0f + 40.0f * random(); // A minute of busy, fluctuating load
+		}
+
+		const TraceRow& previous = trace.back();
+		trace.push_back({step * kStepNs,
+		                 previous.busy + static_cast<uint64_t>(load / 100.0f * kScale),
+		                 previous.total + kScale});
+	}
+	return trace;
+}
+
+_Use_decl_annotations_
+std::vector<int64_t> FindSpikes(
+	const std::vector<TraceRow>& trace)
+{
+	static constexpr int kQuietWindows = 4;
+
+	std::vector<int64_t> spikes;
+	int                  quiet = 0;
+	for (int64_t endNs = trace.front().timestampNs + kTickNs; endNs <= trace.back().timestampNs; endNs += kTickNs)
+	{
+		if (LoadBetween(RowAt(trace, endNs - kTickNs), RowAt(trace, endNs)) >= kSpikeLevel)
+		{
+			if (quiet >= kQuietWindows)
+			{
+				spikes.push_back(endNs);
+			}
+			quiet = 0;
+		}
+		else
+		{
+			quiet++;
+		}
+	}
+	return spikes;
+}
+
+template <typename IsDue, typename Observe>
+_Use_decl_annotations_
+Result Replay(
+	const std::vector<TraceRow>& trace,
+	const std::vector<int64_t>&  spikes,
+	IsDue                        isDue,
+	Observe                      observe)
+{
+	Result   result{};
+	size_t   spike    = 0; // The first onset not yet detected or timed out
+	TraceRow lastRead = trace.front();
+	float    shown    = 0.0f;
+
+	for (int64_t nowNs = trace.front().timestampNs + kTickNs; nowNs <= trace.back().timestampNs; nowNs += kTickNs)
+	{
+		while (spike < spikes.size() && nowNs - spikes[spike] > kDetectTimeoutNs)
+		{
+			spike++; // Missed
+		}
+
+		const float trueLoad = LoadBetween(RowAt(trace, nowNs - kTickNs), RowAt(trace, nowNs));
+		if (isDue(nowNs))
+		{
+			const TraceRow& row = RowAt(trace, nowNs);
+			shown               = LoadBetween(lastRead, row);
+			lastRead            = row;
+			result.reads++;
+			observe(nowNs, shown);
+
+			// One read at the spike level detects every onset it covers.
+			for (; shown >= kSpikeLevel && spike < spikes.size() && spikes[spike] <= nowNs; spike++)
+			{
+				result.detected++;
+				result.latenciesNs.push_back(nowNs - spikes[spike]);
+			}
+		}
+
+		result.errorSum += std::fabs(shown - trueLoad);
+		result.ticks++;
+	}
+	return result;
+}
+
+_Use_decl_annotations_
+void PrintResult(
+	const char*    name,
+	const Result&  result,
+	const uint64_t baselineReads,
+	const size_t   spikeCount)
+{
+	std::vector<int64_t> latencies = result.latenciesNs;
+	std::sort(latencies.begin(), latencies.end());
+
+	double mean = 0.0;
+	for (const int64_t latency : latencies)
+	{
+		mean += static_cast<double>(latency);
+	}
+	mean = latencies.empty() ? 0.0 : mean / static_cast<double>(latencies.size());
+
+	const int64_t p95 = latencies.empty() ? 0 : latencies[(latencies.size() - 1) * 95 / 100];
+	const int64_t max = latencies.empty() ? 0 : latencies.back();
+	std::printf("  %-32s %8llu %6.1f%% %7.2f %4u/%-4zu %7.0f ms %7.0f ms %7.0f ms\n",
+	            name, static_cast<unsigned long long>(result.reads),
+	            100.0 * (1.0 - static_cast<double>(result.reads) / static_cast<double>(baselineReads)),
+	            result.errorSum / static_cast<double>(std::max<uint64_t>(result.ticks, 1)),
+	            result.detected, spikeCount, mean / 1e6, p95 / 1e6, max / 1e6);
+}
+
+_Use_decl_annotations_
+float LoadBetween(
+	const TraceRow& from,
+	const TraceRow& to)
+{
+	const uint64_t total = to.total - from.total;
+	return total > 0 ? 100.0f * static_cast<float>(to.busy - from.busy) / static_cast<float>(total) : 0.0f;
+}
+
+_Use_decl_annotations_
+const TraceRow& RowAt(
+	const std::vector<TraceRow>& trace,
+	const int64_t                timestampNs)
+{
+	const auto after = std::upper_bound(trace.begin(), trace.end(), timestampNs,
+	                                    [](const int64_t value, const TraceRow& row) { return value < row.timestampNs; });
+	return after == trace.begin() ? trace.front() : *(after - 1);
+}
+
+#endif // __linux__
@@ -0,0 +1,176 @@
+/**
+ * @file CoreHeatmapTest.cpp
+ * @brief Checks that the core heatmap costs the same draw-list geometry at 4, 8, 64, 200
+ *		  and 512 cores.
+ * @author Alessandro Bellia
+ * @date 10/16/2026
+ *
+ * Build and run from the repository root:
+ *
+ *	g++ -O2 -std=c++20 -IPerformanceOverlay -Ilibs/imgui benchmarks/CoreHeatmapTest.cpp \
+ *		PerformanceOverlay/CoreHeatmap.cpp PerformanceOverlay/TscClock.cpp PerformanceOverlay/ProcFile.cpp \
+ *		libs/imgui/imgui.cpp libs/imgui/imgui_draw.cpp libs/imgui/imgui_tables.cpp libs/imgui/imgui_widgets.cpp -o heatmap-test
+ *	./heatmap-test
+ *
+ * ImGui runs headless: each frame is built and rendered to draw lists, which are not
+ * presented. The heatmap is filled with a full ring of columns and drawn the way
+ * Gui::RenderCoreLoads() does, between its two callbacks, into a window of its own. The
+ * vertices, indices and draw commands it adds to the window's draw list, and the frame's
+ * totals, must be the same at every core count; the program exits with 1 if they are not,
+ * if a machine with more cores than CoreHeatmap::kMaxRows is not pooled, or if a row holds
+ * no core. The last check pushes a column with every core saturated, which must color every
+ * row alike; 200 cores do not divide evenly into kMaxRows and catch rows left empty.
+ */
+
+#include "CoreHeatmap.h"
+#include "TscClock.h"
+#include "imgui.h"
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+/**
+ * @brief The number of frames the median draw time is taken over.
+ */
+static constexpr int kFrames = 101;
+
+/**
+ * @struct HeatmapGeometry
+ * @brief What drawing the heatmap adds to a frame.
+ */
+struct HeatmapGeometry
+{
+	int vertices;      ///< Added to the window's draw list.
+	int indices;       ///< Added to the window's draw list.
+	int commands;      ///< Added to the window's draw list.
+	int frameVertices; ///< In the whole rendered frame.
+	int frameIndices;  ///< In the whole rendered frame.
+};
+
+/**
+ * @brief Renders one frame holding the heatmap in a window of its own.
+ * @param[in] heatmap The heatmap.
+ * @param[out] geometry Receives what the heatmap added.
+ * @return The time the heatmap's draw calls took, in nanoseconds.
+ */
+static int64_t RenderFrame(
+	_In_ const CoreHeatmap& heatmap,
+	_Out_ HeatmapGeometry&  geometry);
+
+
+int main()
+{
+	TscClock::Calibrate();
+
+	ImGui::CreateContext();
+	ImGuiIO& io    = ImGui::GetIO();
+	io.DisplaySize = ImVec2(1920.0f, 1080.0f);
+	io.IniFilename = nullptr;
+	io.BackendFlags |= ImGuiBackendFlags_RendererHasTextures;
+
+	std::printf("%-6s %5s %9s %8s %9s %13s %12s %8s\n",
+	            "cores", "rows", "vertices", "indices", "commands", "frame verts", "frame idxs", "draw");
+
+	int             result = 0;
+	HeatmapGeometry first  = {};
+	for (const uint32_t coreCount : {4u, 8u, 64u, 200u, 512u})
+	{
+		CoreHeatmap heatmap;
+		heatmap.Resize(coreCount);
+
+		std::vector<float> loads(coreCount);
+		for (uint32_t column = 0; column < CoreHeatmap::kColumns; column++)
+		{
+			for (uint32_t core = 0; core < coreCount; core++)
+			{
+				loads[core] = static_cast<float>((core * 37 + column * 11) % 101);
+			}
+			(void)heatmap.PushColumn(loads.data(), coreCount);
+		}
+
+		HeatmapGeometry      geometry;
+		std::vector<int64_t> durations;
+		for (int frame = 0; frame < kFrames; frame++)
+		{
+			durations.push_back(RenderFrame(heatmap, geometry));
+		}
+		std::nth_element(durations.begin(), durations.begin() + kFrames / 2, durations.end());
+
+		std::printf("%-6u %5u %9d %8d %9d %13d %12d %5lld ns\n", coreCount, heatmap.GetRows(),
+		            geometry.vertices, geometry.indices, geometry.commands, geometry.frameVertices,
+		            geometry.frameIndices, static_cast<long long>(durations[kFrames / 2]));
+
+		if (coreCount == 4)
+		{
+			first = geometry;
+		}
+		else if (geometry.vertices != first.vertices || geometry.indices != first.indices ||
+				 geometry.commands != first.commands || geometry.frameVertices != first.frameVertices ||
+				 geometry.frameIndices != first.frameIndices)
+		{
+			std::fprintf(stderr, "%u cores draw different geometry than 4 cores\n", coreCount);
+			result = 1;
+		}
+		if (heatmap.GetRows() > CoreHeatmap::kMaxRows)
+		{
+			std::fprintf(stderr, "%u cores use %u rows, more than %u\n", coreCount, heatmap.GetRows(), CoreHeatmap::kMaxRows);
+			result = 1;
+		}
+
+		// A row without a core would stay at the idle color.
+		std::fill(loads.begin(), loads.end(), 100.0f);
+		(void)heatmap.PushColumn(loads.data(), coreCount);
+		const uint32_t* const pixels = heatmap.GetColumnPixels();
+		const uint32_t        rows   = heatmap.GetRows();
+		if (std::count(pixels, pixels + rows, pixels[0]) != rows)
+		{
+			std::fprintf(stderr, "%u cores leave rows without a core (%u rows of %u cores)\n",
+			             coreCount, rows, heatmap.GetCoresPerRow());
+			result = 1;
+		}
+	}
+
+	ImGui::DestroyContext();
+	std::printf(result == 0 ? "ok\n" : "FAILED\n");
+	return result;
+}
+
+
+_Use_decl_annotations_
+int64_t RenderFrame(
+	const CoreHeatmap& heatmap,
+	HeatmapGeometry&   geometry)
+{
+	ImGui::NewFrame();
+	ImGui::SetNextWindowPos(ImVec2(0.0f, 0.0f));
+	ImGui::SetNextWindowSize(ImVec2(400.0f, 300.0f));
+	ImGui::Begin("Heatmap", nullptr, ImGuiWindowFlags_NoDecoration);
+
+	// As in Gui::RenderCoreLoads(), with a placeholder texture and no sampler to bind.
+	ImDrawList* const drawList = ImGui::GetWindowDrawList();
+	const int         vertices = drawList->VtxBuffer.Size;
+	const int         indices  = drawList->IdxBuffer.Size;
+	const int         commands = drawList->CmdBuffer.Size;
+	const float       rows     = static_cast<float>(heatmap.GetRows());
+	const ImVec2      pos      = ImGui::GetCursorScreenPos();
+	const ImVec2      size(ImGui::GetContentRegionAvail().x, std::clamp(rows * 4.0f, 24.0f, 128.0f));
+	const int64_t     start    = TscClock::NowNs();
+
+	drawList->AddCallback(ImDrawCallback_ResetRenderState, nullptr);
+	heatmap.Draw(drawList, ImTextureRef(static_cast<ImTextureID>(1)), pos, size);
+	drawList->AddCallback(ImDrawCallback_ResetRenderState, nullptr);
+	ImGui::Dummy(size);
+
+	const int64_t elapsedNs = TscClock::NowNs() - start;
+	geometry.vertices       = drawList->VtxBuffer.Size - vertices;
+	geometry.indices        = drawList->IdxBuffer.Size - indices;
+	geometry.commands       = drawList->CmdBuffer.Size - commands;
+
+	ImGui::End();
+	ImGui::Render();
+
+	const ImDrawData* const drawData = ImGui::GetDrawData();
+	geometry.frameVertices           = drawData->TotalVtxCount;
+	geometry.frameIndices            = drawData->TotalIdxCount;
+	return elapsedNs;
+}
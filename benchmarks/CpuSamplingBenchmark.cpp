@@ -0,0 +1,266 @@
+/**
+ * @file CpuSamplingBenchmark.cpp
+ * @brief Measures the cost of a PerformanceMonitor CPU sample over synthetic /proc/stat
+ *		  files of 8, 64 and 512 cores.
+ * @author Alessandro Bellia
+ * @date 10/16/2026
+ *
+ * Build and run from the repository root:
+ *
+ *	g++ -O2 -std=c++20 -IPerformanceOverlay benchmarks/CpuSamplingBenchmark.cpp \
+ *		PerformanceOverlay/PerformanceMonitorLinux.cpp PerformanceOverlay/CpuCoreBank.cpp \
+ *		PerformanceOverlay/ProcFile.cpp PerformanceOverlay/MetricRegistry.cpp PerformanceOverlay/MetricHistory.cpp \
+ *		PerformanceOverlay/RollupStore.cpp PerformanceOverlay/MemoryAccounting.cpp \
+ *		PerformanceOverlay/SourceWatchdog.cpp PerformanceOverlay/AdaptiveRate.cpp PerformanceOverlay/ProcessTable.cpp \
+ *		PerformanceOverlay/ProcessTableLinux.cpp PerformanceOverlay/StringInterner.cpp PerformanceOverlay/TscClock.cpp \
+ *		-o cpu-sampling-bench
+ *	./cpu-sampling-bench [directory]
+ *
+ * A fixture is a directory holding a stat file laid out like /proc/stat, with the aggregate
+ * cpu line followed by one cpuN line per core, and a minimal meminfo, built under the given
+ * directory (/tmp by default) and removed afterwards. Before every sample the stat file is
+ * rewritten in place with each core's counters advanced by a known busy share, so that every
+ * UpdateSource(SourceCpu) parses a fresh file, differences it and runs CpuCoreBank::Compute()
+ * exactly as it would on a live machine; the rewrite is not timed. The per-core loads are
+ * checked against the shares that were written. The "compute" column times
+ * CpuCoreBank::Compute() alone, the part the core count scales the most; in that run the
+ * last core stops being written after two samples, as an offline CPU's line disappears,
+ * and must read as idle from then on. A last sample advances one core's total past
+ * INT32_MAX units, which must only re-baseline the bank and leave every load as it was.
+ */
+
+#ifdef __linux__
+
+#include "CpuCoreBank.h"
+#include "MetricRegistry.h"
+#include "PerformanceMonitor.h"
+#include "TscClock.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+/**
+ * @brief The number of timed samples the median is taken over.
+ */
+static constexpr int kSamples = 101;
+
+/**
+ * @brief The ticks every core's total advances by between two samples (one second at USER_HZ).
+ */
+static constexpr uint64_t kTicksPerSample = 100;
+
+/**
+ * @brief Writes the stat file of a fixture with every core's counters at a given sample.
+ * @param[in] path The stat file's path.
+ * @param[in] coreCount The number of cores.
+ * @param[in] sample The sample index; the counters advance by kTicksPerSample per sample.
+ * @return true if the file was written, false otherwise.
+ */
+static bool WriteStat(
+	_In_ const std::filesystem::path& path,
+	_In_ uint32_t                     coreCount,
+	_In_ uint64_t                     sample);
+
+/**
+ * @brief Gets the busy share a synthetic core runs at.
+ * @param[in] core The core's index.
+ * @return The busy ticks out of every kTicksPerSample.
+ */
+static uint64_t GetBusyTicks(
+	_In_ uint32_t core);
+
+/**
+ * @brief Writes a file.
+ * @param[in] path The file's path.
+ * @param[in] contents The file's contents.
+ * @return true if the file was written, false otherwise.
+ */
+static bool WriteFile(
+	_In_ const std::filesystem::path& path,
+	_In_ const std::string&           contents);
+
+/**
+ * @brief Gets the median of a set of durations.
+ * @param[in,out] durations The durations, reordered.
+ * @return The median.
+ */
+static int64_t GetMedian(
+	_Inout_ std::vector<int64_t>& durations);
+
+
+int main(
+	_In_ const int          argc,
+	_In_reads_(argc) char** argv)
+{
+	TscClock::Calibrate();
+
+	const std::filesystem::path base   = argc > 1 ? argv[1] : "/tmp";
+	int                         result = 0;
+
+	std::printf("%-6s %10s %10s %10s %10s\n", "cores", "sample", "per core", "compute", "per core");
+
+	for (const uint32_t coreCount : {8u, 64u, 512u})
+	{
+		const std::filesystem::path root = base / ("cpu-sampling-bench-" + std::to_string(coreCount));
+		std::filesystem::remove_all(root);
+		std::filesystem::create_directories(root);
+
+		uint64_t sample = 0;
+		if (!WriteStat(root / "stat", coreCount, sample++) ||
+			!WriteFile(root / "meminfo", "MemTotal:       16384000 kB\nMemAvailable:    8192000 kB\n"))
+		{
+			std::fprintf(stderr, "cannot write %s\n", root.c_str());
+			return 1;
+		}
+
+		MetricRegistry     registry;
+		PerformanceMonitor monitor(root.c_str(), root.c_str());
+		if (!monitor.Initialize(registry) || monitor.GetCoreCount() != coreCount)
+		{
+			std::fprintf(stderr, "cannot initialize the monitor over %s\n", root.c_str());
+			return 1;
+		}
+
+		std::vector<int64_t> durations;
+		for (int i = 0; i < kSamples; i++)
+		{
+			(void)WriteStat(root / "stat", coreCount, sample++);
+			const int64_t start = TscClock::NowNs();
+			monitor.UpdateSource(PerformanceMonitor::SourceCpu);
+			durations.push_back(TscClock::NowNs() - start);
+		}
+		const int64_t sampleNs = GetMedian(durations);
+
+		const float* const loads = monitor.GetCoreLoads();
+		for (uint32_t core = 0; core < coreCount; core++)
+		{
+			const float expected = static_cast<float>(GetBusyTicks(core)) * 100.0f / kTicksPerSample;
+			if (std::fabs(loads[core] - expected) > 0.01f)
+			{
+				std::fprintf(stderr, "core %u reads %.2f%%, expected %.2f%%\n", core, loads[core], expected);
+				result = 1;
+				break;
+			}
+		}
+
+		// Compute() alone, with the counters advanced the same way the parser would and the
+		// last core going offline after two samples.
+		const uint32_t offline = coreCount - 1;
+		CpuCoreBank    bank;
+		bank.Resize(coreCount);
+		durations.clear();
+		for (int i = 0; i <= kSamples; i++)
+		{
+			for (uint32_t core = 0; core < (i < 2 ? coreCount : offline); core++)
+			{
+				bank.BusyCounters()[core]  = GetBusyTicks(core) * i;
+				bank.TotalCounters()[core] = kTicksPerSample * i;
+			}
+			const int64_t start = TscClock::NowNs();
+			bank.Compute();
+			durations.push_back(TscClock::NowNs() - start);
+
+			if (i >= 2 && bank.GetLoads()[offline] != 0.0f)
+			{
+				std::fprintf(stderr, "offline core %u reads %.2f%% after sample %d\n", offline, bank.GetLoads()[offline], i);
+				result = 1;
+				break;
+			}
+		}
+		const int64_t computeNs = GetMedian(durations);
+
+		// One core's total jumps past INT32_MAX while core 0's advances as usual.
+		const uint32_t    jumped = offline / 2;
+		const std::vector before(bank.GetLoads(), bank.GetLoads() + coreCount);
+		for (uint32_t core = 0; core < offline; core++)
+		{
+			bank.BusyCounters()[core]  += core == jumped ? 1ULL << 31 : 0;
+			bank.TotalCounters()[core] += core == jumped ? 1ULL << 32 : kTicksPerSample;
+		}
+		bank.Compute();
+		if (!std::equal(before.begin(), before.end(), bank.GetLoads()))
+		{
+			std::fprintf(stderr, "a gap past INT32_MAX on core %u changed the loads\n", jumped);
+			result = 1;
+		}
+
+		std::printf("%-6u %7.2f us %7.1f ns %7.2f us %7.2f ns\n", coreCount, sampleNs / 1e3,
+		            static_cast<double>(sampleNs) / coreCount, computeNs / 1e3,
+		            static_cast<double>(computeNs) / coreCount);
+
+		std::filesystem::remove_all(root);
+	}
+	return result;
+}
+
+
+_Use_decl_annotations_
+bool WriteStat(
+	const std::filesystem::path& path,
+	const uint32_t               coreCount,
+	const uint64_t               sample)
+{
+	// Busy time is split across user and system, idle time across idle and iowait.
+	std::string contents;
+	char        line[256];
+	uint64_t    allBusy = 0;
+	for (uint32_t core = 0; core < coreCount; core++)
+	{
+		allBusy += GetBusyTicks(core);
+	}
+	const uint64_t allIdle = coreCount * kTicksPerSample - allBusy;
+	std::snprintf(line, sizeof(line), "cpu  %llu 0 %llu %llu %llu 0 0 0 0 0\n",
+	              static_cast<unsigned long long>(allBusy * sample / 2),
+	              static_cast<unsigned long long>(allBusy * sample - allBusy * sample / 2),
+	              static_cast<unsigned long long>(allIdle * sample - allIdle * sample / 4),
+	              static_cast<unsigned long long>(allIdle * sample / 4));
+	contents += line;
+
+	for (uint32_t core = 0; core < coreCount; core++)
+	{
+		const uint64_t busy = GetBusyTicks(core) * sample;
+		const uint64_t idle = (kTicksPerSample - GetBusyTicks(core)) * sample;
+		std::snprintf(line, sizeof(line), "cpu%u %llu 0 %llu %llu %llu 0 0 0 0 0\n", core,
+		              static_cast<unsigned long long>(busy / 2), static_cast<unsigned long long>(busy - busy / 2),
+		              static_cast<unsigned long long>(idle - idle / 4), static_cast<unsigned long long>(idle / 4));
+		contents += line;
+	}
+
+	contents += "intr 0\nctxt 0\nbtime 0\nprocesses 0\nprocs_running 1\nprocs_blocked 0\n";
+	return WriteFile(path, contents);
+}
+
+_Use_decl_annotations_
+uint64_t GetBusyTicks(
+	const uint32_t core)
+{
+	return core * 37 % (kTicksPerSample + 1);
+}
+
+_Use_decl_annotations_
+bool WriteFile(
+	const std::filesystem::path& path,
+	const std::string&           contents)
+{
+	// Truncated in place, so that the monitor's open descriptor reads the new contents.
+	FILE* const file = std::fopen(path.c_str(), "w");
+	if (file == nullptr)
+	{
+		return false;
+	}
+	const bool ok = std::fwrite(contents.data(), 1, contents.size(), file) == contents.size();
+	return std::fclose(file) == 0 && ok;
+}
+
+_Use_decl_annotations_
+int64_t GetMedian(
+	std::vector<int64_t>& durations)
+{
+	std::nth_element(durations.begin(), durations.begin() + durations.size() / 2, durations.end());
+	return durations[durations.size() / 2];
+}
+
+#endif // __linux__
@@ -0,0 +1,190 @@
+/**
+ * @file DecimationBenchmark.cpp
+ * @brief Compares ImGui::PlotLines over the raw samples against DecimateMinMax() followed by
+ *		  DrawSparkline() at 1k, 100k and 10M samples.
+ * @author Alessandro Bellia
+ * @date 10/16/2026
+ *
+ * Build and run from the repository root:
+ *
+ *	g++ -O2 -std=c++20 -IPerformanceOverlay -Ilibs/imgui benchmarks/DecimationBenchmark.cpp \
+ *		PerformanceOverlay/PlotDecimation.cpp PerformanceOverlay/Sparkline.cpp PerformanceOverlay/TscClock.cpp \
+ *		PerformanceOverlay/ProcFile.cpp libs/imgui/imgui.cpp libs/imgui/imgui_draw.cpp libs/imgui/imgui_tables.cpp \
+ *		libs/imgui/imgui_widgets.cpp -o decimation-bench
+ *	./decimation-bench
+ *
+ * ImGui runs headless: each frame is built and rendered to draw lists, which are not
+ * presented. The series is noise between 20 and 30 with a single sample at 100, drawn into
+ * a graph kGraphWidth pixels wide: once by handing every sample to ImGui::PlotLines, and
+ * once as the overlay does, through a one-column-per-pixel envelope drawn as a sparkline
+ * with the same frame as PlotEnvelope() in Gui.cpp. The times are the median frame's cost
+ * of the graph, including the decimation, and the vertices are those it added to the draw
+ * list. A graph shows the spike if a vertex of its line lies in the top half of the plot.
+ * PlotLines reads one value per pixel, so its cost stays flat but it shows the spike only
+ * when the spike happens to be the value picked for its pixel; the envelope reads every
+ * sample in the span, and must keep the spike at every size, or the program exits with 1.
+ */
+
+#include "PlotDecimation.h"
+#include "Sparkline.h"
+#include "TscClock.h"
+#include "imgui.h"
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+/**
+ * @brief The width of the graph, in pixels.
+ */
+static constexpr float kGraphWidth = 400.0f;
+
+/**
+ * @brief The height of the graph, in pixels.
+ */
+static constexpr float kGraphHeight = 50.0f;
+
+/**
+ * @brief The number of frames the median is taken over.
+ */
+static constexpr int kFrames = 11;
+
+/**
+ * @struct GraphCost
+ * @brief The median cost of one way of drawing the graph.
+ */
+struct GraphCost
+{
+	int64_t medianNs; ///< Median time of the graph's calls.
+	int     vertices; ///< Vertices the graph added to the draw list.
+	bool    spike;    ///< Whether a vertex of the line lies in the top half of the plot.
+};
+
+/**
+ * @brief Renders kFrames frames with one graph in a window of its own.
+ * @param[in] draw Draws the graph at the cursor.
+ * @return The median cost.
+ */
+template <typename Draw>
+static GraphCost MeasureGraph(
+	_In_ Draw draw);
+
+
+int main()
+{
+	TscClock::Calibrate();
+
+	ImGui::CreateContext();
+	ImGuiIO& io    = ImGui::GetIO();
+	io.DisplaySize = ImVec2(1920.0f, 1080.0f);
+	io.IniFilename = nullptr;
+	io.BackendFlags |= ImGuiBackendFlags_RendererHasTextures;
+
+	std::printf("%-10s %12s %9s %6s %12s %9s %6s\n",
+	            "samples", "PlotLines", "vertices", "spike", "envelope", "vertices", "spike");
+
+	int result = 0;
+	for (const uint32_t count : {1'000u, 100'000u, 10'000'000u})
+	{
+		// One sample per millisecond; the spike sits away from the ends and from any column edge.
+		std::mt19937                          random(42);
+		std::uniform_real_distribution<float> noise(20.0f, 30.0f);
+		std::vector<int64_t>                  timestamps(count);
+		std::vector<float>                    values(count);
+		for (uint32_t i = 0; i < count; i++)
+		{
+			timestamps[i] = static_cast<int64_t>(i) * 1'000'000;
+			values[i]     = noise(random);
+		}
+		values[count / 3 + 1] = 100.0f;
+
+		const GraphCost raw = MeasureGraph([&values, count]
+		{
+			ImGui::PlotLines("##raw", values.data(), static_cast<int>(count), 0, nullptr, 0.0f, 100.0f, ImVec2(kGraphWidth, kGraphHeight));
+		});
+
+		HistoryView view;
+		view.timestamps[0] = timestamps.data();
+		view.values[0]     = values.data();
+		view.sizes[0]      = count;
+
+		const GraphCost envelope = MeasureGraph([&view, &timestamps]
+		{
+			const ImGuiStyle& style    = ImGui::GetStyle();
+			const ImVec2      pos      = ImGui::GetCursorScreenPos();
+			const ImVec2      size(kGraphWidth, kGraphHeight);
+			ImDrawList*       drawList = ImGui::GetWindowDrawList();
+			float             points[2 * static_cast<uint32_t>(kGraphWidth)];
+
+			const uint32_t pointCount = DecimateMinMax(view, timestamps.front(), timestamps.back(), static_cast<uint32_t>(kGraphWidth), points);
+			drawList->AddRectFilled(pos, ImVec2(pos.x + size.x, pos.y + size.y), ImGui::GetColorU32(ImGuiCol_FrameBg), style.FrameRounding);
+			DrawSparkline(
+				drawList,
+				ImVec2(pos.x + style.FramePadding.x, pos.y + style.FramePadding.y),
+				ImVec2(size.x - 2.0f * style.FramePadding.x, size.y - 2.0f * style.FramePadding.y),
+				points,
+				pointCount,
+				0.0f,
+				100.0f,
+				ImGui::GetColorU32(ImGuiCol_PlotLines),
+				ImGui::GetColorU32(ImGuiCol_PlotLines, 0.15f),
+				1.0f);
+			ImGui::Dummy(size);
+		});
+
+		std::printf("%-10u %9.1f us %9d %6s %9.1f us %9d %6s\n", count,
+		            raw.medianNs / 1e3, raw.vertices, raw.spike ? "yes" : "no",
+		            envelope.medianNs / 1e3, envelope.vertices, envelope.spike ? "yes" : "no");
+		if (!envelope.spike)
+		{
+			std::fprintf(stderr, "the envelope of %u samples lost the spike\n", count);
+			result = 1;
+		}
+	}
+
+	ImGui::DestroyContext();
+	std::printf(result == 0 ? "ok\n" : "FAILED\n");
+	return result;
+}
+
+
+template <typename Draw>
+_Use_decl_annotations_
+GraphCost MeasureGraph(
+	Draw draw)
+{
+	GraphCost            cost = {};
+	std::vector<int64_t> durations;
+	for (int frame = 0; frame < kFrames; frame++)
+	{
+		ImGui::NewFrame();
+		ImGui::SetNextWindowPos(ImVec2(0.0f, 0.0f));
+		ImGui::SetNextWindowSize(ImVec2(kGraphWidth + 100.0f, 200.0f));
+		ImGui::Begin("Graph", nullptr, ImGuiWindowFlags_NoDecoration);
+
+		ImDrawList* const drawList = ImGui::GetWindowDrawList();
+		const int         vertices = drawList->VtxBuffer.Size;
+		const float       top      = ImGui::GetCursorScreenPos().y;
+		const ImU32       line     = ImGui::GetColorU32(ImGuiCol_PlotLines);
+		const int64_t     start    = TscClock::NowNs();
+
+		draw();
+
+		durations.push_back(TscClock::NowNs() - start);
+		cost.vertices = drawList->VtxBuffer.Size - vertices;
+		cost.spike    = false;
+		for (int i = vertices; i < drawList->VtxBuffer.Size; i++)
+		{
+			// Only the line's own vertices; the frame and the fill reach the top edge regardless.
+			const ImDrawVert& vertex = drawList->VtxBuffer[i];
+			cost.spike               = cost.spike || (vertex.col == line && vertex.pos.y < top + kGraphHeight * 0.5f);
+		}
+
+		ImGui::End();
+		ImGui::Render();
+	}
+
+	std::nth_element(durations.begin(), durations.begin() + kFrames / 2, durations.end());
+	cost.medianNs = durations[kFrames / 2];
+	return cost;
+}
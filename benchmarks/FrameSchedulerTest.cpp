@@ -0,0 +1,172 @@
+/**
+ * @file FrameSchedulerTest.cpp
+ * @brief Checks the FrameScheduler's decisions and counters against a fake clock.
+ * @author Alessandro Bellia
+ * @date 10/16/2026
+ *
+ * Build and run from the repository root:
+ *
+ *	g++ -O2 -std=c++20 -IPerformanceOverlay benchmarks/FrameSchedulerTest.cpp \
+ *		PerformanceOverlay/FrameScheduler.cpp -o scheduler-test
+ *	./scheduler-test
+ *
+ * The scheduler takes time as a parameter, so every case drives it with explicit
+ * timestamps on a 10 ms refresh interval: a published snapshot and input are drawn at once,
+ * input owes kFramesAfterInput frames in total, the later ones paced at the refresh
+ * interval, an animation renders one frame per interval until it ends, and an idle overlay
+ * renders nothing however long it waits. The last case checks the frames-skipped and
+ * CPU-saved counters against the intervals an always-rendering loop would have drawn.
+ * Every failed check is printed, and the program exits with 1 if any failed.
+ */
+
+#include "FrameScheduler.h"
+#include <cstdio>
+
+using namespace std::chrono_literals;
+
+/**
+ * @brief The refresh interval every case runs at.
+ */
+static constexpr std::chrono::nanoseconds kRefresh = 10ms;
+
+/**
+ * @brief Records the outcome of one check.
+ * @param[in] condition The checked condition.
+ * @param[in] what The description printed if the condition does not hold.
+ * @param[in,out] failures The number of failed checks, incremented on failure.
+ */
+static void Expect(
+	_In_ bool          condition,
+	_In_z_ const char* what,
+	_Inout_ int&       failures);
+
+/**
+ * @brief Renders every frame the scheduler asks for while a fake clock steps 1 ms at a time.
+ * @param[in,out] scheduler The scheduler.
+ * @param[in] from The first time, inclusive.
+ * @param[in] to The last time, exclusive.
+ * @return The number of frames rendered.
+ */
+static uint32_t RunUntil(
+	_Inout_ FrameScheduler&       scheduler,
+	_In_ std::chrono::nanoseconds from,
+	_In_ std::chrono::nanoseconds to);
+
+
+int main()
+{
+	int failures = 0;
+
+	// The first frame is always drawn; nothing else happens until something changes.
+	{
+		FrameScheduler scheduler(kRefresh, 0ms);
+		Expect(scheduler.ShouldRender(0ms), "the first call renders", failures);
+		Expect(!scheduler.ShouldRender(1ms), "nothing pending after the first frame", failures);
+		Expect(scheduler.TimeUntilNextFrame(1ms) == FrameScheduler::kNever, "an idle scheduler schedules no frame", failures);
+	}
+
+	// A new snapshot is drawn at once, exactly once.
+	{
+		FrameScheduler scheduler(kRefresh, 0ms);
+		(void)scheduler.ShouldRender(0ms);
+		scheduler.NotifyData();
+		Expect(scheduler.TimeUntilNextFrame(3ms) == 0ns, "a snapshot makes a frame due", failures);
+		Expect(scheduler.ShouldRender(3ms), "a snapshot renders without waiting for the interval", failures);
+		Expect(!scheduler.ShouldRender(4ms), "a snapshot renders once", failures);
+		Expect(RunUntil(scheduler, 4ms, 1000ms) == 0, "no frame after the snapshot's", failures);
+	}
+
+	// Input is drawn at once, then followed by paced frames until kFramesAfterInput were drawn.
+	{
+		FrameScheduler scheduler(kRefresh, 0ms);
+		(void)scheduler.ShouldRender(0ms);
+		scheduler.NotifyInput();
+		Expect(scheduler.ShouldRender(50ms), "input renders without waiting for the interval", failures);
+		Expect(scheduler.TimeUntilNextFrame(54ms) == 6ms, "the follow-up frame waits for the interval", failures);
+		Expect(!scheduler.ShouldRender(54ms), "the follow-up frame is not drawn early", failures);
+		Expect(RunUntil(scheduler, 55ms, 1000ms) == FrameScheduler::kFramesAfterInput - 1,
+		       "input owes kFramesAfterInput frames in total", failures);
+		Expect(scheduler.TimeUntilNextFrame(1000ms) == FrameScheduler::kNever, "no frame once input settled", failures);
+	}
+
+	// An animation renders one frame per interval until it ends, and nothing after.
+	{
+		FrameScheduler scheduler(kRefresh, 0ms);
+		(void)scheduler.ShouldRender(0ms);
+		scheduler.RequestAnimation(200ms);
+		scheduler.RequestAnimation(150ms); // An earlier end does not cut the animation short
+		Expect(RunUntil(scheduler, 100ms, 200ms) == 10, "an animation renders once per interval", failures);
+		Expect(RunUntil(scheduler, 200ms, 1000ms) == 0, "no frame once the animation ended", failures);
+	}
+
+	// An idle overlay skips every interval, and new data still wakes it.
+	{
+		FrameScheduler scheduler(kRefresh, 0ms);
+		(void)scheduler.ShouldRender(0ms);
+		Expect(RunUntil(scheduler, 1ms, 10'000ms) == 0, "an idle overlay renders nothing", failures);
+		scheduler.NotifyData();
+		Expect(scheduler.ShouldRender(10'000ms), "data wakes an idle overlay", failures);
+	}
+
+	// Counters: one second of 100 intervals with a snapshot every 250 ms, each frame 2 ms of CPU.
+	{
+		FrameScheduler scheduler(kRefresh, 0ms);
+		uint32_t       rendered = 0;
+		for (auto now = 0ms; now < 1000ms; now += 1ms)
+		{
+			if (now.count() % 250 == 0)
+			{
+				scheduler.NotifyData();
+			}
+			if (scheduler.ShouldRender(now))
+			{
+				scheduler.OnFrameRendered(2ms);
+				rendered++;
+			}
+		}
+
+		const FrameScheduler::Stats stats = scheduler.GetStats(1000ms);
+		std::printf("rendered %llu, skipped %llu, frame CPU %lld us, CPU saved %lld us\n",
+		            static_cast<unsigned long long>(stats.framesRendered), static_cast<unsigned long long>(stats.framesSkipped),
+		            static_cast<long long>(stats.frameCpuNs / 1000), static_cast<long long>(stats.cpuSavedNs / 1000));
+		Expect(rendered == 4 && stats.framesRendered == 4, "one frame per snapshot", failures);
+		Expect(stats.framesSkipped == 96, "the other 96 intervals are skipped", failures);
+		Expect(stats.frameCpuNs == 8'000'000, "the rendered frames' CPU time is summed", failures);
+		Expect(stats.cpuSavedNs == 96 * 2'000'000, "each skipped interval saves the mean frame cost", failures);
+	}
+
+	std::printf(failures == 0 ? "ok\n" : "FAILED\n");
+	return failures == 0 ? 0 : 1;
+}
+
+
+_Use_decl_annotations_
+void Expect(
+	const bool  condition,
+	const char* what,
+	int&        failures)
+{
+	if (!condition)
+	{
+		std::fprintf(stderr, "failed: %s\n", what);
+		failures++;
+	}
+}
+
+_Use_decl_annotations_
+uint32_t RunUntil(
+	FrameScheduler&                scheduler,
+	const std::chrono::nanoseconds from,
+	const std::chrono::nanoseconds to)
+{
+	uint32_t frames = 0;
+	for (auto now = from; now < to; now += 1ms)
+	{
+		if (scheduler.ShouldRender(now))
+		{
+			scheduler.OnFrameRendered(1ms);
+			frames++;
+		}
+	}
+	return frames;
+}
@@ -0,0 +1,117 @@
+/**
+ * @file PluginBudgetTest.cpp
+ * @brief Checks what the PluginHost's latency budget does, and does not do, to a plugin
+ *		  that blocks in Sample().
+ * @author Alessandro Bellia
+ * @date 10/16/2026
+ *
+ * Build and run from the repository root:
+ *
+ *	mkdir -p /tmp/slow-plugin
+ *	cc -shared -fPIC -O2 -IPerformanceOverlay benchmarks/SlowPlugin.c -o /tmp/slow-plugin/SlowPlugin.so
+ *	g++ -O2 -std=c++20 -IPerformanceOverlay benchmarks/PluginBudgetTest.cpp \
+ *		PerformanceOverlay/PluginHost.cpp PerformanceOverlay/MetricRegistry.cpp PerformanceOverlay/AdaptiveRate.cpp \
+ *		PerformanceOverlay/TscClock.cpp PerformanceOverlay/ProcFile.cpp -ldl -o plugin-budget-test
+ *	./plugin-budget-test /tmp/slow-plugin
+ *
+ * Sample() runs inline on the sampler thread, and the budget is only checked once the call
+ * has returned. The test loads SlowPlugin with every call blocking for 20 times the budget
+ * and pins that down: each over-budget call takes as long as the plugin blocks, not the
+ * budget; the first kMaxOverruns - 1 of them keep the plugin enabled; the next disables it
+ * and zeroes its value; and from then on Sample() returns at once without calling it. Every
+ * failed check is printed, and the program exits with 1 if any failed.
+ */
+
+#ifdef __linux__
+
+#include "MetricRegistry.h"
+#include "PluginHost.h"
+#include "TscClock.h"
+#include <cstdio>
+#include <cstdlib>
+
+/**
+ * @brief The budget the host is given.
+ */
+static constexpr std::chrono::milliseconds kBudget{1};
+
+/**
+ * @brief How long every Sample() of the plugin blocks.
+ */
+static constexpr std::chrono::milliseconds kBlock{20};
+
+/**
+ * @brief Records the outcome of one check.
+ * @param[in] condition The checked condition.
+ * @param[in] what The description printed if the condition does not hold.
+ * @param[in,out] failures The number of failed checks, incremented on failure.
+ */
+static void Expect(
+	_In_ bool          condition,
+	_In_z_ const char* what,
+	_Inout_ int&       failures);
+
+
+int main(
+	_In_ const int          argc,
+	_In_reads_(argc) char** argv)
+{
+	TscClock::Calibrate();
+
+	const char* const directory = argc > 1 ? argv[1] : "/tmp/slow-plugin";
+	char              blockMs[16];
+	(void)std::snprintf(blockMs, sizeof(blockMs), "%lld", static_cast<long long>(kBlock.count()));
+	(void)setenv("PERFOVERLAY_SLOW_PLUGIN_MS", blockMs, 1);
+
+	MetricRegistry registry;
+	PluginHost     host;
+	host.SetBudget(kBudget);
+	if (host.LoadDirectory(directory, registry) != 1)
+	{
+		std::fprintf(stderr, "cannot load SlowPlugin.so from %s\n", directory);
+		return 1;
+	}
+
+	const int64_t blockNs  = std::chrono::nanoseconds(kBlock).count();
+	const float*  value    = registry.GetValues() + host.GetFirstMetric(0);
+	int           failures = 0;
+	for (uint32_t call = 1; call <= PluginHost::kMaxOverruns; call++)
+	{
+		const int64_t start   = TscClock::NowNs();
+		const bool    enabled = host.Sample(0);
+		const int64_t elapsed = TscClock::NowNs() - start;
+
+		std::printf("call %u: %.1f ms, %s\n", call, elapsed / 1e6, enabled ? "enabled" : "disabled");
+		Expect(elapsed >= blockNs, "an over-budget call runs to the end, however long the plugin blocks", failures);
+		Expect(enabled == (call < PluginHost::kMaxOverruns), "only the kMaxOverruns-th call in a row disables the plugin", failures);
+		Expect(*value == (enabled ? static_cast<float>(call) : 0.0f), "the values are the plugin's until it is disabled, then zero", failures);
+	}
+	Expect(host.GetMaxSampleNs(0) >= blockNs, "the longest call is recorded in full", failures);
+
+	const int64_t start   = TscClock::NowNs();
+	const bool    enabled = host.Sample(0);
+	const int64_t elapsed = TscClock::NowNs() - start;
+	std::printf("call %u: %.3f ms, %s\n", PluginHost::kMaxOverruns + 1, elapsed / 1e6, enabled ? "enabled" : "disabled");
+	Expect(!enabled && !host.IsEnabled(0), "a disabled plugin stays disabled", failures);
+	Expect(elapsed < std::chrono::nanoseconds(kBudget).count(), "a disabled plugin is no longer called", failures);
+
+	host.UnloadAll();
+	std::printf(failures == 0 ? "ok\n" : "FAILED\n");
+	return failures == 0 ? 0 : 1;
+}
+
+
+_Use_decl_annotations_
+void Expect(
+	const bool  condition,
+	const char* what,
+	int&        failures)
+{
+	if (!condition)
+	{
+		std::fprintf(stderr, "failed: %s\n", what);
+		failures++;
+	}
+}
+
+#endif // __linux__
@@ -0,0 +1,112 @@
+/**
+ * @file ProcFixture.h
+ * @brief Contains the writers of the synthetic /proc/[pid] files the process benchmarks
+ *		  scan instead of the real /proc.
+ * @author Alessandro Bellia
+ * @date 10/16/2026
+ *
+ * Header-only, so that a benchmark is still built from its single .cpp plus the overlay
+ * sources it measures.
+ */
+
+#pragma once
+
+#ifdef __linux__
+
+#include "Platform.h"
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <string>
+
+/**
+ * @brief Writes a whole file, replacing any previous contents.
+ * @param[in] path The file's path.
+ * @param[in] data The contents.
+ * @param[in] length The length of the contents, in bytes.
+ * @return true if the file was written, false otherwise.
+ */
+inline bool WriteFixtureFile(
+	_In_ const std::filesystem::path& path,
+	_In_reads_(length) const char*    data,
+	_In_ size_t                       length)
+{
+	FILE* const file = std::fopen(path.c_str(), "w");
+	if (file == nullptr)
+	{
+		return false;
+	}
+	const bool ok = std::fwrite(data, 1, length, file) == length;
+	return std::fclose(file) == 0 && ok;
+}
+
+/**
+ * @brief Writes the stat file of one synthetic process, laid out like a current kernel's.
+ * @param[in] directory The process's directory.
+ * @param[in] pid The process id.
+ * @param[in] name The name shown between the parentheses.
+ * @param[in] startTime The start time, in ticks since boot.
+ * @param[in,out] random The generator for the CPU times and resident memory.
+ * @return true if the file was written, false otherwise.
+ */
+inline bool WriteFixtureStat(
+	_In_ const std::filesystem::path& directory,
+	_In_ uint32_t                     pid,
+	_In_z_ const char*                name,
+	_In_ uint64_t                     startTime,
+	_Inout_ std::mt19937_64&          random)
+{
+	// 52 fields; utime is field 14, stime 15, starttime 22 and rss 24.
+	const auto utime = static_cast<unsigned long long>(random() % 100'000);
+	const auto stime = static_cast<unsigned long long>(random() % 10'000);
+	const auto rss   = static_cast<unsigned long long>(random() % 250'000);
+
+	char      line[512];
+	const int length = std::snprintf(
+		line, sizeof(line),
+		"%u (%s) S 1 %u %u 0 -1 4194560 1520 0 3 0 %llu %llu 0 0 20 0 4 0 %llu 26738688 %llu "
+		"18446744073709551615 1 1 0 0 0 0 0 0 0 0 0 0 17 0 0 0 0 0 0 0 0 0 0 0 0 0 0\n",
+		pid, name, pid, pid, utime, stime, static_cast<unsigned long long>(startTime), rss);
+	return length > 0 && WriteFixtureFile(directory / "stat", line, static_cast<size_t>(length));
+}
+
+/**
+ * @brief Writes the stat, io and schedstat files of one synthetic worker process.
+ * @param[in] root The tree's root.
+ * @param[in] pid The process id.
+ * @param[in] startTime The start time, in ticks since boot.
+ * @param[in,out] random The generator for the CPU times, resident memory, I/O counters and waits.
+ * @return true if every file was written, false otherwise.
+ */
+inline bool WriteFixtureProcess(
+	_In_ const std::filesystem::path& root,
+	_In_ uint32_t                     pid,
+	_In_ uint64_t                     startTime,
+	_Inout_ std::mt19937_64&          random)
+{
+	const std::filesystem::path directory = root / std::to_string(pid);
+	std::filesystem::create_directories(directory);
+
+	// A few hundred names repeat across the tree, as worker pools do.
+	char name[32];
+	(void)std::snprintf(name, sizeof(name), "worker-%u", pid % 997);
+	bool ok = WriteFixtureStat(directory, pid, name, startTime, random);
+
+	char      line[512];
+	const int ioLength = std::snprintf(
+		line, sizeof(line),
+		"rchar: %llu\nwchar: %llu\nsyscr: %llu\nsyscw: %llu\nread_bytes: %llu\nwrite_bytes: %llu\ncancelled_write_bytes: 0\n",
+		static_cast<unsigned long long>(random() % 100'000'000), static_cast<unsigned long long>(random() % 100'000'000),
+		static_cast<unsigned long long>(random() % 100'000), static_cast<unsigned long long>(random() % 100'000),
+		static_cast<unsigned long long>(random() % 10'000'000), static_cast<unsigned long long>(random() % 10'000'000));
+	ok = WriteFixtureFile(directory / "io", line, static_cast<size_t>(ioLength)) && ok;
+
+	const int schedstatLength = std::snprintf(
+		line, sizeof(line), "%llu %llu %llu\n",
+		static_cast<unsigned long long>(random() % 100'000'000'000), static_cast<unsigned long long>(random() % 1'000'000'000),
+		static_cast<unsigned long long>(random() % 100'000));
+	return WriteFixtureFile(directory / "schedstat", line, static_cast<size_t>(schedstatLength)) && ok;
+}
+
+#endif // __linux__
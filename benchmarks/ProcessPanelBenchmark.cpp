@@ -0,0 +1,292 @@
+/**
+ * @file ProcessPanelBenchmark.cpp
+ * @brief Measures the frame time of the ProcessPanel table at 100, 1k, 10k and 100k rows,
+ *		  against a table that submits and re-sorts every row.
+ * @author Alessandro Bellia
+ * @date 10/16/2026
+ *
+ * Build and run from the repository root:
+ *
+ *	g++ -O2 -std=c++20 -IPerformanceOverlay -Ilibs/imgui benchmarks/ProcessPanelBenchmark.cpp \
+ *		PerformanceOverlay/ProcessPanel.cpp PerformanceOverlay/TscClock.cpp PerformanceOverlay/ProcFile.cpp \
+ *		libs/imgui/imgui.cpp libs/imgui/imgui_draw.cpp libs/imgui/imgui_tables.cpp libs/imgui/imgui_widgets.cpp -o panel-bench
+ *	./panel-bench
+ *
+ * ImGui runs headless: each frame is built and rendered to draw lists, which are not
+ * presented. Every kFramesPerScan frames a new list is published, as the sampler does once
+ * a second, with 1% of the processes' CPU usage changed, a few exits and as many new
+ * processes. The times are the median frame and the median frame that received a new
+ * list; the naive table re-sorts every new list from scratch and submits every row.
+ */
+
+#include "ProcessPanel.h"
+#include "TscClock.h"
+#include "imgui.h"
+#include <algorithm>
+#include <cstdio>
+#include <numeric>
+#include <random>
+#include <vector>
+
+/**
+ * @brief The number of frames measured per row count.
+ */
+static constexpr int kFrames = 240;
+
+/**
+ * @brief The number of frames between two published lists: one second at 60 FPS.
+ */
+static constexpr int kFramesPerScan = 60;
+
+/**
+ * @struct FrameTimes
+ * @brief The median frame times of one table.
+ */
+struct FrameTimes
+{
+	int64_t medianNs; ///< Over every frame.
+	int64_t scanNs;   ///< Over the frames that received a new list.
+};
+
+/**
+ * @brief Fills a synthetic process list.
+ * @param[out] processes Receives the list.
+ * @param[in] count The number of processes.
+ * @param[in] random The generator for the CPU usage, resident memory, I/O rates and waits.
+ */
+static void MakeProcesses(
+	_Out_ std::vector<ProcessSample>& processes,
+	_In_ uint32_t                     count,
+	_Inout_ std::mt19937&             random);
+
+/**
+ * @brief Changes the list as a rescan would: 1% of the CPU values move, 0.1% of the
+ *		  processes exit and as many start, reusing their rows like the process table.
+ * @param[in,out] processes The list.
+ * @param[in,out] nextPid The pid the next new process gets.
+ * @param[in] random The generator.
+ */
+static void Rescan(
+	_Inout_ std::vector<ProcessSample>& processes,
+	_Inout_ uint32_t&                   nextPid,
+	_Inout_ std::mt19937&               random);
+
+/**
+ * @brief Runs kFrames frames of one table.
+ * @param[in] count The number of processes.
+ * @param[in] draw Draws the table for a list and its sequence.
+ * @return The median frame times.
+ */
+template <typename Draw>
+static FrameTimes RunFrames(
+	_In_ uint32_t count,
+	_In_ Draw     draw);
+
+/**
+ * @brief Draws every row of the list, fully re-sorted by CPU whenever the list changes.
+ * @param[in] processes The list.
+ * @param[in] sequence The list's sequence.
+ * @param[in,out] order The row order.
+ * @param[in,out] orderSequence The sequence the order was sorted for.
+ */
+static void DrawNaive(
+	_In_ const std::vector<ProcessSample>& processes,
+	_In_ uint64_t                          sequence,
+	_Inout_ std::vector<uint32_t>&         order,
+	_Inout_ uint64_t&                      orderSequence);
+
+/**
+ * @brief Gets the median of a set of durations.
+ * @param[in,out] durations The durations, reordered.
+ * @return The median.
+ */
+static int64_t Median(
+	_Inout_ std::vector<int64_t>& durations);
+
+
+int main()
+{
+	TscClock::Calibrate();
+
+	ImGui::CreateContext();
+	ImGuiIO& io    = ImGui::GetIO();
+	io.DisplaySize = ImVec2(1920.0f, 1080.0f);
+	io.IniFilename = nullptr;
+	io.BackendFlags |= ImGuiBackendFlags_RendererHasTextures;
+
+	std::printf("%-8s %10s %10s %10s %10s %7s %7s\n",
+	            "rows", "panel", "+ list", "naive", "+ list", "merges", "sorts");
+
+	for (const uint32_t count : {100u, 1'000u, 10'000u, 100'000u})
+	{
+		ProcessPanel     panel;
+		const FrameTimes clipped = RunFrames(count, [&panel](const std::vector<ProcessSample>& processes, const uint64_t sequence)
+		{
+			panel.Draw(processes.data(), static_cast<uint32_t>(processes.size()), sequence, 0.0f);
+		});
+
+		std::vector<uint32_t> order;
+		uint64_t              orderSequence = 0;
+		const FrameTimes      naive         = RunFrames(count, [&order, &orderSequence](const std::vector<ProcessSample>& processes, const uint64_t sequence)
+		{
+			DrawNaive(processes, sequence, order, orderSequence);
+		});
+
+		std::printf("%-8u %7.3f ms %7.3f ms %7.3f ms %7.3f ms %7llu %7llu\n",
+		            count, clipped.medianNs / 1e6, clipped.scanNs / 1e6, naive.medianNs / 1e6, naive.scanNs / 1e6,
+		            static_cast<unsigned long long>(panel.GetMergeSortCount()),
+		            static_cast<unsigned long long>(panel.GetFullSortCount()));
+	}
+
+	ImGui::DestroyContext();
+	return 0;
+}
+
+
+_Use_decl_annotations_
+void MakeProcesses(
+	std::vector<ProcessSample>& processes,
+	const uint32_t              count,
+	std::mt19937&               random)
+{
+	std::exponential_distribution<float> load(0.5f);
+	processes.resize(count);
+	for (uint32_t i = 0; i < count; i++)
+	{
+		processes[i].pid       = i + 1;
+		processes[i].cpu       = random() % 4 == 0 ? std::min(load(random), 100.0f) : 0.0f;
+		processes[i].rssBytes  = (random() % 500'000) * 4096;
+		processes[i].readRate  = random() % 8 == 0 ? static_cast<float>(random() % 4'000'000) : 0.0f;
+		processes[i].writeRate = random() % 8 == 0 ? static_cast<float>(random() % 4'000'000) : 0.0f;
+		processes[i].wait      = random() % 16 == 0 ? static_cast<float>(random() % 500) / 10.0f : 0.0f;
+		processes[i].state     = "RSSSSSDI"[random() % 8];
+		(void)std::snprintf(processes[i].name, sizeof(processes[i].name), "worker-%u", static_cast<uint32_t>(random() % 997));
+	}
+}
+
+_Use_decl_annotations_
+void Rescan(
+	std::vector<ProcessSample>& processes,
+	uint32_t&                   nextPid,
+	std::mt19937&               random)
+{
+	std::exponential_distribution<float> load(0.5f);
+	const auto                           count = static_cast<uint32_t>(processes.size());
+	for (uint32_t i = 0; i < std::max(count / 100, 1u); i++)
+	{
+		processes[random() % count].cpu = std::min(load(random), 100.0f);
+	}
+	for (uint32_t i = 0; i < count / 1000; i++)
+	{
+		ProcessSample& process = processes[random() % count];
+		process.pid            = nextPid++;
+		process.cpu            = load(random);
+		process.rssBytes       = (random() % 500'000) * 4096;
+	}
+}
+
+template <typename Draw>
+_Use_decl_annotations_
+FrameTimes RunFrames(
+	const uint32_t count,
+	Draw           draw)
+{
+	std::mt19937               random(42);
+	std::vector<ProcessSample> processes;
+	MakeProcesses(processes, count, random);
+	uint32_t nextPid  = count + 1;
+	uint64_t sequence = 1;
+
+	std::vector<int64_t> frames;
+	std::vector<int64_t> scanFrames;
+	for (int frame = 0; frame < kFrames; frame++)
+	{
+		const bool newList = frame > 0 && frame % kFramesPerScan == 0;
+		if (newList)
+		{
+			Rescan(processes, nextPid, random);
+			++sequence;
+		}
+
+		const int64_t start = TscClock::NowNs();
+		ImGui::NewFrame();
+		ImGui::SetNextWindowPos(ImVec2(0.0f, 0.0f));
+		ImGui::SetNextWindowSize(ImVec2(420.0f, 360.0f));
+		ImGui::Begin("Processes", nullptr, ImGuiWindowFlags_NoDecoration);
+		draw(processes, sequence);
+		ImGui::End();
+		ImGui::Render();
+		const int64_t duration = TscClock::NowNs() - start;
+
+		// The first frames create the window and the table's settings.
+		if (frame >= 2)
+		{
+			frames.push_back(duration);
+		}
+		if (newList)
+		{
+			scanFrames.push_back(duration);
+		}
+	}
+	return {Median(frames), Median(scanFrames)};
+}
+
+_Use_decl_annotations_
+void DrawNaive(
+	const std::vector<ProcessSample>& processes,
+	const uint64_t                    sequence,
+	std::vector<uint32_t>&            order,
+	uint64_t&                         orderSequence)
+{
+	if (orderSequence != sequence)
+	{
+		order.resize(processes.size());
+		std::iota(order.begin(), order.end(), 0u);
+		std::sort(order.begin(), order.end(), [&processes](const uint32_t a, const uint32_t b)
+		{
+			return processes[a].cpu != processes[b].cpu ? processes[a].cpu > processes[b].cpu : processes[a].pid < processes[b].pid;
+		});
+		orderSequence = sequence;
+	}
+
+	if (!ImGui::BeginTable("naive", ProcessPanel::ColumnCount, ImGuiTableFlags_ScrollY | ImGuiTableFlags_RowBg))
+	{
+		return;
+	}
+	ImGui::TableSetupColumn("NAME");
+	ImGui::TableSetupColumn("PID");
+	ImGui::TableSetupColumn("CPU %");
+	ImGui::TableSetupColumn("MEM MB");
+	ImGui::TableSetupColumn("IO KB/s");
+	ImGui::TableSetupColumn("WAIT %");
+	ImGui::TableSetupColumn("S");
+	ImGui::TableHeadersRow();
+	for (const uint32_t index : order)
+	{
+		const ProcessSample& process = processes[index];
+		ImGui::TableNextRow();
+		ImGui::TableNextColumn();
+		ImGui::TextUnformatted(process.name);
+		ImGui::TableNextColumn();
+		ImGui::Text("%u", process.pid);
+		ImGui::TableNextColumn();
+		ImGui::Text("%5.1f", process.cpu);
+		ImGui::TableNextColumn();
+		ImGui::Text("%8.1f", process.rssBytes / (1024.0 * 1024.0));
+		ImGui::TableNextColumn();
+		ImGui::Text("%8.0f", (process.readRate + process.writeRate) / 1024.0f);
+		ImGui::TableNextColumn();
+		ImGui::Text("%6.1f", process.wait);
+		ImGui::TableNextColumn();
+		ImGui::Text("%c", process.state ? process.state : ' ');
+	}
+	ImGui::EndTable();
+}
+
+_Use_decl_annotations_
+int64_t Median(
+	std::vector<int64_t>& durations)
+{
+	std::nth_element(durations.begin(), durations.begin() + durations.size() / 2, durations.end());
+	return durations[durations.size() / 2];
+}
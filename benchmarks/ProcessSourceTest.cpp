@@ -0,0 +1,160 @@
+/**
+ * @file ProcessSourceTest.cpp
+ * @brief Checks that the monitor's process source stays healthy while it scans a synthetic
+ *		  /proc tree of 20,000 processes, a pass several times longer than its deadline.
+ * @author Alessandro Bellia
+ * @date 10/16/2026
+ *
+ * Build and run from the repository root:
+ *
+ *	g++ -O2 -std=c++20 -IPerformanceOverlay benchmarks/ProcessSourceTest.cpp \
+ *		PerformanceOverlay/PerformanceMonitorLinux.cpp PerformanceOverlay/CpuCoreBank.cpp \
+ *		PerformanceOverlay/ProcFile.cpp PerformanceOverlay/MetricRegistry.cpp PerformanceOverlay/MetricHistory.cpp \
+ *		PerformanceOverlay/RollupStore.cpp PerformanceOverlay/MemoryAccounting.cpp \
+ *		PerformanceOverlay/SourceWatchdog.cpp PerformanceOverlay/AdaptiveRate.cpp PerformanceOverlay/ProcessTable.cpp \
+ *		PerformanceOverlay/ProcessTableLinux.cpp PerformanceOverlay/StringInterner.cpp PerformanceOverlay/TscClock.cpp \
+ *		-o process-source-test
+ *	./process-source-test [directory]
+ *
+ * The tree holds the stat and meminfo files the monitor opens and a stat, io and schedstat
+ * file per process, built under the given directory (/tmp by default) and removed
+ * afterwards. A whole unsliced ProcessTable::Update() over it is timed for reference, then
+ * UpdateSource(SourceProcesses) is called back to back for kPasses passes, as the sampler
+ * would while a scan is in progress. After every call the source must be StateOk and have
+ * taken no longer than its deadline, and while a scan is partway the source must ask to be
+ * resumed after the slice interval. Every completed pass must publish all the processes.
+ * Every failed check is printed, and the program exits with 1 if any failed.
+ */
+
+#ifdef __linux__
+
+#include "ProcFixture.h"
+#include "MetricRegistry.h"
+#include "PerformanceMonitor.h"
+#include "TscClock.h"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <string>
+
+/**
+ * @brief The number of processes in the tree.
+ */
+static constexpr uint32_t kProcessCount = 20'000;
+
+/**
+ * @brief The number of completed passes the source is checked over.
+ */
+static constexpr uint32_t kPasses = 3;
+
+/**
+ * @brief Records the outcome of one check.
+ * @param[in] condition The checked condition.
+ * @param[in] what The description printed if the condition does not hold.
+ * @param[in,out] failures The number of failed checks, incremented on failure.
+ */
+static void Expect(
+	_In_ bool          condition,
+	_In_z_ const char* what,
+	_Inout_ int&       failures);
+
+
+int main(
+	_In_ const int          argc,
+	_In_reads_(argc) char** argv)
+{
+	TscClock::Calibrate();
+
+	const std::filesystem::path base = argc > 1 ? argv[1] : "/tmp";
+	const std::filesystem::path root = base / "process-source-test";
+	std::filesystem::remove_all(root);
+	std::filesystem::create_directories(root);
+
+	static constexpr char kStat[]    = "cpu  100 0 100 800 0 0 0 0 0 0\ncpu0 100 0 100 800 0 0 0 0 0 0\n";
+	static constexpr char kMeminfo[] = "MemTotal:       16384000 kB\nMemAvailable:    8192000 kB\n";
+	std::mt19937_64       random(7);
+	bool                  written = WriteFixtureFile(root / "stat", kStat, sizeof(kStat) - 1) &&
+		WriteFixtureFile(root / "meminfo", kMeminfo, sizeof(kMeminfo) - 1);
+	for (uint32_t pid = 1; pid <= kProcessCount && written; pid++)
+	{
+		written = WriteFixtureProcess(root, pid, 1000 + pid, random);
+	}
+	if (!written)
+	{
+		std::fprintf(stderr, "cannot write %s\n", root.c_str());
+		return 1;
+	}
+
+	// A whole pass in one call, which is what the source used to cost.
+	int64_t wholeNs = 0;
+	{
+		ProcessTable table(root.c_str());
+		(void)table.Open();
+		(void)table.Update();
+		const int64_t start = TscClock::NowNs();
+		(void)table.Update();
+		wholeNs = TscClock::NowNs() - start;
+	}
+
+	MetricRegistry     registry;
+	PerformanceMonitor monitor(root.c_str(), root.c_str());
+	if (!monitor.Initialize(registry))
+	{
+		std::fprintf(stderr, "cannot initialize the monitor over %s\n", root.c_str());
+		return 1;
+	}
+
+	const SourceWatchdog& watchdog   = monitor.GetWatchdog();
+	const int64_t         deadlineNs = static_cast<int64_t>(watchdog.GetDeadlineMs(PerformanceMonitor::SourceProcesses)) * 1'000'000;
+	const int64_t         sliceNs    = std::chrono::nanoseconds(PerformanceMonitor::kProcessSliceInterval).count();
+	int                   failures   = 0;
+	uint32_t              passes     = 0;
+	uint32_t              calls      = 0;
+	int64_t               longestNs  = 0;
+	while (passes < kPasses && failures == 0)
+	{
+		monitor.UpdateSource(PerformanceMonitor::SourceProcesses);
+		calls++;
+
+		const int64_t latencyNs = watchdog.GetLatencyNs(PerformanceMonitor::SourceProcesses);
+		longestNs               = std::max(longestNs, latencyNs);
+		Expect(watchdog.GetState(PerformanceMonitor::SourceProcesses) == SourceWatchdog::StateOk, "the source stays ok", failures);
+		Expect(latencyNs <= deadlineNs, "every call fits the source's deadline", failures);
+
+		if (monitor.GetProcesses().IsScanning())
+		{
+			Expect(monitor.GetSourceIntervalNs(PerformanceMonitor::SourceProcesses) == sliceNs,
+			       "a scan in progress is resumed after the slice interval", failures);
+			continue;
+		}
+		Expect(monitor.GetProcesses().GetCount() == kProcessCount, "a completed pass holds every process", failures);
+		Expect(registry.GetValues()[MetricProcessCount] == static_cast<float>(kProcessCount),
+		       "a completed pass publishes the process count", failures);
+		passes++;
+	}
+
+	std::printf("%u processes: whole scan %.1f ms, deadline %.0f ms, %u passes in %u calls, longest call %.1f ms\n",
+	            kProcessCount, wholeNs / 1e6, deadlineNs / 1e6, passes, calls, longestNs / 1e6);
+
+	monitor.Shutdown();
+	std::filesystem::remove_all(root);
+	std::printf(failures == 0 ? "ok\n" : "FAILED\n");
+	return failures == 0 ? 0 : 1;
+}
+
+
+_Use_decl_annotations_
+void Expect(
+	const bool  condition,
+	const char* what,
+	int&        failures)
+{
+	if (!condition)
+	{
+		std::fprintf(stderr, "failed: %s\n", what);
+		failures++;
+	}
+}
+
+#endif // __linux__
@@ -0,0 +1,328 @@
+/**
+ * @file ProcessStoreBenchmark.cpp
+ * @brief Compares the memory and sort cost of the ProcessTable's columns and interned strings
+ *		  against an array of structures owning std::string names and command lines.
+ * @author Alessandro Bellia
+ * @date 10/16/2026
+ *
+ * Build and run from the repository root:
+ *
+ *	g++ -O2 -std=c++20 -IPerformanceOverlay benchmarks/ProcessStoreBenchmark.cpp \
+ *		PerformanceOverlay/ProcessTable.cpp PerformanceOverlay/ProcessTableLinux.cpp \
+ *		PerformanceOverlay/StringInterner.cpp PerformanceOverlay/ProcFile.cpp \
+ *		PerformanceOverlay/TscClock.cpp -o store-bench
+ *	./store-bench [directory]
+ *
+ * A synthetic tree of 10k processes, each with a stat file, a cmdline file and an exe link,
+ * is built under the given directory (/tmp by default) and removed afterwards. The processes
+ * are drawn from a mix like a busy desktop's: kernel threads without an executable, many
+ * browser and worker processes sharing an executable and most of a command line, and a few
+ * one-off tools. Heap usage is measured by counting the bytes behind every operator new. The
+ * array of structures is filled from the table, so both hold exactly the same strings. The
+ * churn pass then replaces a tenth of the processes before each scan until the table has
+ * turned over twice, to check that the strings of the exited processes were freed.
+ */
+
+#ifdef __linux__
+
+#include "ProcFixture.h"
+#include "ProcessTable.h"
+#include "TscClock.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <malloc.h>
+#include <new>
+#include <numeric>
+#include <random>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+/**
+ * @brief The number of processes in the tree.
+ */
+static constexpr uint32_t kProcessCount = 10'000;
+
+/**
+ * @brief The number of sorts the median is taken over.
+ */
+static constexpr int kSorts = 9;
+
+/**
+ * @brief The bytes currently allocated through operator new.
+ */
+static std::atomic<size_t> s_heapBytes{0};
+
+/**
+ * @struct Profile
+ * @brief A kind of process the tree is populated with.
+ */
+struct Profile
+{
+	const char* name;        ///< Formatted with a number for kernel threads.
+	const char* executable;  ///< Empty for kernel threads.
+	const char* commandLine; ///< Formatted with a number; arguments separated by '\n', written as NULs.
+	uint32_t    weight;      ///< Out of the sum of all weights.
+};
+
+/**
+ * @brief The mix of processes; the numbers make some command lines unique.
+ */
+static constexpr Profile kProfiles[] = {
+	{"kworker/%u:1", "", "", 30},
+	{"chrome", "/opt/google/chrome/chrome",
+	 "/opt/google/chrome/chrome\n--type=renderer\n--crashpad-handler-pid=2211\n--enable-crash-reporter=,stable\n"
+	 "--change-stack-guard-on-fork=enable\n--lang=en-US\n--num-raster-threads=4\n--enable-main-frame-before-activation\n"
+	 "--renderer-client-id=%u\n--time-ticks-at-unix-epoch=-1697447123456789\n--launch-time-ticks=1234567\n"
+	 "--shared-files=v8_context_snapshot_data:100\n--field-trial-handle=3,i,1580718231123,2137,262144", 25},
+	{"python3", "/usr/bin/python3.12", "python3\n-m\ncelery\n-A\nworker.app\nworker\n--concurrency=1\n--loglevel=INFO", 15},
+	{"node", "/usr/bin/node", "node\n/srv/app/node_modules/.bin/jest\n--runInBand\n--shard=%u/64", 10},
+	{"bash", "/usr/bin/bash", "-bash", 8},
+	{"postgres", "/usr/lib/postgresql/16/bin/postgres", "postgres: app app 10.0.0.%u(52344) idle", 7},
+	{"sshd", "/usr/sbin/sshd", "sshd: app@pts/%u", 3},
+	{"make", "/usr/bin/make", "make\n-j64\n-C\nbuild/shard-%u", 2},
+};
+
+/**
+ * @struct NaiveProcess
+ * @brief One process in the array-of-structures layout the table is compared against.
+ */
+struct NaiveProcess
+{
+	uint32_t    pid;
+	uint32_t    scan;
+	uint64_t    startTime;
+	uint64_t    cpuTime;
+	uint64_t    rssBytes;
+	uint64_t    readBytes;
+	uint64_t    writeBytes;
+	uint64_t    syscalls;
+	uint64_t    runDelay;
+	float       cpu;
+	float       readRate;
+	float       writeRate;
+	float       syscallRate;
+	float       wait;
+	char        state;
+	bool        ioDenied;
+	std::string name;
+	std::string executable;
+	std::string commandLine;
+};
+
+/**
+ * @brief Writes one synthetic process: its stat file, its cmdline file and its exe link.
+ * @param[in] root The tree's root.
+ * @param[in] pid The process id.
+ * @param[in] random The generator for the profile, the counters and the unique numbers.
+ */
+static void WriteProcess(
+	_In_ const std::filesystem::path& root,
+	_In_ uint32_t                     pid,
+	_Inout_ std::mt19937_64&          random);
+
+/**
+ * @brief Gets the median time of sorting an index array with a comparison.
+ * @param[in] count The number of indices.
+ * @param[in] less The comparison.
+ * @return The median duration in nanoseconds.
+ */
+template <typename Less>
+static int64_t TimeSort(
+	_In_ uint32_t count,
+	_In_ Less     less);
+
+
+void* operator new(
+	const size_t size)
+{
+	void* const p = std::malloc(size);
+	if (!p)
+	{
+		throw std::bad_alloc();
+	}
+	s_heapBytes += ::malloc_usable_size(p);
+	return p;
+}
+
+void operator delete(
+	void* const p) noexcept
+{
+	if (p)
+	{
+		s_heapBytes -= ::malloc_usable_size(p);
+		std::free(p);
+	}
+}
+
+void operator delete(
+	void* const p,
+	size_t) noexcept
+{
+	operator delete(p);
+}
+
+int main(
+	_In_ const int          argc,
+	_In_reads_(argc) char** argv)
+{
+	TscClock::Calibrate();
+
+	const std::filesystem::path base = argc > 1 ? argv[1] : "/tmp";
+	const std::filesystem::path root = base / "process-store-bench";
+	std::mt19937_64             random(42);
+
+	std::filesystem::remove_all(root);
+	for (uint32_t pid = 1; pid <= kProcessCount; pid++)
+	{
+		WriteProcess(root, pid, random);
+	}
+
+	// The table is built on the heap so that everything it holds is counted.
+	const size_t  tableBefore = s_heapBytes;
+	ProcessTable* table       = new ProcessTable(root.c_str());
+	if (!table->Open() || !table->Update())
+	{
+		std::fprintf(stderr, "cannot scan %s\n", root.c_str());
+		return 1;
+	}
+	const size_t tableBytes = s_heapBytes - tableBefore;
+
+	std::vector<ProcessSample> samples;
+	table->CopySamples(samples);
+
+	const size_t                naiveBefore = s_heapBytes;
+	std::vector<NaiveProcess>* naive       = new std::vector<NaiveProcess>();
+	for (const ProcessSample& sample : samples)
+	{
+		naive->push_back(NaiveProcess{sample.pid, 1, 0, 0, sample.rssBytes, 0, 0, 0, 0, sample.cpu,
+		                              sample.readRate, sample.writeRate, sample.syscallRate, sample.wait, sample.state, false,
+		                              sample.name, table->GetExecutable(sample.pid), table->GetCommandLine(sample.pid)});
+	}
+	const size_t naiveBytes = s_heapBytes - naiveBefore;
+
+	const StringInterner& strings = table->GetStrings();
+	size_t                rawBytes = 0;
+	for (const NaiveProcess& process : *naive)
+	{
+		rawBytes += process.name.size() + process.executable.size() + process.commandLine.size();
+	}
+
+	std::printf("%u processes: %u distinct strings, %zu KB of live string bytes out of %zu KB without interning\n",
+	            table->GetCount(), strings.GetCount(), strings.GetLiveBytes() / 1024, rawBytes / 1024);
+	std::printf("%-22s %10s %12s\n", "layout", "heap", "per process");
+	std::printf("%-22s %7zu KB %9zu B\n", "columns + interning", tableBytes / 1024, tableBytes / table->GetCount());
+	std::printf("%-22s %7zu KB %9zu B\n", "structs + std::string", naiveBytes / 1024, naiveBytes / table->GetCount());
+	std::printf("%-22s %7zu KB   (GetMemoryFootprint)\n", "", table->GetMemoryFootprint() / 1024);
+
+	// Sorting by one field: the column is read contiguously, the structures with a stride.
+	std::vector<uint64_t> rss(samples.size());
+	std::transform(samples.begin(), samples.end(), rss.begin(), [](const ProcessSample& sample) { return sample.rssBytes; });
+	const int64_t columnNs = TimeSort(table->GetCount(), [&rss](const uint32_t a, const uint32_t b) { return rss[a] > rss[b]; });
+	const int64_t structNs = TimeSort(table->GetCount(), [naive](const uint32_t a, const uint32_t b)
+	{
+		return (*naive)[a].rssBytes > (*naive)[b].rssBytes;
+	});
+	std::printf("sort by memory: columns %.1f us, structs %.1f us (sizeof %zu)\n",
+	            columnNs / 1e3, structNs / 1e3, sizeof(NaiveProcess));
+
+	std::vector<int64_t> scans;
+	for (int scan = 0; scan < kSorts; scan++)
+	{
+		const int64_t start = TscClock::NowNs();
+		(void)table->Update();
+		scans.push_back(TscClock::NowNs() - start);
+	}
+	std::nth_element(scans.begin(), scans.begin() + kSorts / 2, scans.end());
+	std::printf("steady scan: %.2f ms\n", scans[kSorts / 2] / 1e6);
+
+	// A tenth of the processes exit and as many start before each scan, oldest first, until
+	// the whole table has turned over twice. The strings of the exited processes must be
+	// freed, so the table ends up holding about as many as it started with.
+	const uint32_t churn = kProcessCount / 10;
+	for (uint32_t round = 0; round < 20; round++)
+	{
+		for (uint32_t i = 0; i < churn; i++)
+		{
+			const uint32_t pid = 1 + round * churn + i;
+			std::filesystem::remove_all(root / std::to_string(pid));
+			WriteProcess(root, pid + kProcessCount, random);
+		}
+		(void)table->Update();
+	}
+	std::printf("after 2 turnovers: %u processes, %u distinct strings, %zu KB live, footprint %zu KB\n",
+	            table->GetCount(), strings.GetCount(), strings.GetLiveBytes() / 1024, table->GetMemoryFootprint() / 1024);
+
+	delete naive;
+	delete table;
+	std::filesystem::remove_all(root);
+	return 0;
+}
+
+
+_Use_decl_annotations_
+void WriteProcess(
+	const std::filesystem::path& root,
+	const uint32_t               pid,
+	std::mt19937_64&             random)
+{
+	uint32_t totalWeight = 0;
+	for (const Profile& profile : kProfiles)
+	{
+		totalWeight += profile.weight;
+	}
+	uint32_t       pick    = static_cast<uint32_t>(random() % totalWeight);
+	const Profile* profile = kProfiles;
+	while (pick >= profile->weight)
+	{
+		pick -= profile->weight;
+		++profile;
+	}
+
+	const std::filesystem::path directory = root / std::to_string(pid);
+	std::filesystem::create_directories(directory);
+
+	// Kernel threads are numbered per CPU, so only a few of their names repeat.
+	char      name[64];
+	const int unique = static_cast<int>(random() % 64);
+	(void)std::snprintf(name, sizeof(name), profile->name, unique);
+
+	(void)WriteFixtureStat(directory, pid, name, 1000 + pid, random);
+
+	// Renderer ids and shard numbers are unique to a process; the other numbers repeat.
+	char       commandLine[1024];
+	const auto number       = std::strstr(profile->commandLine, "renderer-client-id") ? pid : static_cast<uint32_t>(unique);
+	const int  commandLength = std::snprintf(commandLine, sizeof(commandLine), profile->commandLine, number);
+	std::replace(commandLine, commandLine + commandLength, '\n', '\0');
+	(void)WriteFixtureFile(directory / "cmdline", commandLine, static_cast<size_t>(commandLength) + (commandLength > 0 ? 1 : 0));
+
+	if (*profile->executable)
+	{
+		(void)::symlink(profile->executable, (directory / "exe").c_str());
+	}
+}
+
+template <typename Less>
+_Use_decl_annotations_
+int64_t TimeSort(
+	const uint32_t count,
+	Less           less)
+{
+	std::vector<int64_t>  durations;
+	std::vector<uint32_t> order(count);
+	for (int sort = 0; sort < kSorts; sort++)
+	{
+		std::iota(order.begin(), order.end(), 0u);
+		const int64_t start = TscClock::NowNs();
+		std::sort(order.begin(), order.end(), less);
+		durations.push_back(TscClock::NowNs() - start);
+	}
+	std::nth_element(durations.begin(), durations.begin() + kSorts / 2, durations.end());
+	return durations[kSorts / 2];
+}
+
+#endif // __linux__
@@ -0,0 +1,182 @@
+/**
+ * @file ProcessTableBenchmark.cpp
+ * @brief Measures the cost of a ProcessTable scan over synthetic /proc trees of 1k, 10k and
+ *		  50k processes, and over the real /proc.
+ * @author Alessandro Bellia
+ * @date 10/16/2026
+ *
+ * Build and run from the repository root:
+ *
+ *	g++ -O2 -std=c++20 -IPerformanceOverlay benchmarks/ProcessTableBenchmark.cpp \
+ *		PerformanceOverlay/ProcessTable.cpp PerformanceOverlay/ProcessTableLinux.cpp \
+ *		PerformanceOverlay/StringInterner.cpp PerformanceOverlay/ProcFile.cpp PerformanceOverlay/TscClock.cpp -o process-bench
+ *	./process-bench [directory]
+ *
+ * A tree is a directory of numbered subdirectories, each holding stat, io and schedstat
+ * files laid out like their /proc/[pid] counterparts, built under the given directory (/tmp
+ * by default) and removed afterwards. The first scan inserts every process; the steady scans
+ * find them all in place, which is what the sampler pays for every second. Before the churn
+ * scan 5% of the processes exit, as many new ones start, and 1% of the pids are taken over
+ * by a new process with a later start time; the scan must report exactly those as reused.
+ * The selection columns compare picking the top ProcessTable::kTopCount by partial selection
+ * against sorting the whole table. Regular files are cheaper to read than procfs, which
+ * formats every stat file on the fly, so the real /proc line is the one to compare against
+ * on a live machine.
+ */
+
+#ifdef __linux__
+
+#include "ProcFixture.h"
+#include "ProcessTable.h"
+#include "TscClock.h"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * @brief The number of steady scans the median is taken over.
+ */
+static constexpr int kSteadyScans = 9;
+
+/**
+ * @brief Times one ProcessTable::Update().
+ * @param[in,out] table The table.
+ * @return The duration in nanoseconds, or -1 if the scan failed.
+ */
+static int64_t TimeScan(
+	_Inout_ ProcessTable& table);
+
+/**
+ * @brief Times picking the top kTopCount of n random values by partial selection and by a full sort.
+ * @param[in] count The number of values.
+ * @param[out] partialNs Receives the partial selection's duration.
+ * @param[out] fullNs Receives the full sort's duration.
+ */
+static void TimeSelection(
+	_In_ uint32_t  count,
+	_Out_ int64_t& partialNs,
+	_Out_ int64_t& fullNs);
+
+
+int main(
+	_In_ const int          argc,
+	_In_reads_(argc) char** argv)
+{
+	TscClock::Calibrate();
+
+	const std::filesystem::path base = argc > 1 ? argv[1] : "/tmp";
+	std::mt19937_64             random(42);
+
+	std::printf("%-10s %10s %10s %9s %10s %7s %10s %10s\n",
+	            "processes", "first", "steady", "per proc", "churn", "reused", "partial", "full sort");
+
+	for (const uint32_t count : {1'000u, 10'000u, 50'000u})
+	{
+		const std::filesystem::path root = base / ("process-bench-" + std::to_string(count));
+		std::filesystem::remove_all(root);
+		for (uint32_t pid = 1; pid <= count; pid++)
+		{
+			(void)WriteFixtureProcess(root, pid, 1000 + pid, random);
+		}
+
+		ProcessTable table(root.c_str());
+		if (!table.Open())
+		{
+			std::fprintf(stderr, "cannot open %s\n", root.c_str());
+			return 1;
+		}
+
+		const int64_t firstNs = TimeScan(table);
+
+		std::vector<int64_t> steady;
+		for (int scan = 0; scan < kSteadyScans; scan++)
+		{
+			steady.push_back(TimeScan(table));
+		}
+		std::nth_element(steady.begin(), steady.begin() + kSteadyScans / 2, steady.end());
+		const int64_t steadyNs = steady[kSteadyScans / 2];
+
+		// 5% exit and are replaced by new pids; 1% of the pids are reused with a later start time.
+		const uint32_t exits  = count / 20;
+		const uint32_t reuses = count / 100;
+		for (uint32_t i = 0; i < exits; i++)
+		{
+			std::filesystem::remove_all(root / std::to_string(1 + i * 20));
+			(void)WriteFixtureProcess(root, count + 1 + i, 900'000 + i, random);
+		}
+		for (uint32_t i = 0; i < reuses; i++)
+		{
+			(void)WriteFixtureProcess(root, 2 + i * 100, 900'000 + i, random);
+		}
+
+		const uint64_t reusedBefore = table.GetReusedPidCount();
+		const int64_t  churnNs      = TimeScan(table);
+		const uint64_t reused       = table.GetReusedPidCount() - reusedBefore;
+
+		int64_t partialNs;
+		int64_t fullNs;
+		TimeSelection(count, partialNs, fullNs);
+
+		std::printf("%-10u %7.2f ms %7.2f ms %6.2f us %7.2f ms %3llu/%-3u %7.1f us %7.1f us\n",
+		            count, firstNs / 1e6, steadyNs / 1e6, steadyNs / 1e3 / count, churnNs / 1e6,
+		            static_cast<unsigned long long>(reused), reuses, partialNs / 1e3, fullNs / 1e3);
+		if (table.GetCount() != count)
+		{
+			std::fprintf(stderr, "expected %u processes after the churn, found %u\n", count, table.GetCount());
+		}
+
+		table.Close();
+		std::filesystem::remove_all(root);
+	}
+
+	ProcessTable live;
+	if (live.Open())
+	{
+		(void)TimeScan(live);
+		const int64_t liveNs = TimeScan(live);
+		std::printf("%-10s %10s %7.2f ms %6.2f us   (%u processes)\n",
+		            "/proc", "", liveNs / 1e6, liveNs / 1e3 / std::max(live.GetCount(), 1u), live.GetCount());
+	}
+	return 0;
+}
+
+
+_Use_decl_annotations_
+int64_t TimeScan(
+	ProcessTable& table)
+{
+	const int64_t start = TscClock::NowNs();
+	const bool    ok    = table.Update();
+	return ok ? TscClock::NowNs() - start : -1;
+}
+
+_Use_decl_annotations_
+void TimeSelection(
+	const uint32_t count,
+	int64_t&       partialNs,
+	int64_t&       fullNs)
+{
+	std::mt19937                          random(7);
+	std::uniform_real_distribution<float> load(0.0f, 100.0f);
+	std::vector<float>                    values(count);
+	std::generate(values.begin(), values.end(), [&] { return load(random); });
+
+	const auto byValue = [&values](const uint32_t a, const uint32_t b) { return values[a] > values[b]; };
+
+	std::vector<uint32_t> order(count);
+	std::iota(order.begin(), order.end(), 0u);
+	int64_t start = TscClock::NowNs();
+	std::partial_sort(order.begin(), order.begin() + ProcessTable::kTopCount, order.end(), byValue);
+	partialNs = TscClock::NowNs() - start;
+
+	std::iota(order.begin(), order.end(), 0u);
+	start = TscClock::NowNs();
+	std::sort(order.begin(), order.end(), byValue);
+	fullNs = TscClock::NowNs() - start;
+}
+
+#endif // __linux__
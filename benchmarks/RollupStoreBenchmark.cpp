@@ -0,0 +1,112 @@
+/**
+ * @file RollupStoreBenchmark.cpp
+ * @brief Measures the memory and append cost of a RollupStore holding 24 hours of 100 metrics.
+ * @author Alessandro Bellia
+ * @date 10/16/2026
+ *
+ * Build and run from the repository root:
+ *
+ *	g++ -O2 -std=c++20 -IPerformanceOverlay benchmarks/RollupStoreBenchmark.cpp \
+ *		PerformanceOverlay/RollupStore.cpp PerformanceOverlay/TscClock.cpp PerformanceOverlay/ProcFile.cpp -o rollup-bench
+ *	./rollup-bench
+ *
+ * The store is configured for 100 metrics and fed one sample per metric per second for 24
+ * hours of simulated time, as many as the sampler appends at its default interval when every
+ * source is volatile. The footprint is RollupStore::GetMemoryFootprint(), the figure the
+ * overlay reports to MemoryAccounting, checked against the tiers' bucket counts and against
+ * the 10-15 MB the README budgets for the whole overlay. Reading the full 24 hours back must
+ * yield one non-empty 10 min bucket per 10 minutes. The program exits with 1 if a check fails.
+ */
+
+#include "RollupStore.h"
+#include "TscClock.h"
+#include <cstdio>
+#include <vector>
+
+/**
+ * @brief The number of metrics, as budgeted in the README.
+ */
+static constexpr uint32_t kMetricCount = 100;
+
+/**
+ * @brief The simulated time covered, in seconds.
+ */
+static constexpr int64_t kSpanSeconds = 24 * 60 * 60;
+
+/**
+ * @brief The lower end of the README's memory budget for the whole overlay, in bytes.
+ */
+static constexpr size_t kBudgetBytes = 10'000'000;
+
+
+int main()
+{
+	TscClock::Calibrate();
+
+	RollupStore store;
+	store.Configure(kMetricCount);
+
+	// The two-second offset keeps the first sample's bucket from being the oldest one retained.
+	const int64_t startNs = 2'000'000'000LL;
+	const int64_t begin   = TscClock::NowNs();
+	for (int64_t second = 0; second < kSpanSeconds; second++)
+	{
+		const int64_t timestampNs = startNs + second * 1'000'000'000LL;
+		for (uint32_t metric = 0; metric < kMetricCount; metric++)
+		{
+			store.Append(metric, timestampNs, static_cast<float>((second + metric) % 100));
+		}
+	}
+	const int64_t appendNs = TscClock::NowNs() - begin;
+	const int64_t appends  = kSpanSeconds * kMetricCount;
+
+	size_t bucketsPerMetric = 0;
+	for (const RollupStore::TierSpec& spec : RollupStore::kTiers)
+	{
+		bucketsPerMetric += spec.bucketCount;
+	}
+	const size_t footprint = store.GetMemoryFootprint();
+	const size_t buckets   = bucketsPerMetric * kMetricCount * sizeof(RollupBucket);
+
+	std::printf("metrics               %u\n", kMetricCount);
+	std::printf("bucket size           %zu bytes\n", sizeof(RollupBucket));
+	std::printf("buckets per metric    %zu\n", bucketsPerMetric);
+	std::printf("footprint             %zu bytes (%.2f MB, %.1f KB per metric)\n",
+	            footprint, footprint / 1e6, footprint / 1e3 / kMetricCount);
+	std::printf("of a %zu MB budget     %.1f%%\n", kBudgetBytes / 1'000'000, 100.0 * footprint / kBudgetBytes);
+	std::printf("append                %.1f ns per sample (%lld samples)\n",
+	            static_cast<double>(appendNs) / appends, static_cast<long long>(appends));
+
+	int result = 0;
+	if (footprint < buckets)
+	{
+		std::fprintf(stderr, "the footprint misses the %zu bytes of buckets\n", buckets);
+		result = 1;
+	}
+	if (footprint > kBudgetBytes)
+	{
+		std::fprintf(stderr, "the rollups alone exceed the %zu MB budget\n", kBudgetBytes / 1'000'000);
+		result = 1;
+	}
+
+	// The span ends in the last bucket and starts in the oldest one the 10 min tier retains.
+	const int64_t             endNs = startNs + (kSpanSeconds - 1) * 1'000'000'000LL;
+	std::vector<RollupBucket> day(RollupStore::kTiers[RollupStore::kTierCount - 1].bucketCount);
+	const RollupRange         range = store.Read(0, endNs - (kSpanSeconds - 600) * 1'000'000'000LL, endNs,
+	                                             static_cast<uint32_t>(day.size()), day.data());
+	uint32_t filled = 0;
+	for (uint32_t i = 0; i < range.count; i++)
+	{
+		filled += day[i].count != 0 ? 1 : 0;
+	}
+	std::printf("24 h read             %u of %u buckets of %lld s filled\n",
+	            filled, range.count, static_cast<long long>(range.bucketNs / 1'000'000'000LL));
+	if (range.count != day.size() || filled != range.count)
+	{
+		std::fprintf(stderr, "the 24 h read does not cover the day\n");
+		result = 1;
+	}
+
+	std::printf(result == 0 ? "ok\n" : "FAILED\n");
+	return result;
+}
@@ -0,0 +1,99 @@
+/**
+ * @file SlowPlugin.c
+ * @brief A test plugin whose Sample() blocks for a set time, for PluginBudgetTest.cpp.
+ * @author Alessandro Bellia
+ * @date 10/16/2026
+ *
+ * Build it into the directory the test loads from:
+ *
+ *	cc -shared -fPIC -O2 -IPerformanceOverlay benchmarks/SlowPlugin.c -o /tmp/slow-plugin/SlowPlugin.so
+ *
+ * Init() reads the time every Sample() blocks for, in milliseconds, from the
+ * PERFOVERLAY_SLOW_PLUGIN_MS environment variable. The plugin reports one metric that
+ * counts its calls, so a value that drops to zero can only have been zeroed by the host.
+ */
+
+#ifdef __linux__
+
+#define _POSIX_C_SOURCE 199309L
+
+#include "MetricPlugin.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * @brief The plugin's state.
+ */
+typedef struct SlowState
+{
+	long     blockMs; ///< How long every Sample() blocks.
+	uint32_t calls;   ///< Number of Sample() calls so far.
+} SlowState;
+
+
+PERFOVERLAY_PLUGIN_EXPORT int PerfOverlayPluginInit(
+	uint32_t apiVersion,
+	void**   context)
+{
+	if (apiVersion != PERFOVERLAY_PLUGIN_API_VERSION)
+	{
+		return 1;
+	}
+
+	SlowState* state = (SlowState*)calloc(1, sizeof(SlowState));
+	if (!state)
+	{
+		return 1;
+	}
+	const char* blockMs = getenv("PERFOVERLAY_SLOW_PLUGIN_MS");
+	state->blockMs      = blockMs ? strtol(blockMs, NULL, 10) : 0;
+	*context            = state;
+	return 0;
+}
+
+PERFOVERLAY_PLUGIN_EXPORT uint32_t PerfOverlayPluginDescribe(
+	void*                  context,
+	PerfOverlayMetricInfo* metrics,
+	uint32_t               capacity)
+{
+	(void)context;
+	if (capacity < 1)
+	{
+		return 0;
+	}
+
+	strcpy(metrics[0].name, "test.slow.calls");
+	metrics[0].unit     = PERFOVERLAY_UNIT_COUNT;
+	metrics[0].rangeMin = 0.0f;
+	metrics[0].rangeMax = 100.0f;
+	return 1;
+}
+
+PERFOVERLAY_PLUGIN_EXPORT void PerfOverlayPluginSample(
+	void*    context,
+	float*   values,
+	uint32_t count)
+{
+	SlowState* state = (SlowState*)context;
+
+	// Stands in for a plugin stuck on a lock, a pipe or a slow device.
+	struct timespec block = {state->blockMs / 1000, (state->blockMs % 1000) * 1000000L};
+	while (nanosleep(&block, &block) != 0)
+	{
+	}
+
+	state->calls++;
+	if (count >= 1)
+	{
+		values[0] = (float)state->calls;
+	}
+}
+
+PERFOVERLAY_PLUGIN_EXPORT void PerfOverlayPluginShutdown(
+	void* context)
+{
+	free(context);
+}
+
+#endif /* __linux__ */
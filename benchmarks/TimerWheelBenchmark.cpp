@@ -0,0 +1,188 @@
+/**
+ * @file TimerWheelBenchmark.cpp
+ * @brief Compares the cost of a wakeup on the TimerWheel against a linear scan of every
+ *		  timer at 256, 4096 and 16384 timers.
+ * @author Alessandro Bellia
+ * @date 10/16/2026
+ *
+ * Build and run from the repository root:
+ *
+ *	g++ -O2 -std=c++20 -IPerformanceOverlay benchmarks/TimerWheelBenchmark.cpp \
+ *		PerformanceOverlay/TimerWheel.cpp PerformanceOverlay/TscClock.cpp PerformanceOverlay/ProcFile.cpp \
+ *		-o timer-wheel-bench
+ *	./timer-wheel-bench
+ *
+ * Both schedulers run the same timers through a minute of simulated time: intervals of
+ * whole milliseconds from 250 ms to 10 s, drawn log-uniformly, each with a random phase,
+ * coalesced within the default 5 ms window. The clock jumps straight to each scheduler's
+ * next wakeup, so the loop is pure scheduling work. The wheel wakes at NextDeadlineNs()
+ * and fires through Advance(); the linear scan walks every timer on each wakeup, firing
+ * the due ones, re-arming them on their grid and finding the next deadline in the same
+ * pass, which is what a plain array of deadlines costs. The wakeups and fired columns are
+ * the wheel's; the times are per wakeup and per timer fired, over all wakeups. Each timer must fire as often on the wheel as in the scan,
+ * give or take one at the end of the span, or the program exits with 1.
+ */
+
+#include "TimerWheel.h"
+#include "TscClock.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+/**
+ * @brief The simulated time each scheduler runs for.
+ */
+static constexpr int64_t kSpanNs = 60'000'000'000;
+
+/**
+ * @struct RunCost
+ * @brief What one scheduler spent over the span.
+ */
+struct RunCost
+{
+	int64_t  elapsedNs; ///< Time spent in the scheduler.
+	uint64_t wakeups;
+	uint64_t fired;
+};
+
+/**
+ * @brief Runs the timers on a TimerWheel.
+ * @param[in] intervals The interval of every timer, in nanoseconds.
+ * @param[in] phases The time to every timer's first deadline, in nanoseconds.
+ * @param[out] counts Receives how often each timer fired.
+ * @return The cost.
+ */
+static RunCost RunWheel(
+	_In_ const std::vector<int64_t>& intervals,
+	_In_ const std::vector<int64_t>& phases,
+	_Out_ std::vector<uint32_t>&     counts);
+
+/**
+ * @brief Runs the timers on an array of deadlines scanned on every wakeup.
+ * @param[in] intervals The interval of every timer, in nanoseconds.
+ * @param[in] phases The time to every timer's first deadline, in nanoseconds.
+ * @param[out] counts Receives how often each timer fired.
+ * @return The cost.
+ */
+static RunCost RunScan(
+	_In_ const std::vector<int64_t>& intervals,
+	_In_ const std::vector<int64_t>& phases,
+	_Out_ std::vector<uint32_t>&     counts);
+
+
+int main()
+{
+	TscClock::Calibrate();
+
+	std::printf("%-7s %8s %9s %12s %10s %12s %10s %8s\n",
+	            "timers", "wakeups", "fired", "wheel", "per fire", "scan", "per fire", "speedup");
+
+	int result = 0;
+	for (const uint32_t timerCount : {256u, 4096u, 16384u})
+	{
+		std::mt19937_64                        random(timerCount);
+		std::uniform_real_distribution<double> exponent(std::log10(250.0), 4.0); // 250 ms to 10 s
+		std::vector<int64_t>                   intervals(timerCount);
+		std::vector<int64_t>                   phases(timerCount);
+		for (uint32_t timer = 0; timer < timerCount; timer++)
+		{
+			intervals[timer] = static_cast<int64_t>(std::pow(10.0, exponent(random))) * 1'000'000;
+			phases[timer]    = static_cast<int64_t>(random() % static_cast<uint64_t>(intervals[timer] / 1'000'000)) * 1'000'000;
+		}
+
+		std::vector<uint32_t> wheelCounts;
+		std::vector<uint32_t> scanCounts;
+		const RunCost         wheel = RunWheel(intervals, phases, wheelCounts);
+		const RunCost         scan  = RunScan(intervals, phases, scanCounts);
+
+		std::printf("%-7u %8llu %9llu %9.1f us %7.0f ns %9.1f us %7.0f ns %7.1fx\n", timerCount,
+		            static_cast<unsigned long long>(wheel.wakeups), static_cast<unsigned long long>(wheel.fired),
+		            wheel.elapsedNs / 1e3 / static_cast<double>(wheel.wakeups), static_cast<double>(wheel.elapsedNs) / static_cast<double>(wheel.fired),
+		            scan.elapsedNs / 1e3 / static_cast<double>(scan.wakeups), static_cast<double>(scan.elapsedNs) / static_cast<double>(scan.fired),
+		            static_cast<double>(scan.elapsedNs) / static_cast<double>(wheel.elapsedNs));
+
+		for (uint32_t timer = 0; timer < timerCount; timer++)
+		{
+			if (wheelCounts[timer] + 1 < scanCounts[timer] || scanCounts[timer] + 1 < wheelCounts[timer])
+			{
+				std::fprintf(stderr, "timer %u of %u fired %u times on the wheel and %u in the scan\n",
+				             timer, timerCount, wheelCounts[timer], scanCounts[timer]);
+				result = 1;
+				break;
+			}
+		}
+	}
+
+	std::printf(result == 0 ? "ok\n" : "FAILED\n");
+	return result;
+}
+
+
+_Use_decl_annotations_
+RunCost RunWheel(
+	const std::vector<int64_t>& intervals,
+	const std::vector<int64_t>& phases,
+	std::vector<uint32_t>&      counts)
+{
+	const auto timerCount = static_cast<uint32_t>(intervals.size());
+	counts.assign(timerCount, 0);
+
+	TimerWheel wheel;
+	wheel.Configure(timerCount, 0);
+	for (uint32_t timer = 0; timer < timerCount; timer++)
+	{
+		(void)wheel.Add(0, std::chrono::nanoseconds(intervals[timer]), std::chrono::nanoseconds(phases[timer]), timer);
+	}
+
+	RunCost       cost  = {};
+	const int64_t start = TscClock::NowNs();
+	for (int64_t nowNs = 0; nowNs < kSpanNs; nowNs = wheel.NextDeadlineNs())
+	{
+		cost.fired += wheel.Advance(nowNs, [&counts](uint32_t, const uint32_t tag) { counts[tag]++; });
+		cost.wakeups++;
+	}
+	cost.elapsedNs = TscClock::NowNs() - start;
+	return cost;
+}
+
+_Use_decl_annotations_
+RunCost RunScan(
+	const std::vector<int64_t>& intervals,
+	const std::vector<int64_t>& phases,
+	std::vector<uint32_t>&      counts)
+{
+	const auto    timerCount = static_cast<uint32_t>(intervals.size());
+	const int64_t windowNs   = std::chrono::nanoseconds(TimerWheel::kDefaultCoalesceWindow).count();
+	counts.assign(timerCount, 0);
+
+	std::vector<int64_t> deadlines(phases);
+	RunCost              cost  = {};
+	const int64_t        start = TscClock::NowNs();
+	for (int64_t nowNs = 0; nowNs < kSpanNs;)
+	{
+		int64_t next = INT64_MAX;
+		for (uint32_t timer = 0; timer < timerCount; timer++)
+		{
+			int64_t& deadline = deadlines[timer];
+			if (deadline <= nowNs + windowNs)
+			{
+				counts[timer]++;
+				cost.fired++;
+
+				// The same grid and coalescing rules as the wheel.
+				deadline += intervals[timer];
+				if (deadline <= nowNs + windowNs)
+				{
+					deadline += ((nowNs + windowNs - deadline) / intervals[timer] + 1) * intervals[timer];
+				}
+			}
+			next = std::min(next, deadline);
+		}
+		cost.wakeups++;
+		nowNs = next;
+	}
+	cost.elapsedNs = TscClock::NowNs() - start;
+	return cost;
+}
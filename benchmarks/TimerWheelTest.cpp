@@ -0,0 +1,346 @@
+/**
+ * @file TimerWheelTest.cpp
+ * @brief Checks the TimerWheel against a brute-force model over randomized schedules.
+ * @author Alessandro Bellia
+ * @date 10/16/2026
+ *
+ * Build and run from the repository root:
+ *
+ *	g++ -O2 -std=c++20 -IPerformanceOverlay benchmarks/TimerWheelTest.cpp \
+ *		PerformanceOverlay/TimerWheel.cpp -o timer-wheel-test
+ *	./timer-wheel-test
+ *
+ * Every round drives a wheel and a model with the same random operations: timers are added
+ * with intervals from a tenth of a tick to ten seconds, some of them shorter than the
+ * coalescing window, cancelled, and given new intervals, both between wakeups and from the
+ * fire callback, while time advances by steps from a fraction of a tick to tens of seconds.
+ * The model keeps every timer in a plain array and, on each Advance(), fires in tick order
+ * the ones whose tick falls within the window, re-arming them with the rules the wheel
+ * documents. Each Advance() must fire the same timers, each at most once, the fired and
+ * missed counters must match, and NextDeadlineNs() must never be later than the earliest
+ * timer. Every failed check is printed, and the program exits with 1 if any failed.
+ */
+
+#include "TimerWheel.h"
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+/**
+ * @brief The number of randomized rounds.
+ */
+static constexpr int kRounds = 20;
+
+/**
+ * @brief The number of operations per round.
+ */
+static constexpr int kOperations = 5000;
+
+/**
+ * @brief The most timers armed at once.
+ */
+static constexpr uint32_t kCapacity = 128;
+
+/**
+ * @brief The tick length every round runs at.
+ */
+static constexpr int64_t kResolutionNs = 1'000'000;
+
+/**
+ * @brief The time tick 0 starts at; not a multiple of the resolution.
+ */
+static constexpr int64_t kOriginNs = 1'234'567;
+
+/**
+ * @struct ModelTimer
+ * @brief One timer of the brute-force model.
+ */
+struct ModelTimer
+{
+	bool     armed;
+	int64_t  deadlineNs;
+	int64_t  intervalNs;
+	int64_t  tick;  ///< The tick it fires on: its deadline's, but never before the tick after it was armed.
+	uint32_t fires; ///< How often it fired, which the callback's decisions are derived from.
+};
+
+/**
+ * @struct Model
+ * @brief The brute-force model of a wheel: every timer in a plain array.
+ */
+struct Model
+{
+	std::vector<ModelTimer> timers;
+	int64_t                 tick     = 0;
+	int64_t                 windowNs = 0;
+	uint64_t                fired    = 0;
+	uint64_t                missed   = 0;
+};
+
+/**
+ * @brief Records the outcome of one check.
+ * @param[in] condition The checked condition.
+ * @param[in] what The description printed if the condition does not hold.
+ * @param[in,out] failures The number of failed checks, incremented on failure.
+ */
+static void Expect(
+	_In_ bool          condition,
+	_In_z_ const char* what,
+	_Inout_ int&       failures);
+
+/**
+ * @brief Gets the tick a deadline falls on, rounded up as the wheel does.
+ * @param[in] deadlineNs The deadline.
+ * @return The tick.
+ */
+static int64_t TickOf(
+	_In_ int64_t deadlineNs);
+
+/**
+ * @brief Decides what the fire callback does to a timer on one of its firings.
+ * @param[in] timer The timer's id.
+ * @param[in] fires How often it fired before.
+ * @param[out] intervalNs Receives the new interval, or 0 to keep the current one.
+ * @return true to cancel the timer.
+ */
+static bool DecideInCallback(
+	_In_ uint32_t  timer,
+	_In_ uint32_t  fires,
+	_Out_ int64_t& intervalNs);
+
+/**
+ * @brief Fires the model's due timers, as TimerWheel::Advance() does.
+ * @param[in,out] model The model.
+ * @param[in] nowNs The current time.
+ * @return The timers fired, sorted.
+ */
+static std::vector<uint32_t> AdvanceModel(
+	_Inout_ Model& model,
+	_In_ int64_t   nowNs);
+
+/**
+ * @brief Draws a timer interval, a tenth of a tick to ten seconds, biased towards short ones.
+ * @param[in,out] random The generator.
+ * @return The interval in nanoseconds.
+ */
+static int64_t DrawInterval(
+	_Inout_ std::mt19937_64& random);
+
+
+int main()
+{
+	int failures = 0;
+	int errors   = 0;
+
+	for (int round = 0; round < kRounds; round++)
+	{
+		std::mt19937_64 random(round + 1);
+		const int64_t   windows[] = {0, 1'000'000, 5'000'000, 20'000'000};
+
+		TimerWheel wheel;
+		Model      model;
+		wheel.Configure(kCapacity, kOriginNs, std::chrono::nanoseconds(kResolutionNs));
+		model.timers.assign(kCapacity, ModelTimer{});
+		model.windowNs = windows[round % 4];
+		wheel.SetCoalesceWindow(std::chrono::nanoseconds(model.windowNs));
+
+		const int before = failures;
+		int64_t   nowNs  = kOriginNs;
+		for (int operation = 0; operation < kOperations && failures - before < 5; operation++)
+		{
+			const uint64_t choice = random() % 100;
+			if (choice < 30)
+			{
+				const int64_t  intervalNs = DrawInterval(random);
+				const int64_t  phaseNs    = static_cast<int64_t>(random() % 2'000'000'000);
+				const uint32_t timer      = wheel.Add(nowNs, std::chrono::nanoseconds(intervalNs), std::chrono::nanoseconds(phaseNs), 0);
+				const auto     armed      = std::count_if(model.timers.begin(), model.timers.end(),
+				                                          [](const ModelTimer& entry) { return entry.armed; });
+				if (timer == TimerWheel::kInvalidTimer)
+				{
+					Expect(armed == kCapacity, "Add() fails only when every timer is armed", failures);
+					continue;
+				}
+				Expect(timer < kCapacity && !model.timers[timer].armed, "Add() hands out a free timer", failures);
+
+				ModelTimer& entry = model.timers[timer];
+				entry.armed       = true;
+				entry.intervalNs  = intervalNs;
+				entry.deadlineNs  = kOriginNs + TickOf(nowNs + phaseNs) * kResolutionNs;
+				entry.tick        = std::max(TickOf(entry.deadlineNs), model.tick + 1);
+				entry.fires       = 0;
+			}
+			else if (choice < 38)
+			{
+				const auto timer = static_cast<uint32_t>(random() % kCapacity);
+				wheel.Cancel(timer);
+				model.timers[timer].armed = false;
+			}
+			else if (choice < 46)
+			{
+				const auto timer = static_cast<uint32_t>(random() % kCapacity);
+				if (model.timers[timer].armed)
+				{
+					const int64_t intervalNs = DrawInterval(random);
+					wheel.SetInterval(timer, intervalNs);
+					model.timers[timer].intervalNs = intervalNs;
+				}
+			}
+			else
+			{
+				// Mostly short steps, a few of them long enough to miss whole periods.
+				const uint64_t step = random() % 100;
+				nowNs += step < 90 ? static_cast<int64_t>(random() % 20'000'000)
+				                   : static_cast<int64_t>(random() % 30'000'000'000);
+
+				std::vector<uint32_t> fired;
+				(void)wheel.Advance(nowNs, [&wheel, &model, &fired](const uint32_t timer, uint32_t)
+				{
+					int64_t intervalNs = 0;
+					if (DecideInCallback(timer, model.timers[timer].fires, intervalNs))
+					{
+						wheel.Cancel(timer);
+					}
+					else if (intervalNs != 0)
+					{
+						wheel.SetInterval(timer, intervalNs);
+					}
+					fired.push_back(timer);
+				});
+				std::sort(fired.begin(), fired.end());
+
+				const std::vector<uint32_t> expected = AdvanceModel(model, nowNs);
+				Expect(std::adjacent_find(fired.begin(), fired.end()) == fired.end(), "a timer fires at most once per Advance()", failures);
+				Expect(fired == expected, "Advance() fires the timers the model does", failures);
+			}
+
+			Expect(wheel.GetFiredCount() == model.fired, "the fired counter matches the model", failures);
+			Expect(wheel.GetMissedCount() == model.missed, "the missed counter matches the model", failures);
+
+			int64_t earliest = INT64_MAX;
+			for (const ModelTimer& entry : model.timers)
+			{
+				earliest = entry.armed ? std::min(earliest, kOriginNs + entry.tick * kResolutionNs) : earliest;
+			}
+			Expect(wheel.NextDeadlineNs() <= earliest, "the next wakeup is never after the earliest timer", failures);
+			Expect(earliest != INT64_MAX || wheel.NextDeadlineNs() == INT64_MAX, "an empty wheel schedules no wakeup", failures);
+		}
+
+		if (failures != before)
+		{
+			std::fprintf(stderr, "round %d (window %lld us) failed\n", round, static_cast<long long>(model.windowNs / 1000));
+			errors++;
+		}
+	}
+
+	std::printf("%d rounds, %d errors\n", kRounds, errors);
+	std::printf(failures == 0 ? "ok\n" : "FAILED\n");
+	return failures == 0 ? 0 : 1;
+}
+
+
+_Use_decl_annotations_
+void Expect(
+	const bool  condition,
+	const char* what,
+	int&        failures)
+{
+	if (!condition)
+	{
+		std::fprintf(stderr, "failed: %s\n", what);
+		failures++;
+	}
+}
+
+_Use_decl_annotations_
+int64_t TickOf(
+	const int64_t deadlineNs)
+{
+	return (deadlineNs - kOriginNs + kResolutionNs - 1) / kResolutionNs;
+}
+
+_Use_decl_annotations_
+bool DecideInCallback(
+	const uint32_t timer,
+	const uint32_t fires,
+	int64_t&       intervalNs)
+{
+	const uint32_t hash = (timer * 2654435761u) ^ (fires * 40503u);
+	intervalNs          = hash % 7 == 0 ? 200'000 + static_cast<int64_t>(hash % 50) * 1'000'000 : 0;
+	return hash % 29 == 0;
+}
+
+_Use_decl_annotations_
+std::vector<uint32_t> AdvanceModel(
+	Model&        model,
+	const int64_t nowNs)
+{
+	std::vector<uint32_t> fired;
+	const int64_t         target = (nowNs + model.windowNs - kOriginNs) / kResolutionNs;
+	if (target <= model.tick)
+	{
+		return fired;
+	}
+
+	// Timers fire in tick order; each is re-armed past the target, so one pass over the
+	// due timers sorted by tick is every firing of this Advance().
+	std::vector<uint32_t> due;
+	for (uint32_t timer = 0; timer < model.timers.size(); timer++)
+	{
+		if (model.timers[timer].armed && model.timers[timer].tick <= target)
+		{
+			due.push_back(timer);
+		}
+	}
+	std::stable_sort(due.begin(), due.end(), [&model](const uint32_t a, const uint32_t b) { return model.timers[a].tick < model.timers[b].tick; });
+
+	for (const uint32_t timer : due)
+	{
+		ModelTimer& entry = model.timers[timer];
+		fired.push_back(timer);
+
+		int64_t    intervalNs = 0;
+		const bool cancel     = DecideInCallback(timer, entry.fires++, intervalNs);
+		if (cancel)
+		{
+			entry.armed = false;
+			continue;
+		}
+		entry.intervalNs = intervalNs != 0 ? intervalNs : entry.intervalNs;
+		model.fired++;
+
+		entry.deadlineNs += entry.intervalNs;
+		if (entry.deadlineNs <= nowNs)
+		{
+			const int64_t missed = (nowNs - entry.deadlineNs) / entry.intervalNs + 1;
+			entry.deadlineNs += missed * entry.intervalNs;
+			model.missed += static_cast<uint64_t>(missed);
+		}
+		while (TickOf(entry.deadlineNs) <= target)
+		{
+			entry.deadlineNs += entry.intervalNs;
+		}
+		entry.tick = TickOf(entry.deadlineNs);
+	}
+
+	model.tick = target;
+	std::sort(fired.begin(), fired.end());
+	return fired;
+}
+
+_Use_decl_annotations_
+int64_t DrawInterval(
+	std::mt19937_64& random)
+{
+	const uint64_t choice = random() % 4;
+	if (choice == 0)
+	{
+		return 100'000 + static_cast<int64_t>(random() % 10'000'000); // Often shorter than the window
+	}
+	if (choice == 1)
+	{
+		return static_cast<int64_t>(1 + random() % 100) * kResolutionNs;
+	}
+	return 1 + static_cast<int64_t>(random() % 10'000'000'000);
+}
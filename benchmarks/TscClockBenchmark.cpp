@@ -0,0 +1,138 @@
+/**
+ * @file TscClockBenchmark.cpp
+ * @brief Compares the cost and drift of TscClock against clock_gettime() on Linux.
+ * @author Alessandro Bellia
+ * @date 10/15/2026
+ *
+ * Build and run from the repository root:
+ *
+ *	g++ -O2 -std=c++20 -IPerformanceOverlay benchmarks/TscClockBenchmark.cpp \
+ *		PerformanceOverlay/TscClock.cpp PerformanceOverlay/ProcFile.cpp -o tsc-bench
+ *	./tsc-bench [seconds]
+ *
+ * The first part times a tight loop of every way to read the time. The second part
+ * compares TscClock::NowNs() against CLOCK_MONOTONIC every 100 ms for the given number of
+ * seconds (30 by default). It reports the error with the periodic Resync(), and what the
+ * error would have been with the startup calibration alone.
+ */
+
+#ifdef __linux__
+
+#include "TscClock.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <thread>
+
+/**
+ * @brief The number of reads each cost measurement averages over.
+ */
+static constexpr int kIterations = 10'000'000;
+
+/**
+ * @brief Reads a clock with clock_gettime().
+ * @param[in] clock The clock id.
+ * @return The clock's time in nanoseconds.
+ */
+static int64_t ClockNs(
+	_In_ clockid_t clock);
+
+/**
+ * @brief Times kIterations calls of a clock read.
+ * @param[in] name The label printed with the result.
+ * @param[in] read The read to time; its results are summed so the loop is not optimized out.
+ */
+template <typename Read>
+static void MeasureCost(
+	_In_z_ const char* name,
+	_In_ Read          read);
+
+
+int main(
+	_In_ const int          argc,
+	_In_reads_(argc) char** argv)
+{
+	const int seconds = argc > 1 ? std::max(std::atoi(argv[1]), 1) : 30;
+
+	TscClock::Calibrate();
+	std::printf("source: %s, %.3f MHz\n", TscClock::IsUsingTsc() ? "invariant TSC" : "steady clock", TscClock::GetTicksPerSecond() / 1e6);
+
+	// --- Cost ---
+	MeasureCost("clock_gettime(CLOCK_MONOTONIC)", [] { return static_cast<uint64_t>(ClockNs(CLOCK_MONOTONIC)); });
+	MeasureCost("std::chrono::steady_clock::now()", []
+	{
+		return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+	});
+	MeasureCost("TscClock::Now()", [] { return TscClock::Now(); });
+	MeasureCost("TscClock::NowNs()", [] { return static_cast<uint64_t>(TscClock::NowNs()); });
+	MeasureCost("TscClock::DurationNs(Now() - start)", [start = TscClock::Now()]
+	{
+		return static_cast<uint64_t>(TscClock::DurationNs(TscClock::Now() - start));
+	});
+
+	// --- Drift ---
+	// Extrapolating from the state right after calibration shows the drift that Resync() removes.
+	const uint64_t startTicks    = TscClock::Now();
+	const int64_t  startNs       = TscClock::ToNanoseconds(startTicks);
+	const double   startRate     = 1e9 / TscClock::GetTicksPerSecond();
+	int64_t        maxResynced   = 0;
+	int64_t        maxCalibrated = 0;
+	int64_t        maxAtResync   = 0;
+
+	for (int tick = 0; tick < seconds * 10; tick++)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(100));
+		TscClock::Resync();
+
+		const int64_t  before = ClockNs(CLOCK_MONOTONIC);
+		const uint64_t ticks  = TscClock::Now();
+		const int64_t  after  = ClockNs(CLOCK_MONOTONIC);
+		const int64_t  actual = before + (after - before) / 2;
+
+		const int64_t resynced   = TscClock::ToNanoseconds(ticks) - actual;
+		const int64_t calibrated = startNs + static_cast<int64_t>(static_cast<double>(ticks - startTicks) * startRate) - actual;
+		maxResynced              = std::max(maxResynced, std::abs(resynced));
+		maxCalibrated            = std::max(maxCalibrated, std::abs(calibrated));
+		maxAtResync              = std::max(maxAtResync, std::abs(TscClock::GetLastResyncErrorNs()));
+
+		if ((tick + 1) % 50 == 0)
+		{
+			std::printf("%4d s: error %+6lld ns with resync, %+8lld ns with calibration only\n",
+			            (tick + 1) / 10, static_cast<long long>(resynced), static_cast<long long>(calibrated));
+		}
+	}
+
+	std::printf("max |error| over %d s: %lld ns with resync (%lld ns drift between resyncs), %lld ns with calibration only\n",
+	            seconds, static_cast<long long>(maxResynced), static_cast<long long>(maxAtResync), static_cast<long long>(maxCalibrated));
+	return 0;
+}
+
+
+_Use_decl_annotations_
+int64_t ClockNs(
+	const clockid_t clock)
+{
+	timespec ts{};
+	(void)::clock_gettime(clock, &ts);
+	return static_cast<int64_t>(ts.tv_sec) * 1'000'000'000 + ts.tv_nsec;
+}
+
+template <typename Read>
+_Use_decl_annotations_
+void MeasureCost(
+	const char* name,
+	Read        read)
+{
+	uint64_t                                    sink  = 0;
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (int i = 0; i < kIterations; i++)
+	{
+		sink += read();
+	}
+	const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+	std::printf("%-36s %6.2f ns/call (checksum %llu)\n", name, elapsed.count() / kIterations, static_cast<unsigned long long>(sink & 0xFF));
+}
+
+#endif // __linux__
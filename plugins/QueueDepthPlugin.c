@@ -0,0 +1,105 @@
+/**
+ * @file QueueDepthPlugin.c
+ * @brief An example metric-provider plugin that reports the depth of a simulated work queue.
+ * @author Alessandro Bellia
+ * @date 10/15/2026
+ *
+ * Build it next to the overlay's executable, in its "plugins" directory:
+ *
+ *	cl /LD /O2 /IPerformanceOverlay plugins\QueueDepthPlugin.c /Fe:x64\Release\plugins\QueueDepthPlugin.dll
+ *	cc -shared -fPIC -O2 -IPerformanceOverlay plugins/QueueDepthPlugin.c -o plugins/QueueDepthPlugin.so
+ *
+ * A real plugin would read the depths from the application it watches, e.g. through shared
+ * memory, and keep Sample() to a few plain loads.
+ */
+
+#include "MetricPlugin.h"
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief The plugin's state.
+ */
+typedef struct QueueState
+{
+	uint32_t seed;      ///< State of the pseudo-random walk.
+	float    depth;     ///< Current number of queued items.
+	float    highWater; ///< Deepest the queue has been.
+} QueueState;
+
+/**
+ * @brief The capacity of the simulated queue.
+ */
+static const float kQueueCapacity = 1024.0f;
+
+
+PERFOVERLAY_PLUGIN_EXPORT int PerfOverlayPluginInit(
+	uint32_t apiVersion,
+	void**   context)
+{
+	if (apiVersion != PERFOVERLAY_PLUGIN_API_VERSION)
+	{
+		return 1;
+	}
+
+	QueueState* state = (QueueState*)calloc(1, sizeof(QueueState));
+	if (!state)
+	{
+		return 1;
+	}
+	state->seed = 12345u;
+	*context    = state;
+	return 0;
+}
+
+PERFOVERLAY_PLUGIN_EXPORT uint32_t PerfOverlayPluginDescribe(
+	void*                  context,
+	PerfOverlayMetricInfo* metrics,
+	uint32_t               capacity)
+{
+	(void)context;
+	if (capacity < 2)
+	{
+		return 0;
+	}
+
+	strcpy(metrics[0].name, "example.queue.depth");
+	metrics[0].unit     = PERFOVERLAY_UNIT_COUNT;
+	metrics[0].rangeMin = 0.0f;
+	metrics[0].rangeMax = kQueueCapacity;
+
+	strcpy(metrics[1].name, "example.queue.high_water");
+	metrics[1].unit     = PERFOVERLAY_UNIT_COUNT;
+	metrics[1].rangeMin = 0.0f;
+	metrics[1].rangeMax = kQueueCapacity;
+	return 2;
+}
+
+PERFOVERLAY_PLUGIN_EXPORT void PerfOverlayPluginSample(
+	void*    context,
+	float*   values,
+	uint32_t count)
+{
+	QueueState* state = (QueueState*)context;
+
+	// A bounded random walk stands in for producers and consumers.
+	state->seed  = state->seed * 1664525u + 1013904223u;
+	state->depth += (float)((int)(state->seed >> 24) - 128) * 0.5f;
+	state->depth = state->depth < 0.0f ? 0.0f : state->depth > kQueueCapacity ? kQueueCapacity : state->depth;
+	if (state->depth > state->highWater)
+	{
+		state->highWater = state->depth;
+	}
+
+	if (count >= 2)
+	{
+		values[0] = state->depth;
+		values[1] = state->highWater;
+	}
+}
+
+PERFOVERLAY_PLUGIN_EXPORT void PerfOverlayPluginShutdown(
+	void* context)
+{
+	free(context);
+}